@@ -0,0 +1,97 @@
+//
+//  ZCRBenchmark.h
+//  ZCREasyBake
+//
+//  Created by Zachary Radke on 10/16/26.
+//  Copyright (c) 2026 Zach Radke. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+/**
+ *  The measurements of a single benchmark against a single corpus.
+ */
+@interface ZCRBenchmarkResult : NSObject
+
+/**
+ *  The name of the operation measured, such as "dough.init".
+ */
+@property (copy, nonatomic, readonly) NSString *name;
+
+/**
+ *  The name of the corpus the operation was measured against.
+ */
+@property (copy, nonatomic, readonly) NSString *corpusName;
+
+/**
+ *  The number of operations timed in each sample.
+ */
+@property (assign, nonatomic, readonly) NSUInteger iterations;
+
+/**
+ *  The median wall time of an operation across all samples, in nanoseconds.
+ */
+@property (assign, nonatomic, readonly) double nanosecondsPerOperation;
+
+/**
+ *  The mean number of heap allocations made by an operation, or a negative value if allocations
+ *  aren't counted on this platform.
+ */
+@property (assign, nonatomic, readonly) double allocationsPerOperation;
+
+/**
+ *  The mean number of bytes requested by the heap allocations of an operation, or a negative value
+ *  if allocations aren't counted on this platform.
+ */
+@property (assign, nonatomic, readonly) double bytesPerOperation;
+
+/**
+ *  The result as a single line of JSON with a fixed key order, so result files can be diffed line
+ *  by line across versions. Allocation measurements which aren't available are written as null.
+ */
+- (NSString *)JSONLine;
+
+@end
+
+
+/**
+ *  ZCRBenchmarkRunner times operations and counts their heap allocations.
+ *
+ *  Each benchmark is run once to warm up, then calibrated by doubling its iteration count until a
+ *  batch takes at least a tenth of the minimum duration. The calibrated batch is then timed for a
+ *  fixed number of samples, and the median is reported so that a single descheduled sample doesn't
+ *  skew the result. Every operation runs inside its own autorelease pool, so autoreleased objects
+ *  are counted against the operation which created them.
+ */
+@interface ZCRBenchmarkRunner : NSObject
+
+/**
+ *  Designated initializer for this class.
+ *
+ *  @param minimumDuration The minimum total time to spend measuring each benchmark, in seconds.
+ *  @param filter          An optional substring which benchmark or corpus names must contain for
+ *                         the benchmark to run.
+ *
+ *  @return A new runner.
+ */
+- (instancetype)initWithMinimumDuration:(NSTimeInterval)minimumDuration filter:(NSString *)filter;
+
+/**
+ *  Measures an operation, unless it is excluded by the filter.
+ *
+ *  @param name       The name of the operation.
+ *  @param corpusName The name of the corpus the operation is run against.
+ *  @param operation  The operation to measure. It is passed an increasing iteration number, which
+ *                    can be used to cycle through a corpus's records. This must not be nil.
+ *
+ *  @return The result, or nil if the benchmark was filtered out.
+ */
+- (ZCRBenchmarkResult *)measure:(NSString *)name corpusName:(NSString *)corpusName
+                      operation:(void (^)(NSUInteger iteration))operation __attribute__((nonnull (1,2,3)));
+
+/**
+ *  The results of every benchmark measured so far, in the order they were measured.
+ */
+@property (strong, nonatomic, readonly) NSArray *results;
+
+@end
@@ -0,0 +1,157 @@
+//
+//  ZCRBenchmark.m
+//  ZCREasyBake
+//
+//  Created by Zachary Radke on 10/16/26.
+//  Copyright (c) 2026 Zach Radke. All rights reserved.
+//
+
+#import "ZCRBenchmark.h"
+
+#import "ZCRBenchmarkAllocations.h"
+
+#include <time.h>
+
+enum { _ZCRBenchmarkSampleCount = 5 };
+
+static uint64_t _ZCRBenchmarkNow(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ull + (uint64_t)now.tv_nsec;
+}
+
+@interface ZCRBenchmarkResult ()
+- (instancetype)initWithName:(NSString *)name corpusName:(NSString *)corpusName
+                  iterations:(NSUInteger)iterations
+     nanosecondsPerOperation:(double)nanosecondsPerOperation
+     allocationsPerOperation:(double)allocationsPerOperation
+           bytesPerOperation:(double)bytesPerOperation;
+@end
+
+@implementation ZCRBenchmarkResult
+
+- (instancetype)initWithName:(NSString *)name corpusName:(NSString *)corpusName
+                  iterations:(NSUInteger)iterations
+     nanosecondsPerOperation:(double)nanosecondsPerOperation
+     allocationsPerOperation:(double)allocationsPerOperation
+           bytesPerOperation:(double)bytesPerOperation {
+    if (!(self = [super init])) { return nil; }
+    
+    _name = [name copy];
+    _corpusName = [corpusName copy];
+    _iterations = iterations;
+    _nanosecondsPerOperation = nanosecondsPerOperation;
+    _allocationsPerOperation = allocationsPerOperation;
+    _bytesPerOperation = bytesPerOperation;
+    
+    return self;
+}
+
+- (NSString *)JSONLine {
+    // Names are generated by the suite and never need escaping.
+    NSString *allocations = (_allocationsPerOperation < 0) ? @"null" : [NSString stringWithFormat:@"%.2f", _allocationsPerOperation];
+    NSString *bytes = (_bytesPerOperation < 0) ? @"null" : [NSString stringWithFormat:@"%.1f", _bytesPerOperation];
+    
+    return [NSString stringWithFormat:@"{\"benchmark\":\"%@\",\"corpus\":\"%@\",\"iterations\":%lu,\"ns_per_op\":%.1f,\"allocs_per_op\":%@,\"bytes_per_op\":%@}",
+            _name, _corpusName, (unsigned long)_iterations, _nanosecondsPerOperation, allocations, bytes];
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"<%@:%p> %@", NSStringFromClass([self class]), self, [self JSONLine]];
+}
+
+@end
+
+
+#pragma mark - ZCRBenchmarkRunner
+
+@implementation ZCRBenchmarkRunner {
+    NSTimeInterval _minimumDuration;
+    NSString *_filter;
+    NSMutableArray *_results;
+}
+
+- (instancetype)initWithMinimumDuration:(NSTimeInterval)minimumDuration filter:(NSString *)filter {
+    if (!(self = [super init])) { return nil; }
+    
+    _minimumDuration = MAX(minimumDuration, 0.001);
+    _filter = [filter copy];
+    _results = [NSMutableArray array];
+    
+    return self;
+}
+
+- (instancetype)init {
+    return [self initWithMinimumDuration:0.5 filter:nil];
+}
+
+- (NSArray *)results {
+    return [_results copy];
+}
+
+- (ZCRBenchmarkResult *)measure:(NSString *)name corpusName:(NSString *)corpusName
+                      operation:(void (^)(NSUInteger))operation {
+    NSParameterAssert(name);
+    NSParameterAssert(corpusName);
+    NSParameterAssert(operation);
+    
+    if (_filter.length > 0 && [name rangeOfString:_filter].location == NSNotFound &&
+        [corpusName rangeOfString:_filter].location == NSNotFound) {
+        return nil;
+    }
+    
+    __block NSUInteger iteration = 0;
+    uint64_t (^runBatch)(NSUInteger) = ^uint64_t(NSUInteger count) {
+        uint64_t start = _ZCRBenchmarkNow();
+        for (NSUInteger i = 0; i < count; i++) {
+            @autoreleasepool {
+                operation(iteration++);
+            }
+        }
+        return _ZCRBenchmarkNow() - start;
+    };
+    
+    runBatch(1);
+    
+    uint64_t calibrationTarget = (uint64_t)(_minimumDuration / 10.0 * 1e9);
+    NSUInteger iterations = 1;
+    while (runBatch(iterations) < calibrationTarget && iterations < (NSUIntegerMax >> 1)) {
+        iterations *= 2;
+    }
+    
+    double samples[_ZCRBenchmarkSampleCount];
+    uint64_t allocationCount = 0;
+    uint64_t byteCount = 0;
+    
+    for (NSUInteger sample = 0; sample < _ZCRBenchmarkSampleCount; sample++) {
+        uint64_t allocationsBefore = ZCRBenchmarkAllocationCount();
+        uint64_t bytesBefore = ZCRBenchmarkAllocatedByteCount();
+        uint64_t elapsed = runBatch(iterations);
+        allocationCount += ZCRBenchmarkAllocationCount() - allocationsBefore;
+        byteCount += ZCRBenchmarkAllocatedByteCount() - bytesBefore;
+    
+        samples[sample] = (double)elapsed / (double)iterations;
+    }
+    
+    // An insertion sort is plenty for a handful of samples.
+    for (NSUInteger i = 1; i < _ZCRBenchmarkSampleCount; i++) {
+        double sample = samples[i];
+        NSUInteger j = i;
+        for (; j > 0 && samples[j - 1] > sample; j--) {
+            samples[j] = samples[j - 1];
+        }
+        samples[j] = sample;
+    }
+    
+    double operationCount = (double)(iterations * _ZCRBenchmarkSampleCount);
+    BOOL countsAllocations = ZCRBenchmarkCountsAllocations();
+    ZCRBenchmarkResult *result = [[ZCRBenchmarkResult alloc] initWithName:name corpusName:corpusName
+                                                               iterations:iterations
+                                                  nanosecondsPerOperation:samples[_ZCRBenchmarkSampleCount / 2]
+                                                  allocationsPerOperation:(countsAllocations) ? allocationCount / operationCount : -1.0
+                                                        bytesPerOperation:(countsAllocations) ? byteCount / operationCount : -1.0];
+    [_results addObject:result];
+    return result;
+}
+
+@end
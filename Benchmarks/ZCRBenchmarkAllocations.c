@@ -0,0 +1,91 @@
+//
+//  ZCRBenchmarkAllocations.c
+//  ZCREasyBake
+//
+//  Created by Zachary Radke on 10/16/26.
+//  Copyright (c) 2026 Zach Radke. All rights reserved.
+//
+
+#include "ZCRBenchmarkAllocations.h"
+
+#include <errno.h>
+#include <stdlib.h>
+
+static uint64_t _ZCRAllocationCount = 0;
+static uint64_t _ZCRAllocatedByteCount = 0;
+
+static inline void _ZCRRecordAllocation(size_t size) {
+    __atomic_fetch_add(&_ZCRAllocationCount, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&_ZCRAllocatedByteCount, size, __ATOMIC_RELAXED);
+}
+
+#if defined(__GLIBC__)
+
+// glibc exports its allocator under these names, so the definitions below can interpose on every
+// allocation in the process, including those made by the Objective-C runtime and Foundation,
+// while still handing the work to the real allocator.
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t count, size_t size);
+extern void *__libc_realloc(void *pointer, size_t size);
+extern void *__libc_memalign(size_t alignment, size_t size);
+extern void __libc_free(void *pointer);
+
+void *malloc(size_t size) {
+    _ZCRRecordAllocation(size);
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t count, size_t size) {
+    _ZCRRecordAllocation(count * size);
+    return __libc_calloc(count, size);
+}
+
+void *realloc(void *pointer, size_t size) {
+    _ZCRRecordAllocation(size);
+    return __libc_realloc(pointer, size);
+}
+
+void *memalign(size_t alignment, size_t size) {
+    _ZCRRecordAllocation(size);
+    return __libc_memalign(alignment, size);
+}
+
+void *aligned_alloc(size_t alignment, size_t size) {
+    _ZCRRecordAllocation(size);
+    return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void **pointer, size_t alignment, size_t size) {
+    if (alignment < sizeof(void *) || (alignment & (alignment - 1)) != 0) { return EINVAL; }
+    
+    _ZCRRecordAllocation(size);
+    void *allocation = __libc_memalign(alignment, size);
+    if (!allocation) { return ENOMEM; }
+    
+    *pointer = allocation;
+    return 0;
+}
+
+void free(void *pointer) {
+    __libc_free(pointer);
+}
+
+bool ZCRBenchmarkCountsAllocations(void) {
+    return true;
+}
+
+#else
+
+bool ZCRBenchmarkCountsAllocations(void) {
+    return false;
+}
+
+#endif
+
+uint64_t ZCRBenchmarkAllocationCount(void) {
+    return __atomic_load_n(&_ZCRAllocationCount, __ATOMIC_RELAXED);
+}
+
+uint64_t ZCRBenchmarkAllocatedByteCount(void) {
+    return __atomic_load_n(&_ZCRAllocatedByteCount, __ATOMIC_RELAXED);
+}
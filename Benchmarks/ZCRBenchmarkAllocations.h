@@ -0,0 +1,31 @@
+//
+//  ZCRBenchmarkAllocations.h
+//  ZCREasyBake
+//
+//  Created by Zachary Radke on 10/16/26.
+//  Copyright (c) 2026 Zach Radke. All rights reserved.
+//
+
+#ifndef ZCREasyBake_ZCRBenchmarkAllocations_h
+#define ZCREasyBake_ZCRBenchmarkAllocations_h
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ *  Whether heap allocations are being counted. Counting replaces malloc and its relatives, which is
+ *  only supported when linking against glibc. Elsewhere the counts below always read 0.
+ */
+bool ZCRBenchmarkCountsAllocations(void);
+
+/**
+ *  The total number of heap allocations made by the process so far, across all threads.
+ */
+uint64_t ZCRBenchmarkAllocationCount(void);
+
+/**
+ *  The total number of bytes requested by heap allocations made by the process so far.
+ */
+uint64_t ZCRBenchmarkAllocatedByteCount(void);
+
+#endif
@@ -0,0 +1,132 @@
+//
+//  ZCRBenchmarkCorpus.h
+//  ZCREasyBake
+//
+//  Created by Zachary Radke on 10/16/26.
+//  Copyright (c) 2026 Zach Radke. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+#import "ZCREasyBake.h"
+
+/**
+ *  The maximum width of a corpus, which is the number of fields declared by ZCRBenchmarkModel.
+ */
+extern const NSUInteger ZCRBenchmarkMaximumWidth;
+
+/**
+ *  The model baked by every corpus. Corpora choose how many of its fields to map, so a single class
+ *  covers every width. Fields are untyped so that both raw and transformed values can be stored.
+ */
+@interface ZCRBenchmarkModel : ZCREasyDough
+@property (strong, nonatomic, readonly) id field00;
+@property (strong, nonatomic, readonly) id field01;
+@property (strong, nonatomic, readonly) id field02;
+@property (strong, nonatomic, readonly) id field03;
+@property (strong, nonatomic, readonly) id field04;
+@property (strong, nonatomic, readonly) id field05;
+@property (strong, nonatomic, readonly) id field06;
+@property (strong, nonatomic, readonly) id field07;
+@property (strong, nonatomic, readonly) id field08;
+@property (strong, nonatomic, readonly) id field09;
+@property (strong, nonatomic, readonly) id field10;
+@property (strong, nonatomic, readonly) id field11;
+@property (strong, nonatomic, readonly) id field12;
+@property (strong, nonatomic, readonly) id field13;
+@property (strong, nonatomic, readonly) id field14;
+@property (strong, nonatomic, readonly) id field15;
+@property (strong, nonatomic, readonly) id field16;
+@property (strong, nonatomic, readonly) id field17;
+@property (strong, nonatomic, readonly) id field18;
+@property (strong, nonatomic, readonly) id field19;
+@property (strong, nonatomic, readonly) id field20;
+@property (strong, nonatomic, readonly) id field21;
+@property (strong, nonatomic, readonly) id field22;
+@property (strong, nonatomic, readonly) id field23;
+@property (strong, nonatomic, readonly) id field24;
+@property (strong, nonatomic, readonly) id field25;
+@property (strong, nonatomic, readonly) id field26;
+@property (strong, nonatomic, readonly) id field27;
+@property (strong, nonatomic, readonly) id field28;
+@property (strong, nonatomic, readonly) id field29;
+@property (strong, nonatomic, readonly) id field30;
+@property (strong, nonatomic, readonly) id field31;
+@end
+
+
+/**
+ *  ZCRBenchmarkCorpus generates a deterministic set of synthetic ingredients, along with the recipe
+ *  which bakes them into ZCRBenchmarkModels.
+ *
+ *  The shape of the ingredients is controlled by the corpus's width, nesting depth, whether fields
+ *  are reached through array indexes, and how many fields are transformed. Nested corpora instead
+ *  bake each of their fields into a child model through a ZCREasyDoughTransformer.
+ */
+@interface ZCRBenchmarkCorpus : NSObject
+
+/**
+ *  The corpora measured by the benchmark suite, covering each dimension on its own.
+ */
++ (NSArray *)standardCorpora;
+
+/**
+ *  Designated initializer for this class.
+ *
+ *  @param name             A unique name for the corpus, used in benchmark results.
+ *  @param width            The number of fields per record, up to ZCRBenchmarkMaximumWidth.
+ *  @param depth            The number of dictionaries the fields are nested inside.
+ *  @param usesArrayIndexes Whether the fields are stored in an array and mapped by index, rather
+ *                          than stored in a dictionary and mapped by key.
+ *  @param transformedCount The number of fields which are transformed while baking.
+ *  @param recordCount      The number of distinct records to generate.
+ *
+ *  @return A new corpus.
+ */
+- (instancetype)initWithName:(NSString *)name width:(NSUInteger)width depth:(NSUInteger)depth
+            usesArrayIndexes:(BOOL)usesArrayIndexes transformedCount:(NSUInteger)transformedCount
+                 recordCount:(NSUInteger)recordCount;
+
+/**
+ *  Creates a corpus whose records each hold an array of child records from another corpus. Each
+ *  child is baked through a ZCREasyDoughTransformer into its own field of the parent model.
+ *
+ *  @param name        A unique name for the corpus, used in benchmark results.
+ *  @param childCorpus The corpus to generate children from. This must not be nil.
+ *  @param childCount  The number of children per record. This must be less than
+ *                     ZCRBenchmarkMaximumWidth, since the last field holds the record's title.
+ *  @param recordCount The number of distinct records to generate.
+ *
+ *  @return A new corpus.
+ */
+- (instancetype)initWithName:(NSString *)name childCorpus:(ZCRBenchmarkCorpus *)childCorpus
+                  childCount:(NSUInteger)childCount recordCount:(NSUInteger)recordCount __attribute__((nonnull (2)));
+
+@property (copy, nonatomic, readonly) NSString *name;
+
+/**
+ *  The recipe which bakes the records into ZCRBenchmarkModels.
+ */
+@property (strong, nonatomic, readonly) ZCREasyRecipe *recipe;
+
+/**
+ *  The raw ingredients of each record.
+ */
+@property (strong, nonatomic, readonly) NSArray *records;
+
+/**
+ *  The raw ingredients of each record with a single field changed, for measuring updates.
+ */
+@property (strong, nonatomic, readonly) NSArray *updatedRecords;
+
+/**
+ *  The records baked with the recipe, in the same order.
+ */
+@property (strong, nonatomic, readonly) NSArray *doughs;
+
+/**
+ *  For nested corpora, the transformer which bakes each child. Otherwise nil.
+ */
+@property (strong, nonatomic, readonly) ZCREasyDoughTransformer *childTransformer;
+
+@end
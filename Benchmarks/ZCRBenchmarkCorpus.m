@@ -0,0 +1,237 @@
+//
+//  ZCRBenchmarkCorpus.m
+//  ZCREasyBake
+//
+//  Created by Zachary Radke on 10/16/26.
+//  Copyright (c) 2026 Zach Radke. All rights reserved.
+//
+
+#import "ZCRBenchmarkCorpus.h"
+
+const NSUInteger ZCRBenchmarkMaximumWidth = 32;
+
+@implementation ZCRBenchmarkModel
+@end
+
+
+/**
+ *  Converts numeric strings into NSNumbers, which stands in for the parsing transformers typically
+ *  found in recipes.
+ */
+@interface ZCRBenchmarkNumberTransformer : NSValueTransformer
+@end
+
+@implementation ZCRBenchmarkNumberTransformer
+
++ (Class)transformedValueClass {
+    return [NSNumber class];
+}
+
++ (BOOL)allowsReverseTransformation {
+    return YES;
+}
+
+- (id)transformedValue:(id)value {
+    if (![value isKindOfClass:[NSString class]]) { return nil; }
+    return @([value longLongValue]);
+}
+
+- (id)reverseTransformedValue:(id)value {
+    if (![value isKindOfClass:[NSNumber class]]) { return nil; }
+    return [value stringValue];
+}
+
+@end
+
+
+#pragma mark - ZCRBenchmarkCorpus
+
+@implementation ZCRBenchmarkCorpus {
+    NSUInteger _width;
+    NSUInteger _depth;
+    BOOL _usesArrayIndexes;
+    NSUInteger _transformedCount;
+    
+    ZCRBenchmarkCorpus *_childCorpus;
+    NSUInteger _childCount;
+}
+
++ (NSArray *)standardCorpora {
+    ZCRBenchmarkCorpus *flat = [[self alloc] initWithName:@"flat-8" width:8 depth:0
+                                         usesArrayIndexes:NO transformedCount:0 recordCount:64];
+    
+    return @[flat,
+             [[self alloc] initWithName:@"flat-32" width:32 depth:0 usesArrayIndexes:NO transformedCount:0 recordCount:64],
+             [[self alloc] initWithName:@"deep-8" width:8 depth:4 usesArrayIndexes:NO transformedCount:0 recordCount:64],
+             [[self alloc] initWithName:@"indexed-8" width:8 depth:1 usesArrayIndexes:YES transformedCount:0 recordCount:64],
+             [[self alloc] initWithName:@"transformed-8" width:8 depth:0 usesArrayIndexes:NO transformedCount:8 recordCount:64],
+             [[self alloc] initWithName:@"nested-4x8" childCorpus:flat childCount:4 recordCount:64]];
+}
+
+- (instancetype)initWithName:(NSString *)name width:(NSUInteger)width depth:(NSUInteger)depth
+            usesArrayIndexes:(BOOL)usesArrayIndexes transformedCount:(NSUInteger)transformedCount
+                 recordCount:(NSUInteger)recordCount {
+    NSParameterAssert(name);
+    NSParameterAssert(width > 0 && width <= ZCRBenchmarkMaximumWidth);
+    NSParameterAssert(transformedCount <= width);
+    
+    if (!(self = [super init])) { return nil; }
+    
+    _name = [name copy];
+    _width = width;
+    _depth = depth;
+    _usesArrayIndexes = usesArrayIndexes;
+    _transformedCount = transformedCount;
+    
+    [self _prepareWithRecordCount:recordCount];
+    
+    return self;
+}
+
+- (instancetype)initWithName:(NSString *)name childCorpus:(ZCRBenchmarkCorpus *)childCorpus
+                  childCount:(NSUInteger)childCount recordCount:(NSUInteger)recordCount {
+    NSParameterAssert(name);
+    NSParameterAssert(childCorpus);
+    NSParameterAssert(childCount > 0 && childCount < ZCRBenchmarkMaximumWidth);
+    
+    if (!(self = [super init])) { return nil; }
+    
+    _name = [name copy];
+    _width = childCount + 1;
+    _childCorpus = childCorpus;
+    _childCount = childCount;
+    _childTransformer = [[ZCREasyDoughTransformer alloc] initWithDoughClass:[ZCRBenchmarkModel class]
+                                                                     recipe:childCorpus.recipe
+                                                            identifierBlock:nil];
+    
+    [self _prepareWithRecordCount:recordCount];
+    
+    return self;
+}
+
+- (instancetype)init {
+    [NSException raise:NSInternalInconsistencyException format:@"Please use the designated initializer for this class."];
+    return nil;
+}
+
+
+#pragma mark Private utilities
+
+- (void)_prepareWithRecordCount:(NSUInteger)recordCount {
+    NSError *error;
+    _recipe = [[ZCREasyRecipe alloc] initWithName:_name ingredientMapping:[self _ingredientMapping]
+                           ingredientTransformers:[self _ingredientTransformers] error:&error];
+    NSAssert(_recipe, @"The %@ corpus has an invalid recipe: %@", _name, error);
+    
+    NSMutableArray *records = [NSMutableArray arrayWithCapacity:recordCount];
+    NSMutableArray *updatedRecords = [NSMutableArray arrayWithCapacity:recordCount];
+    NSMutableArray *doughs = [NSMutableArray arrayWithCapacity:recordCount];
+    
+    for (NSUInteger index = 0; index < recordCount; index++) {
+        id record = [self _recordAtIndex:index revision:0];
+        [records addObject:record];
+        [updatedRecords addObject:[self _recordAtIndex:index revision:1]];
+    
+        id dough = [[ZCRBenchmarkModel alloc] initWithIdentifier:@(index) ingredients:record
+                                                          recipe:_recipe error:&error];
+        NSAssert(dough, @"The %@ corpus has an invalid record: %@", _name, error);
+        [doughs addObject:dough];
+    }
+    
+    _records = [records copy];
+    _updatedRecords = [updatedRecords copy];
+    _doughs = [doughs copy];
+}
+
+- (NSString *)_propertyNameForField:(NSUInteger)field {
+    return [NSString stringWithFormat:@"field%02lu", (unsigned long)field];
+}
+
+- (NSDictionary *)_ingredientMapping {
+    NSMutableDictionary *mapping = [NSMutableDictionary dictionaryWithCapacity:_width];
+    
+    if (_childCorpus) {
+        for (NSUInteger child = 0; child < _childCount; child++) {
+            mapping[[self _propertyNameForField:child]] = [NSString stringWithFormat:@"children[%lu]", (unsigned long)child];
+        }
+        mapping[[self _propertyNameForField:_childCount]] = @"title";
+        return mapping;
+    }
+    
+    NSMutableString *prefix = [NSMutableString string];
+    for (NSUInteger level = 0; level < _depth; level++) {
+        [prefix appendFormat:@"level%lu.", (unsigned long)level];
+    }
+    
+    for (NSUInteger field = 0; field < _width; field++) {
+        if (_usesArrayIndexes) {
+            mapping[[self _propertyNameForField:field]] = [NSString stringWithFormat:@"%@values[%lu]", prefix, (unsigned long)field];
+        } else {
+            mapping[[self _propertyNameForField:field]] = [NSString stringWithFormat:@"%@%@", prefix, [self _propertyNameForField:field]];
+        }
+    }
+    
+    return mapping;
+}
+
+- (NSDictionary *)_ingredientTransformers {
+    NSMutableDictionary *transformers = [NSMutableDictionary dictionary];
+    
+    if (_childCorpus) {
+        for (NSUInteger child = 0; child < _childCount; child++) {
+            transformers[[self _propertyNameForField:child]] = _childTransformer;
+        }
+        return transformers;
+    }
+    
+    ZCRBenchmarkNumberTransformer *numberTransformer = [[ZCRBenchmarkNumberTransformer alloc] init];
+    for (NSUInteger field = 0; field < _transformedCount; field++) {
+        transformers[[self _propertyNameForField:field]] = numberTransformer;
+    }
+    
+    return transformers;
+}
+
+- (id)_recordAtIndex:(NSUInteger)index revision:(NSUInteger)revision {
+    if (_childCorpus) {
+        NSMutableArray *children = [NSMutableArray arrayWithCapacity:_childCount];
+        for (NSUInteger child = 0; child < _childCount; child++) {
+            NSUInteger childIndex = index * _childCount + child;
+            [children addObject:[_childCorpus _recordAtIndex:childIndex revision:(child == 0) ? revision : 0]];
+        }
+        return @{@"title": [NSString stringWithFormat:@"Record %lu", (unsigned long)index],
+                 @"children": children};
+    }
+    
+    // Only the first field depends on the revision, so updates change exactly one property.
+    NSMutableArray *values = [NSMutableArray arrayWithCapacity:_width];
+    for (NSUInteger field = 0; field < _width; field++) {
+        NSUInteger seed = index * 1000 + field + ((field == 0) ? revision : 0);
+        if (field < _transformedCount) {
+            [values addObject:[NSString stringWithFormat:@"%lu", (unsigned long)seed]];
+        } else if (field % 2 == 0) {
+            [values addObject:[NSString stringWithFormat:@"value-%lu", (unsigned long)seed]];
+        } else {
+            [values addObject:@(seed)];
+        }
+    }
+    
+    id leaf;
+    if (_usesArrayIndexes) {
+        leaf = @{@"values": values};
+    } else {
+        NSMutableDictionary *fields = [NSMutableDictionary dictionaryWithCapacity:_width];
+        for (NSUInteger field = 0; field < _width; field++) {
+            fields[[self _propertyNameForField:field]] = values[field];
+        }
+        leaf = fields;
+    }
+    
+    for (NSUInteger level = _depth; level > 0; level--) {
+        leaf = @{[NSString stringWithFormat:@"level%lu", (unsigned long)(level - 1)]: leaf};
+    }
+    
+    return leaf;
+}
+
+@end
@@ -0,0 +1,270 @@
+//
+//  main.m
+//  ZCREasyBake
+//
+//  Created by Zachary Radke on 10/16/26.
+//  Copyright (c) 2026 Zach Radke. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+#import "ZCRBenchmark.h"
+#import "ZCRBenchmarkAllocations.h"
+#import "ZCRBenchmarkCorpus.h"
+
+#include <dispatch/dispatch.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static void ZCRBenchmarkPrintUsage(const char *executable) {
+    fprintf(stderr, "usage: %s [--output <path>] [--filter <substring>] [--min-time <seconds>]\n\n", executable);
+    fprintf(stderr, "Results are written as JSON lines to the output path, or to stdout if none is given.\n");
+}
+
+static void ZCRBenchmarkRunCorpus(ZCRBenchmarkRunner *runner, ZCRBenchmarkCorpus *corpus) {
+    ZCREasyRecipe *recipe = corpus.recipe;
+    NSArray *records = corpus.records;
+    NSArray *updatedRecords = corpus.updatedRecords;
+    NSArray *doughs = corpus.doughs;
+    NSUInteger count = [records count];
+    NSString *name = corpus.name;
+    
+    [runner measure:@"recipe.processIngredients" corpusName:name operation:^(NSUInteger iteration) {
+        [recipe processIngredients:records[iteration % count] error:NULL];
+    }];
+    
+    // Every property is interned through a private pool, so its savings can be reported on their own.
+    ZCREasyInternPool *internPool = [[ZCREasyInternPool alloc] init];
+    ZCREasyRecipe *internedRecipe = [recipe modifyWith:^(id<ZCREasyRecipeMaker> recipeMaker) {
+        recipeMaker.internedPropertyNames = recipe.propertyNames;
+        recipeMaker.internPool = internPool;
+    }];
+    ZCRBenchmarkResult *internedResult = [runner measure:@"recipe.processInterned" corpusName:name operation:^(NSUInteger iteration) {
+        [internedRecipe processIngredients:records[iteration % count] error:NULL];
+    }];
+    if (internedResult) {
+        fprintf(stderr, "%-16s interning saved %llu bytes over %lu hits\n", [name UTF8String],
+                internPool.savedByteCount, (unsigned long)internPool.hitCount);
+    }
+    
+    [runner measure:@"dough.init" corpusName:name operation:^(NSUInteger iteration) {
+        (void)[[ZCRBenchmarkModel alloc] initWithIdentifier:@(iteration % count)
+                                                ingredients:records[iteration % count]
+                                                     recipe:recipe error:NULL];
+    }];
+    
+    // Whole batches are baked per operation, so these compare the serial and parallel throughput.
+    [runner measure:@"dough.bakeAll" corpusName:name operation:^(NSUInteger iteration) {
+        [ZCRBenchmarkModel bakeAll:records identifierPath:nil recipe:recipe errors:NULL];
+    }];
+    
+    // A session shared by every batch reuses its containers and drains every 256 records instead
+    // of after each one.
+    ZCREasyIngestSession *session = [[ZCREasyIngestSession alloc] init];
+    [runner measure:@"dough.bakeAllSession" corpusName:name operation:^(NSUInteger iteration) {
+        [ZCRBenchmarkModel bakeAll:records identifierPath:nil recipe:recipe session:session errors:NULL];
+    }];
+    
+    // Every operation streams the whole corpus through a fresh pipeline, including starting and
+    // stopping its workers.
+    [runner measure:@"dough.pipeline" corpusName:name operation:^(NSUInteger iteration) {
+        ZCREasyPipeline *pipeline = [[ZCREasyPipeline alloc] initWithDoughClass:[ZCRBenchmarkModel class] recipe:recipe];
+        pipeline.session = session;
+        [pipeline startWithError:NULL];
+        for (id record in records) {
+            [pipeline submitInput:record];
+        }
+        [pipeline finishWithCompletion:nil];
+        [pipeline waitUntilFinished];
+    }];
+    
+    [runner measure:@"dough.bakeAllConcurrently" corpusName:name operation:^(NSUInteger iteration) {
+        [ZCRBenchmarkModel bakeAllConcurrently:records identifierPath:nil recipe:recipe errors:NULL];
+    }];
+    
+    [runner measure:@"dough.update" corpusName:name operation:^(NSUInteger iteration) {
+        [doughs[iteration % count] updateWithIngredients:updatedRecords[iteration % count]
+                                                  recipe:recipe error:NULL];
+    }];
+    
+    [runner measure:@"dough.isEqualToIngredients" corpusName:name operation:^(NSUInteger iteration) {
+        [doughs[iteration % count] isEqualToIngredients:records[iteration % count]
+                                             withRecipe:recipe error:NULL];
+    }];
+    
+    [runner measure:@"dough.decompose" corpusName:name operation:^(NSUInteger iteration) {
+        [doughs[iteration % count] decomposeWithRecipe:recipe error:NULL];
+    }];
+    
+    [runner measure:@"dough.copy" corpusName:name operation:^(NSUInteger iteration) {
+        (void)[doughs[iteration % count] copy];
+    }];
+    
+    ZCREasyDoughTransformer *childTransformer = corpus.childTransformer;
+    if (childTransformer) {
+        [runner measure:@"transformer.transformedValue" corpusName:name operation:^(NSUInteger iteration) {
+            [childTransformer transformedValue:records[iteration % count][@"children"][0]];
+        }];
+        
+        // The same children mapped through a single wildcard are baked as one batch per record,
+        // rather than transformed one index at a time.
+        ZCREasyRecipe *wildcardRecipe = [ZCREasyRecipe makeWith:^(id<ZCREasyRecipeMaker> recipeMaker) {
+            [recipeMaker addInstructionForProperty:@"field00" ingredientPath:@"children[*]"
+                                       transformer:childTransformer error:NULL];
+        }];
+        [runner measure:@"recipe.processWildcard" corpusName:name operation:^(NSUInteger iteration) {
+            [wildcardRecipe processIngredients:records[iteration % count] error:NULL];
+        }];
+    }
+}
+
+// Generated mappings share prefixes and mix keys with indexes, like the large recipes built from
+// API schemas at runtime.
+static NSDictionary *ZCRBenchmarkGeneratedMapping(NSUInteger mappingCount) {
+    NSMutableDictionary *mapping = [NSMutableDictionary dictionaryWithCapacity:mappingCount];
+    for (NSUInteger i = 0; i < mappingCount; i++) {
+        mapping[[NSString stringWithFormat:@"property%lu", (unsigned long)i]] =
+            [NSString stringWithFormat:@"group%lu.items[%lu].attributes.field%lu",
+             (unsigned long)(i % 16), (unsigned long)(i % 8), (unsigned long)i];
+    }
+    return [mapping copy];
+}
+
+static void ZCRBenchmarkRunRecipeConstruction(ZCRBenchmarkRunner *runner, NSUInteger mappingCount) {
+    NSDictionary *mapping = ZCRBenchmarkGeneratedMapping(mappingCount);
+    NSString *name = [NSString stringWithFormat:@"mapping-%lu", (unsigned long)mappingCount];
+    
+    [runner measure:@"recipe.init" corpusName:name operation:^(NSUInteger iteration) {
+        (void)[[ZCREasyRecipe alloc] initWithName:nil ingredientMapping:mapping
+                           ingredientTransformers:nil error:NULL];
+    }];
+    
+    [runner measure:@"recipe.makeWith" corpusName:name operation:^(NSUInteger iteration) {
+        [ZCREasyRecipe makeWith:^(id<ZCREasyRecipeMaker> recipeMaker) {
+            [mapping enumerateKeysAndObjectsUsingBlock:^(NSString *propertyName, NSString *ingredientPath, BOOL *stop) {
+                [recipeMaker addInstructionForProperty:propertyName ingredientPath:ingredientPath
+                                           transformer:nil error:NULL];
+            }];
+        }];
+    }];
+    
+    // A variant which adds a single instruction only rebuilds the one path's subtree.
+    ZCREasyRecipe *baseRecipe = [[ZCREasyRecipe alloc] initWithName:nil ingredientMapping:mapping
+                                             ingredientTransformers:nil error:NULL];
+    [runner measure:@"recipe.modifyWith" corpusName:name operation:^(NSUInteger iteration) {
+        [baseRecipe modifyWith:^(id<ZCREasyRecipeMaker> recipeMaker) {
+            [recipeMaker addInstructionForProperty:@"variant" ingredientPath:@"group0.variant"
+                                       transformer:nil error:NULL];
+        }];
+    }];
+    
+    [runner measure:@"recipe.hash" corpusName:name operation:^(NSUInteger iteration) {
+        (void)[baseRecipe hash];
+    }];
+}
+
+// Recipes are added to the box one at a time, the way apps register them lazily, so lookups run
+// against whatever the box published after its last single addition.
+static void ZCRBenchmarkRunRecipeBox(ZCRBenchmarkRunner *runner, NSUInteger recipeCount) {
+    ZCREasyRecipe *recipe = [[ZCREasyRecipe alloc] initWithName:nil
+                                              ingredientMapping:ZCRBenchmarkGeneratedMapping(10)
+                                         ingredientTransformers:nil error:NULL];
+    ZCREasyRecipeBox *box = [[ZCREasyRecipeBox alloc] init];
+    NSMutableArray *recipeNames = [NSMutableArray arrayWithCapacity:recipeCount];
+    for (NSUInteger i = 0; i < recipeCount; i++) {
+        NSString *recipeName = [NSString stringWithFormat:@"BenchmarkRecipe%lu", (unsigned long)i];
+        [box addRecipe:[recipe modifyWith:^(id<ZCREasyRecipeMaker> recipeMaker) {
+            recipeMaker.name = recipeName;
+        }] error:NULL];
+        [recipeNames addObject:recipeName];
+    }
+    NSString *name = [NSString stringWithFormat:@"box-%lu", (unsigned long)recipeCount];
+    
+    [runner measure:@"recipeBox.lookup" corpusName:name operation:^(NSUInteger iteration) {
+        (void)[box recipeWithName:recipeNames[iteration % recipeCount]];
+    }];
+    
+    // Each operation is a batch of 1024 lookups on each of 16 threads at once.
+    [runner measure:@"recipeBox.lookupContended" corpusName:name operation:^(NSUInteger iteration) {
+        dispatch_apply(16, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t thread) {
+            for (NSUInteger i = 0; i < 1024; i++) {
+                (void)[box recipeWithName:recipeNames[(iteration + thread + i) % recipeCount]];
+            }
+        });
+    }];
+}
+
+static void ZCRBenchmarkReport(ZCRBenchmarkRunner *runner, NSUInteger firstResultIndex, NSMutableString *output) {
+    NSArray *results = runner.results;
+    for (NSUInteger i = firstResultIndex; i < [results count]; i++) {
+        ZCRBenchmarkResult *result = results[i];
+        fprintf(stderr, "%-16s %-30s %12.1f ns/op %10.2f allocs/op\n",
+                [result.corpusName UTF8String], [result.name UTF8String],
+                result.nanosecondsPerOperation, result.allocationsPerOperation);
+        [output appendFormat:@"%@\n", [result JSONLine]];
+    }
+}
+
+int main(int argc, const char *argv[]) {
+    @autoreleasepool {
+        NSString *outputPath = nil;
+        NSString *filter = nil;
+        NSTimeInterval minimumDuration = 0.5;
+    
+        for (int i = 1; i < argc; i++) {
+            BOOL hasValue = (i + 1 < argc);
+            if (strcmp(argv[i], "--output") == 0 && hasValue) {
+                outputPath = [NSString stringWithUTF8String:argv[++i]];
+            } else if (strcmp(argv[i], "--filter") == 0 && hasValue) {
+                filter = [NSString stringWithUTF8String:argv[++i]];
+            } else if (strcmp(argv[i], "--min-time") == 0 && hasValue) {
+                minimumDuration = strtod(argv[++i], NULL);
+            } else {
+                ZCRBenchmarkPrintUsage(argv[0]);
+                return (strcmp(argv[i], "--help") == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+            }
+        }
+    
+        if (!ZCRBenchmarkCountsAllocations()) {
+            fprintf(stderr, "Allocations aren't counted on this platform and will be reported as null.\n");
+        }
+    
+        ZCRBenchmarkRunner *runner = [[ZCRBenchmarkRunner alloc] initWithMinimumDuration:minimumDuration
+                                                                                  filter:filter];
+        NSMutableString *output = [NSMutableString string];
+    
+        for (ZCRBenchmarkCorpus *corpus in [ZCRBenchmarkCorpus standardCorpora]) {
+            NSUInteger firstResultIndex = [runner.results count];
+            ZCRBenchmarkRunCorpus(runner, corpus);
+            ZCRBenchmarkReport(runner, firstResultIndex, output);
+        }
+    
+        // Recipe construction should grow linearly with the number of mappings.
+        for (NSNumber *mappingCount in @[@10, @100, @500, @2000]) {
+            NSUInteger firstResultIndex = [runner.results count];
+            ZCRBenchmarkRunRecipeConstruction(runner, [mappingCount unsignedIntegerValue]);
+            ZCRBenchmarkReport(runner, firstResultIndex, output);
+        }
+    
+        // Lookups shouldn't slow down as the box grows or as readers are added.
+        for (NSNumber *recipeCount in @[@64, @1024]) {
+            NSUInteger firstResultIndex = [runner.results count];
+            ZCRBenchmarkRunRecipeBox(runner, [recipeCount unsignedIntegerValue]);
+            ZCRBenchmarkReport(runner, firstResultIndex, output);
+        }
+    
+        if (outputPath) {
+            NSError *error;
+            if (![output writeToFile:outputPath atomically:YES encoding:NSUTF8StringEncoding error:&error]) {
+                fprintf(stderr, "Couldn't write results to %s: %s\n", [outputPath UTF8String],
+                        [[error localizedDescription] UTF8String]);
+                return EXIT_FAILURE;
+            }
+        } else {
+            fputs([output UTF8String], stdout);
+        }
+    }
+    
+    return EXIT_SUCCESS;
+}
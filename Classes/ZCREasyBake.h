@@ -16,5 +16,13 @@
     #import "ZCREasyRecipe.h"
     #import "ZCREasyDough.h"
     #import "ZCREasyDoughTransformer.h"
+    #import "ZCREasyDoughNotifier.h"
+    #import "ZCREasyTransformerCache.h"
+    #import "ZCREasyDoughSnapshot.h"
+    #import "ZCREasyInstrumentation.h"
+    #import "ZCREasyCoercion.h"
+    #import "ZCREasyInternPool.h"
+    #import "ZCREasyIngestSession.h"
+    #import "ZCREasyPipeline.h"
 
 #endif
\ No newline at end of file
@@ -0,0 +1,47 @@
+//
+//  ZCREasyCoercion.h
+//  ZCREasyBake
+//
+//  Created by Zachary Radke on 10/16/26.
+//  Copyright (c) 2026 Zach Radke. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+/**
+ *  Parses an ISO-8601 date without allocating any intermediate objects. The calendar date is
+ *  required, in either the extended (2014-04-21) or basic (20140421) format, and may be followed by
+ *  a "T" or a space and a time of hours and minutes, optionally with seconds and a decimal fraction
+ *  of a second. The time may end in "Z" or an offset of hours and optionally minutes, such as
+ *  "+05:30" or "-08". Times without a zone designator are treated as UTC.
+ *
+ *  @param string       The string to parse.
+ *  @param timeInterval On success, set to the parsed date as seconds since 1970.
+ *
+ *  @return YES if the whole string is a valid date, NO if it is not.
+ */
+FOUNDATION_EXPORT BOOL ZCREasyParseISO8601Date(NSString *string, NSTimeInterval *timeInterval);
+
+/**
+ *  Coerces a raw ingredient value into the type of a property, using the built-in conversions
+ *  enabled by +[ZCREasyDough coercesIngredients]:
+ *
+ *  - NSStrings become NSNumbers for scalar and NSNumber properties. BOOL properties also accept
+ *    "true", "false", "yes" and "no" in any case.
+ *  - NSNumbers become NSStrings for NSString properties.
+ *  - NSStrings become NSDecimalNumbers for NSDecimalNumber properties, as do other NSNumbers.
+ *  - ISO-8601 NSStrings become NSDates for NSDate properties, as do NSNumbers, which are taken as
+ *    seconds since 1970.
+ *  - NSStrings become NSURLs for NSURL properties.
+ *
+ *  Values which are already of the right type, nil and NSNull are returned as they are, as are
+ *  values for properties of any other type.
+ *
+ *  @param value      The value to coerce.
+ *  @param typeClass  The class of an object property, or Nil for scalar and id properties.
+ *  @param scalarType The type encoding character of a scalar property, such as 'q' or 'B', or 0 for
+ *                    object properties.
+ *
+ *  @return The coerced value, or nil if the value can't be converted to the property's type.
+ */
+FOUNDATION_EXPORT id ZCREasyCoerceValue(id value, Class typeClass, char scalarType);
@@ -0,0 +1,238 @@
+//
+//  ZCREasyCoercion.m
+//  ZCREasyBake
+//
+//  Created by Zachary Radke on 10/16/26.
+//  Copyright (c) 2026 Zach Radke. All rights reserved.
+//
+
+#import "ZCREasyCoercion.h"
+
+#import <errno.h>
+#import <math.h>
+#import <stdlib.h>
+#import <strings.h>
+
+// Long enough for any number or timestamp a payload would reasonably carry. Longer strings aren't
+// coerced, which keeps parsing on the stack.
+#define _ZCR_COERCION_BUFFER_LENGTH 64
+
+static BOOL _ZCRCopyASCII(NSString *string, char *buffer, size_t length, const char **end) {
+    if (![string getCString:buffer maxLength:length encoding:NSASCIIStringEncoding]) { return NO; }
+    
+    *end = buffer + strlen(buffer);
+    return YES;
+}
+
+
+#pragma mark - Numbers
+
+static NSNumber *_ZCRNumberFromString(NSString *string, char scalarType) {
+    char buffer[_ZCR_COERCION_BUFFER_LENGTH];
+    const char *end;
+    if (!_ZCRCopyASCII(string, buffer, sizeof(buffer), &end)) { return nil; }
+    
+    // BOOL is a signed char on some platforms, so both encodings accept the literals.
+    if (scalarType == 'B' || scalarType == 'c') {
+        if (!strcasecmp(buffer, "true") || !strcasecmp(buffer, "yes")) { return @YES; }
+        if (!strcasecmp(buffer, "false") || !strcasecmp(buffer, "no")) { return @NO; }
+    }
+    
+    // strto* would skip leading whitespace, and anything left over after the number is rejected
+    // below, so only strings which are entirely a number are coerced.
+    if (buffer == end || !(buffer[0] == '-' || buffer[0] == '+' || buffer[0] == '.' ||
+                           (buffer[0] >= '0' && buffer[0] <= '9'))) {
+        return nil;
+    }
+    
+    char *parsedEnd;
+    if (scalarType != 'f' && scalarType != 'd') {
+        // Unsigned 64 bit values may not fit in a long long.
+        BOOL isUnsigned = (scalarType == 'Q' || scalarType == 'L') && buffer[0] != '-';
+    
+        errno = 0;
+        if (isUnsigned) {
+            unsigned long long integer = strtoull(buffer, &parsedEnd, 10);
+            if (parsedEnd == end && errno == 0) { return @(integer); }
+        } else {
+            long long integer = strtoll(buffer, &parsedEnd, 10);
+            if (parsedEnd == end && errno == 0) { return @(integer); }
+        }
+    }
+    
+    errno = 0;
+    double floatingPoint = strtod(buffer, &parsedEnd);
+    if (parsedEnd != end || errno == ERANGE || !isfinite(floatingPoint)) { return nil; }
+    
+    return @(floatingPoint);
+}
+
+
+#pragma mark - Dates
+
+static BOOL _ZCRParseDigits(const char **cursor, const char *end, NSUInteger count, int *value) {
+    const char *digits = *cursor;
+    if ((NSUInteger)(end - digits) < count) { return NO; }
+    
+    int result = 0;
+    for (NSUInteger i = 0; i < count; i++) {
+        if (digits[i] < '0' || digits[i] > '9') { return NO; }
+        result = result * 10 + (digits[i] - '0');
+    }
+    
+    *cursor = digits + count;
+    *value = result;
+    return YES;
+}
+
+static BOOL _ZCRParseCharacter(const char **cursor, const char *end, char character) {
+    if (*cursor >= end || **cursor != character) { return NO; }
+    
+    (*cursor)++;
+    return YES;
+}
+
+static BOOL _ZCRIsDigitAt(const char *cursor, const char *end) {
+    return cursor < end && *cursor >= '0' && *cursor <= '9';
+}
+
+// The number of days from 1970-01-01 to a date in the proleptic Gregorian calendar.
+static int64_t _ZCRDaysFromCivil(int64_t year, int64_t month, int64_t day) {
+    year -= (month <= 2) ? 1 : 0;
+    int64_t era = ((year >= 0) ? year : year - 399) / 400;
+    int64_t yearOfEra = year - era * 400;
+    int64_t dayOfYear = (153 * (month + ((month > 2) ? -3 : 9)) + 2) / 5 + day - 1;
+    int64_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+}
+
+static int _ZCRDaysInMonth(int year, int month) {
+    static const int daysInMonth[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    BOOL isLeapYear = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+    return (month == 2 && isLeapYear) ? 29 : daysInMonth[month - 1];
+}
+
+BOOL ZCREasyParseISO8601Date(NSString *string, NSTimeInterval *timeInterval) {
+    if (![string isKindOfClass:[NSString class]]) { return NO; }
+    
+    char buffer[_ZCR_COERCION_BUFFER_LENGTH];
+    const char *end;
+    if (!_ZCRCopyASCII(string, buffer, sizeof(buffer), &end)) { return NO; }
+    
+    const char *cursor = buffer;
+    int year, month, day, hour = 0, minute = 0, second = 0;
+    double fraction = 0.0;
+    int offset = 0;
+    
+    // The date decides whether the rest of the string uses the extended or basic format.
+    if (!_ZCRParseDigits(&cursor, end, 4, &year)) { return NO; }
+    BOOL isExtended = _ZCRParseCharacter(&cursor, end, '-');
+    if (!_ZCRParseDigits(&cursor, end, 2, &month)) { return NO; }
+    if (isExtended && !_ZCRParseCharacter(&cursor, end, '-')) { return NO; }
+    if (!_ZCRParseDigits(&cursor, end, 2, &day)) { return NO; }
+    
+    if (cursor < end) {
+        if (*cursor != 'T' && *cursor != 't' && *cursor != ' ') { return NO; }
+        cursor++;
+    
+        if (!_ZCRParseDigits(&cursor, end, 2, &hour)) { return NO; }
+        if (isExtended && !_ZCRParseCharacter(&cursor, end, ':')) { return NO; }
+        if (!_ZCRParseDigits(&cursor, end, 2, &minute)) { return NO; }
+    
+        BOOL hasSeconds = (isExtended) ? _ZCRParseCharacter(&cursor, end, ':') : _ZCRIsDigitAt(cursor, end);
+        if (hasSeconds) {
+            if (!_ZCRParseDigits(&cursor, end, 2, &second)) { return NO; }
+    
+            if (_ZCRParseCharacter(&cursor, end, '.') || _ZCRParseCharacter(&cursor, end, ',')) {
+                if (!_ZCRIsDigitAt(cursor, end)) { return NO; }
+    
+                double scale = 0.1;
+                while (_ZCRIsDigitAt(cursor, end)) {
+                    fraction += (*cursor - '0') * scale;
+                    scale /= 10.0;
+                    cursor++;
+                }
+            }
+        }
+    
+        if (_ZCRParseCharacter(&cursor, end, 'Z') || _ZCRParseCharacter(&cursor, end, 'z')) {
+            // UTC, which is also the default.
+        } else if (cursor < end && (*cursor == '+' || *cursor == '-')) {
+            int sign = (*cursor == '-') ? -1 : 1;
+            cursor++;
+    
+            int offsetHours, offsetMinutes = 0;
+            if (!_ZCRParseDigits(&cursor, end, 2, &offsetHours)) { return NO; }
+            if (_ZCRParseCharacter(&cursor, end, ':') || _ZCRIsDigitAt(cursor, end)) {
+                if (!_ZCRParseDigits(&cursor, end, 2, &offsetMinutes)) { return NO; }
+            }
+            if (offsetHours > 23 || offsetMinutes > 59) { return NO; }
+    
+            offset = sign * (offsetHours * 3600 + offsetMinutes * 60);
+        }
+    }
+    
+    if (cursor != end) { return NO; }
+    
+    // 24:00 is midnight at the end of the day, and a 60th second allows for leap seconds.
+    if (month < 1 || month > 12 || day < 1 || day > _ZCRDaysInMonth(year, month)) { return NO; }
+    if (minute > 59 || second > 60) { return NO; }
+    if (hour > 24 || (hour == 24 && (minute > 0 || second > 0 || fraction > 0.0))) { return NO; }
+    
+    if (timeInterval) {
+        int64_t seconds = _ZCRDaysFromCivil(year, month, day) * 86400 + hour * 3600 + minute * 60 + second - offset;
+        *timeInterval = (NSTimeInterval)seconds + fraction;
+    }
+    return YES;
+}
+
+
+#pragma mark - Coercion
+
+id ZCREasyCoerceValue(id value, Class typeClass, char scalarType) {
+    if (!value || value == [NSNull null]) { return value; }
+    
+    BOOL isString = [value isKindOfClass:[NSString class]];
+    
+    // Anything else is left for the setter to accept or reject, as it would be without coercion.
+    if (scalarType) {
+        return (isString) ? _ZCRNumberFromString(value, scalarType) : value;
+    }
+    
+    if (!typeClass || [value isKindOfClass:typeClass]) { return value; }
+    
+    BOOL isNumber = [value isKindOfClass:[NSNumber class]];
+    
+    if (typeClass == [NSDecimalNumber class]) {
+        if (isNumber) {
+            return [NSDecimalNumber decimalNumberWithDecimal:[value decimalValue]];
+        }
+        if (!isString || ![_ZCRNumberFromString(value, 'd') isKindOfClass:[NSNumber class]]) { return nil; }
+    
+        return [NSDecimalNumber decimalNumberWithString:value
+                                                 locale:@{NSLocaleDecimalSeparator: @"."}];
+    }
+    
+    if (typeClass == [NSNumber class]) {
+        return (isString) ? _ZCRNumberFromString(value, 0) : nil;
+    }
+    
+    if (typeClass == [NSString class]) {
+        return (isNumber) ? [value stringValue] : nil;
+    }
+    
+    if (typeClass == [NSDate class]) {
+        if (isNumber) {
+            return [NSDate dateWithTimeIntervalSince1970:[value doubleValue]];
+        }
+    
+        NSTimeInterval timeInterval;
+        return (isString && ZCREasyParseISO8601Date(value, &timeInterval)) ? [NSDate dateWithTimeIntervalSince1970:timeInterval] : nil;
+    }
+    
+    if (typeClass == [NSURL class]) {
+        return (isString) ? [NSURL URLWithString:value] : nil;
+    }
+    
+    return value;
+}
@@ -30,8 +30,35 @@ FOUNDATION_EXPORT NSString *const ZCREasyDoughIdentifierKey;
  */
 FOUNDATION_EXPORT NSString *const ZCREasyDoughUpdatedDoughKey;
 
+/**
+ *  Key present in update notifications that points to an NSSet of the property names whose values
+ *  changed in the update.
+ */
+FOUNDATION_EXPORT NSString *const ZCREasyDoughChangedPropertyNamesKey;
+
+/**
+ *  Key in identityMapStatistics for the number of lookups which found a canonical instance.
+ */
+FOUNDATION_EXPORT NSString *const ZCREasyDoughIdentityMapHitsKey;
+
+/**
+ *  Key in identityMapStatistics for the number of lookups which found no canonical instance.
+ */
+FOUNDATION_EXPORT NSString *const ZCREasyDoughIdentityMapMissesKey;
+
+/**
+ *  Key in identityMapStatistics for the number of canonical instances replaced by updated ones.
+ */
+FOUNDATION_EXPORT NSString *const ZCREasyDoughIdentityMapUpdatesKey;
+
+/**
+ *  Key in identityMapStatistics for the number of canonical instances. Released instances are
+ *  pruned lazily, so they may be counted until the identity map next looks them up or grows.
+ */
+FOUNDATION_EXPORT NSString *const ZCREasyDoughIdentityMapCountKey;
+
 @protocol ZCREasyBaker;
-@class ZCREasyProperty, ZCREasyDoughTransformer;
+@class ZCREasyProperty, ZCREasyDoughTransformer, ZCREasyDoughNotifier, ZCREasyIngestSession;
 
 /**
  *  Semi-abstract and doughy class designed for immutable model subclassing.
@@ -102,6 +129,22 @@ FOUNDATION_EXPORT NSString *const ZCREasyDoughUpdatedDoughKey;
                        ingredients:(id)ingredients
                             recipe:(ZCREasyRecipe *)recipe error:(NSError **)error;
 
+/**
+ *  Bakes a new instance like the designated initializer, while mapping the ingredients into the
+ *  session's scratch containers rather than new ones. The record is counted by the session. Lazily
+ *  baked classes and subclasses which override the designated initializer are still initialized
+ *  through it.
+ *
+ *  @see initWithIdentifier:ingredients:recipe:error:, ZCREasyIngestSession
+ *
+ *  @param session An optional session to ingest the record through. If this is nil, this is the
+ *                 same as the designated initializer.
+ */
+- (instancetype)initWithIdentifier:(id<NSObject,NSCopying>)identifier
+                       ingredients:(id)ingredients
+                            recipe:(ZCREasyRecipe *)recipe
+                           session:(ZCREasyIngestSession *)session error:(NSError **)error;
+
 /**
  *  Convenience builder for generating fresh instances. This method takes a block and passes it an
  *  object conforming to the ZCREasyBaker protocol. Recipes, ingredients, and an identifier can be
@@ -120,6 +163,83 @@ FOUNDATION_EXPORT NSString *const ZCREasyDoughUpdatedDoughKey;
  */
 + (instancetype)makeWith:(void (^)(id<ZCREasyBaker> baker))constructionBlock __attribute__((nonnull));
 
+/**
+ *  Bakes an array of raw ingredients into instances in a single batch. The recipe and identifier
+ *  path are validated once for the whole batch, and scratch containers are reused between records,
+ *  which makes this considerably faster than repeatedly invoking the designated initializer for
+ *  large pages of records. A failure in one record does not stop the batch.
+ *
+ *  @see initWithIdentifier:ingredients:recipe:error:
+ *
+ *  @param ingredientsArray An array of raw ingredients, each a dictionary or array. This must not
+ *                          be nil.
+ *  @param identifierPath   An optional ingredient path, in the same format as the recipe's
+ *                          ingredient paths, which leads to each record's unique identifier. If
+ *                          this is nil, every instance will be assigned a new unique identifier.
+ *  @param recipe           The recipe to follow while populating the instances. This must not be
+ *                          nil.
+ *  @param errors           An optional pointer which will be populated with an NSDictionary mapping
+ *                          the NSNumber index of each failed record to its NSError. If there were
+ *                          no failures the dictionary will be empty.
+ *
+ *  @return An array of new instances in the same order as the input, with NSNull in place of
+ *          records which failed to bake, or nil if the recipe or identifier path are invalid. In
+ *          that case every index will be mapped to the same error.
+ */
++ (NSArray *)bakeAll:(NSArray *)ingredientsArray
+      identifierPath:(NSString *)identifierPath
+              recipe:(ZCREasyRecipe *)recipe
+              errors:(NSDictionary **)errors __attribute__((nonnull (1)));
+
+/**
+ *  Bakes an array of raw ingredients like bakeAll:identifierPath:recipe:errors:, through a session.
+ *  The session's scratch containers and identifier recipes are reused, and autorelease pools are
+ *  drained every drainInterval records rather than after every record.
+ *
+ *  @see bakeAll:identifierPath:recipe:errors:, ZCREasyIngestSession
+ *
+ *  @param session An optional session to ingest the records through.
+ */
++ (NSArray *)bakeAll:(NSArray *)ingredientsArray
+      identifierPath:(NSString *)identifierPath
+              recipe:(ZCREasyRecipe *)recipe
+             session:(ZCREasyIngestSession *)session
+              errors:(NSDictionary **)errors __attribute__((nonnull (1)));
+
+/**
+ *  Bakes an array of raw ingredients like bakeAll:identifierPath:recipe:errors:, but splits the
+ *  batch into chunks which are baked in parallel across the available cores. Idle workers pick up
+ *  the remaining chunks, so records which take uneven amounts of time still keep every core busy.
+ *  The results and errors are the same as baking serially, and are in the same order as the input.
+ *
+ *  Because records are baked on several threads at once, the recipe's ingredient transformers and
+ *  any overridden setters or initializers must be thread-safe. ZCREasyDoughTransformer and the
+ *  built-in memoization are. Small batches are simply baked on the calling thread.
+ *
+ *  @see bakeAll:identifierPath:recipe:errors:
+ *
+ *  @return An array of new instances in the same order as the input, with NSNull in place of
+ *          records which failed to bake, or nil if the recipe or identifier path are invalid.
+ */
++ (NSArray *)bakeAllConcurrently:(NSArray *)ingredientsArray
+                  identifierPath:(NSString *)identifierPath
+                          recipe:(ZCREasyRecipe *)recipe
+                          errors:(NSDictionary **)errors __attribute__((nonnull (1)));
+
+/**
+ *  Bakes an array of raw ingredients concurrently, through a session. Each worker borrows its own
+ *  scratch containers from the session and drains its autorelease pool every drainInterval records.
+ *
+ *  @see bakeAllConcurrently:identifierPath:recipe:errors:, ZCREasyIngestSession
+ *
+ *  @param session An optional session to ingest the records through.
+ */
++ (NSArray *)bakeAllConcurrently:(NSArray *)ingredientsArray
+                  identifierPath:(NSString *)identifierPath
+                          recipe:(ZCREasyRecipe *)recipe
+                         session:(ZCREasyIngestSession *)session
+                          errors:(NSDictionary **)errors __attribute__((nonnull (1)));
+
 /**
  *  Returns a copy of the unique identifier used to initialize the instance.
  */
@@ -130,13 +250,15 @@ FOUNDATION_EXPORT NSString *const ZCREasyDoughUpdatedDoughKey;
  */
 
 /**
- *  Attempts to update an instance with the passed ingredients and recipe. This method will check
- *  to see if the ingredients are already represented by this instance using the
- *  isEqualToIngredients:withRecipe:error: method. If the ingredients are not equal, a new instance
- *  will be generated using the designated initializer, passing the current instance's identifier,
- *  and notfications will be posted to the updateNotificationName and
- *  ZCREasyDoughUpdateNotification. If the ingredients *are* equal, this method will simply return
- *  self and no notfications will be posted.
+ *  Attempts to update an instance with the passed ingredients and recipe. The ingredients are
+ *  mapped once and compared with the current values, following the same rules as
+ *  isEqualToIngredients:withRecipe:error:. If any values differ, a copy of this instance with the
+ *  same identifier is made, only the differing properties are set on it, and notfications will be
+ *  posted to the updateNotificationName and ZCREasyDoughUpdateNotification through the class's
+ *  updateNotifier, which may deliver them asynchronously. The notification's
+ *  user info includes the changed property names under ZCREasyDoughChangedPropertyNamesKey. If the
+ *  ingredients *are* equal, this method will simply return self and no notfications will be
+ *  posted.
  *
  *  @param ingredients The ingredients to update this instance with. The ingredients must be either
  *                     a dictionary or array and must not be nil.
@@ -151,6 +273,21 @@ FOUNDATION_EXPORT NSString *const ZCREasyDoughUpdatedDoughKey;
                                recipe:(ZCREasyRecipe *)recipe
                                 error:(NSError **)error;
 
+/**
+ *  Updates an instance like updateWithIngredients:recipe:error:, while mapping the ingredients and
+ *  collecting the changes in the session's scratch containers rather than new ones. The record is
+ *  counted by the session.
+ *
+ *  @see updateWithIngredients:recipe:error:, ZCREasyIngestSession
+ *
+ *  @param session An optional session to ingest the record through. If this is nil, this is the
+ *                 same as updateWithIngredients:recipe:error:.
+ */
+- (instancetype)updateWithIngredients:(id)ingredients
+                               recipe:(ZCREasyRecipe *)recipe
+                              session:(ZCREasyIngestSession *)session
+                                error:(NSError **)error;
+
 /**
  *  Convenience method for building an updated instance. This method takes a block and passes an
  *  object conforming to the ZCREasyBaker protocol. A recipe and ingredients should be set on this
@@ -179,6 +316,154 @@ FOUNDATION_EXPORT NSString *const ZCREasyDoughUpdatedDoughKey;
  */
 + (NSString *)updateNotificationName;
 
+/**
+ *  Returns the notifier which delivers this class's update notifications. Subclasses can override
+ *  this to deliver asynchronously, coalesce repeated updates, or batch bulk refreshes. The default
+ *  implementation returns [ZCREasyDoughNotifier defaultNotifier].
+ *
+ *  @see ZCREasyDoughNotifier
+ *
+ *  @return The notifier for this class.
+ */
++ (ZCREasyDoughNotifier *)updateNotifier;
+
+
+/**
+ *  @name Canonical instances
+ */
+
+/**
+ *  Subclasses can override this method to opt into an identity map, which keeps at most one
+ *  canonical instance alive per unique identifier. Instances are held weakly, so the map never
+ *  extends their lifetime. The default implementation returns NO.
+ *
+ *  @see canonicalDoughWithIdentifier:ingredients:recipe:error:
+ *
+ *  @return YES if the class keeps canonical instances, NO if it does not.
+ */
++ (BOOL)usesIdentityMap;
+
+/**
+ *  Bakes an instance through the class's identity map. If a canonical instance already exists for
+ *  the identifier and represents the ingredients, it is returned as is. If it exists but differs,
+ *  it is updated through updateWithIngredients:recipe:error: and the updated instance atomically
+ *  replaces it as the canonical instance. Otherwise a new instance is baked and registered. Once a
+ *  canonical instance is updated with updateWithIngredients:recipe:error:, its replacement becomes
+ *  canonical as well. If usesIdentityMap returns NO, this simply invokes the designated
+ *  initializer.
+ *
+ *  @param identifier  The unique identifier of the instance. This must not be nil.
+ *  @param ingredients The ingredients to populate the instance with.
+ *  @param recipe      The recipe to follow while populating the instance.
+ *  @param error       An optional pointer to an error which may be populated if baking fails.
+ *
+ *  @return The canonical instance for the identifier, or nil if an error occurs.
+ */
++ (instancetype)canonicalDoughWithIdentifier:(id<NSObject,NSCopying>)identifier
+                                 ingredients:(id)ingredients
+                                      recipe:(ZCREasyRecipe *)recipe
+                                       error:(NSError **)error;
+
+/**
+ *  Finds the live canonical instance for the given identifier without baking anything.
+ *
+ *  @param identifier The unique identifier to look up.
+ *
+ *  @return The canonical instance, or nil if none is alive or the class does not use an identity
+ *          map.
+ */
++ (instancetype)canonicalDoughWithIdentifier:(id<NSObject,NSCopying>)identifier;
+
+/**
+ *  A snapshot of the identity map's lookup statistics, keyed by ZCREasyDoughIdentityMapHitsKey,
+ *  ZCREasyDoughIdentityMapMissesKey, ZCREasyDoughIdentityMapUpdatesKey and
+ *  ZCREasyDoughIdentityMapCountKey. Each value is an NSNumber.
+ *
+ *  @return The statistics, or nil if the class does not use an identity map.
+ */
++ (NSDictionary *)identityMapStatistics;
+
+/**
+ *  Forgets every canonical instance and resets the identity map statistics.
+ */
++ (void)resetIdentityMap;
+
+
+/**
+ *  @name Slot storage
+ */
+
+/**
+ *  Subclasses can override this method to store their @dynamic properties in a compact slot buffer
+ *  instead of individual iVars. Getters for these properties are installed automatically. Copies
+ *  share the buffer until either instance is written to, at which point the writer takes its own
+ *  copy, so copying and updating large models is cheap. Only object and simple scalar properties
+ *  are supported, and objects are always held strongly (or copied for copy properties), so weak
+ *  properties should not be declared @dynamic. The default implementation returns NO.
+ *
+ *  @return YES if @dynamic properties are kept in slot storage, NO if they are not.
+ */
++ (BOOL)usesSlotStorage;
+
+/**
+ *  Subclasses which use slot storage can override this method to defer baking their @dynamic
+ *  properties until they are first read. Baking then keeps a copy of the raw ingredients, and each
+ *  property is mapped and transformed by its getter the first time it is invoked, which is cheap
+ *  when only a few properties of a large payload are ever read. Properties which aren't stored in
+ *  slots are still baked immediately, and copying a dough resolves all of its properties first.
+ *
+ *  Because errors can't be reported from a getter, a property whose ingredient is missing, has an
+ *  unexpected type, or fails to transform is left unset (nil or zero) instead of failing the bake.
+ *  Resolution is thread-safe. This has no effect unless usesSlotStorage returns YES. The default
+ *  implementation returns NO.
+ *
+ *  @return YES if @dynamic properties are resolved on first access, NO if they are baked eagerly.
+ */
++ (BOOL)usesLazyBaking;
+
+
+/**
+ *  @name Type coercion
+ */
+
+/**
+ *  Subclasses can override this method to coerce mapped ingredients into the types of their
+ *  properties, replacing the transformers which would otherwise be needed for common conversions.
+ *  Strings become numbers for scalar and NSNumber properties, numbers become strings for NSString
+ *  properties, and ISO-8601 strings or timestamps become dates for NSDate properties. The full
+ *  list of conversions is documented with ZCREasyCoerceValue().
+ *
+ *  Coercion uses the type metadata of each property, and only applies to properties without an
+ *  ingredient transformer in the recipe, so transformers are still invoked wherever they are
+ *  configured. Values which can't be coerced into a known type are handled by the recipe's
+ *  mismatchPolicy, and values are stored by the same setters which bake uncoerced values. The
+ *  default implementation returns NO.
+ *
+ *  @return YES if mapped ingredients are coerced into their property types, NO if they are not.
+ */
++ (BOOL)coercesIngredients;
+
+
+/**
+ *  @name Instrumentation
+ */
+
+/**
+ *  Returns the measurements this class has recorded while ZCREasyInstrumentation was enabled. The
+ *  snapshot may include ZCREasyInstrumentationMappingEvent for processing ingredients while baking
+ *  or updating, ZCREasyInstrumentationSettingEvent for setting the mapped values,
+ *  ZCREasyInstrumentationCopyingEvent for copies, and ZCREasyInstrumentationNotifyingEvent for
+ *  posting update notifications. Measurements are kept per class, so subclasses have their own.
+ *  Transformations are recorded by the recipe, see [ZCREasyRecipe instrumentationSnapshot].
+ *
+ *  @return An NSDictionary of ZCREasyInstrumentationStatistics keyed by event name.
+ */
++ (NSDictionary *)instrumentationSnapshot;
+
+/**
+ *  Discards the measurements this class has recorded.
+ */
++ (void)resetInstrumentation;
 
 /**
  *  @name Recipe utilities
@@ -205,6 +490,22 @@ FOUNDATION_EXPORT NSString *const ZCREasyDoughUpdatedDoughKey;
  */
 - (id)decomposeWithRecipe:(ZCREasyRecipe *)recipe error:(NSError **)error;
 
+/**
+ *  Decomposes an instance straight into UTF-8 encoded JSON data, without building the intermediate
+ *  dictionaries and arrays. The output represents the same ingredients as decomposeWithRecipe:error:
+ *  would, though key order and number formatting may differ from NSJSONSerialization.
+ *
+ *  @see decomposeWithRecipe:error:
+ *
+ *  @param recipe The recipe to follow for decomposing this instance.
+ *  @param error  An optional error pointer which may be populated during the course of decomposing
+ *                the instance, including if a value cannot be represented as JSON.
+ *
+ *  @return JSON data representing the current model using the given recipe, or nil if an error
+ *          occurs.
+ */
+- (NSData *)decomposeToJSONDataWithRecipe:(ZCREasyRecipe *)recipe error:(NSError **)error;
+
 /**
  *  Checks if the ingredients and recipe passed are represented by the current instance. Only keys
  *  present in the recipe's [ZCREasyRecipe ingredientMapping] will be checked. The ingredient values
@@ -259,6 +560,16 @@ FOUNDATION_EXPORT NSString *const ZCREasyDoughUpdatedDoughKey;
  */
 + (void)enumeratePropertiesWith:(void (^)(ZCREasyProperty *property, BOOL *shouldStop))block __attribute__((nonnull));
 
+/**
+ *  Builds the introspected metadata of the given classes on a background queue. Metadata is
+ *  otherwise built on the first bake of each class, so prewarming at launch takes that cost off
+ *  the main thread. Building is thread-safe, and a class which is baked while being prewarmed
+ *  simply waits for its metadata rather than building it twice.
+ *
+ *  @param classes An array of ZCREasyDough subclasses. Other classes are ignored.
+ */
++ (void)prewarmClasses:(NSArray *)classes;
+
 /**
  *  Generates a new, reversible value transformer for this class. The value transformer should be
  *  given raw ingredients and will generate baked models. In reverse, the transformer will take
@@ -11,6 +11,12 @@
 #import "ZCREasyError.h"
 #import "ZCREasyProperty.h"
 #import "ZCREasyDoughTransformer.h"
+#import "ZCREasyDoughNotifier.h"
+#import "ZCREasyInstrumentation.h"
+#import "ZCREasyCoercion.h"
+#import "ZCREasyIngestSession.h"
+
+#import <pthread.h>
 
 NSString *const ZCREasyDoughExceptionAlreadyBaked = @"com.zachradke.easyBake.easyDough.exception.alreadyBaked";
 
@@ -20,14 +26,128 @@ NSString *const ZCREasyDoughIdentifierKey = @"ZCREasyDoughIdentifierKey";
 
 NSString *const ZCREasyDoughUpdatedDoughKey = @"ZCREasyDoughUpdatedDoughKey";
 
+NSString *const ZCREasyDoughChangedPropertyNamesKey = @"ZCREasyDoughChangedPropertyNamesKey";
+
+NSString *const ZCREasyDoughIdentityMapHitsKey = @"ZCREasyDoughIdentityMapHitsKey";
+
+NSString *const ZCREasyDoughIdentityMapMissesKey = @"ZCREasyDoughIdentityMapMissesKey";
+
+NSString *const ZCREasyDoughIdentityMapUpdatesKey = @"ZCREasyDoughIdentityMapUpdatesKey";
+
+NSString *const ZCREasyDoughIdentityMapCountKey = @"ZCREasyDoughIdentityMapCountKey";
+
+@interface ZCREasyRecipe (ZCREasyPrivate)
+- (BOOL)_processIngredients:(id)ingredients into:(NSMutableDictionary *)processedIngredients
+                      error:(NSError **)error;
+- (id)_processIngredients:(id)ingredients forProperty:(NSString *)propertyName found:(BOOL *)found;
+- (id)_ingredientsWithValueProvider:(id (^)(NSString *propertyName))valueProvider;
+- (NSData *)_JSONDataWithValueProvider:(id (^)(NSString *propertyName))valueProvider
+                                 error:(NSError **)error;
+@end
+
+@interface ZCREasyIngestSession (ZCREasyPrivate)
+- (NSMutableDictionary *)_dequeueScratchDictionary;
+- (void)_enqueueScratchDictionary:(NSMutableDictionary *)dictionary;
+- (ZCREasyRecipe *)_identifierRecipeForPath:(NSString *)identifierPath;
+- (void)_setIdentifierRecipe:(ZCREasyRecipe *)recipe forPath:(NSString *)identifierPath;
+- (void)_didIngestRecords:(NSUInteger)count;
+- (void)_didIngestRecord;
+- (void)_willDrainPool;
+@end
+
 @interface _ZCREasyBaker : NSObject <ZCREasyBaker>
 - (instancetype)initWithClass:(Class)doughClass;
 - (id)bake;
 @end
 
+/**
+ *  A thread-safe table of weakly held canonical doughs keyed by their unique identifiers. The table
+ *  is split into independently locked stripes so concurrent lookups rarely contend.
+ */
+@interface _ZCREasyIdentityMap : NSObject
+- (id)lookupDoughForIdentifier:(id)identifier;
+- (id)swapDough:(id)dough forIdentifier:(id)identifier expecting:(id)expectedDough;
+- (void)removeAllDoughs;
+- (NSDictionary *)statistics;
+@end
+
+/**
+ *  The slot layout for a dough class using slot storage. Object and scalar properties are assigned
+ *  indexes into separate slot arrays.
+ */
+@interface _ZCREasySlotLayout : NSObject
+- (instancetype)initWithProperties:(NSSet *)properties;
+@property (assign, nonatomic, readonly) NSUInteger objectCount;
+@property (assign, nonatomic, readonly) NSUInteger scalarCount;
+@property (strong, nonatomic, readonly) NSSet *propertyNames;
+- (ZCREasyProperty *)propertyForName:(NSString *)propertyName;
+- (ZCREasyProperty *)propertyForGetter:(SEL)getter;
+- (NSUInteger)slotForPropertyName:(NSString *)propertyName;
+@end
+
+/**
+ *  A compact, copy-on-write buffer of property values. Once a buffer is shared between instances it
+ *  is never written again, and writers take an unshared clone instead.
+ */
+@interface _ZCREasySlotStorage : NSObject
+- (instancetype)initWithLayout:(_ZCREasySlotLayout *)layout;
+@property (assign, nonatomic, getter=isShared) BOOL shared;
+- (_ZCREasySlotStorage *)unsharedStorage;
+- (id)objectAtSlot:(NSUInteger)slot;
+- (void)setObject:(id)object atSlot:(NSUInteger)slot;
+- (void *)scalarAtSlot:(NSUInteger)slot;
+@end
+
+/**
+ *  The introspected metadata of a dough class, built in a single pass over its properties.
+ */
+@interface _ZCREasyClassMetadata : NSObject
+- (instancetype)initWithDoughClass:(Class)doughClass;
+@property (strong, nonatomic, readonly) NSSet *properties;
+@property (strong, nonatomic, readonly) NSSet *propertyNames;
+@property (strong, nonatomic, readonly) NSSet *settablePropertyNames;
+@property (strong, nonatomic, readonly) NSSet *settableReadonlyPropertyNames;
+@property (strong, nonatomic, readonly) _ZCREasySlotLayout *slotLayout;
+@property (strong, nonatomic, readonly) ZCREasyInstrumentationRecorder *instrumentation;
+@end
+
+/**
+ *  The raw ingredients and recipe retained by a lazily baked dough, along with a flag for each slot
+ *  recording whether its property has been resolved yet.
+ */
+@interface _ZCREasyLazyIngredients : NSObject
+- (instancetype)initWithIngredients:(id)ingredients recipe:(ZCREasyRecipe *)recipe
+                             layout:(_ZCREasySlotLayout *)layout;
+@property (strong, nonatomic, readonly) id ingredients;
+@property (strong, nonatomic, readonly) ZCREasyRecipe *recipe;
+- (BOOL)isResolvedAtIndex:(NSUInteger)index;
+- (void)markResolvedAtIndex:(NSUInteger)index;
+@end
+
+@interface ZCREasyDough ()
++ (_ZCREasyClassMetadata *)_metadata;
++ (_ZCREasySlotLayout *)_slotLayout;
+- (_ZCREasySlotStorage *)_unsharedSlotStorage;
+@end
+
+/**
+ *  A pre-resolved way of setting a single property on a dough class. Setters are resolved once per
+ *  class into either a setter IMP or a raw iVar offset, so baking can skip key-value coding.
+ */
+@interface _ZCREasySetter : NSObject
+- (instancetype)initWithProperty:(ZCREasyProperty *)property doughClass:(Class)doughClass;
+- (BOOL)acceptsValue:(id)value;
+- (id)coercedValue:(id)value;
+- (void)setValue:(id)value onDough:(ZCREasyDough *)dough;
+- (void)copyValueFromDough:(ZCREasyDough *)sourceDough toDough:(ZCREasyDough *)dough;
+@end
+
 #pragma mark - ZCREasyDough
 
-@implementation ZCREasyDough
+@implementation ZCREasyDough {
+    _ZCREasySlotStorage *_slotStorage;
+    _ZCREasyLazyIngredients *_lazyIngredients;
+}
 
 - (instancetype)initWithIdentifier:(id<NSObject,NSCopying>)identifier
                        ingredients:(id)ingredients
@@ -40,10 +160,46 @@ NSString *const ZCREasyDoughUpdatedDoughKey = @"ZCREasyDoughUpdatedDoughKey";
         return nil;
     }
     
+    if (ingredients && [[self class] usesLazyBaking] && [[self class] _slotLayout]) {
+        return [self _initWithIdentifier:identifier lazyIngredients:ingredients recipe:recipe error:error];
+    }
+    
     NSDictionary *mappedIngredients = [[self class] _mappedIngredients:ingredients
                                                             withRecipe:recipe
                                                                  error:error];
     if (!mappedIngredients) { return nil; }
+    
+    return [self _initWithIdentifier:identifier mappedIngredients:mappedIngredients error:error];
+}
+
+- (instancetype)initWithIdentifier:(id<NSObject,NSCopying>)identifier
+                       ingredients:(id)ingredients
+                            recipe:(ZCREasyRecipe *)recipe
+                           session:(ZCREasyIngestSession *)session
+                             error:(NSError *__autoreleasing *)error {
+    // Lazy doughs keep their raw ingredients rather than mapping them, and subclasses which override
+    // the designated initializer are still routed through it.
+    if (!session || !identifier || !ingredients || [[self class] _usesDesignatedInitializer]) {
+        self = [self initWithIdentifier:identifier ingredients:ingredients recipe:recipe error:error];
+        [session _didIngestRecord];
+        return self;
+    }
+    
+    NSMutableDictionary *mappedIngredients = [session _dequeueScratchDictionary];
+    if ([[self class] _mapIngredients:ingredients withRecipe:recipe into:mappedIngredients error:error]) {
+        self = [self _initWithIdentifier:identifier mappedIngredients:mappedIngredients error:error];
+    } else {
+        self = nil;
+    }
+    [session _enqueueScratchDictionary:mappedIngredients];
+    [session _didIngestRecord];
+    
+    return self;
+}
+
+- (instancetype)_initWithIdentifier:(id<NSObject,NSCopying>)identifier
+                  mappedIngredients:(NSDictionary *)mappedIngredients
+                              error:(NSError *__autoreleasing *)error {
     if (!(self = [super init])) { return nil; }
     
     _uniqueIdentifier = [(id)identifier copy];
@@ -55,6 +211,44 @@ NSString *const ZCREasyDoughUpdatedDoughKey = @"ZCREasyDoughUpdatedDoughKey";
     return self;
 }
 
+- (instancetype)_initWithIdentifier:(id<NSObject,NSCopying>)identifier
+                    lazyIngredients:(id)ingredients
+                             recipe:(ZCREasyRecipe *)recipe
+                              error:(NSError *__autoreleasing *)error {
+    if (![[self class] _validateRecipe:recipe error:error]) { return nil; }
+    
+    if (![ingredients isKindOfClass:[NSDictionary class]] && ![ingredients isKindOfClass:[NSArray class]]) {
+        if (error) {
+            *error = ZCREasyBakeParameterError(@"Ingredients (%@) must be a dictionary or an array!", ingredients);
+        }
+        return nil;
+    }
+    
+    // Properties outside slot storage have no getter to defer them behind, so they are baked now.
+    ZCREasyRecipe *eagerRecipe = [[self class] _eagerRecipeForLazyRecipe:recipe];
+    NSDictionary *mappedIngredients = [NSDictionary dictionary];
+    if (eagerRecipe) {
+        mappedIngredients = [eagerRecipe processIngredients:ingredients error:error];
+        if (!mappedIngredients) { return nil; }
+    }
+    
+    if (!(self = [self _initWithIdentifier:identifier mappedIngredients:mappedIngredients error:error])) {
+        return nil;
+    }
+    
+    // The storage is created up front so that resolving a property never replaces it while another
+    // thread is reading from it.
+    _ZCREasySlotLayout *slotLayout = [[self class] _slotLayout];
+    [self _unsharedSlotStorage];
+    if ([recipe.propertyNames intersectsSet:slotLayout.propertyNames]) {
+        _lazyIngredients = [[_ZCREasyLazyIngredients alloc] initWithIngredients:[ingredients copy]
+                                                                          recipe:recipe
+                                                                          layout:slotLayout];
+    }
+    
+    return self;
+}
+
 - (instancetype)init {
     // Because an identifier is necessary for initializing an instance, we create one manually
     // rather than leaving a useless init method.
@@ -70,6 +264,43 @@ NSString *const ZCREasyDoughUpdatedDoughKey = @"ZCREasyDoughUpdatedDoughKey";
     return [chef bake];
 }
 
++ (NSArray *)bakeAll:(NSArray *)ingredientsArray
+      identifierPath:(NSString *)identifierPath
+              recipe:(ZCREasyRecipe *)recipe
+              errors:(NSDictionary *__autoreleasing *)errors {
+    return [self bakeAll:ingredientsArray identifierPath:identifierPath recipe:recipe session:nil errors:errors];
+}
+
++ (NSArray *)bakeAll:(NSArray *)ingredientsArray
+      identifierPath:(NSString *)identifierPath
+              recipe:(ZCREasyRecipe *)recipe
+             session:(ZCREasyIngestSession *)session
+              errors:(NSDictionary *__autoreleasing *)errors {
+    NSParameterAssert(ingredientsArray);
+    
+    return [self _bakeAll:ingredientsArray identifierPath:identifierPath recipe:recipe
+             concurrently:NO session:session errors:errors];
+}
+
++ (NSArray *)bakeAllConcurrently:(NSArray *)ingredientsArray
+                  identifierPath:(NSString *)identifierPath
+                          recipe:(ZCREasyRecipe *)recipe
+                          errors:(NSDictionary *__autoreleasing *)errors {
+    return [self bakeAllConcurrently:ingredientsArray identifierPath:identifierPath recipe:recipe
+                             session:nil errors:errors];
+}
+
++ (NSArray *)bakeAllConcurrently:(NSArray *)ingredientsArray
+                  identifierPath:(NSString *)identifierPath
+                          recipe:(ZCREasyRecipe *)recipe
+                         session:(ZCREasyIngestSession *)session
+                          errors:(NSDictionary *__autoreleasing *)errors {
+    NSParameterAssert(ingredientsArray);
+    
+    return [self _bakeAll:ingredientsArray identifierPath:identifierPath recipe:recipe
+             concurrently:YES session:session errors:errors];
+}
+
 - (id)uniqueIdentifier {
     return [(id)_uniqueIdentifier copy];
 }
@@ -77,45 +308,82 @@ NSString *const ZCREasyDoughUpdatedDoughKey = @"ZCREasyDoughUpdatedDoughKey";
 - (instancetype)updateWithIngredients:(id)ingredients
                                recipe:(ZCREasyRecipe *)recipe
                                 error:(NSError *__autoreleasing *)error {
-    // We need to manually pass an error pointer to establish if there was an error while finding
-    // equality rather than relying on the passed error pointer which may not exist.
-    NSError *isEqualError = nil;
-    BOOL isEqual = [self isEqualToIngredients:ingredients withRecipe:recipe error:&isEqualError];
+    return [self updateWithIngredients:ingredients recipe:recipe session:nil error:error];
+}
+
+- (instancetype)updateWithIngredients:(id)ingredients
+                               recipe:(ZCREasyRecipe *)recipe
+                              session:(ZCREasyIngestSession *)session
+                                error:(NSError *__autoreleasing *)error {
+    // Like isEqualToIngredients:withRecipe:error:, both a recipe and ingredients are required.
+    if (!recipe || !ingredients) {
+        if (error) {
+            *error = ZCREasyBakeParameterError(@"Missing recipe and/or ingredients!");
+        }
+        return nil;
+    }
+    
+    NSMutableDictionary *mappedIngredients = (session) ? [session _dequeueScratchDictionary] :
+                                             [NSMutableDictionary dictionaryWithCapacity:[recipe.propertyNames count]];
+    NSMutableDictionary *changedIngredients = (session) ? [session _dequeueScratchDictionary] : nil;
+    
+    id updatedDough = [self _updateWithIngredients:ingredients recipe:recipe mappedIngredients:mappedIngredients
+                                changedIngredients:changedIngredients error:error];
+    
+    [session _enqueueScratchDictionary:mappedIngredients];
+    [session _enqueueScratchDictionary:changedIngredients];
+    [session _didIngestRecord];
     
-    if (isEqualError) {
-        if (error) { *error = isEqualError; }
+    return updatedDough;
+}
+
+- (instancetype)_updateWithIngredients:(id)ingredients recipe:(ZCREasyRecipe *)recipe
+                     mappedIngredients:(NSMutableDictionary *)mappedIngredients
+                    changedIngredients:(NSMutableDictionary *)changedIngredients
+                                 error:(NSError *__autoreleasing *)error {
+    // The ingredients are mapped once, and the same mapping is used both to find the changed
+    // properties and to populate the updated instance.
+    if (![[self class] _mapIngredients:ingredients withRecipe:recipe into:mappedIngredients error:error]) {
         return nil;
     }
     
-    if (isEqual) {
+    NSSet *changedPropertyNames = [self _changedPropertyNamesForMappedIngredients:mappedIngredients
+                                                                      stopAtFirst:NO
+                                                                            error:error];
+    if (!changedPropertyNames) { return nil; }
+    
+    if (changedPropertyNames.count == 0) {
         // If the ingredients are already represented by this instance, we simply return self.
         return self;
     } else {
-        // We use the passed recipe to determine the remapped keys to populate...
-        NSDictionary *mappedIngredients = [[self class] _mappedIngredients:ingredients
-                                                                withRecipe:recipe
-                                                                     error:error];
-        if (!mappedIngredients) { return nil; }
+        if (!changedIngredients) {
+            changedIngredients = [NSMutableDictionary dictionaryWithCapacity:changedPropertyNames.count];
+        }
+        for (NSString *propertyName in changedPropertyNames) {
+            changedIngredients[propertyName] = mappedIngredients[propertyName];
+        }
         
-        id updatedDough = [self copy];
+        // Only the unchanged properties are carried over, since the changed ones are set next.
+        id updatedDough = [self _copyExcludingPropertyNames:changedPropertyNames error:error];
         
-        if (![updatedDough _setMappedIngredients:mappedIngredients error:error]) {
+        if (!updatedDough || ![updatedDough _setMappedIngredients:changedIngredients error:error]) {
             return nil;
         }
         
-        // Since we don't rely on pointers to determine equality, we pass the identifier and updated
-        // model in the user-info to identify the model.
-        NSDictionary *userInfo = @{ZCREasyDoughIdentifierKey: [(id)_uniqueIdentifier copy],
-                                   ZCREasyDoughUpdatedDoughKey: updatedDough};
+        // If this instance is canonical, its replacement becomes canonical too.
+        if ([[self class] usesIdentityMap]) {
+            [[[self class] _identityMap] swapDough:updatedDough forIdentifier:_uniqueIdentifier
+                                         expecting:self];
+        }
+        
+        ZCREasyInstrumentationRecorder *instrumentation = (ZCREasyInstrumentationIsEnabled()) ? [[self class] _metadata].instrumentation : nil;
+        uint64_t startTime = (instrumentation) ? ZCREasyInstrumentationBegin(instrumentation, ZCREasyInstrumentationNotifyingEvent) : 0;
         
-        [[NSNotificationCenter defaultCenter] postNotificationName:ZCREasyDoughUpdateNotification
-                                                            object:self userInfo:userInfo];
+        [[[self class] updateNotifier] postUpdateOfDough:self updatedDough:updatedDough
+                                    changedPropertyNames:changedPropertyNames];
         
-        NSString *classUpdateNotification = [[self class] updateNotificationName];
-        if (classUpdateNotification &&
-            ![classUpdateNotification isEqualToString:ZCREasyDoughUpdateNotification]) {
-            [[NSNotificationCenter defaultCenter] postNotificationName:classUpdateNotification
-                                                                object:self userInfo:userInfo];
+        if (instrumentation) {
+            ZCREasyInstrumentationEnd(instrumentation, ZCREasyInstrumentationNotifyingEvent, startTime);
         }
         
         return updatedDough;
@@ -131,6 +399,103 @@ NSString *const ZCREasyDoughUpdatedDoughKey = @"ZCREasyDoughUpdatedDoughKey";
     return [self updateWithIngredients:chef.ingredients recipe:chef.recipe error:NULL];
 }
 
++ (BOOL)usesIdentityMap {
+    return NO;
+}
+
++ (BOOL)usesSlotStorage {
+    return NO;
+}
+
++ (BOOL)usesLazyBaking {
+    return NO;
+}
+
++ (BOOL)coercesIngredients {
+    return NO;
+}
+
++ (instancetype)canonicalDoughWithIdentifier:(id<NSObject,NSCopying>)identifier
+                                 ingredients:(id)ingredients
+                                      recipe:(ZCREasyRecipe *)recipe
+                                       error:(NSError *__autoreleasing *)error {
+    if (![self usesIdentityMap]) {
+        return [[self alloc] initWithIdentifier:identifier ingredients:ingredients recipe:recipe
+                                          error:error];
+    }
+    
+    if (!identifier) {
+        if (error) {
+            *error = ZCREasyBakeParameterError(@"Missing a unique identifier!");
+        }
+        return nil;
+    }
+    
+    _ZCREasyIdentityMap *identityMap = [self _identityMap];
+    id existingDough = [identityMap lookupDoughForIdentifier:identifier];
+    
+    // The expensive baking happens outside the map's locks, so if another thread swaps in a dough
+    // first we simply try again against the winner.
+    while (YES) {
+        id candidateDough = nil;
+        if (existingDough) {
+            candidateDough = [existingDough updateWithIngredients:ingredients recipe:recipe
+                                                            error:error];
+            if (!candidateDough || candidateDough == existingDough) { return candidateDough; }
+        } else {
+            candidateDough = [[self alloc] initWithIdentifier:identifier ingredients:ingredients
+                                                       recipe:recipe error:error];
+            if (!candidateDough) { return nil; }
+        }
+        
+        id currentDough = [identityMap swapDough:candidateDough forIdentifier:identifier
+                                       expecting:existingDough];
+        if (currentDough == candidateDough) { return candidateDough; }
+        
+        existingDough = currentDough;
+    }
+}
+
++ (instancetype)canonicalDoughWithIdentifier:(id<NSObject,NSCopying>)identifier {
+    if (!identifier || ![self usesIdentityMap]) { return nil; }
+    return [[self _identityMap] lookupDoughForIdentifier:identifier];
+}
+
++ (NSDictionary *)instrumentationSnapshot {
+    return [[self _metadata].instrumentation snapshot];
+}
+
++ (void)resetInstrumentation {
+    [[self _metadata].instrumentation reset];
+}
+
++ (NSDictionary *)identityMapStatistics {
+    if (![self usesIdentityMap]) { return nil; }
+    return [[self _identityMap] statistics];
+}
+
++ (void)resetIdentityMap {
+    if (![self usesIdentityMap]) { return; }
+    [[self _identityMap] removeAllDoughs];
+}
+
++ (_ZCREasyIdentityMap *)_identityMap {
+    _ZCREasyIdentityMap *identityMap = objc_getAssociatedObject(self, _cmd);
+    if (identityMap) { return identityMap; }
+    
+    // Unlike the introspection caches, two maps for the same class would split the canonical
+    // instances, so creation is serialized.
+    @synchronized(self) {
+        identityMap = objc_getAssociatedObject(self, _cmd);
+        if (!identityMap) {
+            identityMap = [[_ZCREasyIdentityMap alloc] init];
+            objc_setAssociatedObject(self, _cmd, identityMap, OBJC_ASSOCIATION_RETAIN);
+        }
+    }
+    
+    return identityMap;
+}
+
 + (NSString *)updateNotificationName {
     if (self == [ZCREasyDough class]) {
         return ZCREasyDoughUpdateNotification;
@@ -139,37 +504,22 @@ NSString *const ZCREasyDoughUpdatedDoughKey = @"ZCREasyDoughUpdatedDoughKey";
     }
 }
 
++ (ZCREasyDoughNotifier *)updateNotifier {
+    return [ZCREasyDoughNotifier defaultNotifier];
+}
+
 - (id)decomposeWithRecipe:(ZCREasyRecipe *)recipe
                     error:(NSError *__autoreleasing *)error {
     if (![[self class] _validateRecipe:recipe error:error]) {
         return nil;
     }
     
-    // We need to determine what object should be the root, either a dictionary or array.
-    id ingredients;
-    NSArray *testComponents = [[recipe.ingredientMappingComponents allValues] firstObject];
-    if ([[testComponents firstObject] isKindOfClass:[NSString class]]) {
-        ingredients = [NSMutableDictionary dictionary];
-    } else {
-        ingredients = [NSMutableArray array];
-    }
-    
+    // The recipe's compiled ingredient tree already knows the shape of the result, so each
+    // container is built once with its final contents.
     @try {
-        id value;
-        for (NSString *propertyName in recipe.propertyNames) {
-            value = [self valueForKey:propertyName];
-            
-            NSValueTransformer *transformer = recipe.ingredientTransformers[propertyName];
-            
-            // Only reversible transformations are used during decomposition
-            if (transformer && [[transformer class] allowsReverseTransformation]) {
-                value = [transformer reverseTransformedValue:value];
-            }
-            if (!value) { value = [NSNull null]; }
-            
-            NSArray *components = recipe.ingredientMappingComponents[propertyName];
-            [self _setValue:value forComponents:components mutableIngredients:ingredients];
-        }
+        return [recipe _ingredientsWithValueProvider:^id(NSString *propertyName) {
+            return [self valueForKey:propertyName];
+        }];
     }
     @catch (NSException *exception) {
         if (error) {
@@ -177,65 +527,25 @@ NSString *const ZCREasyDoughUpdatedDoughKey = @"ZCREasyDoughUpdatedDoughKey";
         }
         return nil;
     }
-    
-    return [ingredients copy];
 }
 
-- (void)_setValue:(id)value forComponents:(NSArray *)ingredientComponents
-mutableIngredients:(id)mutableIngredients {
-    NSParameterAssert(value);
-    NSParameterAssert(mutableIngredients);
+- (NSData *)decomposeToJSONDataWithRecipe:(ZCREasyRecipe *)recipe
+                                    error:(NSError *__autoreleasing *)error {
+    if (![[self class] _validateRecipe:recipe error:error]) {
+        return nil;
+    }
     
-    // Convenience block for filling in an arbitrary location in the ingredient tree
-    void (^fillLocation)(id, id, id) = ^(id location, id fillPiece, id fillValue) {
-        if ([fillPiece isKindOfClass:[NSString class]]) {
-            [location setObject:fillValue forKey:fillPiece];
-        } else {
-            NSUInteger valueIndex = [fillPiece unsignedIntegerValue];
-            for (NSUInteger i = [location count]; i < valueIndex; i++) {
-                [location setObject:[NSNull null] atIndex:i];
-            }
-            [location setObject:fillValue atIndex:valueIndex];
-        }
-    };
-    
-    id currentLocation = mutableIngredients; // Pointer to the current container in the tree.
-    id newLocation; // The next possible container in the tree
-    id placeholderPiece = nil; // Container for a piece that must be resolved by the next piece
-    for (id piece in ingredientComponents) {
-        BOOL isDictionaryPiece = [piece isKindOfClass:[NSString class]];
-        if (placeholderPiece) {
-            // If there is an unresolved piece, we need to create the next location based on the
-            // current piece
-            newLocation = (isDictionaryPiece) ? [NSMutableDictionary dictionary] :
-                                                [NSMutableArray array];
-            fillLocation(currentLocation, placeholderPiece, newLocation);
-            currentLocation = newLocation;
-            placeholderPiece = piece;
-        } else {
-            // If there is no unresolved piece, we check if the next location exists, and if not
-            // we defer resolution till the next piece.
-            newLocation = nil;
-            if (isDictionaryPiece) {
-                newLocation = [currentLocation objectForKey:piece];
-            } else {
-                NSUInteger pieceIndex = [piece unsignedIntegerValue];
-                if ([currentLocation count] > pieceIndex) {
-                    newLocation = [currentLocation objectAtIndex:pieceIndex];
-                }
-            }
-            
-            if (newLocation && newLocation != [NSNull null]) {
-                currentLocation = newLocation;
-            } else {
-                placeholderPiece = piece;
-            }
+    @try {
+        return [recipe _JSONDataWithValueProvider:^id(NSString *propertyName) {
+            return [self valueForKey:propertyName];
+        } error:error];
+    }
+    @catch (NSException *exception) {
+        if (error) {
+            *error = ZCREasyBakeExceptionError(exception);
         }
+        return nil;
     }
-    
-    // At the very end we need to set the actual value in the last location
-    id lastPiece = [ingredientComponents lastObject];
-    fillLocation(currentLocation, lastPiece, value);
 }
 
 - (BOOL)isEqualToIngredients:(id)ingredients
@@ -255,28 +565,10 @@ mutableIngredients:(id)mutableIngredients {
                                                                  error:error];
     if (!mappedIngredients) { return NO; }
     
-    __block BOOL isEqual = YES;
-    
-    @try {
-        __block id currentValue = nil;
-        [mappedIngredients enumerateKeysAndObjectsUsingBlock:^(NSString *propertyName, id ingredientValue, BOOL *stop) {
-            currentValue = [self valueForKey:propertyName];
-            
-            // Ingredient NSNull values are remapped to nil
-            if (ingredientValue == (id)[NSNull null]) { ingredientValue = nil; }
-            
-            isEqual = (!currentValue && !ingredientValue) || [currentValue isEqual:ingredientValue];
-            if (!isEqual) { *stop = YES; }
-        }];
-    }
-    @catch (NSException *exception) {
-        if (error) {
-            *error = ZCREasyBakeExceptionError(exception);
-        }
-        return NO;
-    }
-    
-    return isEqual;
+    NSSet *changedPropertyNames = [self _changedPropertyNamesForMappedIngredients:mappedIngredients
+                                                                      stopAtFirst:YES
+                                                                            error:error];
+    return (changedPropertyNames && changedPropertyNames.count == 0);
 }
 
 + (ZCREasyRecipe *)genericRecipe {
@@ -313,6 +605,186 @@ mutableIngredients:(id)mutableIngredients {
 
 #pragma mark Private utilities
 
+// Batches are only split into chunks of at least this many records, since smaller chunks cost more
+// to schedule than they save.
+#define _ZCR_MINIMUM_CHUNK_SIZE 16
+
++ (NSArray *)_bakeAll:(NSArray *)ingredientsArray identifierPath:(NSString *)identifierPath
+               recipe:(ZCREasyRecipe *)recipe concurrently:(BOOL)concurrently
+              session:(ZCREasyIngestSession *)session errors:(NSDictionary *__autoreleasing *)errors {
+    NSUInteger count = [ingredientsArray count];
+    NSMutableDictionary *mutableErrors = [NSMutableDictionary dictionary];
+    
+    // The recipe and identifier path are validated once for the whole batch rather than per record,
+    // and a session keeps the identifier recipe for its later batches.
+    NSError *batchError = nil;
+    ZCREasyRecipe *identifierRecipe = nil;
+    if ([self _validateRecipe:recipe error:&batchError] && identifierPath) {
+        identifierRecipe = [session _identifierRecipeForPath:identifierPath];
+        if (!identifierRecipe) {
+            identifierRecipe = [[ZCREasyRecipe alloc] initWithName:nil
+                                                 ingredientMapping:@{ZCREasyDoughIdentifierKey: identifierPath}
+                                            ingredientTransformers:nil error:&batchError];
+            if (identifierRecipe) {
+                [session _setIdentifierRecipe:identifierRecipe forPath:identifierPath];
+            }
+        }
+    }
+    
+    if (batchError) {
+        for (NSUInteger i = 0; i < count; i++) {
+            mutableErrors[@(i)] = batchError;
+        }
+        if (errors) { *errors = [mutableErrors copy]; }
+        return nil;
+    }
+    
+    if (count == 0) {
+        if (errors) { *errors = [NSDictionary dictionary]; }
+        return [NSArray array];
+    }
+    
+    // Every record has its own result and error slot, so workers never write to shared containers
+    // and the results come out in input order however the work is scheduled.
+    __strong id *doughs = (__strong id *)calloc(count, sizeof(id));
+    __strong NSError **doughErrors = (__strong NSError **)calloc(count, sizeof(NSError *));
+    
+    // Resolving the class metadata and setters publishes them under a lock, so it's done up front
+    // rather than by every worker racing to do it at once.
+    [self _setters];
+    
+    NSUInteger chunkCount = 1;
+    if (concurrently) {
+        // Several chunks per core lets idle workers pick up the remaining chunks when records take
+        // uneven amounts of time, while keeping each chunk large enough to amortize its scratch
+        // containers.
+        NSUInteger processorCount = MAX([[NSProcessInfo processInfo] activeProcessorCount], (NSUInteger)1);
+        chunkCount = MIN(processorCount * 4, (count + _ZCR_MINIMUM_CHUNK_SIZE - 1) / _ZCR_MINIMUM_CHUNK_SIZE);
+    }
+    
+    if (chunkCount <= 1) {
+        [self _bakeIngredientsArray:ingredientsArray range:NSMakeRange(0, count) identifierRecipe:identifierRecipe
+                             recipe:recipe session:session doughs:doughs errors:doughErrors];
+    } else {
+        NSUInteger chunkSize = (count + chunkCount - 1) / chunkCount;
+        dispatch_apply(chunkCount, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t chunk) {
+            NSUInteger location = (NSUInteger)chunk * chunkSize;
+            if (location >= count) { return; }
+            
+            NSRange range = NSMakeRange(location, MIN(chunkSize, count - location));
+            [self _bakeIngredientsArray:ingredientsArray range:range identifierRecipe:identifierRecipe
+                                 recipe:recipe session:session doughs:doughs errors:doughErrors];
+        });
+    }
+    
+    for (NSUInteger i = 0; i < count; i++) {
+        if (!doughs[i]) {
+            doughs[i] = [NSNull null];
+            mutableErrors[@(i)] = doughErrors[i];
+        }
+        doughErrors[i] = nil;
+    }
+    
+    NSArray *bakedDoughs = [NSArray arrayWithObjects:doughs count:count];
+    
+    for (NSUInteger i = 0; i < count; i++) {
+        doughs[i] = nil;
+    }
+    free(doughs);
+    free(doughErrors);
+    
+    if (errors) {
+        *errors = [mutableErrors copy];
+    }
+    
+    return bakedDoughs;
+}
+
++ (void)_bakeIngredientsArray:(NSArray *)ingredientsArray range:(NSRange)range
+             identifierRecipe:(ZCREasyRecipe *)identifierRecipe recipe:(ZCREasyRecipe *)recipe
+                      session:(ZCREasyIngestSession *)session
+                       doughs:(__strong id *)doughs errors:(__strong NSError **)errors {
+    BOOL usesDesignatedInitializer = [self _usesDesignatedInitializer];
+    
+    NSMutableDictionary *scratchIngredients = (session) ? [session _dequeueScratchDictionary] :
+                                              [NSMutableDictionary dictionaryWithCapacity:[recipe.propertyNames count]];
+    NSMutableDictionary *scratchIdentifier = (session) ? [session _dequeueScratchDictionary] :
+                                             [NSMutableDictionary dictionaryWithCapacity:1];
+    
+    // Without a session every record gets its own pool, and with one the pool is drained every
+    // drainInterval records.
+    NSUInteger drainInterval = (session) ? session.drainInterval : 1;
+    for (NSUInteger poolStart = range.location; poolStart < NSMaxRange(range); poolStart += drainInterval) {
+        @autoreleasepool {
+            NSUInteger poolEnd = MIN(poolStart + drainInterval, NSMaxRange(range));
+            for (NSUInteger index = poolStart; index < poolEnd; index++) {
+                id ingredients = ingredientsArray[index];
+                NSError *error = nil;
+                id dough = nil;
+                id identifier = nil;
+                
+                if (identifierRecipe) {
+                    [scratchIdentifier removeAllObjects];
+                    if ([identifierRecipe _processIngredients:ingredients into:scratchIdentifier error:&error]) {
+                        identifier = scratchIdentifier[ZCREasyDoughIdentifierKey];
+                        if (identifier == [NSNull null]) { identifier = nil; }
+                        if (!identifier) {
+                            error = ZCREasyBakeParameterError(@"Missing a unique identifier at path (%@)!",
+                                                              identifierRecipe.ingredientMapping[ZCREasyDoughIdentifierKey]);
+                        }
+                    }
+                } else {
+                    identifier = [NSUUID UUID];
+                }
+                
+                if (identifier) {
+                    if (usesDesignatedInitializer) {
+                        dough = [[self alloc] initWithIdentifier:identifier ingredients:ingredients
+                                                          recipe:recipe error:&error];
+                    } else {
+                        [scratchIngredients removeAllObjects];
+                        
+                        ZCREasyInstrumentationRecorder *instrumentation = (ZCREasyInstrumentationIsEnabled()) ? [self _metadata].instrumentation : nil;
+                        uint64_t startTime = (instrumentation) ? ZCREasyInstrumentationBegin(instrumentation, ZCREasyInstrumentationMappingEvent) : 0;
+                        BOOL didMap = [recipe _processIngredients:ingredients into:scratchIngredients error:&error] &&
+                                      [self _checkMappedIngredients:scratchIngredients recipe:recipe error:&error];
+                        if (instrumentation) {
+                            ZCREasyInstrumentationEnd(instrumentation, ZCREasyInstrumentationMappingEvent, startTime);
+                        }
+                        
+                        if (didMap) {
+                            dough = [[self alloc] _initWithIdentifier:identifier
+                                                    mappedIngredients:scratchIngredients
+                                                                error:&error];
+                        }
+                    }
+                }
+                
+                doughs[index] = dough;
+                if (!dough) {
+                    errors[index] = error ?: ZCREasyBakeParameterError(@"Could not bake ingredients at index (%lu).", (unsigned long)index);
+                }
+            }
+            
+            if (session) {
+                [session _didIngestRecords:poolEnd - poolStart];
+                [session _willDrainPool];
+            }
+        }
+    }
+    
+    [session _enqueueScratchDictionary:scratchIngredients];
+    [session _enqueueScratchDictionary:scratchIdentifier];
+}
+
+// Subclasses which override the designated initializer, and lazy doughs which keep their raw
+// ingredients, have to be baked through it rather than from mapped ingredients.
++ (BOOL)_usesDesignatedInitializer {
+    SEL initSelector = @selector(initWithIdentifier:ingredients:recipe:error:);
+    return ([self usesLazyBaking] ||
+            [self instanceMethodForSelector:initSelector] != [ZCREasyDough instanceMethodForSelector:initSelector]);
+}
+
 + (BOOL)_validateRecipe:(ZCREasyRecipe *)recipe error:(NSError *__autoreleasing *)error {
     if (!recipe) {
         if (error) {
@@ -340,35 +812,156 @@ mutableIngredients:(id)mutableIngredients {
     // empty dictionary.
     if (!ingredients && !recipe) { return [NSDictionary dictionary]; }
     
-    if ([self _validateRecipe:recipe error:error]) {
-        return [recipe processIngredients:ingredients error:error];
-    } else {
-        return nil;
+    NSMutableDictionary *mappedIngredients = [NSMutableDictionary dictionaryWithCapacity:[recipe.propertyNames count]];
+    
+    return ([self _mapIngredients:ingredients withRecipe:recipe into:mappedIngredients error:error]) ? mappedIngredients : nil;
+}
+
++ (BOOL)_mapIngredients:(id)ingredients withRecipe:(ZCREasyRecipe *)recipe
+                   into:(NSMutableDictionary *)mappedIngredients error:(NSError *__autoreleasing *)error {
+    if (!ingredients && !recipe) { return YES; }
+    
+    if (![self _validateRecipe:recipe error:error]) { return NO; }
+    
+    ZCREasyInstrumentationRecorder *instrumentation = (ZCREasyInstrumentationIsEnabled()) ? [self _metadata].instrumentation : nil;
+    uint64_t startTime = (instrumentation) ? ZCREasyInstrumentationBegin(instrumentation, ZCREasyInstrumentationMappingEvent) : 0;
+    BOOL didMap = [recipe _processIngredients:ingredients into:mappedIngredients error:error] &&
+                  [self _checkMappedIngredients:mappedIngredients recipe:recipe error:error];
+    if (instrumentation) {
+        ZCREasyInstrumentationEnd(instrumentation, ZCREasyInstrumentationMappingEvent, startTime);
     }
+    
+    return didMap;
 }
 
-- (BOOL)_setMappedIngredients:(NSDictionary *)mappedIngredients
-                        error:(NSError *__autoreleasing *)error {
++ (BOOL)_checkMappedIngredients:(NSMutableDictionary *)mappedIngredients recipe:(ZCREasyRecipe *)recipe
+                          error:(NSError *__autoreleasing *)error {
     NSParameterAssert(mappedIngredients);
     
-    BOOL didAllowSettingReadonlyIVars = _allowsSettingReadonlyIVars;
-    _allowsSettingReadonlyIVars = YES;
+    // Values which can't be stored in their property, such as nil for a scalar, are caught here
+    // rather than by the exception key-value coding would raise while setting them.
+    NSDictionary *setters = [self _setters];
+    NSMutableDictionary *mismatches;
     
-    @try {
-        [mappedIngredients enumerateKeysAndObjectsUsingBlock:^(id key, id obj, BOOL *stop) {
-            // NSNull ingredient values are remapped to nil for setting
-            if (obj == [NSNull null]) { obj = nil; }
-            [self setValue:obj forKey:key];
-        }];
+    // Coerced values replace the mapped ones, so the keys are copied rather than enumerated live.
+    BOOL coerces = [self coercesIngredients];
+    NSDictionary *transformers = recipe.ingredientTransformers;
+    id<NSFastEnumeration> propertyNames = (coerces) ? [mappedIngredients allKeys] : mappedIngredients;
+    for (NSString *propertyName in propertyNames) {
+        id value = mappedIngredients[propertyName];
+        if (value == [NSNull null]) { value = nil; }
+        
+        _ZCREasySetter *setter = setters[propertyName];
+        if (!setter) { continue; }
+        
+        BOOL isCoercible = YES;
+        if (coerces && value && !transformers[propertyName]) {
+            value = [setter coercedValue:value];
+            isCoercible = (value != nil);
+            if (isCoercible) {
+                mappedIngredients[propertyName] = value;
+            }
+        }
+        
+        if (!isCoercible || ![setter acceptsValue:value]) {
+            if (!mismatches) {
+                mismatches = [NSMutableDictionary dictionary];
+            }
+            mismatches[propertyName] = recipe.ingredientMapping[propertyName];
+        }
     }
-    @catch (NSException *exception) {
+    
+    if (!mismatches) { return YES; }
+    
+    if (recipe.mismatchPolicy == ZCREasyRecipeMismatchPolicyFailFast) {
         if (error) {
-            *error = ZCREasyBakeExceptionError(exception);
+            *error = ZCREasyBakeMismatchError(mismatches);
         }
         return NO;
     }
-    @finally {
+    
+    // A scalar can't hold null, so it is left unset by both of the other policies, as is any
+    // property when skipping. Objects which couldn't be coerced are nulled under NullField.
+    for (NSString *propertyName in mismatches) {
+        BOOL nullsField = recipe.mismatchPolicy == ZCREasyRecipeMismatchPolicyNullField && [setters[propertyName] acceptsValue:nil];
+        if (nullsField) {
+            mappedIngredients[propertyName] = [NSNull null];
+        } else {
+            [mappedIngredients removeObjectForKey:propertyName];
+        }
+    }
+    return YES;
+}
+
+- (NSSet *)_changedPropertyNamesForMappedIngredients:(NSDictionary *)mappedIngredients
+                                         stopAtFirst:(BOOL)stopAtFirst
+                                               error:(NSError *__autoreleasing *)error {
+    NSParameterAssert(mappedIngredients);
+    
+    NSMutableSet *changedPropertyNames = [NSMutableSet set];
+    
+    @try {
+        __block id currentValue = nil;
+        [mappedIngredients enumerateKeysAndObjectsUsingBlock:^(NSString *propertyName, id ingredientValue, BOOL *stop) {
+            currentValue = [self valueForKey:propertyName];
+            
+            // Ingredient NSNull values are remapped to nil
+            if (ingredientValue == (id)[NSNull null]) { ingredientValue = nil; }
+            
+            BOOL isEqual = (!currentValue && !ingredientValue) || [currentValue isEqual:ingredientValue];
+            if (!isEqual) {
+                [changedPropertyNames addObject:propertyName];
+                if (stopAtFirst) { *stop = YES; }
+            }
+        }];
+    }
+    @catch (NSException *exception) {
+        if (error) {
+            *error = ZCREasyBakeExceptionError(exception);
+        }
+        return nil;
+    }
+    
+    return [changedPropertyNames copy];
+}
+
+- (BOOL)_setMappedIngredients:(NSDictionary *)mappedIngredients
+                        error:(NSError *__autoreleasing *)error {
+    NSParameterAssert(mappedIngredients);
+    
+    BOOL didAllowSettingReadonlyIVars = _allowsSettingReadonlyIVars;
+    _allowsSettingReadonlyIVars = YES;
+    
+    NSDictionary *setters = [[self class] _setters];
+    
+    ZCREasyInstrumentationRecorder *instrumentation = (ZCREasyInstrumentationIsEnabled()) ? [[self class] _metadata].instrumentation : nil;
+    uint64_t startTime = (instrumentation) ? ZCREasyInstrumentationBegin(instrumentation, ZCREasyInstrumentationSettingEvent) : 0;
+    
+    @try {
+        [mappedIngredients enumerateKeysAndObjectsUsingBlock:^(id key, id obj, BOOL *stop) {
+            // NSNull ingredient values are remapped to nil for setting
+            if (obj == [NSNull null]) { obj = nil; }
+            
+            _ZCREasySetter *setter = setters[key];
+            if (setter) {
+                [setter setValue:obj onDough:self];
+            } else {
+                [self setValue:obj forKey:key];
+            }
+        }];
+    }
+    @catch (NSException *exception) {
+        if (error) {
+            *error = ZCREasyBakeExceptionError(exception);
+        }
+        return NO;
+    }
+    @finally {
         _allowsSettingReadonlyIVars = didAllowSettingReadonlyIVars;
+        
+        if (instrumentation) {
+            ZCREasyInstrumentationEnd(instrumentation, ZCREasyInstrumentationSettingEvent, startTime);
+        }
     }
     
     return YES;
@@ -377,17 +970,228 @@ mutableIngredients:(id)mutableIngredients {
 #pragma mark NSCopying
 
 - (id)copyWithZone:(NSZone *)zone {
-    id copy = [[[self class] alloc] initWithIdentifier:_uniqueIdentifier ingredients:nil recipe:nil
-                                                 error:NULL];
+    return [self _copyExcludingPropertyNames:nil error:NULL];
+}
+
+- (id)_copyExcludingPropertyNames:(NSSet *)excludedPropertyNames error:(NSError *__autoreleasing *)error {
+    ZCREasyInstrumentationRecorder *instrumentation = (ZCREasyInstrumentationIsEnabled()) ? [[self class] _metadata].instrumentation : nil;
+    uint64_t startTime = (instrumentation) ? ZCREasyInstrumentationBegin(instrumentation, ZCREasyInstrumentationCopyingEvent) : 0;
+    
+    // Copies are baked eagerly, so any properties still waiting to be resolved are resolved first.
+    [self _resolveAllLazyProperties];
+    
+    ZCREasyDough *copy = [[[self class] alloc] initWithIdentifier:_uniqueIdentifier ingredients:nil
+                                                           recipe:nil error:NULL];
+    
+    // Slot storage is shared with the copy rather than copied, and is only cloned once either
+    // instance needs to write to it.
+    NSSet *slotPropertyNames = nil;
+    if (_slotStorage) {
+        _slotStorage.shared = YES;
+        copy->_slotStorage = _slotStorage;
+        slotPropertyNames = [[self class] _slotLayout].propertyNames;
+    }
+    
+    // Values are carried over through the pre-resolved setters, which read iVars directly where
+    // they can, instead of boxing every property through key-value coding.
+    NSDictionary *setters = [[self class] _setters];
+    BOOL didCopy = YES;
+    copy->_allowsSettingReadonlyIVars = YES;
+    
+    @try {
+        for (NSString *propertyName in [[self class] _settablePropertyNames]) {
+            if ([excludedPropertyNames containsObject:propertyName] || [slotPropertyNames containsObject:propertyName]) {
+                continue;
+            }
+            
+            _ZCREasySetter *setter = setters[propertyName];
+            if (setter) {
+                [setter copyValueFromDough:self toDough:copy];
+            } else {
+                [copy setValue:[self valueForKey:propertyName] forKey:propertyName];
+            }
+        }
+    }
+    @catch (NSException *exception) {
+        if (error) {
+            *error = ZCREasyBakeExceptionError(exception);
+        }
+        didCopy = NO;
+    }
+    @finally {
+        copy->_allowsSettingReadonlyIVars = NO;
+        
+        if (instrumentation) {
+            ZCREasyInstrumentationEnd(instrumentation, ZCREasyInstrumentationCopyingEvent, startTime);
+        }
+    }
     
-    NSArray *settableKeys = [[[self class] _settablePropertyNames] allObjects];
-    NSDictionary *mappedIngredients = [self dictionaryWithValuesForKeys:settableKeys];
+    return (didCopy) ? copy : nil;
+}
+
+
+#pragma mark Slot storage
+
++ (_ZCREasySlotLayout *)_slotLayout {
+    return [self _metadata].slotLayout;
+}
+
+- (_ZCREasySlotStorage *)_unsharedSlotStorage {
+    if (!_slotStorage) {
+        _slotStorage = [[_ZCREasySlotStorage alloc] initWithLayout:[[self class] _slotLayout]];
+    } else if (_slotStorage.isShared) {
+        _slotStorage = [_slotStorage unsharedStorage];
+    }
+    return _slotStorage;
+}
+
++ (ZCREasyRecipe *)_eagerRecipeForLazyRecipe:(ZCREasyRecipe *)recipe {
+    // The eager part of a recipe is derived once per class and kept on the recipe itself, keyed by
+    // the class's metadata.
+    _ZCREasyClassMetadata *metadata = [self _metadata];
+    id eagerRecipe = objc_getAssociatedObject(recipe, (__bridge void *)metadata);
+    if (eagerRecipe) {
+        return (eagerRecipe == [NSNull null]) ? nil : eagerRecipe;
+    }
     
-    if ([copy _setMappedIngredients:mappedIngredients error:NULL]) {
-        return copy;
+    NSMutableSet *eagerPropertyNames = [recipe.propertyNames mutableCopy];
+    [eagerPropertyNames minusSet:metadata.slotLayout.propertyNames];
+    
+    if ([eagerPropertyNames count] == 0) {
+        eagerRecipe = [NSNull null];
+    } else if ([eagerPropertyNames count] == [recipe.propertyNames count]) {
+        eagerRecipe = recipe;
     } else {
-        return nil;
+        eagerRecipe = [recipe modifyWith:^(id<ZCREasyRecipeMaker> recipeMaker) {
+            for (NSString *propertyName in recipe.propertyNames) {
+                if (![eagerPropertyNames containsObject:propertyName]) {
+                    [recipeMaker removeInstructionForProperty:propertyName error:NULL];
+                }
+            }
+        }];
     }
+    
+    objc_setAssociatedObject(recipe, (__bridge void *)metadata, eagerRecipe, OBJC_ASSOCIATION_RETAIN);
+    return (eagerRecipe == [NSNull null]) ? nil : eagerRecipe;
+}
+
+static pthread_mutex_t *_ZCRLazyLockForDough(ZCREasyDough *dough) {
+#define _ZCR_LAZY_LOCK_STRIPES 16
+    static pthread_mutex_t locks[_ZCR_LAZY_LOCK_STRIPES];
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        for (NSUInteger i = 0; i < _ZCR_LAZY_LOCK_STRIPES; i++) {
+            pthread_mutex_init(&locks[i], NULL);
+        }
+    });
+    
+    // Doughs are at least 16 byte aligned, so the low bits of their address carry no information.
+    return &locks[((uintptr_t)(__bridge void *)dough >> 4) % _ZCR_LAZY_LOCK_STRIPES];
+#undef _ZCR_LAZY_LOCK_STRIPES
+}
+
+- (void)_resolveLazyProperty:(NSString *)propertyName atIndex:(NSUInteger)index {
+    _ZCREasyLazyIngredients *lazyIngredients = _lazyIngredients;
+    if (!lazyIngredients || [lazyIngredients isResolvedAtIndex:index]) { return; }
+    
+    // The value is resolved outside the lock, since its transformer may bake other lazy doughs. If
+    // two threads race to resolve the same property, the first value stored wins.
+    BOOL found = NO;
+    ZCREasyRecipe *recipe = lazyIngredients.recipe;
+    id value = [recipe _processIngredients:lazyIngredients.ingredients forProperty:propertyName found:&found];
+    if (value == [NSNull null]) { value = nil; }
+    
+    _ZCREasySetter *setter = [[self class] _setters][propertyName];
+    if (value && [[self class] coercesIngredients] && !recipe.ingredientTransformers[propertyName]) {
+        // Values which can't be coerced are left unset, just as if they were missing.
+        value = [setter coercedValue:value];
+        found = (found && value != nil);
+    }
+    
+    pthread_mutex_t *lock = _ZCRLazyLockForDough(self);
+    pthread_mutex_lock(lock);
+    @try {
+        if (![lazyIngredients isResolvedAtIndex:index] && found) {
+            [setter setValue:value onDough:self];
+        }
+    }
+    @catch (NSException *exception) {
+        // Values which can't be set are left unset, just as if they were missing.
+    }
+    @finally {
+        [lazyIngredients markResolvedAtIndex:index];
+        pthread_mutex_unlock(lock);
+    }
+}
+
+- (void)_resolveAllLazyProperties {
+    if (!_lazyIngredients) { return; }
+    
+    _ZCREasySlotLayout *slotLayout = [[self class] _slotLayout];
+    for (NSString *propertyName in _lazyIngredients.recipe.propertyNames) {
+        ZCREasyProperty *property = [slotLayout propertyForName:propertyName];
+        if (!property) { continue; }
+        
+        NSUInteger slot = [slotLayout slotForPropertyName:propertyName];
+        [self _resolveLazyProperty:propertyName atIndex:(property.isObject) ? slot : slotLayout.objectCount + slot];
+    }
+}
+
++ (BOOL)resolveInstanceMethod:(SEL)selector {
+    // Getters for dynamic properties are installed lazily and read straight from the slot storage.
+    ZCREasyProperty *property = [[self _slotLayout] propertyForGetter:selector];
+    if (!property) {
+        return [super resolveInstanceMethod:selector];
+    }
+    
+    NSUInteger slot = [[self _slotLayout] slotForPropertyName:property.name];
+    NSString *propertyName = property.name;
+    id getterBlock = nil;
+    const char *typeEncoding = NULL;
+    
+    // Lazily baked doughs resolve each property the first time its getter is invoked.
+    if (property.isObject) {
+        getterBlock = ^id(ZCREasyDough *dough) {
+            if (dough->_lazyIngredients) {
+                [dough _resolveLazyProperty:propertyName atIndex:slot];
+            }
+            return [dough->_slotStorage objectAtSlot:slot];
+        };
+        typeEncoding = "@@:";
+    } else {
+        NSUInteger index = [self _slotLayout].objectCount + slot;
+        switch ([property.type characterAtIndex:0]) {
+#define _ZCR_SLOT_GETTER_CASE(encoding, scalarType, methodEncoding) \
+            case encoding: \
+                getterBlock = ^scalarType(ZCREasyDough *dough) { \
+                    if (dough->_lazyIngredients) { \
+                        [dough _resolveLazyProperty:propertyName atIndex:index]; \
+                    } \
+                    _ZCREasySlotStorage *storage = dough->_slotStorage; \
+                    return (storage) ? *(scalarType *)[storage scalarAtSlot:slot] : (scalarType)0; \
+                }; \
+                typeEncoding = methodEncoding; \
+                break;
+            _ZCR_SLOT_GETTER_CASE('c', char, "c@:")
+            _ZCR_SLOT_GETTER_CASE('C', unsigned char, "C@:")
+            _ZCR_SLOT_GETTER_CASE('s', short, "s@:")
+            _ZCR_SLOT_GETTER_CASE('S', unsigned short, "S@:")
+            _ZCR_SLOT_GETTER_CASE('i', int, "i@:")
+            _ZCR_SLOT_GETTER_CASE('I', unsigned int, "I@:")
+            _ZCR_SLOT_GETTER_CASE('l', long, "l@:")
+            _ZCR_SLOT_GETTER_CASE('L', unsigned long, "L@:")
+            _ZCR_SLOT_GETTER_CASE('q', long long, "q@:")
+            _ZCR_SLOT_GETTER_CASE('Q', unsigned long long, "Q@:")
+            _ZCR_SLOT_GETTER_CASE('f', float, "f@:")
+            _ZCR_SLOT_GETTER_CASE('d', double, "d@:")
+            _ZCR_SLOT_GETTER_CASE('B', bool, "B@:")
+#undef _ZCR_SLOT_GETTER_CASE
+            default:
+                return [super resolveInstanceMethod:selector];
+        }
+    }
+    
+    return class_addMethod(self, selector, imp_implementationWithBlock(getterBlock), typeEncoding);
 }
 
 
@@ -445,72 +1249,732 @@ mutableIngredients:(id)mutableIngredients {
 
 #pragma mark Introspection
 
++ (void)prewarmClasses:(NSArray *)classes {
+    NSArray *doughClasses = [classes copy];
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_LOW, 0), ^{
+        for (Class doughClass in doughClasses) {
+            if (![doughClass isSubclassOfClass:[ZCREasyDough class]]) { continue; }
+            [doughClass _setters];
+        }
+    });
+}
+
++ (_ZCREasyClassMetadata *)_metadata {
+    static char _ZCRMetadataKey;
+    _ZCREasyClassMetadata *metadata = objc_getAssociatedObject(self, &_ZCRMetadataKey);
+    if (metadata) { return metadata; }
+    
+    // Metadata is built once under a lock and only published once complete, so racing first uses
+    // neither duplicate the work nor see a partial table.
+    @synchronized([ZCREasyDough class]) {
+        metadata = objc_getAssociatedObject(self, &_ZCRMetadataKey);
+        if (!metadata) {
+            metadata = [[_ZCREasyClassMetadata alloc] initWithDoughClass:self];
+            objc_setAssociatedObject(self, &_ZCRMetadataKey, metadata, OBJC_ASSOCIATION_RETAIN);
+        }
+    }
+    
+    return metadata;
+}
+
 + (NSSet *)_properties {
-    NSSet *storedProperties = objc_getAssociatedObject(self, _cmd);
-    if (storedProperties) { return storedProperties; }
+    return [self _metadata].properties;
+}
+
++ (NSSet *)_settablePropertyNames {
+    return [self _metadata].settablePropertyNames;
+}
+
++ (NSSet *)_settableReadonlyPropertyNames {
+    return [self _metadata].settableReadonlyPropertyNames;
+}
+
++ (NSDictionary *)_setters {
+    static char _ZCRSettersKey;
+    NSDictionary *storedSetters = objc_getAssociatedObject(self, &_ZCRSettersKey);
+    if (storedSetters) { return storedSetters; }
+    
+    // The setters are published separately from the rest of the metadata, because resolving them
+    // can query the runtime, which in turn may need the slot layout.
+    _ZCREasyClassMetadata *metadata = [self _metadata];
+    
+    @synchronized([ZCREasyDough class]) {
+        storedSetters = objc_getAssociatedObject(self, &_ZCRSettersKey);
+        if (storedSetters) { return storedSetters; }
+        
+        // Subclasses which override setValue:forKey: expect it to be invoked for every ingredient,
+        // so they only get setters for slot properties, which key-value coding cannot reach.
+        SEL kvcSelector = @selector(setValue:forKey:);
+        BOOL overridesKVC = [self instanceMethodForSelector:kvcSelector] != [ZCREasyDough instanceMethodForSelector:kvcSelector];
+        NSSet *slotPropertyNames = metadata.slotLayout.propertyNames;
+        
+        NSMutableDictionary *mutableSetters = [NSMutableDictionary dictionary];
+        for (ZCREasyProperty *property in metadata.properties) {
+            if (overridesKVC && ![slotPropertyNames containsObject:property.name]) { continue; }
+            mutableSetters[property.name] = [[_ZCREasySetter alloc] initWithProperty:property
+                                                                          doughClass:self];
+        }
+        storedSetters = [mutableSetters copy];
+        
+        objc_setAssociatedObject(self, &_ZCRSettersKey, storedSetters, OBJC_ASSOCIATION_RETAIN);
+    }
+    
+    return storedSetters;
+}
+
++ (NSSet *)allPropertyNames {
+    return [self _metadata].propertyNames;
+}
+
++ (void)enumeratePropertiesWith:(void (^)(ZCREasyProperty *, BOOL *))block {
+    if (!block) { return; }
+    [[self _properties] enumerateObjectsUsingBlock:block];
+}
+
+@end
+
+
+#pragma mark - _ZCREasyIdentityMap
+
+#define _ZCR_IDENTITY_MAP_STRIPES 16
+
+// The entry count a stripe must reach before its released doughs are pruned.
+#define _ZCR_IDENTITY_MAP_MIN_PRUNE_COUNT 32
+
+@implementation _ZCREasyIdentityMap {
+    NSArray *_tables;
+    pthread_mutex_t _locks[_ZCR_IDENTITY_MAP_STRIPES];
+    NSUInteger _pruneCounts[_ZCR_IDENTITY_MAP_STRIPES];
+    unsigned long long _hits[_ZCR_IDENTITY_MAP_STRIPES];
+    unsigned long long _misses[_ZCR_IDENTITY_MAP_STRIPES];
+    unsigned long long _updates[_ZCR_IDENTITY_MAP_STRIPES];
+}
+
+- (instancetype)init {
+    if (!(self = [super init])) { return nil; }
+    
+    NSMutableArray *tables = [NSMutableArray arrayWithCapacity:_ZCR_IDENTITY_MAP_STRIPES];
+    for (NSUInteger i = 0; i < _ZCR_IDENTITY_MAP_STRIPES; i++) {
+        [tables addObject:[NSMapTable strongToWeakObjectsMapTable]];
+        pthread_mutex_init(&_locks[i], NULL);
+        _pruneCounts[i] = _ZCR_IDENTITY_MAP_MIN_PRUNE_COUNT;
+    }
+    _tables = [tables copy];
+    
+    return self;
+}
+
+- (void)dealloc {
+    for (NSUInteger i = 0; i < _ZCR_IDENTITY_MAP_STRIPES; i++) {
+        pthread_mutex_destroy(&_locks[i]);
+    }
+}
+
+- (id)lookupDoughForIdentifier:(id)identifier {
+    NSUInteger stripe = [identifier hash] % _ZCR_IDENTITY_MAP_STRIPES;
+    
+    NSMapTable *table = _tables[stripe];
+    
+    pthread_mutex_lock(&_locks[stripe]);
+    id dough = [table objectForKey:identifier];
+    if (dough) {
+        _hits[stripe]++;
+    } else {
+        // The identifier may still be keyed to a released dough.
+        [table removeObjectForKey:identifier];
+        _misses[stripe]++;
+    }
+    pthread_mutex_unlock(&_locks[stripe]);
+    
+    return dough;
+}
+
+- (id)swapDough:(id)dough forIdentifier:(id)identifier expecting:(id)expectedDough {
+    NSUInteger stripe = [identifier hash] % _ZCR_IDENTITY_MAP_STRIPES;
+    NSMapTable *table = _tables[stripe];
+    
+    pthread_mutex_lock(&_locks[stripe]);
+    id currentDough = [table objectForKey:identifier];
+    BOOL didSwap = (currentDough == expectedDough);
+    if (didSwap) {
+        [table setObject:dough forKey:[identifier copy]];
+        if (expectedDough) {
+            _updates[stripe]++;
+        } else if ([table count] >= _pruneCounts[stripe]) {
+            [self _pruneStripe:stripe];
+        }
+    }
+    pthread_mutex_unlock(&_locks[stripe]);
+    
+    return (didSwap) ? dough : currentDough;
+}
+
+// Must be called while holding the stripe's lock. The next prune waits until the stripe doubles,
+// so pruning costs a constant amount per inserted dough.
+- (void)_pruneStripe:(NSUInteger)stripe {
+    NSMapTable *table = _tables[stripe];
+    
+    NSMutableArray *releasedIdentifiers = [NSMutableArray array];
+    for (id identifier in table) {
+        if (![table objectForKey:identifier]) {
+            [releasedIdentifiers addObject:identifier];
+        }
+    }
+    for (id identifier in releasedIdentifiers) {
+        [table removeObjectForKey:identifier];
+    }
+    
+    _pruneCounts[stripe] = MAX([table count] * 2, (NSUInteger)_ZCR_IDENTITY_MAP_MIN_PRUNE_COUNT);
+}
+
+- (void)removeAllDoughs {
+    for (NSUInteger i = 0; i < _ZCR_IDENTITY_MAP_STRIPES; i++) {
+        pthread_mutex_lock(&_locks[i]);
+        [_tables[i] removeAllObjects];
+        _pruneCounts[i] = _ZCR_IDENTITY_MAP_MIN_PRUNE_COUNT;
+        _hits[i] = 0;
+        _misses[i] = 0;
+        _updates[i] = 0;
+        pthread_mutex_unlock(&_locks[i]);
+    }
+}
+
+- (NSDictionary *)statistics {
+    unsigned long long hits = 0, misses = 0, updates = 0, count = 0;
+    
+    for (NSUInteger i = 0; i < _ZCR_IDENTITY_MAP_STRIPES; i++) {
+        pthread_mutex_lock(&_locks[i]);
+        hits += _hits[i];
+        misses += _misses[i];
+        updates += _updates[i];
+        // Released doughs are pruned lazily, so they may be counted until their stripe is pruned.
+        count += [_tables[i] count];
+        pthread_mutex_unlock(&_locks[i]);
+    }
+    
+    return @{ZCREasyDoughIdentityMapHitsKey: @(hits),
+             ZCREasyDoughIdentityMapMissesKey: @(misses),
+             ZCREasyDoughIdentityMapUpdatesKey: @(updates),
+             ZCREasyDoughIdentityMapCountKey: @(count)};
+}
+
+@end
+
+
+#pragma mark - _ZCREasySetter
+
+typedef NS_ENUM(NSInteger, _ZCREasySetterKind) {
+    _ZCREasySetterKindKeyValueCoding = 0,
+    _ZCREasySetterKindObjectSetter,
+    _ZCREasySetterKindScalarSetter,
+    _ZCREasySetterKindStrongIVar,
+    _ZCREasySetterKindWeakIVar,
+    _ZCREasySetterKindUnretainedIVar,
+    _ZCREasySetterKindScalarIVar,
+    _ZCREasySetterKindObjectSlot,
+    _ZCREasySetterKindScalarSlot
+};
+
+static inline char _ZCRScalarTypeForEncoding(NSString *typeEncoding) {
+    if (typeEncoding.length != 1) { return 0; }
+    
+    char type = (char)[typeEncoding characterAtIndex:0];
+    switch (type) {
+        case 'c': case 'C': case 's': case 'S': case 'i': case 'I': case 'l': case 'L':
+        case 'q': case 'Q': case 'f': case 'd': case 'B':
+            return type;
+        default:
+            return 0;
+    }
+}
+
+// The accessor key-value coding unboxes non-number values with for each scalar type.
+static SEL _ZCRScalarAccessorForType(char type) {
+    switch (type) {
+        case 'c': return @selector(charValue);
+        case 'C': return @selector(unsignedCharValue);
+        case 's': return @selector(shortValue);
+        case 'S': return @selector(unsignedShortValue);
+        case 'i': return @selector(intValue);
+        case 'I': return @selector(unsignedIntValue);
+        case 'l': return @selector(longValue);
+        case 'L': return @selector(unsignedLongValue);
+        case 'q': return @selector(longLongValue);
+        case 'Q': return @selector(unsignedLongLongValue);
+        case 'f': return @selector(floatValue);
+        case 'd': return @selector(doubleValue);
+        case 'B': return @selector(boolValue);
+        default: return NULL;
+    }
+}
+
+// Either invokes the scalar setter IMP, or writes straight into the iVar slot when there is none.
+static void _ZCRSetScalar(id dough, SEL selector, IMP implementation, void *slot, char type,
+                          NSNumber *number) {
+    switch (type) {
+#define _ZCR_SCALAR_CASE(encoding, scalarType, accessor) \
+        case encoding: { \
+            scalarType scalar = (scalarType)[number accessor]; \
+            if (implementation) { \
+                ((void (*)(id, SEL, scalarType))implementation)(dough, selector, scalar); \
+            } else { \
+                *(scalarType *)slot = scalar; \
+            } \
+            break; \
+        }
+        _ZCR_SCALAR_CASE('c', char, charValue)
+        _ZCR_SCALAR_CASE('C', unsigned char, unsignedCharValue)
+        _ZCR_SCALAR_CASE('s', short, shortValue)
+        _ZCR_SCALAR_CASE('S', unsigned short, unsignedShortValue)
+        _ZCR_SCALAR_CASE('i', int, intValue)
+        _ZCR_SCALAR_CASE('I', unsigned int, unsignedIntValue)
+        _ZCR_SCALAR_CASE('l', long, longValue)
+        _ZCR_SCALAR_CASE('L', unsigned long, unsignedLongValue)
+        _ZCR_SCALAR_CASE('q', long long, longLongValue)
+        _ZCR_SCALAR_CASE('Q', unsigned long long, unsignedLongLongValue)
+        _ZCR_SCALAR_CASE('f', float, floatValue)
+        _ZCR_SCALAR_CASE('d', double, doubleValue)
+        _ZCR_SCALAR_CASE('B', bool, boolValue)
+#undef _ZCR_SCALAR_CASE
+        default:
+            break;
+    }
+}
+
+// Whether an ivar layout, as returned by class_getIvarLayout, marks the word at the given offset.
+// Each layout byte skips its high nibble of words and then scans its low nibble.
+static BOOL _ZCRIvarLayoutScansOffset(const uint8_t *layout, ptrdiff_t offset) {
+    if (!layout) { return NO; }
+    
+    ptrdiff_t index = 0;
+    ptrdiff_t ivarIndex = offset / (ptrdiff_t)sizeof(id);
+    uint8_t byte;
+    while ((byte = *layout++)) {
+        index += (byte >> 4);
+        if (index > ivarIndex) { return NO; }
+        index += (byte & 0x0F);
+        if (index > ivarIndex) { return YES; }
+    }
+    return NO;
+}
+
+// The ownership of an object iVar comes from the layouts of the class that declares it, since the
+// property attributes can't tell an ARC strong iVar from an assign one. Without layouts, iVars
+// which aren't weak are treated as strong, which is what ARC makes them by default.
+static _ZCREasySetterKind _ZCRSetterKindForObjectIVar(Class doughClass, Ivar iVar, BOOL isWeak) {
+    if (isWeak) { return _ZCREasySetterKindWeakIVar; }
+    
+    Class declaringClass = doughClass;
+    for (; declaringClass; declaringClass = class_getSuperclass(declaringClass)) {
+        unsigned int count = 0;
+        Ivar *iVars = class_copyIvarList(declaringClass, &count);
+        BOOL declares = NO;
+        for (unsigned int i = 0; i < count && !declares; i++) {
+            declares = (iVars[i] == iVar);
+        }
+        free(iVars);
+        if (declares) { break; }
+    }
+    if (!declaringClass) { return _ZCREasySetterKindStrongIVar; }
+    
+    const uint8_t *strongLayout = class_getIvarLayout(declaringClass);
+    const uint8_t *weakLayout = class_getWeakIvarLayout(declaringClass);
+    ptrdiff_t offset = ivar_getOffset(iVar);
+    
+    if (_ZCRIvarLayoutScansOffset(strongLayout, offset)) { return _ZCREasySetterKindStrongIVar; }
+    if (_ZCRIvarLayoutScansOffset(weakLayout, offset)) { return _ZCREasySetterKindWeakIVar; }
+    
+    return (strongLayout || weakLayout) ? _ZCREasySetterKindUnretainedIVar : _ZCREasySetterKindStrongIVar;
+}
+
+@implementation _ZCREasySetter {
+    NSString *_key;
+    _ZCREasySetterKind _kind;
+    SEL _selector;
+    IMP _implementation;
+    ptrdiff_t _offset;
+    NSUInteger _slot;
+    char _scalarType;
+    Class _typeClass;
+    SEL _scalarAccessor;
+    BOOL _acceptsNil;
+    BOOL _copies;
+}
+
+- (instancetype)initWithProperty:(ZCREasyProperty *)property doughClass:(Class)doughClass {
+    NSParameterAssert(property);
+    NSParameterAssert(doughClass);
+    
+    if (!(self = [super init])) { return nil; }
+    
+    _key = [property.name copy];
+    _scalarType = (property.isObject) ? 0 : _ZCRScalarTypeForEncoding(property.type);
+    _typeClass = (property.isObject) ? property.typeClass : Nil;
+    _scalarAccessor = _ZCRScalarAccessorForType(_scalarType);
+    
+    // Nil scalars raise unless the class handles them itself.
+    SEL nilSelector = @selector(setNilValueForKey:);
+    _acceptsNil = !_scalarType || [doughClass instanceMethodForSelector:nilSelector] != [ZCREasyDough instanceMethodForSelector:nilSelector];
+    
+    // Structs, pointers and other exotic types are left to key-value coding.
+    if (!property.isObject && !_scalarType) {
+        _kind = _ZCREasySetterKindKeyValueCoding;
+        return self;
+    }
+    
+    _copies = [property hasAttribute:ZCREasyPropertyAttrCopy];
+    
+    // Dynamic properties of classes using slot storage live in the slot buffer.
+    _ZCREasySlotLayout *slotLayout = [doughClass _slotLayout];
+    if ([slotLayout propertyForName:_key]) {
+        _slot = [slotLayout slotForPropertyName:_key];
+        _kind = (property.isObject) ? _ZCREasySetterKindObjectSlot : _ZCREasySetterKindScalarSlot;
+        return self;
+    }
+    
+    // Key-value coding prefers a set<Key>: method, so we do the same before using the iVar.
+    NSString *setterName = [NSString stringWithFormat:@"set%@%@:",
+                            [[_key substringToIndex:1] uppercaseString], [_key substringFromIndex:1]];
+    SEL setter = NSSelectorFromString(setterName);
+    if (![doughClass instancesRespondToSelector:setter]) {
+        setter = property.customSetter;
+    }
+    
+    if (setter && [doughClass instancesRespondToSelector:setter]) {
+        _selector = setter;
+        _implementation = [doughClass instanceMethodForSelector:setter];
+        _kind = (property.isObject) ? _ZCREasySetterKindObjectSetter : _ZCREasySetterKindScalarSetter;
+        return self;
+    }
+    
+    Ivar iVar = (property.iVarName) ? class_getInstanceVariable(doughClass, [property.iVarName UTF8String]) : NULL;
+    if (!iVar) {
+        _kind = _ZCREasySetterKindKeyValueCoding;
+        return self;
+    }
+    
+    _offset = ivar_getOffset(iVar);
+    
+    if (!property.isObject) {
+        _kind = _ZCREasySetterKindScalarIVar;
+    } else if (_copies || [property hasAttribute:ZCREasyPropertyAttrRetain]) {
+        _kind = _ZCREasySetterKindStrongIVar;
+    } else {
+        _kind = _ZCRSetterKindForObjectIVar(doughClass, iVar, property.isWeak);
+    }
+    
+    return self;
+}
+
+- (BOOL)acceptsValue:(id)value {
+    if (!_scalarType) { return YES; }
+    if (!value) { return _acceptsNil; }
+    
+    return [value isKindOfClass:[NSNumber class]] || [value respondsToSelector:_scalarAccessor];
+}
+
+- (id)coercedValue:(id)value {
+    return ZCREasyCoerceValue(value, _typeClass, _scalarType);
+}
+
+- (void)setValue:(id)value onDough:(ZCREasyDough *)dough {
+    void *slot = (uint8_t *)(__bridge void *)dough + _offset;
+    
+    switch (_kind) {
+        case _ZCREasySetterKindObjectSetter:
+            ((void (*)(id, SEL, id))_implementation)(dough, _selector, value);
+            break;
+        case _ZCREasySetterKindStrongIVar:
+            *(__strong id *)slot = (_copies) ? [value copy] : value;
+            break;
+        case _ZCREasySetterKindWeakIVar:
+            *(__weak id *)slot = value;
+            break;
+        case _ZCREasySetterKindUnretainedIVar:
+            *(__unsafe_unretained id *)slot = value;
+            break;
+        case _ZCREasySetterKindObjectSlot:
+            [[dough _unsharedSlotStorage] setObject:((_copies) ? [value copy] : value) atSlot:_slot];
+            break;
+        case _ZCREasySetterKindScalarSlot:
+            if (!value) {
+                [dough setNilValueForKey:_key];
+            } else if ([value isKindOfClass:[NSNumber class]]) {
+                _ZCRSetScalar(dough, NULL, NULL, [[dough _unsharedSlotStorage] scalarAtSlot:_slot],
+                              _scalarType, value);
+            } else {
+                [dough setValue:value forKey:_key];
+            }
+            break;
+        case _ZCREasySetterKindScalarSetter:
+        case _ZCREasySetterKindScalarIVar:
+            if (!value) {
+                // Matches key-value coding, which raises by default for nil scalars.
+                [dough setNilValueForKey:_key];
+            } else if ([value isKindOfClass:[NSNumber class]]) {
+                IMP implementation = (_kind == _ZCREasySetterKindScalarSetter) ? _implementation : NULL;
+                _ZCRSetScalar(dough, _selector, implementation, slot, _scalarType, value);
+            } else {
+                // Non-number values get key-value coding's own unboxing rules.
+                [dough setValue:value forKey:_key];
+            }
+            break;
+        case _ZCREasySetterKindKeyValueCoding:
+        default:
+            [dough setValue:value forKey:_key];
+            break;
+    }
+}
+
+- (void)copyValueFromDough:(ZCREasyDough *)sourceDough toDough:(ZCREasyDough *)dough {
+    void *sourceSlot = (uint8_t *)(__bridge void *)sourceDough + _offset;
+    
+    switch (_kind) {
+        case _ZCREasySetterKindStrongIVar:
+            [self setValue:*(__strong id *)sourceSlot onDough:dough];
+            break;
+        case _ZCREasySetterKindWeakIVar:
+            [self setValue:*(__weak id *)sourceSlot onDough:dough];
+            break;
+        case _ZCREasySetterKindUnretainedIVar:
+            [self setValue:*(__unsafe_unretained id *)sourceSlot onDough:dough];
+            break;
+        case _ZCREasySetterKindScalarIVar: {
+            NSUInteger size = 0;
+            char encoding[2] = {_scalarType, '\0'};
+            NSGetSizeAndAlignment(encoding, &size, NULL);
+            memcpy((uint8_t *)(__bridge void *)dough + _offset, sourceSlot, size);
+            break;
+        }
+        case _ZCREasySetterKindObjectSlot:
+        case _ZCREasySetterKindScalarSlot:
+            // Slot values travel with the slot storage, which copies share.
+            break;
+        default:
+            // Accessors may be overridden, so the value is read and written through them.
+            [self setValue:[sourceDough valueForKey:_key] onDough:dough];
+            break;
+    }
+}
+
+@end
+
+
+#pragma mark - _ZCREasyClassMetadata
+
+@implementation _ZCREasyClassMetadata
+
+- (instancetype)initWithDoughClass:(Class)doughClass {
+    NSParameterAssert(doughClass);
     
-    NSMutableSet *mutableProperties = [NSMutableSet set];
+    if (!(self = [super init])) { return nil; }
+    
+    NSMutableSet *properties = [NSMutableSet set];
+    NSMutableSet *propertyNames = [NSMutableSet set];
+    NSMutableSet *settablePropertyNames = [NSMutableSet set];
+    NSMutableSet *settableReadonlyPropertyNames = [NSMutableSet set];
     
     // We expose properties up till ZCREasyDough to prevent exposing non-user defined properties.
     Class rootClass = [ZCREasyDough class];
-    Class currentClass = self;
-    NSSet *currentProperties = nil;
-    
-    while (currentClass != rootClass) {
-        currentProperties = [ZCREasyProperty propertiesForClass:currentClass];
-        if (currentProperties) {
-            [mutableProperties unionSet:currentProperties];
+    for (Class currentClass = doughClass; currentClass && currentClass != rootClass;
+         currentClass = [currentClass superclass]) {
+        for (ZCREasyProperty *property in [ZCREasyProperty propertiesForClass:currentClass]) {
+            if ([properties containsObject:property]) { continue; }
+            [properties addObject:property];
+            [propertyNames addObject:property.name];
+            
+            // Read-only properties can only be set through their backing iVar.
+            if (!property.isReadOnly) {
+                [settablePropertyNames addObject:property.name];
+            } else if (property.iVarName) {
+                [settablePropertyNames addObject:property.name];
+                [settableReadonlyPropertyNames addObject:property.name];
+            }
         }
-        currentClass = [currentClass superclass];
     }
-    objc_setAssociatedObject(self, _cmd, mutableProperties, OBJC_ASSOCIATION_COPY);
     
-    return [mutableProperties copy];
+    _properties = [properties copy];
+    _propertyNames = [propertyNames copy];
+    _settablePropertyNames = [settablePropertyNames copy];
+    _settableReadonlyPropertyNames = [settableReadonlyPropertyNames copy];
+    
+    if ([doughClass usesSlotStorage]) {
+        _slotLayout = [[_ZCREasySlotLayout alloc] initWithProperties:_properties];
+    }
+    
+    _instrumentation = [[ZCREasyInstrumentationRecorder alloc] initWithSubject:NSStringFromClass(doughClass)];
+    
+    return self;
 }
 
-+ (NSSet *)_settablePropertyNames {
-    NSSet *storedProperties = objc_getAssociatedObject(self, _cmd);
-    if (storedProperties) { return storedProperties; }
+@end
+
+
+#pragma mark - _ZCREasySlotLayout
+
+@implementation _ZCREasySlotLayout {
+    NSDictionary *_propertiesByName;
+    NSDictionary *_propertiesByGetter;
+    NSDictionary *_slotsByName;
+}
+
+- (instancetype)initWithProperties:(NSSet *)properties {
+    if (!(self = [super init])) { return nil; }
     
-    NSPredicate *predicate = [NSPredicate predicateWithFormat:@"%K == YES AND %K == nil", NSStringFromSelector(@selector(isReadOnly)), NSStringFromSelector(@selector(iVarName))];
-    NSSet *invalidProperties = [[self _properties] filteredSetUsingPredicate:predicate];
+    NSMutableDictionary *propertiesByName = [NSMutableDictionary dictionary];
+    NSMutableDictionary *propertiesByGetter = [NSMutableDictionary dictionary];
+    NSMutableDictionary *slotsByName = [NSMutableDictionary dictionary];
     
-    NSMutableSet *mutableProperties = [[self _properties] mutableCopy];
-    [mutableProperties minusSet:invalidProperties];
+    for (ZCREasyProperty *property in properties) {
+        // Only dynamic object and simple scalar properties can be backed by slots.
+        if (![property hasAttribute:ZCREasyPropertyAttrDynamic]) { continue; }
+        if (!property.isObject && !_ZCRScalarTypeForEncoding(property.type)) { continue; }
+        
+        NSUInteger slot = (property.isObject) ? _objectCount++ : _scalarCount++;
+        
+        SEL getter = property.customGetter ?: NSSelectorFromString(property.name);
+        propertiesByName[property.name] = property;
+        propertiesByGetter[NSStringFromSelector(getter)] = property;
+        slotsByName[property.name] = @(slot);
+    }
     
-    storedProperties = [mutableProperties valueForKey:NSStringFromSelector(@selector(name))];
+    _propertiesByName = [propertiesByName copy];
+    _propertiesByGetter = [propertiesByGetter copy];
+    _slotsByName = [slotsByName copy];
+    _propertyNames = [NSSet setWithArray:[propertiesByName allKeys]];
     
-    objc_setAssociatedObject(self, _cmd, storedProperties, OBJC_ASSOCIATION_RETAIN);
-    return storedProperties;
+    return self;
 }
 
-+ (NSSet *)_settableReadonlyPropertyNames {
-    NSSet *storedProperties = objc_getAssociatedObject(self, _cmd);
-    if (storedProperties) { return storedProperties; }
+- (ZCREasyProperty *)propertyForName:(NSString *)propertyName {
+    return _propertiesByName[propertyName];
+}
+
+- (ZCREasyProperty *)propertyForGetter:(SEL)getter {
+    return _propertiesByGetter[NSStringFromSelector(getter)];
+}
+
+- (NSUInteger)slotForPropertyName:(NSString *)propertyName {
+    return [_slotsByName[propertyName] unsignedIntegerValue];
+}
+
+@end
+
+
+#pragma mark - _ZCREasyLazyIngredients
+
+@implementation _ZCREasyLazyIngredients {
+    NSUInteger _count;
+    uint8_t *_resolved;
+}
+
+- (instancetype)initWithIngredients:(id)ingredients recipe:(ZCREasyRecipe *)recipe
+                             layout:(_ZCREasySlotLayout *)layout {
+    NSParameterAssert(recipe);
+    NSParameterAssert(layout);
     
-    NSPredicate *predicate = [NSPredicate predicateWithFormat:@"%K == YES AND %K != nil", NSStringFromSelector(@selector(isReadOnly)), NSStringFromSelector(@selector(iVarName))];
-    storedProperties = [[self _properties] filteredSetUsingPredicate:predicate];
-    storedProperties = [storedProperties valueForKey:NSStringFromSelector(@selector(name))];
+    if (!(self = [super init])) { return nil; }
+    
+    _ingredients = ingredients;
+    _recipe = recipe;
+    
+    // Object slots are indexed first, followed by scalar slots. Properties which aren't in the
+    // recipe have nothing to resolve, so they start out resolved.
+    _count = layout.objectCount + layout.scalarCount;
+    _resolved = malloc(MAX(_count, 1));
+    memset(_resolved, 1, MAX(_count, 1));
+    
+    for (NSString *propertyName in recipe.propertyNames) {
+        ZCREasyProperty *property = [layout propertyForName:propertyName];
+        if (!property) { continue; }
+        
+        NSUInteger slot = [layout slotForPropertyName:propertyName];
+        _resolved[(property.isObject) ? slot : layout.objectCount + slot] = 0;
+    }
     
-    objc_setAssociatedObject(self, _cmd, storedProperties, OBJC_ASSOCIATION_RETAIN);
-    return storedProperties;
+    return self;
 }
 
-+ (NSSet *)allPropertyNames {
-    // We do this associated-object song and dance to cache these sets per class. It's ok if the
-    // work is overriden on multiple threads because the result will always be the same!
-    NSSet *storedNames = objc_getAssociatedObject(self, _cmd);
-    if (storedNames) { return storedNames; }
+- (void)dealloc {
+    free(_resolved);
+}
+
+- (BOOL)isResolvedAtIndex:(NSUInteger)index {
+    NSParameterAssert(index < _count);
+    return __atomic_load_n(&_resolved[index], __ATOMIC_ACQUIRE) != 0;
+}
+
+- (void)markResolvedAtIndex:(NSUInteger)index {
+    NSParameterAssert(index < _count);
+    __atomic_store_n(&_resolved[index], 1, __ATOMIC_RELEASE);
+}
+
+@end
+
+
+#pragma mark - _ZCREasySlotStorage
+
+@implementation _ZCREasySlotStorage {
+    NSUInteger _objectCount;
+    NSUInteger _scalarCount;
+    __strong id *_objects;
+    uint64_t *_scalars;
+}
+
+- (instancetype)initWithLayout:(_ZCREasySlotLayout *)layout {
+    NSParameterAssert(layout);
+    
+    if (!(self = [super init])) { return nil; }
+    
+    _objectCount = layout.objectCount;
+    _scalarCount = layout.scalarCount;
     
-    storedNames = [[self _properties] valueForKey:NSStringFromSelector(@selector(name))];
-    objc_setAssociatedObject(self, _cmd, storedNames, OBJC_ASSOCIATION_RETAIN);
+    // Every scalar fits in a 64-bit slot, which keeps the buffer compact and aligned.
+    _objects = (__strong id *)calloc(MAX(_objectCount, 1), sizeof(id));
+    _scalars = calloc(MAX(_scalarCount, 1), sizeof(uint64_t));
     
-    return storedNames;
+    return self;
 }
 
-+ (void)enumeratePropertiesWith:(void (^)(ZCREasyProperty *, BOOL *))block {
-    if (!block) { return; }
-    [[self _properties] enumerateObjectsUsingBlock:block];
+- (void)dealloc {
+    for (NSUInteger i = 0; i < _objectCount; i++) {
+        _objects[i] = nil;
+    }
+    free(_objects);
+    free(_scalars);
+}
+
+- (_ZCREasySlotStorage *)unsharedStorage {
+    if (!self.isShared) { return self; }
+    
+    _ZCREasySlotStorage *storage = [[[self class] alloc] init];
+    storage->_objectCount = _objectCount;
+    storage->_scalarCount = _scalarCount;
+    storage->_objects = (__strong id *)calloc(MAX(_objectCount, 1), sizeof(id));
+    storage->_scalars = calloc(MAX(_scalarCount, 1), sizeof(uint64_t));
+    
+    for (NSUInteger i = 0; i < _objectCount; i++) {
+        storage->_objects[i] = _objects[i];
+    }
+    memcpy(storage->_scalars, _scalars, _scalarCount * sizeof(uint64_t));
+    
+    return storage;
+}
+
+- (id)objectAtSlot:(NSUInteger)slot {
+    NSParameterAssert(slot < _objectCount);
+    return _objects[slot];
+}
+
+- (void)setObject:(id)object atSlot:(NSUInteger)slot {
+    NSParameterAssert(slot < _objectCount);
+    NSAssert(!self.isShared, @"Shared slot storage must not be written to.");
+    _objects[slot] = object;
+}
+
+- (void *)scalarAtSlot:(NSUInteger)slot {
+    NSParameterAssert(slot < _scalarCount);
+    return &_scalars[slot];
 }
 
 @end
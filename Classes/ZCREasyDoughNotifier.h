@@ -0,0 +1,172 @@
+//
+//  ZCREasyDoughNotifier.h
+//  ZCREasyBake
+//
+//  Created by Zachary Radke on 10/16/26.
+//  Copyright (c) 2026 Zach Radke. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+@class ZCREasyDough;
+
+/**
+ *  Notification posted once for a batch of updates made inside performBatchUpdates:. The
+ *  notification's user info contains the updates under ZCREasyDoughUpdatesKey.
+ */
+FOUNDATION_EXPORT NSString *const ZCREasyDoughBatchUpdateNotification;
+
+/**
+ *  Key present in batch update notifications that points to an NSArray of update dictionaries, in
+ *  the order the doughs were first updated. Each dictionary contains the same keys as an individual
+ *  update notification, along with ZCREasyDoughOriginalDoughKey.
+ */
+FOUNDATION_EXPORT NSString *const ZCREasyDoughUpdatesKey;
+
+/**
+ *  Key present in each batched update dictionary that points to the dough which was updated. For
+ *  individual update notifications this is the notification's object instead.
+ */
+FOUNDATION_EXPORT NSString *const ZCREasyDoughOriginalDoughKey;
+
+/**
+ *  Key in the notifier statistics for the number of updates waiting to be delivered.
+ */
+FOUNDATION_EXPORT NSString *const ZCREasyDoughNotifierQueueDepthKey;
+
+/**
+ *  Key in the notifier statistics for the number of updates posted to the notifier.
+ */
+FOUNDATION_EXPORT NSString *const ZCREasyDoughNotifierPostedCountKey;
+
+/**
+ *  Key in the notifier statistics for the number of updates merged into a pending update for the
+ *  same dough.
+ */
+FOUNDATION_EXPORT NSString *const ZCREasyDoughNotifierCoalescedCountKey;
+
+/**
+ *  Key in the notifier statistics for the number of updates delivered to observers.
+ */
+FOUNDATION_EXPORT NSString *const ZCREasyDoughNotifierDeliveredCountKey;
+
+/**
+ *  Key in the notifier statistics for the mean time in seconds between an update being posted and
+ *  delivered.
+ */
+FOUNDATION_EXPORT NSString *const ZCREasyDoughNotifierAverageLatencyKey;
+
+/**
+ *  Key in the notifier statistics for the longest time in seconds between an update being posted
+ *  and delivered.
+ */
+FOUNDATION_EXPORT NSString *const ZCREasyDoughNotifierMaxLatencyKey;
+
+/**
+ *  ZCREasyDoughNotifier delivers the update notifications of ZCREasyDough instances.
+ *
+ *  By default updates are delivered synchronously on the updating thread, exactly as the
+ *  ZCREasyDoughUpdateNotification and the class's updateNotificationName. A notifier configured
+ *  with a delivery queue instead delivers asynchronously on that queue, so ingestion is never
+ *  blocked on observers. Updates to the same dough which are still waiting to be delivered are
+ *  coalesced into one: observers receive the original dough as the notification's object, the
+ *  latest updated dough, and the union of the changed property names. A coalescing interval holds
+ *  updates back for that long to give repeated updates a chance to coalesce.
+ *
+ *  Updates made inside performBatchUpdates: are collected and delivered as a single
+ *  ZCREasyDoughBatchUpdateNotification rather than individually, which suits bulk refreshes.
+ *
+ *  Notifiers are thread-safe.
+ */
+@interface ZCREasyDoughNotifier : NSObject
+
+/**
+ *  The notifier used by ZCREasyDough classes which don't override
+ *  [ZCREasyDough updateNotifier]. Unless replaced, this delivers synchronously to the default
+ *  notification center.
+ *
+ *  @return The default notifier.
+ */
++ (instancetype)defaultNotifier;
+
+/**
+ *  Replaces the default notifier.
+ *
+ *  @param notifier The new default notifier, or nil to restore the synchronous notifier.
+ */
++ (void)setDefaultNotifier:(ZCREasyDoughNotifier *)notifier;
+
+/**
+ *  Designated initializer for this class.
+ *
+ *  @param notificationCenter The notification center to post to. If nil, the default notification
+ *                            center is used.
+ *  @param deliveryQueue      The queue to deliver notifications on. If nil, notifications are
+ *                            delivered synchronously by the updating thread and nothing is
+ *                            coalesced.
+ *  @param coalescingInterval How long in seconds asynchronous updates are held before delivery.
+ *                            This is ignored if there is no delivery queue.
+ *
+ *  @return A new notifier.
+ */
+- (instancetype)initWithNotificationCenter:(NSNotificationCenter *)notificationCenter
+                             deliveryQueue:(dispatch_queue_t)deliveryQueue
+                        coalescingInterval:(NSTimeInterval)coalescingInterval;
+
+/**
+ *  The notification center notifications are posted to.
+ */
+@property (strong, nonatomic, readonly) NSNotificationCenter *notificationCenter;
+
+/**
+ *  The queue notifications are delivered on, or nil if they are delivered synchronously.
+ */
+@property (strong, nonatomic, readonly) dispatch_queue_t deliveryQueue;
+
+/**
+ *  How long in seconds updates are held to be coalesced before delivery.
+ */
+@property (assign, nonatomic, readonly) NSTimeInterval coalescingInterval;
+
+/**
+ *  Posts the update of a dough. This is invoked by [ZCREasyDough updateWithIngredients:recipe:error:]
+ *  and rarely needs to be called directly.
+ *
+ *  @param dough                The dough which was updated. This must not be nil.
+ *  @param updatedDough         The updated dough. This must not be nil.
+ *  @param changedPropertyNames The names of the properties which changed.
+ */
+- (void)postUpdateOfDough:(ZCREasyDough *)dough
+             updatedDough:(ZCREasyDough *)updatedDough
+     changedPropertyNames:(NSSet *)changedPropertyNames __attribute__((nonnull (1,2)));
+
+/**
+ *  Executes the block, collecting every update posted to this notifier until it returns, and then
+ *  delivers them as one ZCREasyDoughBatchUpdateNotification. Batches may be nested, in which case
+ *  delivery waits for the outermost batch. Note that updates posted from other threads while a
+ *  batch is open join that batch.
+ *
+ *  @param block The block to execute. This must not be nil.
+ */
+- (void)performBatchUpdates:(void (^)(void))block __attribute__((nonnull));
+
+/**
+ *  Delivers any pending updates without waiting for the coalescing interval, and returns once they
+ *  have been delivered. This must not be called from the delivery queue.
+ */
+- (void)flush;
+
+/**
+ *  A snapshot of the notifier's delivery statistics, keyed by the ZCREasyDoughNotifier statistics
+ *  keys. Each value is an NSNumber.
+ *
+ *  @return The statistics.
+ */
+- (NSDictionary *)statistics;
+
+/**
+ *  Resets the delivery statistics. Pending updates are unaffected.
+ */
+- (void)resetStatistics;
+
+@end
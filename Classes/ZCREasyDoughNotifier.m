@@ -0,0 +1,327 @@
+//
+//  ZCREasyDoughNotifier.m
+//  ZCREasyBake
+//
+//  Created by Zachary Radke on 10/16/26.
+//  Copyright (c) 2026 Zach Radke. All rights reserved.
+//
+
+#import "ZCREasyDoughNotifier.h"
+
+#import "ZCREasyDough.h"
+
+#import <pthread.h>
+
+NSString *const ZCREasyDoughBatchUpdateNotification = @"com.zachradke.easyBake.easyDough.notifications.batchUpdated";
+
+NSString *const ZCREasyDoughUpdatesKey = @"ZCREasyDoughUpdatesKey";
+
+NSString *const ZCREasyDoughOriginalDoughKey = @"ZCREasyDoughOriginalDoughKey";
+
+NSString *const ZCREasyDoughNotifierQueueDepthKey = @"ZCREasyDoughNotifierQueueDepthKey";
+
+NSString *const ZCREasyDoughNotifierPostedCountKey = @"ZCREasyDoughNotifierPostedCountKey";
+
+NSString *const ZCREasyDoughNotifierCoalescedCountKey = @"ZCREasyDoughNotifierCoalescedCountKey";
+
+NSString *const ZCREasyDoughNotifierDeliveredCountKey = @"ZCREasyDoughNotifierDeliveredCountKey";
+
+NSString *const ZCREasyDoughNotifierAverageLatencyKey = @"ZCREasyDoughNotifierAverageLatencyKey";
+
+NSString *const ZCREasyDoughNotifierMaxLatencyKey = @"ZCREasyDoughNotifierMaxLatencyKey";
+
+/**
+ *  An update waiting to be delivered. Later updates of the same dough are merged into it.
+ */
+@interface _ZCREasyPendingUpdate : NSObject
+- (instancetype)initWithDough:(ZCREasyDough *)dough updatedDough:(ZCREasyDough *)updatedDough
+         changedPropertyNames:(NSSet *)changedPropertyNames;
+- (void)mergeUpdatedDough:(ZCREasyDough *)updatedDough changedPropertyNames:(NSSet *)changedPropertyNames;
+@property (strong, nonatomic, readonly) ZCREasyDough *dough;
+@property (assign, nonatomic, readonly) CFAbsoluteTime postedTime;
+- (NSDictionary *)userInfo;
+@end
+
+
+#pragma mark - ZCREasyDoughNotifier
+
+static ZCREasyDoughNotifier *_ZCRDefaultNotifier = nil;
+
+@implementation ZCREasyDoughNotifier {
+    pthread_mutex_t _lock;
+    NSMutableArray *_pendingUpdates;
+    NSMutableDictionary *_pendingUpdatesByKey;
+    NSUInteger _batchDepth;
+    BOOL _deliversBatch;
+    BOOL _deliveryScheduled;
+    
+    NSUInteger _postedCount;
+    NSUInteger _coalescedCount;
+    NSUInteger _deliveredCount;
+    CFAbsoluteTime _totalLatency;
+    CFAbsoluteTime _maxLatency;
+}
+
++ (instancetype)defaultNotifier {
+    @synchronized(self) {
+        if (!_ZCRDefaultNotifier) {
+            _ZCRDefaultNotifier = [[ZCREasyDoughNotifier alloc] init];
+        }
+        return _ZCRDefaultNotifier;
+    }
+}
+
++ (void)setDefaultNotifier:(ZCREasyDoughNotifier *)notifier {
+    @synchronized(self) {
+        _ZCRDefaultNotifier = notifier;
+    }
+}
+
+- (instancetype)initWithNotificationCenter:(NSNotificationCenter *)notificationCenter
+                             deliveryQueue:(dispatch_queue_t)deliveryQueue
+                        coalescingInterval:(NSTimeInterval)coalescingInterval {
+    if (!(self = [super init])) { return nil; }
+    
+    _notificationCenter = notificationCenter ?: [NSNotificationCenter defaultCenter];
+    _deliveryQueue = deliveryQueue;
+    _coalescingInterval = MAX(coalescingInterval, 0.0);
+    
+    pthread_mutex_init(&_lock, NULL);
+    _pendingUpdates = [NSMutableArray array];
+    _pendingUpdatesByKey = [NSMutableDictionary dictionary];
+    
+    return self;
+}
+
+- (instancetype)init {
+    return [self initWithNotificationCenter:nil deliveryQueue:nil coalescingInterval:0.0];
+}
+
+- (void)dealloc {
+    pthread_mutex_destroy(&_lock);
+}
+
+- (void)postUpdateOfDough:(ZCREasyDough *)dough
+             updatedDough:(ZCREasyDough *)updatedDough
+     changedPropertyNames:(NSSet *)changedPropertyNames {
+    NSParameterAssert(dough);
+    NSParameterAssert(updatedDough);
+    
+    _ZCREasyPendingUpdate *update = nil;
+    BOOL shouldScheduleDelivery = NO;
+    
+    pthread_mutex_lock(&_lock);
+    _postedCount++;
+    
+    if (!_deliveryQueue && _batchDepth == 0) {
+        // Synchronous delivery skips the queue entirely.
+        pthread_mutex_unlock(&_lock);
+        update = [[_ZCREasyPendingUpdate alloc] initWithDough:dough updatedDough:updatedDough
+                                         changedPropertyNames:changedPropertyNames];
+        [self _deliverUpdates:@[update] asBatch:NO];
+        return;
+    }
+    
+    // Updates are coalesced per dough class and identifier, since the identifier alone only
+    // determines uniqueness within a class.
+    id<NSCopying> key = @[[dough class], dough.uniqueIdentifier ?: [NSNull null]];
+    update = _pendingUpdatesByKey[key];
+    if (update) {
+        [update mergeUpdatedDough:updatedDough changedPropertyNames:changedPropertyNames];
+        _coalescedCount++;
+    } else {
+        update = [[_ZCREasyPendingUpdate alloc] initWithDough:dough updatedDough:updatedDough
+                                         changedPropertyNames:changedPropertyNames];
+        _pendingUpdatesByKey[key] = update;
+        [_pendingUpdates addObject:update];
+    }
+    
+    if (_batchDepth == 0 && !_deliveryScheduled) {
+        _deliveryScheduled = YES;
+        shouldScheduleDelivery = YES;
+    }
+    pthread_mutex_unlock(&_lock);
+    
+    if (!shouldScheduleDelivery) { return; }
+    
+    __weak typeof(self) weakSelf = self;
+    dispatch_block_t deliveryBlock = ^{
+        [weakSelf _deliverPendingUpdates];
+    };
+    
+    if (_coalescingInterval > 0.0) {
+        dispatch_time_t deliveryTime = dispatch_time(DISPATCH_TIME_NOW,
+                                                     (int64_t)(_coalescingInterval * NSEC_PER_SEC));
+        dispatch_after(deliveryTime, _deliveryQueue, deliveryBlock);
+    } else {
+        dispatch_async(_deliveryQueue, deliveryBlock);
+    }
+}
+
+- (void)performBatchUpdates:(void (^)(void))block {
+    NSParameterAssert(block);
+    
+    pthread_mutex_lock(&_lock);
+    _batchDepth++;
+    pthread_mutex_unlock(&_lock);
+    
+    @try {
+        block();
+    }
+    @finally {
+        pthread_mutex_lock(&_lock);
+        _batchDepth--;
+        BOOL shouldDeliver = (_batchDepth == 0 && _pendingUpdates.count > 0);
+        if (shouldDeliver) {
+            // Whichever delivery runs next takes the whole batch, including a delivery which was
+            // already scheduled before the batch began.
+            _deliversBatch = YES;
+        }
+        pthread_mutex_unlock(&_lock);
+        
+        if (shouldDeliver) {
+            if (_deliveryQueue) {
+                __weak typeof(self) weakSelf = self;
+                dispatch_async(_deliveryQueue, ^{
+                    [weakSelf _deliverPendingUpdates];
+                });
+            } else {
+                [self _deliverPendingUpdates];
+            }
+        }
+    }
+}
+
+- (void)flush {
+    if (_deliveryQueue) {
+        dispatch_sync(_deliveryQueue, ^{
+            [self _deliverPendingUpdates];
+        });
+    } else {
+        [self _deliverPendingUpdates];
+    }
+}
+
+- (NSDictionary *)statistics {
+    pthread_mutex_lock(&_lock);
+    NSDictionary *statistics = @{ZCREasyDoughNotifierQueueDepthKey: @(_pendingUpdates.count),
+                                 ZCREasyDoughNotifierPostedCountKey: @(_postedCount),
+                                 ZCREasyDoughNotifierCoalescedCountKey: @(_coalescedCount),
+                                 ZCREasyDoughNotifierDeliveredCountKey: @(_deliveredCount),
+                                 ZCREasyDoughNotifierAverageLatencyKey: @((_deliveredCount > 0) ? _totalLatency / _deliveredCount : 0.0),
+                                 ZCREasyDoughNotifierMaxLatencyKey: @(_maxLatency)};
+    pthread_mutex_unlock(&_lock);
+    
+    return statistics;
+}
+
+- (void)resetStatistics {
+    pthread_mutex_lock(&_lock);
+    _postedCount = 0;
+    _coalescedCount = 0;
+    _deliveredCount = 0;
+    _totalLatency = 0.0;
+    _maxLatency = 0.0;
+    pthread_mutex_unlock(&_lock);
+}
+
+
+#pragma mark Delivery
+
+- (void)_deliverPendingUpdates {
+    pthread_mutex_lock(&_lock);
+    _deliveryScheduled = NO;
+    
+    // An open batch will deliver everything once it closes.
+    if (_batchDepth > 0 || _pendingUpdates.count == 0) {
+        pthread_mutex_unlock(&_lock);
+        return;
+    }
+    
+    NSArray *updates = [_pendingUpdates copy];
+    BOOL asBatch = _deliversBatch;
+    [_pendingUpdates removeAllObjects];
+    [_pendingUpdatesByKey removeAllObjects];
+    _deliversBatch = NO;
+    pthread_mutex_unlock(&_lock);
+    
+    [self _deliverUpdates:updates asBatch:asBatch];
+}
+
+- (void)_deliverUpdates:(NSArray *)updates asBatch:(BOOL)asBatch {
+    if (asBatch) {
+        NSMutableArray *updateInfos = [NSMutableArray arrayWithCapacity:updates.count];
+        for (_ZCREasyPendingUpdate *update in updates) {
+            NSMutableDictionary *updateInfo = [[update userInfo] mutableCopy];
+            updateInfo[ZCREasyDoughOriginalDoughKey] = update.dough;
+            [updateInfos addObject:updateInfo];
+        }
+    
+        [_notificationCenter postNotificationName:ZCREasyDoughBatchUpdateNotification object:nil
+                                         userInfo:@{ZCREasyDoughUpdatesKey: updateInfos}];
+    } else {
+        for (_ZCREasyPendingUpdate *update in updates) {
+            NSDictionary *userInfo = [update userInfo];
+            [_notificationCenter postNotificationName:ZCREasyDoughUpdateNotification
+                                               object:update.dough userInfo:userInfo];
+    
+            NSString *classUpdateNotification = [[update.dough class] updateNotificationName];
+            if (classUpdateNotification &&
+                ![classUpdateNotification isEqualToString:ZCREasyDoughUpdateNotification]) {
+                [_notificationCenter postNotificationName:classUpdateNotification
+                                                   object:update.dough userInfo:userInfo];
+            }
+        }
+    }
+    
+    CFAbsoluteTime deliveredTime = CFAbsoluteTimeGetCurrent();
+    
+    pthread_mutex_lock(&_lock);
+    for (_ZCREasyPendingUpdate *update in updates) {
+        CFAbsoluteTime latency = MAX(deliveredTime - update.postedTime, 0.0);
+        _totalLatency += latency;
+        _maxLatency = MAX(_maxLatency, latency);
+    }
+    _deliveredCount += updates.count;
+    pthread_mutex_unlock(&_lock);
+}
+
+@end
+
+
+#pragma mark - _ZCREasyPendingUpdate
+
+@implementation _ZCREasyPendingUpdate {
+    ZCREasyDough *_updatedDough;
+    NSMutableSet *_changedPropertyNames;
+}
+
+- (instancetype)initWithDough:(ZCREasyDough *)dough updatedDough:(ZCREasyDough *)updatedDough
+         changedPropertyNames:(NSSet *)changedPropertyNames {
+    if (!(self = [super init])) { return nil; }
+    
+    _dough = dough;
+    _updatedDough = updatedDough;
+    _changedPropertyNames = (changedPropertyNames) ? [changedPropertyNames mutableCopy] : [NSMutableSet set];
+    _postedTime = CFAbsoluteTimeGetCurrent();
+    
+    return self;
+}
+
+- (void)mergeUpdatedDough:(ZCREasyDough *)updatedDough changedPropertyNames:(NSSet *)changedPropertyNames {
+    // The original dough and posted time are kept, so observers see the whole span of the updates.
+    _updatedDough = updatedDough;
+    if (changedPropertyNames) {
+        [_changedPropertyNames unionSet:changedPropertyNames];
+    }
+}
+
+- (NSDictionary *)userInfo {
+    // Since we don't rely on pointers to determine equality, we pass the identifier and updated
+    // model in the user-info to identify the model.
+    return @{ZCREasyDoughIdentifierKey: [(id)_dough.uniqueIdentifier copy],
+             ZCREasyDoughUpdatedDoughKey: _updatedDough,
+             ZCREasyDoughChangedPropertyNamesKey: [_changedPropertyNames copy]};
+}
+
+@end
@@ -0,0 +1,149 @@
+//
+//  ZCREasyDoughSnapshot.h
+//  ZCREasyBake
+//
+//  Created by Zachary Radke on 10/16/26.
+//  Copyright (c) 2026 Zach Radke. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+@class ZCREasyRecipe;
+
+/**
+ *  ZCREasyDoughSnapshot is a compact binary snapshot of a collection of ZCREasyDough instances,
+ *  designed to be memory mapped and read lazily.
+ *
+ *  The schema of a snapshot comes from a recipe and the dough class's properties: every property in
+ *  the recipe becomes a column. Scalar properties are stored in fixed-width columns of 64-bit
+ *  integers or doubles, and object properties in fixed-width tagged cells. Strings are interned
+ *  into a single string table, so repeated values are only stored once. The identifiers of the
+ *  doughs are stored in their own column. Values are stored after the recipe's transformations
+ *  have been applied, so reading a snapshot never runs the transformers again.
+ *
+ *  Opening a snapshot only validates its header and schema, so it costs the same no matter how many
+ *  doughs it holds. Doughs are materialized when they are first accessed, and kept so that later
+ *  accesses return the same instance. Strings are decoded once and shared between doughs.
+ *
+ *  Object values may be NSStrings, NSNumbers, NSDates, NSData, or any other object supporting
+ *  NSSecureCoding, which are archived. Archives are decoded securely, and may only contain the
+ *  class of their property along with Foundation's collection and value classes. Snapshots are stored in the byte order of the device which wrote
+ *  them and can't be read on a device with a different byte order.
+ *
+ *  Snapshots are immutable and thread-safe.
+ */
+@interface ZCREasyDoughSnapshot : NSObject
+
+/**
+ *  @name Writing snapshots
+ */
+
+/**
+ *  Encodes doughs into snapshot data.
+ *
+ *  @param doughs     The doughs to encode, in the order they should be read. These must all be
+ *                    instances of the dough class. This must not be nil.
+ *  @param doughClass The ZCREasyDough subclass whose properties describe the columns. This must not
+ *                    be nil.
+ *  @param recipe     The recipe whose property names choose the columns. If nil, the dough class's
+ *                    genericRecipe is used.
+ *  @param error      An error pointer which will be populated if the doughs can't be encoded.
+ *
+ *  @return The snapshot data, or nil if an error occurred.
+ */
++ (NSData *)dataWithDoughs:(NSArray *)doughs
+                doughClass:(Class)doughClass
+                    recipe:(ZCREasyRecipe *)recipe
+                     error:(NSError **)error __attribute__((nonnull (1,2)));
+
+/**
+ *  Encodes doughs into snapshot data and atomically writes it to a file.
+ *
+ *  @see dataWithDoughs:doughClass:recipe:error:
+ *
+ *  @return YES if the snapshot was written, NO if an error occurred.
+ */
++ (BOOL)writeDoughs:(NSArray *)doughs
+         doughClass:(Class)doughClass
+             recipe:(ZCREasyRecipe *)recipe
+              toURL:(NSURL *)URL
+              error:(NSError **)error __attribute__((nonnull (1,2,4)));
+
+
+/**
+ *  @name Reading snapshots
+ */
+
+/**
+ *  Designated initializer for this class. This validates the snapshot's header and schema, but
+ *  doesn't read any of its records.
+ *
+ *  @param data       The snapshot data. This is retained, and should be memory mapped for large
+ *                    snapshots. This must not be nil.
+ *  @param doughClass The ZCREasyDough subclass to materialize. It must have a compatible property
+ *                    for every column in the snapshot. This must not be nil.
+ *  @param error      An error pointer which will be populated if the snapshot is invalid.
+ *
+ *  @return A new snapshot, or nil if an error occurred.
+ */
+- (instancetype)initWithData:(NSData *)data doughClass:(Class)doughClass
+                       error:(NSError **)error __attribute__((nonnull (1,2)));
+
+/**
+ *  Memory maps a snapshot file and opens it.
+ *
+ *  @see initWithData:doughClass:error:
+ *
+ *  @return A new snapshot, or nil if the file couldn't be mapped or the snapshot is invalid.
+ */
+- (instancetype)initWithContentsOfURL:(NSURL *)URL doughClass:(Class)doughClass
+                                error:(NSError **)error __attribute__((nonnull (1,2)));
+
+/**
+ *  The ZCREasyDough subclass which is materialized.
+ */
+@property (assign, nonatomic, readonly) Class doughClass;
+
+/**
+ *  The number of doughs in the snapshot.
+ */
+@property (assign, nonatomic, readonly) NSUInteger count;
+
+/**
+ *  The names of the properties stored in the snapshot, in column order.
+ */
+@property (strong, nonatomic, readonly) NSArray *propertyNames;
+
+/**
+ *  The number of doughs which have been materialized so far.
+ */
+@property (assign, nonatomic, readonly) NSUInteger materializedCount;
+
+/**
+ *  Reads the identifier of a dough without materializing it.
+ *
+ *  @param index The index of the dough. This must be less than count.
+ *
+ *  @return The identifier, or nil if it couldn't be read.
+ */
+- (id)identifierAtIndex:(NSUInteger)index;
+
+/**
+ *  Returns the dough at an index, materializing it if it hasn't been accessed before.
+ *
+ *  @param index The index of the dough.
+ *  @param error An error pointer which will be populated if the dough can't be materialized.
+ *
+ *  @return The dough, or nil if the index is out of bounds or an error occurred.
+ */
+- (id)doughAtIndex:(NSUInteger)index error:(NSError **)error;
+
+/**
+ *  Subscripting support for doughAtIndex:error:. Like NSArray, this raises an NSRangeException if
+ *  the index is out of bounds.
+ *
+ *  @return The dough, or nil if it couldn't be materialized.
+ */
+- (id)objectAtIndexedSubscript:(NSUInteger)index;
+
+@end
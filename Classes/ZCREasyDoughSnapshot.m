@@ -0,0 +1,859 @@
+//
+//  ZCREasyDoughSnapshot.m
+//  ZCREasyBake
+//
+//  Created by Zachary Radke on 10/16/26.
+//  Copyright (c) 2026 Zach Radke. All rights reserved.
+//
+
+#import "ZCREasyDoughSnapshot.h"
+
+#import "ZCREasyDough.h"
+#import "ZCREasyError.h"
+#import "ZCREasyProperty.h"
+
+#import <pthread.h>
+
+#pragma mark - Snapshot format
+
+/*
+ *  A snapshot is laid out as follows, with every section aligned to 8 bytes:
+ *
+ *  - The header.
+ *  - The schema, a JSON array describing each column's property name, kind, and offset.
+ *  - The identifiers column, one tagged cell per record.
+ *  - The property columns. Each column stores one fixed-width value per record, so a record's value
+ *    is found at the column offset plus the record index times the column width.
+ *  - The string table, followed by the blob table. Each table is an array of count + 1 offsets into
+ *    the table's bytes, followed by the bytes themselves.
+ */
+
+static const char _ZCRSnapshotMagic[8] = {'Z', 'C', 'R', 'S', 'N', 'A', 'P', '\0'};
+static const uint32_t _ZCRSnapshotVersion = 1;
+static const uint32_t _ZCRSnapshotByteOrderMark = 0x01020304;
+
+static NSString *const _ZCRSnapshotNameKey = @"name";
+static NSString *const _ZCRSnapshotKindKey = @"kind";
+static NSString *const _ZCRSnapshotOffsetKey = @"offset";
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrderMark;
+    uint64_t recordCount;
+    uint64_t schemaOffset;
+    uint64_t schemaLength;
+    uint64_t identifiersOffset;
+    uint64_t stringsOffset;
+    uint64_t stringCount;
+    uint64_t blobsOffset;
+    uint64_t blobCount;
+} _ZCRSnapshotHeader;
+
+typedef NS_ENUM(uint8_t, _ZCRSnapshotColumnKind) {
+    _ZCRSnapshotColumnUnsupported = 0,
+    _ZCRSnapshotColumnInteger,
+    _ZCRSnapshotColumnUnsigned,
+    _ZCRSnapshotColumnDouble,
+    _ZCRSnapshotColumnObject
+};
+
+typedef NS_ENUM(uint8_t, _ZCRSnapshotTag) {
+    _ZCRSnapshotTagNil = 0,
+    _ZCRSnapshotTagInteger,
+    _ZCRSnapshotTagUnsigned,
+    _ZCRSnapshotTagDouble,
+    _ZCRSnapshotTagBool,
+    _ZCRSnapshotTagString,
+    _ZCRSnapshotTagDate,
+    _ZCRSnapshotTagData,
+    _ZCRSnapshotTagArchive
+};
+
+/**
+ *  The fixed-width encoding of an object. The payload is interpreted according to the tag, and
+ *  holds the table index for strings, data, and archives.
+ */
+typedef struct {
+    uint8_t tag;
+    uint8_t reserved[7];
+    union {
+        int64_t integer;
+        uint64_t unsignedInteger;
+        double real;
+    } payload;
+} _ZCRSnapshotCell;
+
+typedef struct {
+    _ZCRSnapshotColumnKind kind;
+    uint64_t offset;
+} _ZCRSnapshotColumn;
+
+static inline uint64_t _ZCRSnapshotAlign(uint64_t length) {
+    return (length + 7) & ~(uint64_t)7;
+}
+
+static inline size_t _ZCRSnapshotColumnWidth(_ZCRSnapshotColumnKind kind) {
+    return (kind == _ZCRSnapshotColumnObject) ? sizeof(_ZCRSnapshotCell) : sizeof(uint64_t);
+}
+
+static inline BOOL _ZCRSnapshotRangeIsValid(uint64_t offset, uint64_t count, uint64_t width,
+                                            uint64_t dataLength) {
+    if (offset > dataLength) { return NO; }
+    return (width == 0) || (count <= (dataLength - offset) / width);
+}
+
+static _ZCRSnapshotColumnKind _ZCRSnapshotKindForProperty(ZCREasyProperty *property) {
+    if (property.isObject) { return _ZCRSnapshotColumnObject; }
+    if ([property.type length] != 1) { return _ZCRSnapshotColumnUnsupported; }
+    
+    switch ([property.type characterAtIndex:0]) {
+        case 'c':
+        case 's':
+        case 'i':
+        case 'l':
+        case 'q':
+        case 'B':
+            return _ZCRSnapshotColumnInteger;
+        case 'C':
+        case 'S':
+        case 'I':
+        case 'L':
+        case 'Q':
+            return _ZCRSnapshotColumnUnsigned;
+        case 'f':
+        case 'd':
+            return _ZCRSnapshotColumnDouble;
+        default:
+            return _ZCRSnapshotColumnUnsupported;
+    }
+}
+
+// The classes any archived value may contain, on top of the class of the property it's stored for.
+static NSSet *_ZCRSnapshotArchiveClasses(void) {
+    static NSSet *archiveClasses;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        archiveClasses = [NSSet setWithObjects:[NSArray class], [NSDictionary class], [NSSet class],
+                          [NSOrderedSet class], [NSString class], [NSNumber class], [NSDate class],
+                          [NSData class], [NSNull class], [NSUUID class], [NSURL class], nil];
+    });
+    return archiveClasses;
+}
+
+
+#pragma mark - _ZCREasySnapshotTable
+
+/**
+ *  Collects the entries of a string or blob table while a snapshot is written. Strings are interned
+ *  so that repeated values share one entry.
+ */
+@interface _ZCREasySnapshotTable : NSObject
+- (uint64_t)indexOfString:(NSString *)string;
+- (uint64_t)indexOfData:(NSData *)data;
+@property (assign, nonatomic, readonly) uint64_t count;
+- (void)appendToData:(NSMutableData *)data;
+@end
+
+@implementation _ZCREasySnapshotTable {
+    NSMutableDictionary *_stringIndexes;
+    NSMutableData *_offsets;
+    NSMutableData *_bytes;
+}
+
+- (instancetype)init {
+    if (!(self = [super init])) { return nil; }
+    
+    _stringIndexes = [NSMutableDictionary dictionary];
+    _offsets = [NSMutableData dataWithLength:sizeof(uint64_t)];
+    _bytes = [NSMutableData data];
+    
+    return self;
+}
+
+- (uint64_t)indexOfString:(NSString *)string {
+    NSNumber *index = _stringIndexes[string];
+    if (index) { return [index unsignedLongLongValue]; }
+    
+    uint64_t newIndex = [self indexOfData:[string dataUsingEncoding:NSUTF8StringEncoding]];
+    _stringIndexes[[string copy]] = @(newIndex);
+    return newIndex;
+}
+
+- (uint64_t)indexOfData:(NSData *)data {
+    uint64_t index = _count++;
+    [_bytes appendData:data];
+    
+    uint64_t endOffset = [_bytes length];
+    [_offsets appendBytes:&endOffset length:sizeof(endOffset)];
+    
+    return index;
+}
+
+- (void)appendToData:(NSMutableData *)data {
+    [data appendData:_offsets];
+    [data appendData:_bytes];
+    [data increaseLengthBy:_ZCRSnapshotAlign([data length]) - [data length]];
+}
+
+@end
+
+
+#pragma mark - ZCREasyDoughSnapshot
+
+@implementation ZCREasyDoughSnapshot {
+    NSData *_data;
+    const uint8_t *_bytes;
+    _ZCRSnapshotHeader _header;
+    _ZCRSnapshotColumn *_columns;
+    NSArray *_columnArchiveClasses;
+    ZCREasyRecipe *_materializationRecipe;
+    
+    pthread_mutex_t _lock;
+    __strong id *_doughs;
+    __strong NSString **_strings;
+    NSMutableIndexSet *_materializedIndexes;
+    NSMutableIndexSet *_decodedStringIndexes;
+}
+
+#pragma mark Writing
+
++ (NSData *)dataWithDoughs:(NSArray *)doughs
+                doughClass:(Class)doughClass
+                    recipe:(ZCREasyRecipe *)recipe
+                     error:(NSError *__autoreleasing *)error {
+    NSParameterAssert(doughs);
+    NSParameterAssert(doughClass);
+    NSAssert([doughClass isSubclassOfClass:[ZCREasyDough class]], @"Snapshot class must be a subclass of ZCREasyDough.");
+    
+    recipe = recipe ?: [doughClass genericRecipe];
+    
+    NSMutableDictionary *properties = [NSMutableDictionary dictionary];
+    [doughClass enumeratePropertiesWith:^(ZCREasyProperty *property, BOOL *shouldStop) {
+        properties[property.name] = property;
+    }];
+    
+    // Columns are sorted by name so equal recipes always produce the same layout.
+    NSArray *propertyNames = [[recipe.propertyNames allObjects] sortedArrayUsingSelector:@selector(compare:)];
+    NSUInteger columnCount = [propertyNames count];
+    _ZCRSnapshotColumnKind kinds[MAX(columnCount, 1)];
+    
+    for (NSUInteger column = 0; column < columnCount; column++) {
+        ZCREasyProperty *property = properties[propertyNames[column]];
+        kinds[column] = property ? _ZCRSnapshotKindForProperty(property) : _ZCRSnapshotColumnUnsupported;
+        if (kinds[column] == _ZCRSnapshotColumnUnsupported) {
+            if (error) {
+                *error = ZCREasyBakeParameterError(@"Property (%@) of class (%@) can't be stored in a snapshot.",
+                                                   propertyNames[column], NSStringFromClass(doughClass));
+            }
+            return nil;
+        }
+    }
+    
+    uint64_t recordCount = [doughs count];
+    _ZCREasySnapshotTable *strings = [[_ZCREasySnapshotTable alloc] init];
+    _ZCREasySnapshotTable *blobs = [[_ZCREasySnapshotTable alloc] init];
+    NSMutableData *identifiers = [NSMutableData dataWithLength:recordCount * sizeof(_ZCRSnapshotCell)];
+    NSMutableArray *columnData = [NSMutableArray arrayWithCapacity:columnCount];
+    for (NSUInteger column = 0; column < columnCount; column++) {
+        [columnData addObject:[NSMutableData dataWithLength:recordCount * _ZCRSnapshotColumnWidth(kinds[column])]];
+    }
+    
+    @try {
+        _ZCRSnapshotCell *identifierCells = [identifiers mutableBytes];
+        uint64_t record = 0;
+        for (ZCREasyDough *dough in doughs) {
+            if (![dough isKindOfClass:doughClass]) {
+                if (error) {
+                    *error = ZCREasyBakeParameterError(@"Object (%@) at index %llu is not a %@.", dough,
+                                                       record, NSStringFromClass(doughClass));
+                }
+                return nil;
+            }
+    
+            if (![self _encodeObject:dough.uniqueIdentifier intoCell:&identifierCells[record]
+                             strings:strings blobs:blobs]) {
+                if (error) {
+                    *error = ZCREasyBakeParameterError(@"Identifier (%@) at index %llu can't be stored in a snapshot.",
+                                                       dough.uniqueIdentifier, record);
+                }
+                return nil;
+            }
+    
+            for (NSUInteger column = 0; column < columnCount; column++) {
+                id value = [dough valueForKey:propertyNames[column]];
+                void *bytes = [columnData[column] mutableBytes];
+    
+                switch (kinds[column]) {
+                    case _ZCRSnapshotColumnInteger:
+                        ((int64_t *)bytes)[record] = [value longLongValue];
+                        break;
+                    case _ZCRSnapshotColumnUnsigned:
+                        ((uint64_t *)bytes)[record] = [value unsignedLongLongValue];
+                        break;
+                    case _ZCRSnapshotColumnDouble:
+                        ((double *)bytes)[record] = [value doubleValue];
+                        break;
+                    default:
+                        if (![self _encodeObject:value intoCell:&((_ZCRSnapshotCell *)bytes)[record]
+                                         strings:strings blobs:blobs]) {
+                            if (error) {
+                                *error = ZCREasyBakeParameterError(@"Value (%@) for property (%@) at index %llu can't be stored in a snapshot.",
+                                                                   value, propertyNames[column], record);
+                            }
+                            return nil;
+                        }
+                        break;
+                }
+            }
+            record++;
+        }
+    }
+    @catch (NSException *exception) {
+        if (error) {
+            *error = ZCREasyBakeExceptionError(exception);
+        }
+        return nil;
+    }
+    
+    // With every section's size known, the offsets can be laid out before anything is written.
+    _ZCRSnapshotHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, _ZCRSnapshotMagic, sizeof(header.magic));
+    header.version = _ZCRSnapshotVersion;
+    header.byteOrderMark = _ZCRSnapshotByteOrderMark;
+    header.recordCount = recordCount;
+    header.schemaOffset = _ZCRSnapshotAlign(sizeof(header));
+    
+    NSMutableArray *schema = [NSMutableArray arrayWithCapacity:columnCount];
+    uint64_t columnOffset = 0;
+    for (NSUInteger column = 0; column < columnCount; column++) {
+        [schema addObject:@{_ZCRSnapshotNameKey: propertyNames[column],
+                            _ZCRSnapshotKindKey: @(kinds[column]),
+                            _ZCRSnapshotOffsetKey: @(columnOffset)}];
+        columnOffset += _ZCRSnapshotAlign([columnData[column] length]);
+    }
+    NSData *schemaData = [NSJSONSerialization dataWithJSONObject:schema options:0 error:error];
+    if (!schemaData) { return nil; }
+    
+    header.schemaLength = [schemaData length];
+    header.identifiersOffset = _ZCRSnapshotAlign(header.schemaOffset + header.schemaLength);
+    uint64_t columnsOffset = _ZCRSnapshotAlign(header.identifiersOffset + [identifiers length]);
+    header.stringsOffset = columnsOffset + columnOffset;
+    header.stringCount = strings.count;
+    
+    NSMutableData *data = [NSMutableData dataWithCapacity:(NSUInteger)header.stringsOffset];
+    [data appendBytes:&header length:sizeof(header)];
+    [data setLength:(NSUInteger)header.schemaOffset];
+    [data appendData:schemaData];
+    [data setLength:(NSUInteger)header.identifiersOffset];
+    [data appendData:identifiers];
+    [data setLength:(NSUInteger)columnsOffset];
+    for (NSMutableData *column in columnData) {
+        [data appendData:column];
+        [data setLength:(NSUInteger)_ZCRSnapshotAlign([data length])];
+    }
+    [strings appendToData:data];
+    
+    // The blob table's position is only known once the strings are written, so it is patched in.
+    header.blobsOffset = [data length];
+    header.blobCount = blobs.count;
+    [blobs appendToData:data];
+    [data replaceBytesInRange:NSMakeRange(0, sizeof(header)) withBytes:&header];
+    
+    return [data copy];
+}
+
++ (BOOL)writeDoughs:(NSArray *)doughs
+         doughClass:(Class)doughClass
+             recipe:(ZCREasyRecipe *)recipe
+              toURL:(NSURL *)URL
+              error:(NSError *__autoreleasing *)error {
+    NSParameterAssert(URL);
+    
+    NSData *data = [self dataWithDoughs:doughs doughClass:doughClass recipe:recipe error:error];
+    if (!data) { return NO; }
+    
+    return [data writeToURL:URL options:NSDataWritingAtomic error:error];
+}
+
+
+#pragma mark Reading
+
+- (instancetype)initWithData:(NSData *)data doughClass:(Class)doughClass
+                       error:(NSError *__autoreleasing *)error {
+    NSParameterAssert(data);
+    NSParameterAssert(doughClass);
+    NSAssert([doughClass isSubclassOfClass:[ZCREasyDough class]], @"Snapshot class must be a subclass of ZCREasyDough.");
+    
+    if (!(self = [super init])) { return nil; }
+    
+    _data = data;
+    _bytes = [data bytes];
+    _doughClass = doughClass;
+    pthread_mutex_init(&_lock, NULL);
+    _materializedIndexes = [NSMutableIndexSet indexSet];
+    _decodedStringIndexes = [NSMutableIndexSet indexSet];
+    
+    if (![self _readHeader:error] || ![self _readSchema:error]) { return nil; }
+    
+    // Every record is allocated a pointer up front, but the zeroed pages are only committed once a
+    // dough near them is materialized.
+    _doughs = (__strong id *)calloc(MAX(_count, 1), sizeof(id));
+    _strings = (__strong NSString **)calloc(MAX(_header.stringCount, 1), sizeof(NSString *));
+    
+    return self;
+}
+
+- (instancetype)initWithContentsOfURL:(NSURL *)URL doughClass:(Class)doughClass
+                                error:(NSError *__autoreleasing *)error {
+    NSParameterAssert(URL);
+    
+    NSData *data = [NSData dataWithContentsOfURL:URL options:NSDataReadingMappedAlways error:error];
+    if (!data) { return nil; }
+    
+    return [self initWithData:data doughClass:doughClass error:error];
+}
+
+- (instancetype)init {
+    [NSException raise:NSInternalInconsistencyException format:@"Please use the designated initializer for this class."];
+    return nil;
+}
+
+- (void)dealloc {
+    // Only the pointers which were ever set need releasing, which avoids touching the whole buffer.
+    __strong id *doughs = _doughs;
+    if (doughs) {
+        [_materializedIndexes enumerateIndexesUsingBlock:^(NSUInteger index, BOOL *stop) {
+            doughs[index] = nil;
+        }];
+        free(doughs);
+    }
+    __strong NSString **strings = _strings;
+    if (strings) {
+        [_decodedStringIndexes enumerateIndexesUsingBlock:^(NSUInteger index, BOOL *stop) {
+            strings[index] = nil;
+        }];
+        free(strings);
+    }
+    free(_columns);
+    pthread_mutex_destroy(&_lock);
+}
+
+- (NSUInteger)materializedCount {
+    pthread_mutex_lock(&_lock);
+    NSUInteger materializedCount = [_materializedIndexes count];
+    pthread_mutex_unlock(&_lock);
+    return materializedCount;
+}
+
+- (id)identifierAtIndex:(NSUInteger)index {
+    if (index >= _count) { return nil; }
+    
+    return [self _objectForCellAtOffset:_header.identifiersOffset + index * sizeof(_ZCRSnapshotCell)
+                         archiveClasses:_ZCRSnapshotArchiveClasses() error:NULL];
+}
+
+- (id)doughAtIndex:(NSUInteger)index error:(NSError *__autoreleasing *)error {
+    if (index >= _count) {
+        if (error) {
+            *error = ZCREasyBakeParameterError(@"Index %lu is beyond the snapshot's %lu doughs.",
+                                               (unsigned long)index, (unsigned long)_count);
+        }
+        return nil;
+    }
+    
+    pthread_mutex_lock(&_lock);
+    id dough = _doughs[index];
+    pthread_mutex_unlock(&_lock);
+    if (dough) { return dough; }
+    
+    // Materializing happens outside the lock so that unrelated doughs can be read concurrently. If
+    // two threads race to the same dough, the first one stored wins.
+    dough = [self _materializeDoughAtIndex:index error:error];
+    if (!dough) { return nil; }
+    
+    pthread_mutex_lock(&_lock);
+    if (_doughs[index]) {
+        dough = _doughs[index];
+    } else {
+        _doughs[index] = dough;
+        [_materializedIndexes addIndex:index];
+    }
+    pthread_mutex_unlock(&_lock);
+    
+    return dough;
+}
+
+- (id)objectAtIndexedSubscript:(NSUInteger)index {
+    if (index >= _count) {
+        [NSException raise:NSRangeException format:@"Index %lu is beyond the snapshot's %lu doughs.",
+         (unsigned long)index, (unsigned long)_count];
+    }
+    
+    return [self doughAtIndex:index error:NULL];
+}
+
+
+#pragma mark NSObject
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"<%@:%p> class:%@ count:%lu materialized:%lu properties:%@",
+            NSStringFromClass([self class]), self, NSStringFromClass(_doughClass),
+            (unsigned long)_count, (unsigned long)self.materializedCount, _propertyNames];
+}
+
+
+#pragma mark Private utilities
+
++ (BOOL)_encodeObject:(id)value intoCell:(_ZCRSnapshotCell *)cell
+              strings:(_ZCREasySnapshotTable *)strings blobs:(_ZCREasySnapshotTable *)blobs {
+    memset(cell, 0, sizeof(*cell));
+    
+    if (!value || value == [NSNull null]) {
+        cell->tag = _ZCRSnapshotTagNil;
+    } else if ([value isKindOfClass:[NSString class]]) {
+        cell->tag = _ZCRSnapshotTagString;
+        cell->payload.unsignedInteger = [strings indexOfString:value];
+    } else if ([value isKindOfClass:[NSNumber class]] && ![value isKindOfClass:[NSDecimalNumber class]]) {
+        const char *type = [value objCType];
+        if (CFGetTypeID((__bridge CFTypeRef)value) == CFBooleanGetTypeID()) {
+            cell->tag = _ZCRSnapshotTagBool;
+            cell->payload.integer = [value boolValue];
+        } else if (type[0] == 'f' || type[0] == 'd') {
+            cell->tag = _ZCRSnapshotTagDouble;
+            cell->payload.real = [value doubleValue];
+        } else if (type[0] == 'Q') {
+            cell->tag = _ZCRSnapshotTagUnsigned;
+            cell->payload.unsignedInteger = [value unsignedLongLongValue];
+        } else {
+            cell->tag = _ZCRSnapshotTagInteger;
+            cell->payload.integer = [value longLongValue];
+        }
+    } else if ([value isKindOfClass:[NSDate class]]) {
+        cell->tag = _ZCRSnapshotTagDate;
+        cell->payload.real = [value timeIntervalSinceReferenceDate];
+    } else if ([value isKindOfClass:[NSData class]]) {
+        cell->tag = _ZCRSnapshotTagData;
+        cell->payload.unsignedInteger = [blobs indexOfData:value];
+    } else if ([value conformsToProtocol:@protocol(NSSecureCoding)] && [[value class] supportsSecureCoding]) {
+        // Archives are decoded securely, so only objects which support secure coding are written.
+        NSMutableData *archive = [NSMutableData data];
+        NSKeyedArchiver *archiver = [[NSKeyedArchiver alloc] initForWritingWithMutableData:archive];
+        archiver.requiresSecureCoding = YES;
+        @try {
+            [archiver encodeObject:value forKey:NSKeyedArchiveRootObjectKey];
+            [archiver finishEncoding];
+        }
+        @catch (NSException *exception) {
+            return NO;
+        }
+    
+        cell->tag = _ZCRSnapshotTagArchive;
+        cell->payload.unsignedInteger = [blobs indexOfData:archive];
+    } else {
+        return NO;
+    }
+    
+    return YES;
+}
+
+- (BOOL)_readHeader:(NSError *__autoreleasing *)error {
+    uint64_t dataLength = [_data length];
+    
+    if (dataLength < sizeof(_ZCRSnapshotHeader)) {
+        if (error) {
+            *error = ZCREasyBakeParameterError(@"The snapshot data is too short to be a snapshot.");
+        }
+        return NO;
+    }
+    
+    memcpy(&_header, _bytes, sizeof(_header));
+    
+    if (memcmp(_header.magic, _ZCRSnapshotMagic, sizeof(_header.magic)) != 0) {
+        if (error) {
+            *error = ZCREasyBakeParameterError(@"The data is not a snapshot.");
+        }
+        return NO;
+    }
+    
+    if (_header.byteOrderMark != _ZCRSnapshotByteOrderMark) {
+        if (error) {
+            *error = ZCREasyBakeParameterError(@"The snapshot was written with a different byte order.");
+        }
+        return NO;
+    }
+    
+    if (_header.version != _ZCRSnapshotVersion) {
+        if (error) {
+            *error = ZCREasyBakeParameterError(@"Snapshot version %u is not supported.", _header.version);
+        }
+        return NO;
+    }
+    
+    BOOL isValid = (_header.recordCount <= NSUIntegerMax &&
+                    _ZCRSnapshotRangeIsValid(_header.schemaOffset, _header.schemaLength, 1, dataLength) &&
+                    _ZCRSnapshotRangeIsValid(_header.identifiersOffset, _header.recordCount, sizeof(_ZCRSnapshotCell), dataLength) &&
+                    _header.stringCount < UINT64_MAX && _header.blobCount < UINT64_MAX &&
+                    _ZCRSnapshotRangeIsValid(_header.stringsOffset, _header.stringCount + 1, sizeof(uint64_t), dataLength) &&
+                    _ZCRSnapshotRangeIsValid(_header.blobsOffset, _header.blobCount + 1, sizeof(uint64_t), dataLength));
+    if (!isValid) {
+        if (error) {
+            *error = ZCREasyBakeParameterError(@"The snapshot's sections are out of bounds.");
+        }
+        return NO;
+    }
+    
+    _count = (NSUInteger)_header.recordCount;
+    return YES;
+}
+
+- (BOOL)_readSchema:(NSError *__autoreleasing *)error {
+    NSData *schemaData = [_data subdataWithRange:NSMakeRange((NSUInteger)_header.schemaOffset,
+                                                             (NSUInteger)_header.schemaLength)];
+    NSArray *schema = [NSJSONSerialization JSONObjectWithData:schemaData options:0 error:NULL];
+    if (![schema isKindOfClass:[NSArray class]]) {
+        if (error) {
+            *error = ZCREasyBakeParameterError(@"The snapshot's schema is invalid.");
+        }
+        return NO;
+    }
+    
+    NSMutableDictionary *properties = [NSMutableDictionary dictionary];
+    [_doughClass enumeratePropertiesWith:^(ZCREasyProperty *property, BOOL *shouldStop) {
+        properties[property.name] = property;
+    }];
+    
+    uint64_t dataLength = [_data length];
+    uint64_t columnsOffset = _ZCRSnapshotAlign(_header.identifiersOffset + _header.recordCount * sizeof(_ZCRSnapshotCell));
+    NSMutableArray *propertyNames = [NSMutableArray arrayWithCapacity:[schema count]];
+    NSMutableArray *columnArchiveClasses = [NSMutableArray arrayWithCapacity:[schema count]];
+    _columns = calloc(MAX([schema count], 1), sizeof(_ZCRSnapshotColumn));
+    
+    NSUInteger column = 0;
+    for (NSDictionary *columnSchema in schema) {
+        NSString *propertyName = [columnSchema isKindOfClass:[NSDictionary class]] ? columnSchema[_ZCRSnapshotNameKey] : nil;
+        NSNumber *kind = [columnSchema isKindOfClass:[NSDictionary class]] ? columnSchema[_ZCRSnapshotKindKey] : nil;
+        NSNumber *offset = [columnSchema isKindOfClass:[NSDictionary class]] ? columnSchema[_ZCRSnapshotOffsetKey] : nil;
+    
+        if (![propertyName isKindOfClass:[NSString class]] || ![kind isKindOfClass:[NSNumber class]] ||
+            ![offset isKindOfClass:[NSNumber class]] || [offset unsignedLongLongValue] > dataLength ||
+            [kind integerValue] <= _ZCRSnapshotColumnUnsupported || [kind integerValue] > _ZCRSnapshotColumnObject) {
+            if (error) {
+                *error = ZCREasyBakeParameterError(@"The snapshot's schema is invalid.");
+            }
+            return NO;
+        }
+    
+        _columns[column].kind = (_ZCRSnapshotColumnKind)[kind integerValue];
+        _columns[column].offset = columnsOffset + [offset unsignedLongLongValue];
+        if (!_ZCRSnapshotRangeIsValid(_columns[column].offset, _header.recordCount,
+                                      _ZCRSnapshotColumnWidth(_columns[column].kind), dataLength)) {
+            if (error) {
+                *error = ZCREasyBakeParameterError(@"The snapshot's column for property (%@) is out of bounds.", propertyName);
+            }
+            return NO;
+        }
+    
+        // Scalars and objects are encoded differently, so a column must match its property's kind.
+        ZCREasyProperty *property = properties[propertyName];
+        _ZCRSnapshotColumnKind propertyKind = property ? _ZCRSnapshotKindForProperty(property) : _ZCRSnapshotColumnUnsupported;
+        BOOL isCompatible = (propertyKind == _ZCRSnapshotColumnObject) == (_columns[column].kind == _ZCRSnapshotColumnObject);
+        if (propertyKind == _ZCRSnapshotColumnUnsupported || !isCompatible) {
+            if (error) {
+                *error = ZCREasyBakeParameterError(@"Class (%@) has no compatible property for the snapshot's column (%@).",
+                                                   NSStringFromClass(_doughClass), propertyName);
+            }
+            return NO;
+        }
+    
+        // Archived values are only decoded as the property's class or a Foundation value class.
+        NSSet *archiveClasses = _ZCRSnapshotArchiveClasses();
+        if (property.typeClass) {
+            archiveClasses = [archiveClasses setByAddingObject:property.typeClass];
+        }
+    
+        [propertyNames addObject:propertyName];
+        [columnArchiveClasses addObject:archiveClasses];
+        column++;
+    }
+    
+    _propertyNames = [propertyNames copy];
+    _columnArchiveClasses = [columnArchiveClasses copy];
+    _materializationRecipe = [ZCREasyRecipe makeWith:^(id<ZCREasyRecipeMaker> recipeMaker) {
+        recipeMaker.ingredientMapping = [NSDictionary dictionaryWithObjects:propertyNames forKeys:propertyNames];
+    }];
+    
+    return YES;
+}
+
+- (id)_materializeDoughAtIndex:(NSUInteger)index error:(NSError *__autoreleasing *)error {
+    NSError *cellError;
+    id identifier = [self _objectForCellAtOffset:_header.identifiersOffset + index * sizeof(_ZCRSnapshotCell)
+                                  archiveClasses:_ZCRSnapshotArchiveClasses() error:&cellError];
+    if (!identifier) {
+        if (error) {
+            *error = cellError ?: ZCREasyBakeParameterError(@"The dough at index %lu has no identifier.", (unsigned long)index);
+        }
+        return nil;
+    }
+    
+    NSUInteger columnCount = [_propertyNames count];
+    NSMutableDictionary *ingredients = [NSMutableDictionary dictionaryWithCapacity:columnCount];
+    
+    for (NSUInteger column = 0; column < columnCount; column++) {
+        _ZCRSnapshotColumn columnInfo = _columns[column];
+        uint64_t offset = columnInfo.offset + index * _ZCRSnapshotColumnWidth(columnInfo.kind);
+        id value = nil;
+    
+        switch (columnInfo.kind) {
+            case _ZCRSnapshotColumnInteger: {
+                int64_t integer;
+                memcpy(&integer, _bytes + offset, sizeof(integer));
+                value = @(integer);
+                break;
+            }
+            case _ZCRSnapshotColumnUnsigned: {
+                uint64_t unsignedInteger;
+                memcpy(&unsignedInteger, _bytes + offset, sizeof(unsignedInteger));
+                value = @(unsignedInteger);
+                break;
+            }
+            case _ZCRSnapshotColumnDouble: {
+                double real;
+                memcpy(&real, _bytes + offset, sizeof(real));
+                value = @(real);
+                break;
+            }
+            default:
+                cellError = nil;
+                value = [self _objectForCellAtOffset:offset archiveClasses:_columnArchiveClasses[column]
+                                               error:&cellError];
+                if (cellError) {
+                    if (error) {
+                        *error = cellError;
+                    }
+                    return nil;
+                }
+                break;
+        }
+    
+        // Missing ingredients are left unset, which leaves nil object properties nil.
+        if (value) {
+            ingredients[_propertyNames[column]] = value;
+        }
+    }
+    
+    return [[_doughClass alloc] initWithIdentifier:identifier ingredients:ingredients
+                                            recipe:_materializationRecipe error:error];
+}
+
+- (id)_objectForCellAtOffset:(uint64_t)offset archiveClasses:(NSSet *)archiveClasses
+                       error:(NSError *__autoreleasing *)error {
+    _ZCRSnapshotCell cell;
+    memcpy(&cell, _bytes + offset, sizeof(cell));
+    
+    switch ((_ZCRSnapshotTag)cell.tag) {
+        case _ZCRSnapshotTagNil:
+            return nil;
+        case _ZCRSnapshotTagInteger:
+            return @(cell.payload.integer);
+        case _ZCRSnapshotTagUnsigned:
+            return @(cell.payload.unsignedInteger);
+        case _ZCRSnapshotTagDouble:
+            return @(cell.payload.real);
+        case _ZCRSnapshotTagBool:
+            return [NSNumber numberWithBool:(cell.payload.integer != 0)];
+        case _ZCRSnapshotTagDate:
+            return [NSDate dateWithTimeIntervalSinceReferenceDate:cell.payload.real];
+        case _ZCRSnapshotTagString:
+            return [self _stringAtIndex:cell.payload.unsignedInteger error:error];
+        case _ZCRSnapshotTagData:
+        case _ZCRSnapshotTagArchive: {
+            NSData *data = [self _dataInTableAtOffset:_header.blobsOffset count:_header.blobCount
+                                                index:cell.payload.unsignedInteger error:error];
+            if (!data || cell.tag == _ZCRSnapshotTagData) { return data; }
+    
+            @try {
+                NSKeyedUnarchiver *unarchiver = [[NSKeyedUnarchiver alloc] initForReadingWithData:data];
+                unarchiver.requiresSecureCoding = YES;
+                id object = [unarchiver decodeObjectOfClasses:archiveClasses forKey:NSKeyedArchiveRootObjectKey];
+                [unarchiver finishDecoding];
+                return object;
+            }
+            @catch (NSException *exception) {
+                if (error) {
+                    *error = ZCREasyBakeExceptionError(exception);
+                }
+                return nil;
+            }
+        }
+    }
+    
+    if (error) {
+        *error = ZCREasyBakeParameterError(@"The snapshot contains an unknown value tag (%u).", cell.tag);
+    }
+    return nil;
+}
+
+- (NSString *)_stringAtIndex:(uint64_t)index error:(NSError *__autoreleasing *)error {
+    if (index >= _header.stringCount) {
+        if (error) {
+            *error = ZCREasyBakeParameterError(@"The snapshot's string index %llu is out of bounds.", index);
+        }
+        return nil;
+    }
+    
+    pthread_mutex_lock(&_lock);
+    NSString *string = _strings[index];
+    pthread_mutex_unlock(&_lock);
+    if (string) { return string; }
+    
+    NSData *data = [self _dataInTableAtOffset:_header.stringsOffset count:_header.stringCount
+                                        index:index error:error];
+    if (!data) { return nil; }
+    
+    string = [[NSString alloc] initWithData:data encoding:NSUTF8StringEncoding];
+    if (!string) {
+        if (error) {
+            *error = ZCREasyBakeParameterError(@"The snapshot's string at index %llu is not valid UTF-8.", index);
+        }
+        return nil;
+    }
+    
+    pthread_mutex_lock(&_lock);
+    if (_strings[index]) {
+        string = _strings[index];
+    } else {
+        _strings[index] = string;
+        [_decodedStringIndexes addIndex:(NSUInteger)index];
+    }
+    pthread_mutex_unlock(&_lock);
+    
+    return string;
+}
+
+- (NSData *)_dataInTableAtOffset:(uint64_t)tableOffset count:(uint64_t)count index:(uint64_t)index
+                           error:(NSError *__autoreleasing *)error {
+    uint64_t startOffset = 0;
+    uint64_t endOffset = 0;
+    if (index < count) {
+        memcpy(&startOffset, _bytes + tableOffset + index * sizeof(uint64_t), sizeof(uint64_t));
+        memcpy(&endOffset, _bytes + tableOffset + (index + 1) * sizeof(uint64_t), sizeof(uint64_t));
+    }
+    
+    // The table's bytes follow its offsets, and were bounds checked only as far as the offsets.
+    uint64_t bytesOffset = tableOffset + (count + 1) * sizeof(uint64_t);
+    if (index >= count || startOffset > endOffset || endOffset > [_data length] ||
+        !_ZCRSnapshotRangeIsValid(bytesOffset + startOffset, endOffset - startOffset, 1, [_data length])) {
+        if (error) {
+            *error = ZCREasyBakeParameterError(@"The snapshot's table entry %llu is out of bounds.", index);
+        }
+        return nil;
+    }
+    
+    // Values are copied out of the snapshot, since doughs may outlive the mapped file.
+    return [NSData dataWithBytes:_bytes + bytesOffset + startOffset length:(NSUInteger)(endOffset - startOffset)];
+}
+
+@end
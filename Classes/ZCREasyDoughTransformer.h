@@ -15,6 +15,12 @@
  *  ZCREasyDough models and decompose them into raw ingredients. The transformer should be given
  *  raw ingredients to turn into models. The class also supports reverse transformations, turning
  *  baked models back into raw ingredients.
+ *
+ *  Since every transformation bakes a new model, these transformers don't allow memoization.
+ *
+ *  For properties mapped through a "[*]" wildcard, transformers without an identifier block bake
+ *  every element in a single batch with bakeAll:identifierPath:recipe:errors:, so the recipe is
+ *  validated once per collection rather than once per element.
  */
 @interface ZCREasyDoughTransformer : NSValueTransformer
 
@@ -38,7 +44,30 @@
                    identifierBlock:(id<NSObject,NSCopying> (^)(id rawIngredients))identifierBlock;
 
 /**
- *  Stores the last serialization error, if any.
+ *  Bakes raw ingredients into a model, like transformedValue:, while reporting any error directly.
+ *
+ *  @param value The raw ingredients to bake. If this is nil, nil is returned without an error.
+ *  @param error An optional pointer to an error which will be populated if baking fails.
+ *
+ *  @return A new model, or nil if the value is nil or an error occurs.
+ */
+- (id)transformedValue:(id)value error:(NSError **)error;
+
+/**
+ *  Decomposes a model into raw ingredients, like reverseTransformedValue:, while reporting any
+ *  error directly.
+ *
+ *  @param value The model to decompose. If this is nil, nil is returned without an error.
+ *  @param error An optional pointer to an error which will be populated if decomposing fails.
+ *
+ *  @return The raw ingredients, or nil if the value is nil or an error occurs.
+ */
+- (id)reverseTransformedValue:(id)value error:(NSError **)error;
+
+/**
+ *  The error of the last transformation on the calling thread, or nil if it succeeded.
+ *  Transformations running on other threads, for example while baking concurrently, record their
+ *  errors separately, so a single transformer can be safely shared between threads.
  */
 @property (strong, nonatomic, readonly) NSError *error;
 
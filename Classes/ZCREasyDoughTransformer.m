@@ -14,6 +14,7 @@
     Class _doughClass;
     ZCREasyRecipe *_recipe;
     id<NSObject,NSCopying> (^_identifierBlock)(id);
+    NSString *_errorKey;
 }
 
 - (instancetype)initWithDoughClass:(Class)doughClass recipe:(ZCREasyRecipe *)recipe
@@ -28,6 +29,13 @@
     _recipe = recipe;
     _identifierBlock = [identifierBlock copy];
     
+    // Errors are kept in each thread's dictionary under a key unique to this transformer, so
+    // concurrent transformations never share state. A counter is used rather than the address,
+    // since a later transformer could reuse it and find a stale error.
+    static uint64_t transformerCount = 0;
+    _errorKey = [NSString stringWithFormat:@"ZCREasyDoughTransformer.error.%llu",
+                 (unsigned long long)__atomic_add_fetch(&transformerCount, 1, __ATOMIC_RELAXED)];
+    
     return self;
 }
 
@@ -36,6 +44,12 @@
     return nil;
 }
 
+- (void)dealloc {
+    // Other threads' dictionaries can't be reached, but they only keep an error until the thread
+    // next transforms successfully or exits.
+    [[[NSThread currentThread] threadDictionary] removeObjectForKey:_errorKey];
+}
+
 + (Class)transformedValueClass {
     return [ZCREasyDough class];
 }
@@ -44,36 +58,90 @@
     return YES;
 }
 
-- (id)transformedValue:(id)value {
-    if (!value) { return nil; }
-    
-    id identifier;
-    if (_identifierBlock) {
-        identifier = _identifierBlock(value);
++ (BOOL)zcr_allowsMemoization {
+    // Each transformation bakes a distinct model and may record an error, so results can't be reused.
+    return NO;
+}
+
+- (NSError *)error {
+    return [[NSThread currentThread] threadDictionary][_errorKey];
+}
+
+// Replaces the calling thread's error, so a successful transformation clears the previous one.
+- (void)_recordError:(NSError *)error {
+    NSMutableDictionary *threadDictionary = [[NSThread currentThread] threadDictionary];
+    if (error) {
+        threadDictionary[_errorKey] = error;
     } else {
-        identifier = [NSUUID UUID];
+        [threadDictionary removeObjectForKey:_errorKey];
     }
-        
+}
+
+- (id)transformedValue:(id)value {
     NSError *error;
-    id dough = [[_doughClass alloc] initWithIdentifier:identifier ingredients:value
-                                                recipe:_recipe error:&error];
-    if (!dough) {
-        _error = error;
-    }
+    id dough = [self transformedValue:value error:&error];
+    [self _recordError:(dough) ? nil : error];
     
     return dough;
 }
 
 - (id)reverseTransformedValue:(id)value {
+    NSError *error;
+    id ingredients = [self reverseTransformedValue:value error:&error];
+    [self _recordError:(ingredients) ? nil : error];
+    
+    return ingredients;
+}
+
+- (id)transformedValue:(id)value error:(NSError *__autoreleasing *)error {
     if (!value) { return nil; }
     
-    NSError *error;
-    id ingredients = [value decomposeWithRecipe:_recipe error:&error];
-    if (!ingredients) {
-        _error = error;
+    if (_identifierBlock) {
+        // Identified ingredients are resolved through the identity map, if the class keeps one.
+        return [_doughClass canonicalDoughWithIdentifier:_identifierBlock(value) ingredients:value
+                                                  recipe:_recipe error:error];
+    } else {
+        return [[_doughClass alloc] initWithIdentifier:[NSUUID UUID] ingredients:value
+                                                recipe:_recipe error:error];
     }
+}
+
+- (NSArray *)zcr_transformedValues:(NSArray *)values {
+    // Identified doughs are resolved one at a time through the identity map.
+    if (_identifierBlock) { return [super zcr_transformedValues:values]; }
     
-    return ingredients;
+    // Otherwise the whole collection is baked as one batch, so the recipe is only validated once.
+    // Missing values are left out of the batch, since they aren't ingredients to bake.
+    NSIndexSet *presentIndexes = [values indexesOfObjectsPassingTest:^BOOL(id value, NSUInteger index, BOOL *stop) {
+        return value != [NSNull null];
+    }];
+    NSArray *ingredientsArray = ([presentIndexes count] == [values count]) ? values : [values objectsAtIndexes:presentIndexes];
+    
+    NSDictionary *errors;
+    NSArray *doughs = [_doughClass bakeAll:ingredientsArray identifierPath:nil recipe:_recipe errors:&errors];
+    NSNumber *lastIndex = [[errors allKeys] valueForKeyPath:@"@max.self"];
+    [self _recordError:(lastIndex) ? errors[lastIndex] : nil];
+    
+    if (doughs && [presentIndexes count] == [values count]) { return doughs; }
+    
+    NSMutableArray *transformedValues = [NSMutableArray arrayWithCapacity:[values count]];
+    for (NSUInteger i = 0; i < [values count]; i++) {
+        [transformedValues addObject:[NSNull null]];
+    }
+    if (doughs) {
+        __block NSUInteger bakedIndex = 0;
+        [presentIndexes enumerateIndexesUsingBlock:^(NSUInteger index, BOOL *stop) {
+            transformedValues[index] = doughs[bakedIndex++];
+        }];
+    }
+    
+    return [transformedValues copy];
+}
+
+- (id)reverseTransformedValue:(id)value error:(NSError *__autoreleasing *)error {
+    if (!value) { return nil; }
+    
+    return [value decomposeWithRecipe:_recipe error:error];
 }
 
 @end
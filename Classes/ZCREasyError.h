@@ -23,6 +23,12 @@ FOUNDATION_EXPORT NSInteger const ZCREasyBakeErrorInvalidParameters;
  */
 FOUNDATION_EXPORT NSInteger const ZCREasyBakeErrorExceptionRaised;
 
+/**
+ *  Error when raw ingredients don't have the shape a recipe's ingredient paths expect, for example
+ *  when a path leads through a string where it expects a dictionary, or past the end of an array.
+ */
+FOUNDATION_EXPORT NSInteger const ZCREasyBakeErrorMismatchedIngredients;
+
 /**
  *  Key in a ZCREasyBakeErrorExceptionRaised error's userInfo for getting the exception's name.
  */
@@ -33,6 +39,12 @@ FOUNDATION_EXPORT NSString *const ZCREasyBakeExceptionNameKey;
  */
 FOUNDATION_EXPORT NSString *const ZCREasyBakeExceptionUserInfoKey;
 
+/**
+ *  Key in a ZCREasyBakeErrorMismatchedIngredients error's userInfo for getting an NSDictionary which
+ *  maps the name of every property that couldn't be reached to its ingredient path.
+ */
+FOUNDATION_EXPORT NSString *const ZCREasyBakeMismatchedPropertiesKey;
+
 /**
  *  Function for generating ZCREasyBakeErrorInvalidParameters errors.
  *
@@ -53,3 +65,15 @@ FOUNDATION_EXPORT NSError *ZCREasyBakeParameterError(NSString *failureReason, ..
  *  @return An exception error configured for the ZCREasyBake error space.
  */
 FOUNDATION_EXPORT NSError *ZCREasyBakeExceptionError(NSException *exception) __attribute__((nonnull));
+
+/**
+ *  Function for generating ZCREasyBakeErrorMismatchedIngredients errors. The failure reason lists
+ *  every mismatched property and path, and the user info contains the
+ *  ZCREasyBakeMismatchedPropertiesKey.
+ *
+ *  @param mismatchedProperties An NSDictionary mapping the names of the properties which couldn't be
+ *                              reached to their ingredient paths. This must not be nil.
+ *
+ *  @return A mismatch error configured for the ZCREasyBake error space.
+ */
+FOUNDATION_EXPORT NSError *ZCREasyBakeMismatchError(NSDictionary *mismatchedProperties) __attribute__((nonnull));
@@ -12,9 +12,11 @@ NSString *const ZCREasyBakeErrorDomain = @"com.zachradke.easyBake.errorDomain";
 
 NSInteger const ZCREasyBakeErrorInvalidParameters = 1969;
 NSInteger const ZCREasyBakeErrorExceptionRaised = 1970;
+NSInteger const ZCREasyBakeErrorMismatchedIngredients = 1971;
 
 NSString *const ZCREasyBakeExceptionNameKey = @"ZCREasyBakeExceptionNameKey";
 NSString *const ZCREasyBakeExceptionUserInfoKey = @"ZCREasyBakeExceptionUserInfoKey";
+NSString *const ZCREasyBakeMismatchedPropertiesKey = @"ZCREasyBakeMismatchedPropertiesKey";
 
 NSError *ZCREasyBakeParameterError(NSString *failureReason, ...) {
     NSCParameterAssert(failureReason);
@@ -49,3 +51,24 @@ NSError *ZCREasyBakeExceptionError(NSException *exception) {
                                code:ZCREasyBakeErrorExceptionRaised
                            userInfo:userInfo];
 }
+
+NSError *ZCREasyBakeMismatchError(NSDictionary *mismatchedProperties) {
+    NSCParameterAssert(mismatchedProperties);
+    
+    // Properties are sorted so that the same mismatches always produce the same reason.
+    NSArray *propertyNames = [[mismatchedProperties allKeys] sortedArrayUsingSelector:@selector(compare:)];
+    NSMutableArray *descriptions = [NSMutableArray arrayWithCapacity:[propertyNames count]];
+    for (NSString *propertyName in propertyNames) {
+        [descriptions addObject:[NSString stringWithFormat:@"%@ (%@)", propertyName, mismatchedProperties[propertyName]]];
+    }
+    
+    NSString *failureReason = [NSString stringWithFormat:@"Ingredients do not match the ingredient paths of %@.",
+                               [descriptions componentsJoinedByString:@", "]];
+    NSDictionary *userInfo = @{NSLocalizedDescriptionKey: @"Mismatched ingredients.",
+                               NSLocalizedFailureReasonErrorKey: failureReason,
+                               ZCREasyBakeMismatchedPropertiesKey: [mismatchedProperties copy]};
+    
+    return [NSError errorWithDomain:ZCREasyBakeErrorDomain
+                               code:ZCREasyBakeErrorMismatchedIngredients
+                           userInfo:userInfo];
+}
@@ -0,0 +1,96 @@
+//
+//  ZCREasyIngestSession.h
+//  ZCREasyBake
+//
+//  Created by Zachary Radke on 10/16/26.
+//  Copyright (c) 2026 Zach Radke. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+/**
+ *  ZCREasyIngestSession scopes the work of a large import, such as baking or updating tens of
+ *  thousands of records from a feed, to keep its memory close to steady state.
+ *
+ *  A session owns the mutable scratch containers that ingredients are mapped into. The bake and
+ *  update methods of ZCREasyDough which accept a session borrow the containers from it rather than
+ *  allocating new ones for every record. Identifier recipes built for batches are also kept and
+ *  reused.
+ *
+ *  The autoreleased temporaries left behind by each record are drained every drainInterval records.
+ *  This happens in ingestRecords:usingBlock: and in the batch bake methods. Draining in groups
+ *  bounds the high-water mark without paying for an autorelease pool per record.
+ *
+ *  Sessions report how many records went through them and the peaks sampled just before each drain.
+ *
+ *  Sessions are thread-safe, so a single session can be shared by the workers of a concurrent batch.
+ */
+@interface ZCREasyIngestSession : NSObject
+
+/**
+ *  Designated initializer for this class.
+ *
+ *  @param drainInterval The number of records to ingest between autorelease pool drains. This must
+ *                       be greater than 0.
+ *
+ *  @return A new session.
+ */
+- (instancetype)initWithDrainInterval:(NSUInteger)drainInterval;
+
+/**
+ *  The number of records ingested between autorelease pool drains. Sessions made with init drain
+ *  every 256 records.
+ */
+@property (assign, nonatomic, readonly) NSUInteger drainInterval;
+
+/**
+ *  Enumerates records inside autorelease pools that are drained every drainInterval records. The
+ *  peak memory is sampled before each drain. Each record is typically baked or updated in the
+ *  block, passing the receiver as the session.
+ *
+ *  @param records An enumerator of the records to ingest. Records are pulled one at a time, so a
+ *                 lazily generated stream is never held in memory all at once. This must not be nil.
+ *  @param block   A block invoked for every record. Setting stop to YES ends the enumeration once
+ *                 the block returns. This must not be nil.
+ */
+- (void)ingestRecords:(NSEnumerator *)records
+           usingBlock:(void (^)(id record, BOOL *stop))block __attribute__((nonnull));
+
+/**
+ *  @name Statistics
+ */
+
+/**
+ *  The number of records baked or updated through the session.
+ */
+@property (assign, nonatomic, readonly) NSUInteger recordCount;
+
+/**
+ *  The number of autorelease pools drained by the session.
+ */
+@property (assign, nonatomic, readonly) NSUInteger drainCount;
+
+/**
+ *  The number of times a scratch container was reused rather than allocated.
+ */
+@property (assign, nonatomic, readonly) NSUInteger reusedContainerCount;
+
+/**
+ *  The highest resident memory of the process sampled during the session, in bytes. Memory is
+ *  sampled before each drain, and every drainInterval records which are baked or updated outside
+ *  of a draining method. This is 0 on platforms which don't report resident memory.
+ */
+@property (assign, nonatomic, readonly) unsigned long long peakResidentBytes;
+
+/**
+ *  The highest number of live heap allocations sampled during the session, taken at the same
+ *  points as peakResidentBytes. This is 0 on platforms whose allocator doesn't report it.
+ */
+@property (assign, nonatomic, readonly) unsigned long long peakAllocationCount;
+
+/**
+ *  Resets every statistic to 0. Scratch containers and identifier recipes are kept.
+ */
+- (void)resetStatistics;
+
+@end
@@ -0,0 +1,242 @@
+//
+//  ZCREasyIngestSession.m
+//  ZCREasyBake
+//
+//  Created by Zachary Radke on 10/16/26.
+//  Copyright (c) 2026 Zach Radke. All rights reserved.
+//
+
+#import "ZCREasyIngestSession.h"
+
+#import "ZCREasyRecipe.h"
+
+#import <pthread.h>
+#import <stdio.h>
+#import <unistd.h>
+
+#if defined(__APPLE__)
+    #import <mach/mach.h>
+    #import <malloc/malloc.h>
+#endif
+
+// Sampling memory takes a system call, so it is only done once per interval rather than per record.
+static unsigned long long _ZCRResidentBytes(void) {
+#if defined(__APPLE__)
+    struct mach_task_basic_info info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, (task_info_t)&info, &count) != KERN_SUCCESS) { return 0; }
+    return info.resident_size;
+#elif defined(__linux__)
+    FILE *statm = fopen("/proc/self/statm", "r");
+    if (!statm) { return 0; }
+    
+    unsigned long long size = 0, residentPages = 0;
+    int matched = fscanf(statm, "%llu %llu", &size, &residentPages);
+    fclose(statm);
+    return (matched == 2) ? residentPages * (unsigned long long)sysconf(_SC_PAGESIZE) : 0;
+#else
+    return 0;
+#endif
+}
+
+static unsigned long long _ZCRAllocationCount(void) {
+#if defined(__APPLE__)
+    malloc_statistics_t statistics;
+    malloc_zone_statistics(NULL, &statistics);
+    return statistics.blocks_in_use;
+#else
+    return 0;
+#endif
+}
+
+@implementation ZCREasyIngestSession {
+    pthread_mutex_t _lock;
+    NSMutableArray *_scratchDictionaries;
+    NSMutableDictionary *_identifierRecipes;
+    
+    NSUInteger _recordCount;
+    NSUInteger _drainCount;
+    NSUInteger _reusedContainerCount;
+    unsigned long long _peakResidentBytes;
+    unsigned long long _peakAllocationCount;
+}
+
+- (instancetype)initWithDrainInterval:(NSUInteger)drainInterval {
+    NSParameterAssert(drainInterval > 0);
+    
+    if (!(self = [super init])) { return nil; }
+    
+    _drainInterval = MAX(drainInterval, (NSUInteger)1);
+    pthread_mutex_init(&_lock, NULL);
+    _scratchDictionaries = [NSMutableArray array];
+    _identifierRecipes = [NSMutableDictionary dictionary];
+    
+    return self;
+}
+
+- (instancetype)init {
+    return [self initWithDrainInterval:256];
+}
+
+- (void)dealloc {
+    pthread_mutex_destroy(&_lock);
+}
+
+- (void)ingestRecords:(NSEnumerator *)records usingBlock:(void (^)(id, BOOL *))block {
+    NSParameterAssert(records);
+    NSParameterAssert(block);
+    
+    BOOL stop = NO;
+    BOOL isExhausted = NO;
+    while (!stop && !isExhausted) {
+        @autoreleasepool {
+            NSUInteger ingestedCount = 0;
+            while (ingestedCount < _drainInterval && !stop) {
+                id record = [records nextObject];
+                if (!record) {
+                    isExhausted = YES;
+                    break;
+                }
+    
+                block(record, &stop);
+                ingestedCount++;
+            }
+    
+            if (ingestedCount > 0) {
+                [self _willDrainPool];
+            }
+        }
+    }
+}
+
+- (NSUInteger)recordCount {
+    pthread_mutex_lock(&_lock);
+    NSUInteger recordCount = _recordCount;
+    pthread_mutex_unlock(&_lock);
+    
+    return recordCount;
+}
+
+- (NSUInteger)drainCount {
+    pthread_mutex_lock(&_lock);
+    NSUInteger drainCount = _drainCount;
+    pthread_mutex_unlock(&_lock);
+    
+    return drainCount;
+}
+
+- (NSUInteger)reusedContainerCount {
+    pthread_mutex_lock(&_lock);
+    NSUInteger reusedContainerCount = _reusedContainerCount;
+    pthread_mutex_unlock(&_lock);
+    
+    return reusedContainerCount;
+}
+
+- (unsigned long long)peakResidentBytes {
+    pthread_mutex_lock(&_lock);
+    unsigned long long peakResidentBytes = _peakResidentBytes;
+    pthread_mutex_unlock(&_lock);
+    
+    return peakResidentBytes;
+}
+
+- (unsigned long long)peakAllocationCount {
+    pthread_mutex_lock(&_lock);
+    unsigned long long peakAllocationCount = _peakAllocationCount;
+    pthread_mutex_unlock(&_lock);
+    
+    return peakAllocationCount;
+}
+
+- (void)resetStatistics {
+    pthread_mutex_lock(&_lock);
+    _recordCount = 0;
+    _drainCount = 0;
+    _reusedContainerCount = 0;
+    _peakResidentBytes = 0;
+    _peakAllocationCount = 0;
+    pthread_mutex_unlock(&_lock);
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"%@ records:%lu drains:%lu peakResidentBytes:%llu peakAllocations:%llu",
+            [super description], (unsigned long)self.recordCount, (unsigned long)self.drainCount,
+            self.peakResidentBytes, self.peakAllocationCount];
+}
+
+
+#pragma mark Private utilities
+
+- (NSMutableDictionary *)_dequeueScratchDictionary {
+    pthread_mutex_lock(&_lock);
+    NSMutableDictionary *dictionary = [_scratchDictionaries lastObject];
+    if (dictionary) {
+        [_scratchDictionaries removeLastObject];
+        _reusedContainerCount++;
+    }
+    pthread_mutex_unlock(&_lock);
+    
+    return dictionary ?: [NSMutableDictionary dictionary];
+}
+
+- (void)_enqueueScratchDictionary:(NSMutableDictionary *)dictionary {
+    if (!dictionary) { return; }
+    
+    // Emptied outside the lock, since releasing the values can take a while.
+    [dictionary removeAllObjects];
+    
+    pthread_mutex_lock(&_lock);
+    [_scratchDictionaries addObject:dictionary];
+    pthread_mutex_unlock(&_lock);
+}
+
+- (ZCREasyRecipe *)_identifierRecipeForPath:(NSString *)identifierPath {
+    pthread_mutex_lock(&_lock);
+    ZCREasyRecipe *recipe = _identifierRecipes[identifierPath];
+    pthread_mutex_unlock(&_lock);
+    
+    return recipe;
+}
+
+- (void)_setIdentifierRecipe:(ZCREasyRecipe *)recipe forPath:(NSString *)identifierPath {
+    pthread_mutex_lock(&_lock);
+    _identifierRecipes[identifierPath] = recipe;
+    pthread_mutex_unlock(&_lock);
+}
+
+- (void)_didIngestRecords:(NSUInteger)count {
+    pthread_mutex_lock(&_lock);
+    _recordCount += count;
+    pthread_mutex_unlock(&_lock);
+}
+
+- (void)_didIngestRecord {
+    pthread_mutex_lock(&_lock);
+    BOOL samplesMemory = (++_recordCount % _drainInterval == 0);
+    pthread_mutex_unlock(&_lock);
+    
+    if (samplesMemory) {
+        [self _sampleMemory];
+    }
+}
+
+- (void)_willDrainPool {
+    [self _sampleMemory];
+    
+    pthread_mutex_lock(&_lock);
+    _drainCount++;
+    pthread_mutex_unlock(&_lock);
+}
+
+- (void)_sampleMemory {
+    unsigned long long residentBytes = _ZCRResidentBytes();
+    unsigned long long allocationCount = _ZCRAllocationCount();
+    
+    pthread_mutex_lock(&_lock);
+    _peakResidentBytes = MAX(_peakResidentBytes, residentBytes);
+    _peakAllocationCount = MAX(_peakAllocationCount, allocationCount);
+    pthread_mutex_unlock(&_lock);
+}
+
+@end
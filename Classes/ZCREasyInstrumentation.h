@@ -0,0 +1,211 @@
+//
+//  ZCREasyInstrumentation.h
+//  ZCREasyBake
+//
+//  Created by Zachary Radke on 10/16/26.
+//  Copyright (c) 2026 Zach Radke. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+/**
+ *  Processing raw ingredients into property values by following a recipe's ingredient paths,
+ *  including any transformations.
+ */
+extern NSString *const ZCREasyInstrumentationMappingEvent;
+
+/**
+ *  Applying an ingredient transformer. Recipes record a separate event for each transformed
+ *  property, named by appending a period and the property name to this prefix, for example
+ *  "transforming.updatedAt".
+ */
+extern NSString *const ZCREasyInstrumentationTransformingEvent;
+
+/**
+ *  Setting mapped values on a dough's properties.
+ */
+extern NSString *const ZCREasyInstrumentationSettingEvent;
+
+/**
+ *  Copying a dough.
+ */
+extern NSString *const ZCREasyInstrumentationCopyingEvent;
+
+/**
+ *  Posting an update notification through a dough class's updateNotifier.
+ */
+extern NSString *const ZCREasyInstrumentationNotifyingEvent;
+
+/**
+ *  A trace hook, invoked with the name of the event and the name of the recipe or dough class it
+ *  belongs to. The subject may be nil for unnamed recipes.
+ */
+typedef void (^ZCREasyInstrumentationTraceHandler)(NSString *event, NSString *subject);
+
+/**
+ *  ZCREasyInstrumentation controls the built-in instrumentation of recipes and doughs.
+ *
+ *  When enabled, each recipe and each dough class counts and times the work it does, and the
+ *  results can be read through [ZCREasyRecipe instrumentationSnapshot] and
+ *  [ZCREasyDough instrumentationSnapshot]. Recipes record mapping and a transforming event per
+ *  transformed property, while dough classes record mapping, setting, copying and notifying. Events
+ *  nest, so mapping includes the time spent transforming.
+ *
+ *  Instrumentation is disabled by default. While disabled, each instrumented call costs a single
+ *  predictable branch on a global flag, and nothing is timed or recorded.
+ */
+@interface ZCREasyInstrumentation : NSObject
+
+/**
+ *  Whether instrumentation is enabled. This is equivalent to ZCREasyInstrumentationIsEnabled().
+ */
++ (BOOL)isEnabled;
+
+/**
+ *  Enables or disables instrumentation for the whole process. Events which are in progress when
+ *  this changes may or may not be recorded.
+ */
++ (void)setEnabled:(BOOL)enabled;
+
+/**
+ *  Installs hooks which are invoked as each instrumented event begins and ends, so that a host
+ *  app can forward them to its own tracer. The hooks are invoked synchronously on the thread doing
+ *  the work, and only while instrumentation is enabled, so they must be fast and thread-safe. Pass
+ *  nil for both to remove the hooks.
+ *
+ *  @param beginHandler An optional hook invoked as an event begins.
+ *  @param endHandler   An optional hook invoked as an event ends, including when it fails.
+ */
++ (void)setTraceBeginHandler:(ZCREasyInstrumentationTraceHandler)beginHandler
+                  endHandler:(ZCREasyInstrumentationTraceHandler)endHandler;
+
+@end
+
+
+/**
+ *  An immutable snapshot of the measurements recorded for a single event.
+ */
+@interface ZCREasyInstrumentationStatistics : NSObject
+
+/**
+ *  The number of times the event was recorded.
+ */
+@property (assign, nonatomic, readonly) uint64_t count;
+
+/**
+ *  The total duration of every recording, in nanoseconds.
+ */
+@property (assign, nonatomic, readonly) uint64_t totalNanoseconds;
+
+/**
+ *  The shortest recorded duration in nanoseconds, or 0 if nothing was recorded.
+ */
+@property (assign, nonatomic, readonly) uint64_t minimumNanoseconds;
+
+/**
+ *  The longest recorded duration in nanoseconds.
+ */
+@property (assign, nonatomic, readonly) uint64_t maximumNanoseconds;
+
+/**
+ *  The mean recorded duration in nanoseconds, or 0 if nothing was recorded.
+ */
+@property (assign, nonatomic, readonly) double meanNanoseconds;
+
+/**
+ *  A histogram of the recorded durations as an array of NSNumber counts. The bucket at index i
+ *  counts durations of at least 2^i and less than 2^(i+1) nanoseconds, except that the first bucket
+ *  also counts durations of 0 and the last bucket counts every longer duration.
+ */
+@property (strong, nonatomic, readonly) NSArray *histogram;
+
+/**
+ *  Estimates a percentile of the recorded durations from the histogram. Because buckets double in
+ *  width, the estimate is the upper bound of the bucket the percentile falls in.
+ *
+ *  @param percentile The percentile to estimate, from 0.0 to 1.0.
+ *
+ *  @return The estimated duration in nanoseconds, or 0 if nothing was recorded.
+ */
+- (uint64_t)nanosecondsAtPercentile:(double)percentile;
+
+@end
+
+
+/**
+ *  ZCREasyInstrumentationRecorder collects the measurements of a single recipe or dough class.
+ *  Recipes and dough classes create their own recorders, so this rarely needs to be used directly.
+ *
+ *  Recorders are thread-safe.
+ */
+@interface ZCREasyInstrumentationRecorder : NSObject
+
+/**
+ *  Designated initializer for this class.
+ *
+ *  @param subject The name passed to the trace hooks for events recorded here. This may be nil.
+ *
+ *  @return A new, empty recorder.
+ */
+- (instancetype)initWithSubject:(NSString *)subject;
+
+/**
+ *  The name passed to the trace hooks for events recorded here.
+ */
+@property (copy, nonatomic, readonly) NSString *subject;
+
+/**
+ *  Adds a measurement for an event.
+ *
+ *  @param event       The name of the event. This must not be nil.
+ *  @param nanoseconds The duration of the event.
+ */
+- (void)recordEvent:(NSString *)event nanoseconds:(uint64_t)nanoseconds __attribute__((nonnull (1)));
+
+/**
+ *  @return An NSDictionary of ZCREasyInstrumentationStatistics keyed by event name. Events which
+ *          haven't been recorded are absent.
+ */
+- (NSDictionary *)snapshot;
+
+/**
+ *  Discards every measurement.
+ */
+- (void)reset;
+
+@end
+
+
+/**
+ *  The backing flag of ZCREasyInstrumentationIsEnabled(). Use +[ZCREasyInstrumentation setEnabled:]
+ *  to change it.
+ */
+extern int _ZCREasyInstrumentationEnabled;
+
+/**
+ *  Whether instrumentation is enabled. This is inlined so that checking it is a single load.
+ */
+static inline BOOL ZCREasyInstrumentationIsEnabled(void) {
+    return __builtin_expect(__atomic_load_n(&_ZCREasyInstrumentationEnabled, __ATOMIC_RELAXED), 0) != 0;
+}
+
+/**
+ *  Marks the beginning of an instrumented event, invoking the begin trace hook if there is one.
+ *  This should only be called while instrumentation is enabled.
+ *
+ *  @param recorder The recorder the event will be recorded in.
+ *  @param event    The name of the event.
+ *
+ *  @return The start time of the event, to be passed to ZCREasyInstrumentationEnd().
+ */
+extern uint64_t ZCREasyInstrumentationBegin(ZCREasyInstrumentationRecorder *recorder, NSString *event);
+
+/**
+ *  Marks the end of an instrumented event begun with ZCREasyInstrumentationBegin(), recording its
+ *  duration and invoking the end trace hook if there is one.
+ *
+ *  @param recorder  The recorder to record the event in.
+ *  @param event     The name of the event.
+ *  @param startTime The start time returned by ZCREasyInstrumentationBegin().
+ */
+extern void ZCREasyInstrumentationEnd(ZCREasyInstrumentationRecorder *recorder, NSString *event, uint64_t startTime);
@@ -0,0 +1,232 @@
+//
+//  ZCREasyInstrumentation.m
+//  ZCREasyBake
+//
+//  Created by Zachary Radke on 10/16/26.
+//  Copyright (c) 2026 Zach Radke. All rights reserved.
+//
+
+#import "ZCREasyInstrumentation.h"
+
+#import <pthread.h>
+#import <time.h>
+
+NSString *const ZCREasyInstrumentationMappingEvent = @"mapping";
+NSString *const ZCREasyInstrumentationTransformingEvent = @"transforming";
+NSString *const ZCREasyInstrumentationSettingEvent = @"setting";
+NSString *const ZCREasyInstrumentationCopyingEvent = @"copying";
+NSString *const ZCREasyInstrumentationNotifyingEvent = @"notifying";
+
+int _ZCREasyInstrumentationEnabled = 0;
+
+// Buckets double in width, so 40 of them reach past 9 minutes.
+#define _ZCR_HISTOGRAM_BUCKETS 40
+
+static pthread_mutex_t _ZCRTraceLock = PTHREAD_MUTEX_INITIALIZER;
+static int _ZCRHasTraceHandlers = 0;
+static ZCREasyInstrumentationTraceHandler _ZCRTraceBeginHandler;
+static ZCREasyInstrumentationTraceHandler _ZCRTraceEndHandler;
+
+static uint64_t _ZCRInstrumentationNow(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ull + (uint64_t)now.tv_nsec;
+}
+
+static void _ZCRInstrumentationTrace(ZCREasyInstrumentationRecorder *recorder, NSString *event, BOOL isBegin) {
+    if (!__atomic_load_n(&_ZCRHasTraceHandlers, __ATOMIC_ACQUIRE)) { return; }
+    
+    // The handler is retained under the lock, but invoked outside it so that handlers may be
+    // replaced from within a handler.
+    pthread_mutex_lock(&_ZCRTraceLock);
+    ZCREasyInstrumentationTraceHandler handler = (isBegin) ? _ZCRTraceBeginHandler : _ZCRTraceEndHandler;
+    pthread_mutex_unlock(&_ZCRTraceLock);
+    
+    if (handler) {
+        handler(event, recorder.subject);
+    }
+}
+
+uint64_t ZCREasyInstrumentationBegin(ZCREasyInstrumentationRecorder *recorder, NSString *event) {
+    _ZCRInstrumentationTrace(recorder, event, YES);
+    return _ZCRInstrumentationNow();
+}
+
+void ZCREasyInstrumentationEnd(ZCREasyInstrumentationRecorder *recorder, NSString *event, uint64_t startTime) {
+    uint64_t now = _ZCRInstrumentationNow();
+    [recorder recordEvent:event nanoseconds:(now > startTime) ? now - startTime : 0];
+    _ZCRInstrumentationTrace(recorder, event, NO);
+}
+
+
+#pragma mark - ZCREasyInstrumentation
+
+@implementation ZCREasyInstrumentation
+
++ (BOOL)isEnabled {
+    return ZCREasyInstrumentationIsEnabled();
+}
+
++ (void)setEnabled:(BOOL)enabled {
+    __atomic_store_n(&_ZCREasyInstrumentationEnabled, (enabled) ? 1 : 0, __ATOMIC_RELAXED);
+}
+
++ (void)setTraceBeginHandler:(ZCREasyInstrumentationTraceHandler)beginHandler
+                  endHandler:(ZCREasyInstrumentationTraceHandler)endHandler {
+    pthread_mutex_lock(&_ZCRTraceLock);
+    _ZCRTraceBeginHandler = [beginHandler copy];
+    _ZCRTraceEndHandler = [endHandler copy];
+    __atomic_store_n(&_ZCRHasTraceHandlers, (beginHandler || endHandler) ? 1 : 0, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&_ZCRTraceLock);
+}
+
+@end
+
+
+#pragma mark - ZCREasyInstrumentationStatistics
+
+/**
+ *  The mutable measurements of a single event, guarded by the owning recorder's lock.
+ */
+@interface _ZCREasyInstrumentationCounter : NSObject {
+    @package
+    uint64_t _count;
+    uint64_t _totalNanoseconds;
+    uint64_t _minimumNanoseconds;
+    uint64_t _maximumNanoseconds;
+    uint64_t _buckets[_ZCR_HISTOGRAM_BUCKETS];
+}
+@end
+
+@implementation _ZCREasyInstrumentationCounter
+@end
+
+@interface ZCREasyInstrumentationStatistics ()
+- (instancetype)initWithCounter:(_ZCREasyInstrumentationCounter *)counter;
+@end
+
+@implementation ZCREasyInstrumentationStatistics
+
+- (instancetype)initWithCounter:(_ZCREasyInstrumentationCounter *)counter {
+    NSParameterAssert(counter);
+    
+    if (!(self = [super init])) { return nil; }
+    
+    _count = counter->_count;
+    _totalNanoseconds = counter->_totalNanoseconds;
+    _minimumNanoseconds = counter->_minimumNanoseconds;
+    _maximumNanoseconds = counter->_maximumNanoseconds;
+    
+    NSMutableArray *histogram = [NSMutableArray arrayWithCapacity:_ZCR_HISTOGRAM_BUCKETS];
+    for (NSUInteger i = 0; i < _ZCR_HISTOGRAM_BUCKETS; i++) {
+        [histogram addObject:@(counter->_buckets[i])];
+    }
+    _histogram = [histogram copy];
+    
+    return self;
+}
+
+- (double)meanNanoseconds {
+    return (_count > 0) ? (double)_totalNanoseconds / (double)_count : 0.0;
+}
+
+- (uint64_t)nanosecondsAtPercentile:(double)percentile {
+    if (_count == 0) { return 0; }
+    
+    percentile = MIN(MAX(percentile, 0.0), 1.0);
+    uint64_t targetCount = (uint64_t)ceil(percentile * (double)_count);
+    uint64_t seenCount = 0;
+    
+    for (NSUInteger i = 0; i < [_histogram count]; i++) {
+        seenCount += [_histogram[i] unsignedLongLongValue];
+        if (seenCount >= targetCount && seenCount > 0) {
+            // The bounds are clamped to the durations actually recorded.
+            uint64_t upperBound = (i + 1 < _ZCR_HISTOGRAM_BUCKETS) ? (1ull << (i + 1)) - 1 : _maximumNanoseconds;
+            return MAX(MIN(upperBound, _maximumNanoseconds), _minimumNanoseconds);
+        }
+    }
+    
+    return _maximumNanoseconds;
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"<%@:%p> count:%llu mean:%.0fns min:%lluns max:%lluns p50:%lluns p99:%lluns",
+            NSStringFromClass([self class]), self, (unsigned long long)_count, [self meanNanoseconds],
+            (unsigned long long)_minimumNanoseconds, (unsigned long long)_maximumNanoseconds,
+            (unsigned long long)[self nanosecondsAtPercentile:0.5],
+            (unsigned long long)[self nanosecondsAtPercentile:0.99]];
+}
+
+@end
+
+
+#pragma mark - ZCREasyInstrumentationRecorder
+
+@implementation ZCREasyInstrumentationRecorder {
+    pthread_mutex_t _lock;
+    NSMutableDictionary *_counters;
+}
+
+- (instancetype)initWithSubject:(NSString *)subject {
+    if (!(self = [super init])) { return nil; }
+    
+    _subject = [subject copy];
+    pthread_mutex_init(&_lock, NULL);
+    _counters = [NSMutableDictionary dictionary];
+    
+    return self;
+}
+
+- (instancetype)init {
+    return [self initWithSubject:nil];
+}
+
+- (void)dealloc {
+    pthread_mutex_destroy(&_lock);
+}
+
+- (void)recordEvent:(NSString *)event nanoseconds:(uint64_t)nanoseconds {
+    NSParameterAssert(event);
+    
+    // The bucket is the position of the highest set bit, so each bucket is twice as wide as the last.
+    NSUInteger bucket = (nanoseconds > 0) ? (NSUInteger)(63 - __builtin_clzll(nanoseconds)) : 0;
+    bucket = MIN(bucket, (NSUInteger)_ZCR_HISTOGRAM_BUCKETS - 1);
+    
+    pthread_mutex_lock(&_lock);
+    _ZCREasyInstrumentationCounter *counter = _counters[event];
+    if (!counter) {
+        counter = [[_ZCREasyInstrumentationCounter alloc] init];
+        counter->_minimumNanoseconds = UINT64_MAX;
+        _counters[event] = counter;
+    }
+    counter->_count++;
+    counter->_totalNanoseconds += nanoseconds;
+    counter->_minimumNanoseconds = MIN(counter->_minimumNanoseconds, nanoseconds);
+    counter->_maximumNanoseconds = MAX(counter->_maximumNanoseconds, nanoseconds);
+    counter->_buckets[bucket]++;
+    pthread_mutex_unlock(&_lock);
+}
+
+- (NSDictionary *)snapshot {
+    pthread_mutex_lock(&_lock);
+    NSMutableDictionary *snapshot = [NSMutableDictionary dictionaryWithCapacity:[_counters count]];
+    [_counters enumerateKeysAndObjectsUsingBlock:^(NSString *event, _ZCREasyInstrumentationCounter *counter, BOOL *stop) {
+        snapshot[event] = [[ZCREasyInstrumentationStatistics alloc] initWithCounter:counter];
+    }];
+    pthread_mutex_unlock(&_lock);
+    
+    return [snapshot copy];
+}
+
+- (void)reset {
+    pthread_mutex_lock(&_lock);
+    [_counters removeAllObjects];
+    pthread_mutex_unlock(&_lock);
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"<%@:%p> subject:%@ events:%@", NSStringFromClass([self class]),
+            self, _subject, [self snapshot]];
+}
+
+@end
@@ -0,0 +1,79 @@
+//
+//  ZCREasyInternPool.h
+//  ZCREasyBake
+//
+//  Created by Zachary Radke on 10/16/26.
+//  Copyright (c) 2026 Zach Radke. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+/**
+ *  ZCREasyInternPool deduplicates equal NSStrings and NSNumbers, so that repeated values such as
+ *  enum-like strings or status codes share a single instance rather than each record holding its
+ *  own copy. The pool only holds its values weakly, so a value is dropped from the pool once nothing
+ *  else retains it.
+ *
+ *  Recipes intern the processed values of the properties listed in their internedPropertyNames, so
+ *  pools rarely need to be used directly. Instead, a recipe's internPool can be inspected to see how
+ *  much interning saves.
+ *
+ *  NSNumbers are only shared with numbers of the same class and type encoding, so that a boolean is
+ *  never replaced by an equal integer, or an integer by an equal double.
+ *
+ *  Pools are thread-safe, and lookups of different values rarely contend with each other.
+ */
+@interface ZCREasyInternPool : NSObject
+
+/**
+ *  The pool used by recipes which don't configure their own.
+ *
+ *  @return A pool shared throughout the app.
+ */
++ (instancetype)sharedPool;
+
+/**
+ *  Returns the pooled instance equal to a value, adding the value to the pool if there is none.
+ *  Mutable strings are copied before being added.
+ *
+ *  @param value The value to intern. Values other than NSStrings and NSNumbers, including nil, are
+ *               returned as they are.
+ *
+ *  @return The pooled instance equal to the value, or the value itself if it can't be pooled.
+ */
+- (id)internedValue:(id)value;
+
+/**
+ *  Removes every value from the pool. The statistics are unaffected.
+ */
+- (void)removeAllValues;
+
+/**
+ *  The number of live values in the pool.
+ */
+@property (assign, nonatomic, readonly) NSUInteger count;
+
+/**
+ *  The number of lookups which found an equal pooled value.
+ */
+@property (assign, nonatomic, readonly) NSUInteger hitCount;
+
+/**
+ *  The number of lookups which found no equal pooled value.
+ */
+@property (assign, nonatomic, readonly) NSUInteger missCount;
+
+/**
+ *  An estimate of the heap bytes saved, from the allocations of the duplicates which hits replaced
+ *  with pooled values. Duplicates which aren't heap allocated, such as tagged pointers, save
+ *  nothing. The memory is only reclaimed once the raw ingredients holding the duplicates are
+ *  released.
+ */
+@property (assign, nonatomic, readonly) unsigned long long savedByteCount;
+
+/**
+ *  Resets the hit, miss and saved byte counts. Pooled values are unaffected.
+ */
+- (void)resetStatistics;
+
+@end
@@ -0,0 +1,168 @@
+//
+//  ZCREasyInternPool.m
+//  ZCREasyBake
+//
+//  Created by Zachary Radke on 10/16/26.
+//  Copyright (c) 2026 Zach Radke. All rights reserved.
+//
+
+#import "ZCREasyInternPool.h"
+
+#import <objc/runtime.h>
+#import <pthread.h>
+#import <string.h>
+
+#if defined(__APPLE__)
+    #import <malloc/malloc.h>
+#endif
+
+// Values are spread over stripes by hash, so concurrent lookups of different values rarely wait on
+// the same lock.
+#define _ZCR_INTERN_POOL_STRIPES 16
+
+// The heap bytes a duplicate occupies. Other runtimes may place object headers before the object,
+// so only Apple's allocator is asked directly, and elsewhere the instance size is an estimate.
+static inline size_t _ZCRAllocationSize(id value) {
+#if defined(__APPLE__)
+    return malloc_size((__bridge const void *)value);
+#else
+    return class_getInstanceSize(object_getClass(value));
+#endif
+}
+
+// Equal numbers of different types, such as @YES and @1, must not stand in for each other.
+static inline BOOL _ZCRIsInterchangeable(id pooledValue, id value) {
+    if (![value isKindOfClass:[NSNumber class]]) { return YES; }
+    
+    return [pooledValue class] == [value class] && strcmp([pooledValue objCType], [value objCType]) == 0;
+}
+
+@implementation ZCREasyInternPool {
+    NSArray *_tables;
+    pthread_mutex_t _locks[_ZCR_INTERN_POOL_STRIPES];
+    unsigned long long _hits[_ZCR_INTERN_POOL_STRIPES];
+    unsigned long long _misses[_ZCR_INTERN_POOL_STRIPES];
+    unsigned long long _savedBytes[_ZCR_INTERN_POOL_STRIPES];
+}
+
++ (instancetype)sharedPool {
+    static ZCREasyInternPool *sharedPool;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedPool = [[self alloc] init];
+    });
+    
+    return sharedPool;
+}
+
+- (instancetype)init {
+    if (!(self = [super init])) { return nil; }
+    
+    NSMutableArray *tables = [NSMutableArray arrayWithCapacity:_ZCR_INTERN_POOL_STRIPES];
+    for (NSUInteger i = 0; i < _ZCR_INTERN_POOL_STRIPES; i++) {
+        [tables addObject:[NSHashTable weakObjectsHashTable]];
+        pthread_mutex_init(&_locks[i], NULL);
+    }
+    _tables = [tables copy];
+    
+    return self;
+}
+
+- (void)dealloc {
+    for (NSUInteger i = 0; i < _ZCR_INTERN_POOL_STRIPES; i++) {
+        pthread_mutex_destroy(&_locks[i]);
+    }
+}
+
+- (id)internedValue:(id)value {
+    if (![value isKindOfClass:[NSString class]] && ![value isKindOfClass:[NSNumber class]]) { return value; }
+    
+    NSUInteger stripe = [value hash] % _ZCR_INTERN_POOL_STRIPES;
+    NSHashTable *table = _tables[stripe];
+    
+    pthread_mutex_lock(&_locks[stripe]);
+    id pooledValue = [table member:value];
+    if (pooledValue && _ZCRIsInterchangeable(pooledValue, value)) {
+        _hits[stripe]++;
+        if (pooledValue != value) {
+            _savedBytes[stripe] += _ZCRAllocationSize(value);
+        }
+        value = pooledValue;
+    } else {
+        _misses[stripe]++;
+        // An equal value of another type keeps its place, and this one is simply not pooled.
+        if (!pooledValue) {
+            value = [value copy];
+            [table addObject:value];
+        }
+    }
+    pthread_mutex_unlock(&_locks[stripe]);
+    
+    return value;
+}
+
+- (void)removeAllValues {
+    for (NSUInteger i = 0; i < _ZCR_INTERN_POOL_STRIPES; i++) {
+        pthread_mutex_lock(&_locks[i]);
+        [_tables[i] removeAllObjects];
+        pthread_mutex_unlock(&_locks[i]);
+    }
+}
+
+- (NSUInteger)count {
+    NSUInteger count = 0;
+    for (NSUInteger i = 0; i < _ZCR_INTERN_POOL_STRIPES; i++) {
+        pthread_mutex_lock(&_locks[i]);
+        // Weakly held values may have been released, so only live entries are counted.
+        for (id value in _tables[i]) {
+            if (value) { count++; }
+        }
+        pthread_mutex_unlock(&_locks[i]);
+    }
+    
+    return count;
+}
+
+- (NSUInteger)hitCount {
+    return (NSUInteger)[self _sumOfCounters:_hits];
+}
+
+- (NSUInteger)missCount {
+    return (NSUInteger)[self _sumOfCounters:_misses];
+}
+
+- (unsigned long long)savedByteCount {
+    return [self _sumOfCounters:_savedBytes];
+}
+
+- (void)resetStatistics {
+    for (NSUInteger i = 0; i < _ZCR_INTERN_POOL_STRIPES; i++) {
+        pthread_mutex_lock(&_locks[i]);
+        _hits[i] = 0;
+        _misses[i] = 0;
+        _savedBytes[i] = 0;
+        pthread_mutex_unlock(&_locks[i]);
+    }
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"%@ count:%lu hits:%lu misses:%lu savedBytes:%llu",
+            [super description], (unsigned long)self.count, (unsigned long)self.hitCount,
+            (unsigned long)self.missCount, self.savedByteCount];
+}
+
+
+#pragma mark Private utilities
+
+- (unsigned long long)_sumOfCounters:(unsigned long long *)counters {
+    unsigned long long sum = 0;
+    for (NSUInteger i = 0; i < _ZCR_INTERN_POOL_STRIPES; i++) {
+        pthread_mutex_lock(&_locks[i]);
+        sum += counters[i];
+        pthread_mutex_unlock(&_locks[i]);
+    }
+    
+    return sum;
+}
+
+@end
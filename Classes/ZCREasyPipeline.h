@@ -0,0 +1,243 @@
+//
+//  ZCREasyPipeline.h
+//  ZCREasyBake
+//
+//  Created by Zachary Radke on 10/16/26.
+//  Copyright (c) 2026 Zach Radke. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+@class ZCREasyRecipe, ZCREasyIngestSession, ZCREasyInstrumentationStatistics;
+
+/**
+ *  The stage which turns submitted inputs into raw ingredients.
+ */
+FOUNDATION_EXPORT NSString *const ZCREasyPipelineParseStage;
+
+/**
+ *  The stage which bakes raw ingredients into doughs.
+ */
+FOUNDATION_EXPORT NSString *const ZCREasyPipelineBakeStage;
+
+/**
+ *  The stage which hands baked doughs to the publish block.
+ */
+FOUNDATION_EXPORT NSString *const ZCREasyPipelinePublishStage;
+
+/**
+ *  A block which parses a submitted input into raw ingredients.
+ *
+ *  @param input The submitted input.
+ *  @param error An optional error pointer to set if the input can't be parsed.
+ *
+ *  @return An NSArray of raw ingredients, one per record, or nil if the input can't be parsed. An
+ *          input such as a page of a feed may produce any number of records.
+ */
+typedef NSArray *(^ZCREasyPipelineParseBlock)(id input, NSError **error);
+
+/**
+ *  ZCREasyPipeline streams inputs through three stages: parse, bake and publish. Each stage runs on
+ *  its own worker threads, so a feed can be read, baked and stored at the same time.
+ *
+ *  The stages are connected by bounded queues. The queues are lock-free rings, and workers only
+ *  block when a queue is full or empty. When a stage falls behind, its queue fills and the stage
+ *  before it blocks until there is room. The pressure carries back to submitInput:, so a slow
+ *  publisher throttles the parser rather than letting records pile up in memory.
+ *
+ *  Pipelines are configured with their properties and then started. Configuration changed after
+ *  startWithError: is ignored. Inputs are submitted from any thread. Once the last input is
+ *  submitted, finishWithCompletion: lets the stages drain. Alternatively, cancel stops every stage
+ *  and discards the records still queued. A started pipeline must be finished or cancelled, since
+ *  its workers keep it alive until then.
+ *
+ *  Records are not kept in order when a stage has more than one worker.
+ *
+ *  Every stage records how many items it processed and how long each took. Throughput and
+ *  latencies can be read at any time, including while the pipeline is running.
+ */
+@interface ZCREasyPipeline : NSObject
+
+/**
+ *  Designated initializer for this class.
+ *
+ *  @param doughClass The ZCREasyDough subclass to bake. This must not be nil.
+ *  @param recipe     The recipe to bake records with. This must not be nil.
+ *
+ *  @return A new pipeline, which must be started before inputs are submitted.
+ */
+- (instancetype)initWithDoughClass:(Class)doughClass recipe:(ZCREasyRecipe *)recipe __attribute__((nonnull));
+
+/**
+ *  The ZCREasyDough subclass baked by the receiver.
+ */
+@property (strong, nonatomic, readonly) Class doughClass;
+
+/**
+ *  The recipe records are baked with.
+ */
+@property (strong, nonatomic, readonly) ZCREasyRecipe *recipe;
+
+/**
+ *  @name Configuration
+ */
+
+/**
+ *  An optional ingredient path to each record's unique identifier, as in
+ *  +[ZCREasyDough bakeAll:identifierPath:recipe:errors:]. Records get a random identifier if
+ *  this is nil.
+ */
+@property (copy, nonatomic) NSString *identifierPath;
+
+/**
+ *  The block the parse stage runs on every input. By default NSData inputs are parsed as JSON and
+ *  a top level array is split into its records. Any other input is passed on as a single record.
+ */
+@property (copy, nonatomic) ZCREasyPipelineParseBlock parseBlock;
+
+/**
+ *  An optional block the publish stage runs on every baked dough, such as to store it. Doughs are
+ *  discarded after this block, so without one the pipeline only fills the identity map of
+ *  doughClass.
+ */
+@property (copy, nonatomic) void (^publishBlock)(id dough);
+
+/**
+ *  An optional block invoked when an input can't be parsed or a record can't be baked. The value
+ *  is the input or raw ingredients which failed. This is invoked on the worker of the failing
+ *  stage, so it must be thread-safe.
+ */
+@property (copy, nonatomic) void (^errorBlock)(NSString *stage, id value, NSError *error);
+
+/**
+ *  An optional session the bake stage bakes through. A new session is used if this is nil.
+ *
+ *  @see ZCREasyIngestSession
+ */
+@property (strong, nonatomic) ZCREasyIngestSession *session;
+
+/**
+ *  The number of items each queue holds before the stage feeding it blocks. The default is 64.
+ */
+@property (assign, nonatomic) NSUInteger queueCapacity;
+
+/**
+ *  The number of worker threads for the parse stage. The default is 1.
+ */
+@property (assign, nonatomic) NSUInteger parseConcurrency;
+
+/**
+ *  The number of worker threads for the bake stage. The default is the number of active
+ *  processors.
+ */
+@property (assign, nonatomic) NSUInteger bakeConcurrency;
+
+/**
+ *  The number of worker threads for the publish stage. The default is 1, so that publishBlock is
+ *  never invoked concurrently.
+ */
+@property (assign, nonatomic) NSUInteger publishConcurrency;
+
+/**
+ *  @name Running
+ */
+
+/**
+ *  Starts the worker threads of every stage.
+ *
+ *  @param error An optional error pointer to set if the recipe doesn't fit doughClass, the
+ *               identifierPath is invalid, or the pipeline was already started.
+ *
+ *  @return YES if the pipeline was started, or NO if not.
+ */
+- (BOOL)startWithError:(NSError **)error;
+
+/**
+ *  Submits an input to the parse stage. If the parse stage's queue is full, this blocks until
+ *  there is room.
+ *
+ *  @param input The input to parse. This must not be nil.
+ *
+ *  @return YES if the input was queued, or NO if the pipeline isn't running or was cancelled while
+ *          waiting.
+ */
+- (BOOL)submitInput:(id)input __attribute__((nonnull));
+
+/**
+ *  Ends the input once every submitInput: call has returned. Calls to submitInput: which are
+ *  already in progress are waited for, so their inputs are processed, while later calls return NO.
+ *  The stages process what is already queued and then stop.
+ *
+ *  @param completion An optional block invoked on a global queue once every stage has stopped.
+ *                    The block is passed YES if the pipeline was cancelled.
+ */
+- (void)finishWithCompletion:(void (^)(BOOL cancelled))completion;
+
+/**
+ *  Blocks until every stage has stopped after finishWithCompletion: or cancel. This returns
+ *  immediately if the pipeline was never started.
+ */
+- (void)waitUntilFinished;
+
+/**
+ *  Stops every stage as soon as its current item is done. Queued records are discarded, and
+ *  blocked calls to submitInput: return NO.
+ */
+- (void)cancel;
+
+/**
+ *  Whether the pipeline was cancelled.
+ */
+@property (assign, nonatomic, readonly, getter = isCancelled) BOOL cancelled;
+
+/**
+ *  Whether every stage has stopped.
+ */
+@property (assign, nonatomic, readonly, getter = isFinished) BOOL finished;
+
+/**
+ *  @name Statistics
+ */
+
+/**
+ *  @param stage One of the stage names, such as ZCREasyPipelineBakeStage.
+ *
+ *  @return The number of items the stage has processed, including those which failed.
+ */
+- (NSUInteger)processedCountForStage:(NSString *)stage;
+
+/**
+ *  @param stage One of the stage names, such as ZCREasyPipelineBakeStage.
+ *
+ *  @return The items processed by the stage per second since the pipeline started, up to when it
+ *          finished.
+ */
+- (double)throughputForStage:(NSString *)stage;
+
+/**
+ *  @param stage One of the stage names, such as ZCREasyPipelineBakeStage.
+ *
+ *  @return The time the stage spent on each item, or nil if it hasn't processed any. Records baked
+ *          together in a batch are each measured as the batch's average.
+ */
+- (ZCREasyInstrumentationStatistics *)latencyForStage:(NSString *)stage;
+
+/**
+ *  @param stage One of the stage names, such as ZCREasyPipelineBakeStage.
+ *
+ *  @return The number of times work for the stage was held back because the stage's queue was
+ *          full. A growing count means the stage is throttling the ones before it.
+ */
+- (NSUInteger)stallCountForStage:(NSString *)stage;
+
+/**
+ *  The number of inputs and records which failed in any stage.
+ */
+@property (assign, nonatomic, readonly) NSUInteger errorCount;
+
+/**
+ *  Resets every statistic, and restarts the throughput clock.
+ */
+- (void)resetStatistics;
+
+@end
@@ -0,0 +1,697 @@
+//
+//  ZCREasyPipeline.m
+//  ZCREasyBake
+//
+//  Created by Zachary Radke on 10/16/26.
+//  Copyright (c) 2026 Zach Radke. All rights reserved.
+//
+
+#import "ZCREasyPipeline.h"
+
+#import "ZCREasyError.h"
+#import "ZCREasyRecipe.h"
+#import "ZCREasyDough.h"
+#import "ZCREasyIngestSession.h"
+#import "ZCREasyInstrumentation.h"
+
+#import <pthread.h>
+#import <sched.h>
+#import <time.h>
+
+NSString *const ZCREasyPipelineParseStage = @"parse";
+NSString *const ZCREasyPipelineBakeStage = @"bake";
+NSString *const ZCREasyPipelinePublishStage = @"publish";
+
+// Records are baked in batches of up to this many, so the recipe is checked and the session's pool
+// drained once per batch rather than per record. Only records which are already queued are batched,
+// so a trickle of records is never held back to fill one.
+#define _ZCR_PIPELINE_BAKE_BATCH 16
+
+// Producers blocked on a full queue wake this often to check whether the pipeline was cancelled.
+#define _ZCR_PIPELINE_CANCEL_POLL_NANOSECONDS (10 * NSEC_PER_MSEC)
+
+static uint64_t _ZCRPipelineNow(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ull + (uint64_t)now.tv_nsec;
+}
+
+static NSArray *_ZCRPipelineParseInput(id input, NSError *__autoreleasing *error) {
+    if (![input isKindOfClass:[NSData class]]) { return @[input]; }
+    
+    id JSONObject = [NSJSONSerialization JSONObjectWithData:input options:0 error:error];
+    if (!JSONObject) { return nil; }
+    
+    return ([JSONObject isKindOfClass:[NSArray class]]) ? JSONObject : @[JSONObject];
+}
+
+
+#pragma mark - Queue
+
+typedef struct {
+    uintptr_t sequence;
+    void *object;
+} _ZCRPipelineCell;
+
+/**
+ *  A bounded multi-producer, multi-consumer queue. The ring itself is lock-free: every cell carries
+ *  a sequence number which says whether it is ready to be written or read at a given position, and
+ *  producers and consumers claim positions with a compare and swap. Semaphores count the free and
+ *  filled slots so that threads only block when the queue is full or empty.
+ *
+ *  Once closed or cancelled, the queue wakes its consumers with one extra signal. Each consumer
+ *  which finds nothing left passes the signal on before returning nil, so every consumer stops
+ *  without the queue knowing how many there are.
+ */
+@interface _ZCREasyPipelineQueue : NSObject
+- (instancetype)initWithCapacity:(NSUInteger)capacity;
+- (BOOL)enqueueObject:(id)object;
+- (id)dequeueObject;
+- (id)tryDequeueObject;
+- (void)close;
+- (void)cancel;
+@property (assign, nonatomic, readonly) NSUInteger stallCount;
+- (void)resetStallCount;
+@end
+
+@implementation _ZCREasyPipelineQueue {
+    _ZCRPipelineCell *_cells;
+    uintptr_t _mask;
+    uintptr_t _enqueuePosition;
+    uintptr_t _dequeuePosition;
+    dispatch_semaphore_t _freeSlots;
+    dispatch_semaphore_t _queuedObjects;
+    int _closed;
+    int _cancelled;
+    NSUInteger _stallCount;
+}
+
+- (instancetype)initWithCapacity:(NSUInteger)capacity {
+    if (!(self = [super init])) { return nil; }
+    
+    // The ring is a power of two so positions map to cells with a mask. The semaphore enforces the
+    // exact capacity.
+    uintptr_t cellCount = 1;
+    while (cellCount < capacity) {
+        cellCount <<= 1;
+    }
+    
+    _cells = (_ZCRPipelineCell *)calloc(cellCount, sizeof(_ZCRPipelineCell));
+    for (uintptr_t i = 0; i < cellCount; i++) {
+        _cells[i].sequence = i;
+    }
+    _mask = cellCount - 1;
+    
+    _freeSlots = dispatch_semaphore_create((long)capacity);
+    _queuedObjects = dispatch_semaphore_create(0);
+    
+    return self;
+}
+
+- (void)dealloc {
+    // Objects left behind by a cancelled pipeline are still retained by the ring.
+    void *object;
+    while ((object = [self _popObject])) {
+        (void)(__bridge_transfer id)object;
+    }
+    free(_cells);
+
+#if !OS_OBJECT_USE_OBJC
+    dispatch_release(_freeSlots);
+    dispatch_release(_queuedObjects);
+#endif
+}
+
+- (BOOL)enqueueObject:(id)object {
+    if (__atomic_load_n(&_cancelled, __ATOMIC_ACQUIRE)) { return NO; }
+    
+    if (dispatch_semaphore_wait(_freeSlots, DISPATCH_TIME_NOW) != 0) {
+        __atomic_add_fetch(&_stallCount, 1, __ATOMIC_RELAXED);
+    
+        // There's no telling how many producers are blocked, so rather than being woken by cancel
+        // they wake up to check for it.
+        while (dispatch_semaphore_wait(_freeSlots, dispatch_time(DISPATCH_TIME_NOW, _ZCR_PIPELINE_CANCEL_POLL_NANOSECONDS)) != 0) {
+            if (__atomic_load_n(&_cancelled, __ATOMIC_ACQUIRE)) { return NO; }
+        }
+    }
+    
+    if (__atomic_load_n(&_cancelled, __ATOMIC_ACQUIRE)) {
+        dispatch_semaphore_signal(_freeSlots);
+        return NO;
+    }
+    
+    // A slot is reserved, but the consumer which freed it may not have released its cell yet.
+    void *pointer = (__bridge_retained void *)object;
+    while (![self _pushObject:pointer]) {
+        sched_yield();
+    }
+    
+    dispatch_semaphore_signal(_queuedObjects);
+    return YES;
+}
+
+- (id)dequeueObject {
+    if (__atomic_load_n(&_cancelled, __ATOMIC_ACQUIRE)) { return nil; }
+    
+    dispatch_semaphore_wait(_queuedObjects, DISPATCH_TIME_FOREVER);
+    return [self _takeObject];
+}
+
+- (id)tryDequeueObject {
+    if (__atomic_load_n(&_cancelled, __ATOMIC_ACQUIRE)) { return nil; }
+    if (dispatch_semaphore_wait(_queuedObjects, DISPATCH_TIME_NOW) != 0) { return nil; }
+    
+    return [self _takeObject];
+}
+
+- (void)close {
+    __atomic_store_n(&_closed, 1, __ATOMIC_RELEASE);
+    dispatch_semaphore_signal(_queuedObjects);
+}
+
+- (void)cancel {
+    __atomic_store_n(&_cancelled, 1, __ATOMIC_RELEASE);
+    dispatch_semaphore_signal(_queuedObjects);
+}
+
+- (NSUInteger)stallCount {
+    return __atomic_load_n(&_stallCount, __ATOMIC_RELAXED);
+}
+
+- (void)resetStallCount {
+    __atomic_store_n(&_stallCount, 0, __ATOMIC_RELAXED);
+}
+
+
+#pragma mark Private utilities
+
+- (id)_takeObject {
+    for (;;) {
+        if (__atomic_load_n(&_cancelled, __ATOMIC_ACQUIRE)) { break; }
+    
+        void *pointer = [self _popObject];
+        if (pointer) {
+            dispatch_semaphore_signal(_freeSlots);
+            return (__bridge_transfer id)pointer;
+        }
+    
+        // Queues are only closed once their producers have stopped, so an empty ring is final.
+        // Otherwise a producer has claimed a cell but not yet filled it.
+        if (__atomic_load_n(&_closed, __ATOMIC_ACQUIRE)) { break; }
+        sched_yield();
+    }
+    
+    dispatch_semaphore_signal(_queuedObjects);
+    return nil;
+}
+
+- (BOOL)_pushObject:(void *)object {
+    uintptr_t position = __atomic_load_n(&_enqueuePosition, __ATOMIC_RELAXED);
+    for (;;) {
+        _ZCRPipelineCell *cell = &_cells[position & _mask];
+        intptr_t difference = (intptr_t)__atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE) - (intptr_t)position;
+    
+        if (difference == 0) {
+            if (__atomic_compare_exchange_n(&_enqueuePosition, &position, position + 1, YES,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                cell->object = object;
+                __atomic_store_n(&cell->sequence, position + 1, __ATOMIC_RELEASE);
+                return YES;
+            }
+        } else if (difference < 0) {
+            return NO;
+        } else {
+            position = __atomic_load_n(&_enqueuePosition, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+- (void *)_popObject {
+    uintptr_t position = __atomic_load_n(&_dequeuePosition, __ATOMIC_RELAXED);
+    for (;;) {
+        _ZCRPipelineCell *cell = &_cells[position & _mask];
+        intptr_t difference = (intptr_t)__atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE) - (intptr_t)(position + 1);
+    
+        if (difference == 0) {
+            if (__atomic_compare_exchange_n(&_dequeuePosition, &position, position + 1, YES,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                void *object = cell->object;
+                cell->object = NULL;
+                __atomic_store_n(&cell->sequence, position + _mask + 1, __ATOMIC_RELEASE);
+                return object;
+            }
+        } else if (difference < 0) {
+            return NULL;
+        } else {
+            position = __atomic_load_n(&_dequeuePosition, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+@end
+
+
+#pragma mark - Pipeline
+
+@implementation ZCREasyPipeline {
+    pthread_mutex_t _lock;
+    pthread_cond_t _finishedCondition;
+    
+    // Held for reading by every submitInput: call, so ending the input can wait out the calls which
+    // are still enqueueing before the parse queue closes.
+    pthread_rwlock_t _submitLock;
+    BOOL _started;
+    BOOL _inputEnded;
+    BOOL _finished;
+    NSMutableArray *_completions;
+    uint64_t _startTime;
+    uint64_t _finishTime;
+    
+    int _accepting;
+    int _cancelled;
+    int _activeParseWorkers;
+    int _activeBakeWorkers;
+    int _activeWorkers;
+    NSUInteger _errorCount;
+    
+    // The configuration is copied when the pipeline starts, so the workers never see it change.
+    ZCREasyPipelineParseBlock _runningParseBlock;
+    void (^_runningPublishBlock)(id dough);
+    void (^_runningErrorBlock)(NSString *stage, id value, NSError *error);
+    NSString *_runningIdentifierPath;
+    ZCREasyIngestSession *_runningSession;
+    
+    _ZCREasyPipelineQueue *_parseQueue;
+    _ZCREasyPipelineQueue *_bakeQueue;
+    _ZCREasyPipelineQueue *_publishQueue;
+    ZCREasyInstrumentationRecorder *_statistics;
+}
+
+- (instancetype)initWithDoughClass:(Class)doughClass recipe:(ZCREasyRecipe *)recipe {
+    NSParameterAssert(doughClass);
+    NSParameterAssert(recipe);
+    
+    if (!(self = [super init])) { return nil; }
+    
+    _doughClass = doughClass;
+    _recipe = recipe;
+    _queueCapacity = 64;
+    _parseConcurrency = 1;
+    _bakeConcurrency = MAX([[NSProcessInfo processInfo] activeProcessorCount], (NSUInteger)1);
+    _publishConcurrency = 1;
+    
+    pthread_mutex_init(&_lock, NULL);
+    pthread_cond_init(&_finishedCondition, NULL);
+    pthread_rwlock_init(&_submitLock, NULL);
+    _completions = [NSMutableArray array];
+    _statistics = [[ZCREasyInstrumentationRecorder alloc] initWithSubject:NSStringFromClass(doughClass)];
+    
+    return self;
+}
+
+- (instancetype)init {
+    [NSException raise:NSInternalInconsistencyException
+                format:@"%@ must be initialized with a dough class and recipe.", NSStringFromClass([self class])];
+    return nil;
+}
+
+- (void)dealloc {
+    pthread_rwlock_destroy(&_submitLock);
+    pthread_cond_destroy(&_finishedCondition);
+    pthread_mutex_destroy(&_lock);
+}
+
+- (BOOL)startWithError:(NSError *__autoreleasing *)error {
+    NSError *startError = nil;
+    
+    pthread_mutex_lock(&_lock);
+    if (_started) {
+        startError = ZCREasyBakeParameterError(@"The pipeline was already started!");
+    } else if (__atomic_load_n(&_cancelled, __ATOMIC_ACQUIRE)) {
+        startError = ZCREasyBakeParameterError(@"The pipeline was cancelled!");
+    } else if (![self _validateConfiguration:&startError]) {
+        // The validation error is already set.
+    } else {
+        _runningParseBlock = self.parseBlock ?: ^NSArray *(id input, NSError *__autoreleasing *parseError) {
+            return _ZCRPipelineParseInput(input, parseError);
+        };
+        _runningPublishBlock = self.publishBlock;
+        _runningErrorBlock = self.errorBlock;
+        _runningIdentifierPath = [self.identifierPath copy];
+        _runningSession = self.session ?: [[ZCREasyIngestSession alloc] init];
+    
+        NSUInteger capacity = MAX(self.queueCapacity, (NSUInteger)1);
+        _parseQueue = [[_ZCREasyPipelineQueue alloc] initWithCapacity:capacity];
+        _bakeQueue = [[_ZCREasyPipelineQueue alloc] initWithCapacity:capacity];
+        _publishQueue = [[_ZCREasyPipelineQueue alloc] initWithCapacity:capacity];
+    
+        _started = YES;
+        _startTime = _ZCRPipelineNow();
+    }
+    pthread_mutex_unlock(&_lock);
+    
+    if (startError) {
+        if (error) { *error = startError; }
+        return NO;
+    }
+    
+    NSUInteger parseConcurrency = MAX(self.parseConcurrency, (NSUInteger)1);
+    NSUInteger bakeConcurrency = MAX(self.bakeConcurrency, (NSUInteger)1);
+    NSUInteger publishConcurrency = MAX(self.publishConcurrency, (NSUInteger)1);
+    _activeParseWorkers = (int)parseConcurrency;
+    _activeBakeWorkers = (int)bakeConcurrency;
+    _activeWorkers = (int)(parseConcurrency + bakeConcurrency + publishConcurrency);
+    
+    // Workers spend their time blocked on the queues, so each gets a thread of its own rather than
+    // tying up the threads of a dispatch queue.
+    [self _startWorkers:publishConcurrency forStage:ZCREasyPipelinePublishStage selector:@selector(_publishWithWorker:)];
+    [self _startWorkers:bakeConcurrency forStage:ZCREasyPipelineBakeStage selector:@selector(_bakeWithWorker:)];
+    [self _startWorkers:parseConcurrency forStage:ZCREasyPipelineParseStage selector:@selector(_parseWithWorker:)];
+    
+    __atomic_store_n(&_accepting, 1, __ATOMIC_RELEASE);
+    return YES;
+}
+
+- (BOOL)submitInput:(id)input {
+    NSParameterAssert(input);
+    
+    pthread_rwlock_rdlock(&_submitLock);
+    BOOL submitted = __atomic_load_n(&_accepting, __ATOMIC_ACQUIRE) && [_parseQueue enqueueObject:input];
+    pthread_rwlock_unlock(&_submitLock);
+    
+    return submitted;
+}
+
+- (void)finishWithCompletion:(void (^)(BOOL))completion {
+    pthread_mutex_lock(&_lock);
+    BOOL isStopped = !_started || _finished;
+    BOOL endsInput = !isStopped && !_inputEnded;
+    if (!isStopped && completion) {
+        [_completions addObject:[completion copy]];
+    }
+    _inputEnded = YES;
+    pthread_mutex_unlock(&_lock);
+    
+    __atomic_store_n(&_accepting, 0, __ATOMIC_RELEASE);
+    
+    if (isStopped) {
+        if (completion) {
+            BOOL cancelled = self.isCancelled;
+            dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+                completion(cancelled);
+            });
+        }
+    } else if (endsInput) {
+        // A submission which saw the pipeline accepting may still be enqueueing, and anything it
+        // queued after the close would never be parsed.
+        pthread_rwlock_wrlock(&_submitLock);
+        pthread_rwlock_unlock(&_submitLock);
+    
+        [_parseQueue close];
+    }
+}
+
+- (void)waitUntilFinished {
+    pthread_mutex_lock(&_lock);
+    while (_started && !_finished) {
+        pthread_cond_wait(&_finishedCondition, &_lock);
+    }
+    pthread_mutex_unlock(&_lock);
+}
+
+- (void)cancel {
+    __atomic_store_n(&_cancelled, 1, __ATOMIC_RELEASE);
+    __atomic_store_n(&_accepting, 0, __ATOMIC_RELEASE);
+    
+    pthread_mutex_lock(&_lock);
+    NSArray *queues = (_started) ? @[_parseQueue, _bakeQueue, _publishQueue] : nil;
+    pthread_mutex_unlock(&_lock);
+    
+    [queues makeObjectsPerformSelector:@selector(cancel)];
+}
+
+- (BOOL)isCancelled {
+    return __atomic_load_n(&_cancelled, __ATOMIC_ACQUIRE) != 0;
+}
+
+- (BOOL)isFinished {
+    pthread_mutex_lock(&_lock);
+    BOOL finished = _finished;
+    pthread_mutex_unlock(&_lock);
+    
+    return finished;
+}
+
+- (NSUInteger)processedCountForStage:(NSString *)stage {
+    return (NSUInteger)[self latencyForStage:stage].count;
+}
+
+- (double)throughputForStage:(NSString *)stage {
+    NSUInteger processedCount = [self processedCountForStage:stage];
+    
+    pthread_mutex_lock(&_lock);
+    uint64_t startTime = _startTime;
+    uint64_t endTime = (_finished) ? _finishTime : _ZCRPipelineNow();
+    BOOL started = _started;
+    pthread_mutex_unlock(&_lock);
+    
+    if (!started || endTime <= startTime) { return 0.0; }
+    return (double)processedCount / ((double)(endTime - startTime) / 1e9);
+}
+
+- (ZCREasyInstrumentationStatistics *)latencyForStage:(NSString *)stage {
+    return [_statistics snapshot][stage];
+}
+
+- (NSUInteger)stallCountForStage:(NSString *)stage {
+    return [self _queueForStage:stage].stallCount;
+}
+
+- (NSUInteger)errorCount {
+    return __atomic_load_n(&_errorCount, __ATOMIC_RELAXED);
+}
+
+- (void)resetStatistics {
+    [_statistics reset];
+    __atomic_store_n(&_errorCount, 0, __ATOMIC_RELAXED);
+    
+    pthread_mutex_lock(&_lock);
+    _startTime = _ZCRPipelineNow();
+    _finishTime = _startTime;
+    NSArray *queues = (_started) ? @[_parseQueue, _bakeQueue, _publishQueue] : nil;
+    pthread_mutex_unlock(&_lock);
+    
+    [queues makeObjectsPerformSelector:@selector(resetStallCount)];
+}
+
+- (NSString *)description {
+    NSMutableString *description = [NSMutableString stringWithString:[super description]];
+    for (NSString *stage in @[ZCREasyPipelineParseStage, ZCREasyPipelineBakeStage, ZCREasyPipelinePublishStage]) {
+        [description appendFormat:@" %@:%lu (%.1f/s, %lu stalls)", stage, (unsigned long)[self processedCountForStage:stage],
+         [self throughputForStage:stage], (unsigned long)[self stallCountForStage:stage]];
+    }
+    [description appendFormat:@" errors:%lu", (unsigned long)self.errorCount];
+    
+    return description;
+}
+
+
+#pragma mark Workers
+
+- (void)_parseWithWorker:(id)unused {
+    BOOL isRunning = YES;
+    while (isRunning) {
+        @autoreleasepool {
+            id input = [_parseQueue dequeueObject];
+            if (!input) {
+                isRunning = NO;
+                continue;
+            }
+    
+            uint64_t startTime = _ZCRPipelineNow();
+            NSError *error = nil;
+            NSArray *records = _runningParseBlock(input, &error);
+            [self _recordStage:ZCREasyPipelineParseStage startTime:startTime count:1];
+    
+            if (!records) {
+                [self _reportError:error ?: ZCREasyBakeParameterError(@"Could not parse input (%@).", input)
+                          forStage:ZCREasyPipelineParseStage value:input];
+                continue;
+            }
+    
+            for (id record in records) {
+                if (![_bakeQueue enqueueObject:record]) {
+                    isRunning = NO;
+                    break;
+                }
+            }
+        }
+    }
+    
+    if (__atomic_sub_fetch(&_activeParseWorkers, 1, __ATOMIC_ACQ_REL) == 0) {
+        [_bakeQueue close];
+    }
+    [self _workerDidStop];
+}
+
+- (void)_bakeWithWorker:(id)unused {
+    __strong id batch[_ZCR_PIPELINE_BAKE_BATCH];
+    
+    BOOL isRunning = YES;
+    while (isRunning) {
+        @autoreleasepool {
+            id firstRecord = [_bakeQueue dequeueObject];
+            if (!firstRecord) {
+                isRunning = NO;
+                continue;
+            }
+    
+            NSUInteger batchCount = 1;
+            batch[0] = firstRecord;
+            while (batchCount < _ZCR_PIPELINE_BAKE_BATCH && (batch[batchCount] = [_bakeQueue tryDequeueObject])) {
+                batchCount++;
+            }
+    
+            NSArray *records = [NSArray arrayWithObjects:batch count:batchCount];
+            for (NSUInteger i = 0; i < batchCount; i++) {
+                batch[i] = nil;
+            }
+    
+            uint64_t startTime = _ZCRPipelineNow();
+            NSDictionary *errors = nil;
+            NSArray *doughs = [_doughClass bakeAll:records identifierPath:_runningIdentifierPath recipe:_recipe
+                                           session:_runningSession errors:&errors];
+            [self _recordStage:ZCREasyPipelineBakeStage startTime:startTime count:batchCount];
+    
+            for (NSUInteger i = 0; i < batchCount && isRunning; i++) {
+                id dough = doughs[i];
+                if (!dough || dough == [NSNull null]) {
+                    [self _reportError:errors[@(i)] ?: ZCREasyBakeParameterError(@"Could not bake ingredients (%@).", records[i])
+                              forStage:ZCREasyPipelineBakeStage value:records[i]];
+                } else {
+                    isRunning = [_publishQueue enqueueObject:dough];
+                }
+            }
+        }
+    }
+    
+    if (__atomic_sub_fetch(&_activeBakeWorkers, 1, __ATOMIC_ACQ_REL) == 0) {
+        [_publishQueue close];
+    }
+    [self _workerDidStop];
+}
+
+- (void)_publishWithWorker:(id)unused {
+    BOOL isRunning = YES;
+    while (isRunning) {
+        @autoreleasepool {
+            id dough = [_publishQueue dequeueObject];
+            if (!dough) {
+                isRunning = NO;
+                continue;
+            }
+    
+            uint64_t startTime = _ZCRPipelineNow();
+            if (_runningPublishBlock) {
+                _runningPublishBlock(dough);
+            }
+            [self _recordStage:ZCREasyPipelinePublishStage startTime:startTime count:1];
+        }
+    }
+    
+    [self _workerDidStop];
+}
+
+
+#pragma mark Private utilities
+
+- (BOOL)_validateConfiguration:(NSError *__autoreleasing *)error {
+    if (![_doughClass isSubclassOfClass:[ZCREasyDough class]]) {
+        if (error) {
+            *error = ZCREasyBakeParameterError(@"The dough class (%@) is not a subclass of ZCREasyDough!", _doughClass);
+        }
+        return NO;
+    }
+    
+    if (![_recipe.propertyNames isSubsetOfSet:[_doughClass allPropertyNames]]) {
+        if (error) {
+            NSMutableSet *unknownNames = [_recipe.propertyNames mutableCopy];
+            [unknownNames minusSet:[_doughClass allPropertyNames]];
+            *error = ZCREasyBakeParameterError(@"The recipe contains unknown property names: %@", unknownNames);
+        }
+        return NO;
+    }
+    
+    // Checked now so that a bad path fails the start rather than every record.
+    return (!self.identifierPath ||
+            [[ZCREasyRecipe alloc] initWithName:nil ingredientMapping:@{ZCREasyDoughIdentifierKey: self.identifierPath}
+                         ingredientTransformers:nil error:error]);
+}
+
+- (void)_startWorkers:(NSUInteger)count forStage:(NSString *)stage selector:(SEL)selector {
+    for (NSUInteger i = 0; i < count; i++) {
+        NSThread *thread = [[NSThread alloc] initWithTarget:self selector:selector object:nil];
+        thread.name = [NSString stringWithFormat:@"com.zachradke.easyBake.pipeline.%@.%lu", stage, (unsigned long)i];
+        [thread start];
+    }
+}
+
+- (_ZCREasyPipelineQueue *)_queueForStage:(NSString *)stage {
+    pthread_mutex_lock(&_lock);
+    _ZCREasyPipelineQueue *queue = nil;
+    if ([stage isEqualToString:ZCREasyPipelineParseStage]) {
+        queue = _parseQueue;
+    } else if ([stage isEqualToString:ZCREasyPipelineBakeStage]) {
+        queue = _bakeQueue;
+    } else if ([stage isEqualToString:ZCREasyPipelinePublishStage]) {
+        queue = _publishQueue;
+    }
+    pthread_mutex_unlock(&_lock);
+    
+    return queue;
+}
+
+- (void)_recordStage:(NSString *)stage startTime:(uint64_t)startTime count:(NSUInteger)count {
+    uint64_t now = _ZCRPipelineNow();
+    uint64_t nanoseconds = ((now > startTime) ? now - startTime : 0) / count;
+    for (NSUInteger i = 0; i < count; i++) {
+        [_statistics recordEvent:stage nanoseconds:nanoseconds];
+    }
+}
+
+- (void)_reportError:(NSError *)error forStage:(NSString *)stage value:(id)value {
+    __atomic_add_fetch(&_errorCount, 1, __ATOMIC_RELAXED);
+    
+    if (_runningErrorBlock) {
+        _runningErrorBlock(stage, value, error);
+    }
+}
+
+// A cancelled stage can stop before the ones feeding it, so the pipeline only finishes once every
+// worker has stopped.
+- (void)_workerDidStop {
+    if (__atomic_sub_fetch(&_activeWorkers, 1, __ATOMIC_ACQ_REL) == 0) {
+        [self _didFinish];
+    }
+}
+
+- (void)_didFinish {
+    pthread_mutex_lock(&_lock);
+    _finished = YES;
+    _finishTime = _ZCRPipelineNow();
+    NSArray *completions = [_completions copy];
+    [_completions removeAllObjects];
+    pthread_cond_broadcast(&_finishedCondition);
+    pthread_mutex_unlock(&_lock);
+    
+    __atomic_store_n(&_accepting, 0, __ATOMIC_RELEASE);
+    
+    BOOL cancelled = self.isCancelled;
+    for (void (^completion)(BOOL) in completions) {
+        dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+            completion(cancelled);
+        });
+    }
+}
+
+@end
@@ -8,40 +8,42 @@
 
 #import "ZCREasyProperty.h"
 
-static inline NSString *_ZCRStringForPropertyAttribute(ZCREasyPropertyAttribute attribute) {
-    switch (attribute) {
-        case ZCREasyPropertyAttrType:
-            return @"T";
-        case ZCREasyPropertyAttrIVarName:
-            return @"V";
-        case ZCREasyPropertyAttrReadOnly:
-            return @"R";
-        case ZCREasyPropertyAttrCopy:
-            return @"C";
-        case ZCREasyPropertyAttrRetain:
-            return @"&";
-        case ZCREasyPropertyAttrNonAtomic:
-            return @"N";
-        case ZCREasyPropertyAttrCustomGetter:
-            return @"G";
-        case ZCREasyPropertyAttrCustomSetter:
-            return @"S";
-        case ZCREasyPropertyAttrDynamic:
-            return @"D";
-        case ZCREasyPropertyAttrWeak:
-            return @"W";
-        case ZCREasyPropertyAttrGarbageCollectable:
-            return @"P";
-        case ZCREasyPropertyAttrOldTypeEncoding:
-            return @"t";
+// Maps the leading character of an attribute to its attribute constant, or returns -1 if unknown.
+static inline NSInteger _ZCRPropertyAttributeForCharacter(char character) {
+    switch (character) {
+        case 'T':
+            return ZCREasyPropertyAttrType;
+        case 'V':
+            return ZCREasyPropertyAttrIVarName;
+        case 'R':
+            return ZCREasyPropertyAttrReadOnly;
+        case 'C':
+            return ZCREasyPropertyAttrCopy;
+        case '&':
+            return ZCREasyPropertyAttrRetain;
+        case 'N':
+            return ZCREasyPropertyAttrNonAtomic;
+        case 'G':
+            return ZCREasyPropertyAttrCustomGetter;
+        case 'S':
+            return ZCREasyPropertyAttrCustomSetter;
+        case 'D':
+            return ZCREasyPropertyAttrDynamic;
+        case 'W':
+            return ZCREasyPropertyAttrWeak;
+        case 'P':
+            return ZCREasyPropertyAttrGarbageCollectable;
+        case 't':
+            return ZCREasyPropertyAttrOldTypeEncoding;
         default:
-            return nil;
+            return -1;
     }
 }
 
 
 @implementation ZCREasyProperty {
     NSString *_attributeString;
+    uint32_t _attributeMask;
 }
 
 - (instancetype)initWithProperty:(objc_property_t)property {
@@ -51,11 +53,52 @@ static inline NSString *_ZCRStringForPropertyAttribute(ZCREasyPropertyAttribute
     
     _name = [NSString stringWithUTF8String:property_getName(property)];
     
-    _attributeString = [NSString stringWithUTF8String:property_getAttributes(property)];
-    _attributes = [NSSet setWithArray:[_attributeString componentsSeparatedByString:@","]];
+    const char *attributes = property_getAttributes(property);
+    _attributeString = [NSString stringWithUTF8String:attributes];
     
-    _type = [self _contextStringForAttribute:ZCREasyPropertyAttrType];
-    _iVarName = [self _contextStringForAttribute:ZCREasyPropertyAttrIVarName];
+    // The attributes are parsed in a single pass, recording which are present in a bit mask and
+    // keeping the context strings of the few attributes which have one.
+    NSMutableSet *attributeSet = [NSMutableSet set];
+    NSString *customGetterString = nil;
+    NSString *customSetterString = nil;
+    
+    const char *attributeStart = attributes;
+    while (attributeStart && *attributeStart) {
+        const char *attributeEnd = strchr(attributeStart, ',');
+        size_t length = (attributeEnd) ? (size_t)(attributeEnd - attributeStart) : strlen(attributeStart);
+        
+        NSString *attributeString = [[NSString alloc] initWithBytes:attributeStart length:length
+                                                           encoding:NSUTF8StringEncoding];
+        if (attributeString) {
+            [attributeSet addObject:attributeString];
+        }
+        
+        NSInteger attribute = _ZCRPropertyAttributeForCharacter(*attributeStart);
+        if (attribute >= 0) {
+            _attributeMask |= (1U << attribute);
+            
+            NSString *contextString = (length > 1) ? [attributeString substringFromIndex:1] : @"";
+            switch (attribute) {
+                case ZCREasyPropertyAttrType:
+                    _type = contextString;
+                    break;
+                case ZCREasyPropertyAttrIVarName:
+                    _iVarName = contextString;
+                    break;
+                case ZCREasyPropertyAttrCustomGetter:
+                    customGetterString = contextString;
+                    break;
+                case ZCREasyPropertyAttrCustomSetter:
+                    customSetterString = contextString;
+                    break;
+                default:
+                    break;
+            }
+        }
+        
+        attributeStart = (attributeEnd) ? attributeEnd + 1 : NULL;
+    }
+    _attributes = [attributeSet copy];
     
     _isReadOnly = [self hasAttribute:ZCREasyPropertyAttrReadOnly];
     _isWeak = [self hasAttribute:ZCREasyPropertyAttrWeak];
@@ -65,12 +108,10 @@ static inline NSString *_ZCRStringForPropertyAttribute(ZCREasyPropertyAttribute
         _typeClass = [self _parseTypeClassFromString:_type];
     }
     
-    NSString *customGetterString = [self _contextStringForAttribute:ZCREasyPropertyAttrCustomGetter];
     if (customGetterString.length > 0) {
         _customGetter = NSSelectorFromString(customGetterString);
     }
     
-    NSString *customSetterString = [self _contextStringForAttribute:ZCREasyPropertyAttrCustomSetter];
     if (customSetterString.length > 0) {
         _customSetter = NSSelectorFromString(customSetterString);
     }
@@ -86,16 +127,8 @@ static inline NSString *_ZCRStringForPropertyAttribute(ZCREasyPropertyAttribute
 }
 
 - (BOOL)hasAttribute:(ZCREasyPropertyAttribute)attribute {
-    NSPredicate *predicate = [NSPredicate predicateWithFormat:@"SELF BEGINSWITH %@",
-                              _ZCRStringForPropertyAttribute(attribute)];
-    return ([[_attributes filteredSetUsingPredicate:predicate] count] > 0);
-}
-
-- (NSString *)_contextStringForAttribute:(ZCREasyPropertyAttribute)attribute {
-    NSString *attributeIdentifier = _ZCRStringForPropertyAttribute(attribute);
-    NSPredicate *predicate = [NSPredicate predicateWithFormat:@"SELF BEGINSWITH %@", attributeIdentifier];
-    NSString *fullAttribute = [[_attributes filteredSetUsingPredicate:predicate] anyObject];
-    return [fullAttribute substringFromIndex:attributeIdentifier.length];
+    if (attribute < 0 || attribute > ZCREasyPropertyAttrOldTypeEncoding) { return NO; }
+    return (_attributeMask & (1U << attribute)) != 0;
 }
 
 - (Class)_parseTypeClassFromString:(NSString *)typeString {
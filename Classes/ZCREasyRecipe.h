@@ -8,8 +8,31 @@
 
 #import <Foundation/Foundation.h>
 
+@class ZCREasyTransformerCache, ZCREasyInternPool;
 @protocol ZCREasyRecipeMaker;
 
+/**
+ *  How a recipe handles raw ingredients which don't have the shape its ingredient paths expect,
+ *  such as a string where a path expects a dictionary, or an array too short for a path's index.
+ */
+typedef NS_ENUM(NSInteger, ZCREasyRecipeMismatchPolicy) {
+    /**
+     *  Processing stops at the first mismatched container and fails with a
+     *  ZCREasyBakeErrorMismatchedIngredients error. This is the default.
+     */
+    ZCREasyRecipeMismatchPolicyFailFast = 0,
+    /**
+     *  Properties which can't be reached are left out of the processed ingredients, as if their
+     *  ingredients were missing.
+     */
+    ZCREasyRecipeMismatchPolicySkipField,
+    /**
+     *  Properties which can't be reached are set to NSNull in the processed ingredients, without
+     *  being passed to their transformers.
+     */
+    ZCREasyRecipeMismatchPolicyNullField
+};
+
 /**
  *  A ZCREasyRecipe represents a set of instructions to follow for converting raw ingredients
  *  supplied by an external source into a cannonical dictionary of processed ingredients suitable
@@ -26,6 +49,16 @@
  *  path to "user[1]", since the object for the "user" key is assumed to be a dictionary in the
  *  first path, and an array in the second.
  *
+ *  The form "[*]" is a wildcard which maps every element of an array, for example "items[*].sku".
+ *  The property is then set to an array of the values found by following the rest of the path from
+ *  each element, with NSNull for elements which don't lead to a value. Every element is traversed
+ *  in the same pass, and the property's transformer is handed the whole array at once through
+ *  zcr_transformedValues:, so a ZCREasyDoughTransformer bakes all of the elements in a single
+ *  batch. The NSNull placeholders are left out of the array the transformer sees, while explicit
+ *  null values are transformed as nil, just as they are outside of a wildcard. A wildcard can't
+ *  share its array with fixed indexes, and wildcards may be nested to produce nested arrays, in
+ *  which case the transformer applies to the innermost elements.
+ *
  *  Recipes are immutable, so invoking copy on one will simply return self. Modifications can be
  *  made, but will produce new recipes. These recipes often only need to be created once and reused
  *  for a given ZCREasyDough subclass. To aid in this process, please see ZCREasyRecipeBox.
@@ -33,6 +66,18 @@
  *  To use a recipe outside of ZCREasyDough, the processIngredients: method can be used to follow
  *  the mapping and transformation instructions of a recipe to process raw ingredients.
  *
+ *  Expensive transformations of frequently repeated raw values, such as parsing dates, can be
+ *  memoized by giving the property a memoization limit. The recipe then keeps a bounded cache of
+ *  transformed values for that property, which is shared by every use of the recipe.
+ *
+ *  Properties whose values repeat across many records, such as enum-like strings, can be interned
+ *  by listing them in internedPropertyNames. Their processed NSString and NSNumber values are then
+ *  deduplicated through the recipe's internPool, so equal values share a single instance.
+ *
+ *  Ingredients are traversed with explicit type and bounds checks, so malformed ingredients never
+ *  raise exceptions. What happens to the properties they make unreachable is decided by the
+ *  recipe's mismatchPolicy.
+ *
  *  It shouldn't be required to subclass ZCREasyRecipe, though it is entirely possible to do so.
  */
 @interface ZCREasyRecipe : NSObject
@@ -55,10 +100,26 @@
  *                                been registered as NSValueTransformer names. This is optional, but
  *                                if present the property names must all exist in the ingredient
  *                                mapping, and all values be valid.
+ *  @param memoizationLimits      An NSDictionary of property names mapped to NSNumbers of the
+ *                                maximum number of transformed values to memoize for them. This is
+ *                                optional, but if present the property names must all have
+ *                                ingredient transformers, and all limits be greater than 0.
+ *                                Properties whose transformers don't allow memoization are not
+ *                                memoized.
  *  @param error                  An error pointer which may be populated upon a failure.
  *
  *  @return An immutable recipe for use by a ZCREasyDough subclass, or nil if an error occured.
  */
+- (instancetype)initWithName:(NSString *)name
+           ingredientMapping:(NSDictionary *)ingredientMapping
+      ingredientTransformers:(NSDictionary *)ingredientTransformers
+           memoizationLimits:(NSDictionary *)memoizationLimits error:(NSError **)error;
+
+/**
+ *  Creates an immutable recipe which memoizes none of its transformations.
+ *
+ *  @see initWithName:ingredientMapping:ingredientTransformers:memoizationLimits:error:
+ */
 - (instancetype)initWithName:(NSString *)name
            ingredientMapping:(NSDictionary *)ingredientMapping
       ingredientTransformers:(NSDictionary *)ingredientTransformers error:(NSError **)error;
@@ -66,7 +127,7 @@
 /**
  *  Builder for generating recipes.
  *
- *  @see initWithName:ingredientMapping:ingredientTransformers:error:, ZCREasyRecipeMaker
+ *  @see initWithName:ingredientMapping:ingredientTransformers:memoizationLimits:error:, ZCREasyRecipeMaker
  *
  *  @param constructionBlock A block which takes an object conforming to the ZCREasyRecipeMaker
  *                           protocol. This block will be executed once and then a recipe will be
@@ -77,7 +138,10 @@
 + (instancetype)makeWith:(void (^)(id<ZCREasyRecipeMaker> recipeMaker))constructionBlock __attribute__((nonnull));
 
 /**
- *  Builds a new recipe from an existing recipe, with modifications.
+ *  Builds a new recipe from an existing recipe, with modifications. Only the paths which were
+ *  added or changed are broken down again, and parts of the ingredient trie which no modified path
+ *  passes through are shared with the receiver rather than rebuilt and revalidated. Deriving many
+ *  variants of one large recipe therefore costs about as much as the instructions which differ.
  *
  *  @param modificationBlock A block which takes an object conforming to the ZCREasyRecipeMaker
  *                           protocol. This object will be pre-populated with attributes from the
@@ -106,9 +170,9 @@
 
 /**
  *  An NSDictionary mapping canonical property names to arrays of decomposed ingredient paths. These
- *  path components may be either NSStrings indicating a dictionary key to traverse, or NSNumbers
- *  indicating an array index to traverse. This is automatically generated from the provided
- *  ingredientMapping.
+ *  path components may be NSStrings indicating a dictionary key to traverse, NSNumbers indicating
+ *  an array index to traverse, or NSNull indicating a wildcard over every element of an array. This
+ *  is automatically generated from the provided ingredientMapping.
  */
 @property (strong, nonatomic, readonly) NSDictionary *ingredientMappingComponents;
 
@@ -119,6 +183,37 @@
  */
 @property (strong, nonatomic, readonly) NSDictionary *ingredientTransformers;
 
+/**
+ *  An NSDictionary of NSNumbers mapped to property names, limiting how many transformed values are
+ *  memoized for each property. This is empty if no transformations are memoized.
+ */
+@property (strong, nonatomic, readonly) NSDictionary *memoizationLimits;
+
+/**
+ *  An NSDictionary of ZCREasyTransformerCaches mapped to the property names whose transformations
+ *  they memoize. The caches report their hit rates, which is useful for tuning memoizationLimits.
+ */
+@property (strong, nonatomic, readonly) NSDictionary *transformerCaches;
+
+/**
+ *  How ingredients which don't match the ingredient paths are handled. This defaults to
+ *  ZCREasyRecipeMismatchPolicyFailFast, and can be changed through the ZCREasyRecipeMaker.
+ */
+@property (assign, nonatomic, readonly) ZCREasyRecipeMismatchPolicy mismatchPolicy;
+
+/**
+ *  An NSSet of the property names whose processed values are interned. This is empty if no values
+ *  are interned, and can be changed through the ZCREasyRecipeMaker.
+ */
+@property (strong, nonatomic, readonly) NSSet *internedPropertyNames;
+
+/**
+ *  The pool which interned values are deduplicated through. This is the shared pool unless the
+ *  ZCREasyRecipeMaker provides another, and nil if no values are interned. The pool reports how
+ *  many bytes interning has saved.
+ */
+@property (strong, nonatomic, readonly) ZCREasyInternPool *internPool;
+
 /**
  *  A convenience accessor for the property names registered in the ingredientMapping.
  */
@@ -145,6 +240,8 @@
  *  to an ingredient transformer, and if the ingredient transformer returns nil it will be converted
  *  to NSNull in the response.
  *
+ *  Containers which don't match the ingredient paths are handled according to the mismatchPolicy.
+ *
  *  @param ingredients The raw ingredients to process.
  *
  *  @return An NSDictionary where the keys are cannonical property names mapped from the ingredient
@@ -153,6 +250,81 @@
  */
 - (NSDictionary *)processIngredients:(id)ingredients error:(NSError **)error;
 
+/**
+ *  Processes raw ingredients like processIngredients:error:, while also reporting the properties
+ *  which couldn't be reached. This is useful with the skip and null field policies, which otherwise
+ *  drop mismatches silently.
+ *
+ *  @see processIngredients:error:
+ *
+ *  @param ingredients The raw ingredients to process.
+ *  @param mismatches  An optional pointer which will be populated with an NSDictionary mapping the
+ *                     name of every property that couldn't be reached to its ingredient path. If
+ *                     the ingredients matched, the dictionary will be empty. With the fail fast
+ *                     policy, only the mismatches up to the first mismatched container are listed.
+ *  @param error       An optional pointer to an error which will be populated if processing fails.
+ *
+ *  @return An NSDictionary of processed ingredients, or nil if an error occurs.
+ */
+- (NSDictionary *)processIngredients:(id)ingredients mismatches:(NSDictionary **)mismatches
+                               error:(NSError **)error;
+
+/**
+ *  Processes an array of raw ingredients in a single batch. This is equivalent to calling
+ *  processIngredients:error: for each element, but scratch containers are reused between elements
+ *  so large batches avoid most of the per-record allocations. A failure in one element does not
+ *  stop the batch.
+ *
+ *  @see processIngredients:error:
+ *
+ *  @param ingredientsArray An array of raw ingredients, each a dictionary or array. NSNull elements
+ *                          are treated as missing ingredients. This must not be nil.
+ *  @param errors           An optional pointer which will be populated with an NSDictionary mapping
+ *                          the NSNumber index of each failed element to its NSError. If there were
+ *                          no failures the dictionary will be empty.
+ *
+ *  @return An array of processed ingredient dictionaries in the same order as the input. Elements
+ *          which failed to process are represented by NSNull.
+ */
+- (NSArray *)processIngredientsArray:(NSArray *)ingredientsArray
+                              errors:(NSDictionary **)errors __attribute__((nonnull (1)));
+
+/**
+ *  Processes raw JSON data directly, without first deserializing the whole document. The data is
+ *  scanned once, and containers which no ingredient path leads into are skipped over without being
+ *  materialized, so only the values the recipe needs are ever allocated. The result is the same as
+ *  deserializing the data with NSJSONSerialization and passing it to processIngredients:error:,
+ *  except that the numbers and literals in skipped subtrees aren't validated. The structure of
+ *  skipped subtrees is, so mismatched brackets and missing commas or colons are still errors.
+ *
+ *  @see processIngredients:error:
+ *
+ *  @param JSONData UTF-8 encoded JSON data whose root is an object or array. This must not be nil.
+ *  @param error    An optional pointer to an error which may be populated if the data is malformed
+ *                  or does not match the recipe's ingredient paths.
+ *
+ *  @return An NSDictionary of processed ingredients, or nil if an error occurs.
+ */
+- (NSDictionary *)processJSONData:(NSData *)JSONData error:(NSError **)error __attribute__((nonnull (1)));
+
+/**
+ *  @name Instrumentation
+ */
+
+/**
+ *  Returns the measurements this recipe has recorded while ZCREasyInstrumentation was enabled. The
+ *  snapshot includes ZCREasyInstrumentationMappingEvent for every full processing pass, and a
+ *  transforming event per transformed property, such as "transforming.updatedAt".
+ *
+ *  @return An NSDictionary of ZCREasyInstrumentationStatistics keyed by event name.
+ */
+- (NSDictionary *)instrumentationSnapshot;
+
+/**
+ *  Discards the measurements this recipe has recorded.
+ */
+- (void)resetInstrumentation;
+
 @end
 
 /**
@@ -164,6 +336,11 @@
  *  recipes with the same name will result in only the first recipe being added and subsequent
  *  recipes being ignored. To re-register a name, the registered recipe must first be removed.
  *
+ *  Boxes are optimized for reading. Lookups through recipeWithName: read an immutable snapshot
+ *  without taking any locks. Adding a recipe takes constant time, and the first lookup to miss
+ *  afterwards publishes a new snapshot including it. Removing a recipe republishes the snapshot
+ *  right away, so it is comparatively expensive and best kept rare.
+ *
  *  For convenience, a singleton box is exposed which can be used throughout an app. However, it is
  *  completely reasonable to intialize an instance and maintain multiple boxes.
  *
@@ -194,6 +371,19 @@
  */
 - (BOOL)addRecipe:(ZCREasyRecipe *)recipe error:(NSError **)error;
 
+/**
+ *  Adds several recipes to the box at once. Either all of the recipes are added, or if any of them
+ *  is missing a name or has a name which is already registered, none of them are. Unlike adding
+ *  recipes one by one, the added recipes are published to readers immediately, so this is the
+ *  preferred way to register many recipes at launch.
+ *
+ *  @param recipes An array of recipes to add. This must not be nil.
+ *  @param error   An error pointer that will be populated if a failure occurs.
+ *
+ *  @return YES if the recipes were added, NO if they could not be added.
+ */
+- (BOOL)addRecipes:(NSArray *)recipes error:(NSError **)error;
+
 /**
  *  Creates a recipe using a builder block and adds it to the box.
  *
@@ -259,6 +449,32 @@
  */
 @property (copy, nonatomic) NSDictionary *ingredientTransformers;
 
+/**
+ *  The NSDictionary of memoization limits for transformed properties. The keys are canonical
+ *  property names and the values are NSNumbers greater than 0. This property is optional, but if
+ *  it is set all the keys must also be present in the ingredientTransformers keys.
+ */
+@property (copy, nonatomic) NSDictionary *memoizationLimits;
+
+/**
+ *  How ingredients which don't match the ingredient paths are handled. This defaults to
+ *  ZCREasyRecipeMismatchPolicyFailFast.
+ */
+@property (assign, nonatomic) ZCREasyRecipeMismatchPolicy mismatchPolicy;
+
+/**
+ *  The NSSet of property names whose processed values should be interned. Interning applies after
+ *  any transformer, to NSString and NSNumber values and to the elements of wildcard arrays, and
+ *  leaves other values as they are. This property is optional, but if it is set all the names must
+ *  also be present in the ingredientMapping keys.
+ */
+@property (copy, nonatomic) NSSet *internedPropertyNames;
+
+/**
+ *  The pool to intern values through. This is optional, and defaults to the shared pool.
+ */
+@property (strong, nonatomic) ZCREasyInternPool *internPool;
+
 /**
  *  Adds an entry to the ingredientMapping and ingredientTransformer dictionaries.
  *
@@ -275,7 +491,8 @@
                       transformer:(id)transformer error:(NSError **)error;
 
 /**
- *  Removes an entry from the ingredientMapping and ingredientTransformer dictionaries.
+ *  Removes an entry from the ingredientMapping, ingredientTransformer, and memoizationLimits
+ *  dictionaries, and from the internedPropertyNames.
  *
  *  @param propertyName The canonical property name to remove. This must not be nil and must be
  *                      one of the ingredientMapping keys.
@@ -296,3 +513,22 @@
 
 @end
 
+
+/**
+ *  Collection support for NSValueTransformer, used by recipes for properties mapped through a
+ *  wildcard.
+ */
+@interface NSValueTransformer (ZCREasyCollections)
+
+/**
+ *  Transforms every element of a collection at once. The default implementation invokes
+ *  transformedValue: for each element, passing nil for NSNull. Subclasses which can share work
+ *  between elements, such as validating a recipe once, can override this.
+ *
+ *  @param values The values to transform. NSNull stands in for missing values.
+ *
+ *  @return An array of the transformed values in the same order, with NSNull in place of nil.
+ */
+- (NSArray *)zcr_transformedValues:(NSArray *)values;
+
+@end
@@ -9,22 +9,519 @@
 #import "ZCREasyRecipe.h"
 
 #import "ZCREasyError.h"
+#import "ZCREasyInstrumentation.h"
+#import "ZCREasyInternPool.h"
+#import "ZCREasyTransformerCache.h"
+
+#import <errno.h>
+#import <math.h>
+#import <pthread.h>
+#import <sched.h>
 
 @interface _ZCREasyRecipeMaker : NSObject <ZCREasyRecipeMaker>
+@property (strong, nonatomic) ZCREasyRecipe *baseRecipe;
 - (ZCREasyRecipe *)makeRecipe;
 @end
 
+/**
+ *  A single node in a recipe's compiled ingredient trie. Paths sharing a prefix share the nodes for
+ *  that prefix, so each container in the ingredients is only visited once per processing pass.
+ */
+@interface _ZCREasyIngredientNode : NSObject
+- (instancetype)initWithPiece:(id)piece;
+@property (strong, nonatomic, readonly) NSString *key;
+@property (strong, nonatomic, readonly) NSData *keyData;
+@property (assign, nonatomic, readonly) NSUInteger index;
+@property (assign, nonatomic, readonly) BOOL isIndex;
+@property (assign, nonatomic, readonly) BOOL isWildcard;
+@property (assign, nonatomic, readonly) BOOL isCollected;
+@property (strong, nonatomic, readonly) NSArray *children;
+@property (strong, nonatomic, readonly) NSArray *propertyNames;
+@property (strong, nonatomic, readonly) NSArray *childKeys;
+@property (strong, nonatomic, readonly) NSArray *childSlots;
+@property (strong, nonatomic, readonly) NSData *JSONKeyData;
+@property (strong, nonatomic, readonly) NSArray *collectedPropertyNames;
+@property (strong, nonatomic, readonly) NSSet *transformedPropertyNames;
+- (BOOL)acceptsPiece:(id)piece;
+- (_ZCREasyIngredientNode *)childForPiece:(id)piece;
+- (_ZCREasyIngredientNode *)existingChildForPiece:(id)piece;
+- (void)adoptChild:(_ZCREasyIngredientNode *)child forPiece:(id)piece;
+- (void)addPropertyName:(NSString *)propertyName;
+- (void)compileLayout;
+@end
+
+@interface ZCREasyRecipe ()
+@property (strong, nonatomic, readonly) _ZCREasyIngredientNode *ingredientTrie;
+@property (strong, nonatomic, readonly) ZCREasyInstrumentationRecorder *instrumentation;
+@property (strong, nonatomic, readonly) NSDictionary *transformingEvents;
+@property (assign, nonatomic, readwrite) ZCREasyRecipeMismatchPolicy mismatchPolicy;
+@property (strong, nonatomic, readwrite) NSSet *internedPropertyNames;
+@property (strong, nonatomic, readwrite) ZCREasyInternPool *internPool;
+- (instancetype)_initWithName:(NSString *)name
+            ingredientMapping:(NSDictionary *)ingredientMapping
+       ingredientTransformers:(NSDictionary *)ingredientTransformers
+            memoizationLimits:(NSDictionary *)memoizationLimits
+                   baseRecipe:(ZCREasyRecipe *)baseRecipe
+                        error:(NSError **)error;
+@end
+
+
+#pragma mark - JSON scanning
+
+/**
+ *  A cursor over raw JSON bytes. Failures are recorded as a static reason so that scanning never
+ *  allocates until an error is actually reported.
+ */
+typedef struct {
+    const uint8_t *start;
+    const uint8_t *cursor;
+    const uint8_t *end;
+    const char *failureReason;
+} _ZCRJSONScanner;
+
+static inline BOOL _ZCRJSONFail(_ZCRJSONScanner *scanner, const char *failureReason) {
+    if (!scanner->failureReason) {
+        scanner->failureReason = failureReason;
+    }
+    return NO;
+}
+
+static inline void _ZCRJSONSkipWhitespace(_ZCRJSONScanner *scanner) {
+    while (scanner->cursor < scanner->end) {
+        uint8_t c = *scanner->cursor;
+        if (c != ' ' && c != '\n' && c != '\r' && c != '\t') { return; }
+        scanner->cursor++;
+    }
+}
+
+static inline BOOL _ZCRJSONConsume(_ZCRJSONScanner *scanner, uint8_t expected) {
+    _ZCRJSONSkipWhitespace(scanner);
+    if (scanner->cursor < scanner->end && *scanner->cursor == expected) {
+        scanner->cursor++;
+        return YES;
+    }
+    return NO;
+}
+
+// Moves past a string whose opening quote was already consumed, noting if it contains escapes.
+static BOOL _ZCRJSONSkipStringBody(_ZCRJSONScanner *scanner, BOOL *hasEscapes) {
+    while (scanner->cursor < scanner->end) {
+        uint8_t c = *scanner->cursor++;
+        if (c == '"') {
+            return YES;
+        } else if (c == '\\') {
+            if (hasEscapes) { *hasEscapes = YES; }
+            scanner->cursor++;
+        } else if (c < 0x20) {
+            return _ZCRJSONFail(scanner, "Unescaped control character in string");
+        }
+    }
+    return _ZCRJSONFail(scanner, "Unterminated string");
+}
+
+// The deepest nesting a skipped value may have, which matches NSJSONSerialization's own limit.
+#define _ZCR_JSON_MAX_DEPTH 512
+
+// Moves past an object key and its colon.
+static BOOL _ZCRJSONSkipKey(_ZCRJSONScanner *scanner) {
+    if (!_ZCRJSONConsume(scanner, '"')) {
+        return _ZCRJSONFail(scanner, "Expected a key");
+    }
+    if (!_ZCRJSONSkipStringBody(scanner, NULL)) { return NO; }
+    
+    return (_ZCRJSONConsume(scanner, ':')) ? YES : _ZCRJSONFail(scanner, "Expected ':' after key");
+}
+
+// Moves past a scalar, which runs until the next structural character or whitespace.
+static BOOL _ZCRJSONSkipScalar(_ZCRJSONScanner *scanner) {
+    const uint8_t *valueStart = scanner->cursor;
+    while (scanner->cursor < scanner->end) {
+        uint8_t c = *scanner->cursor;
+        if (c == ',' || c == ':' || c == '{' || c == '}' || c == '[' || c == ']' || c == '"' ||
+            c == ' ' || c == '\n' || c == '\r' || c == '\t') {
+            break;
+        }
+        scanner->cursor++;
+    }
+    return (scanner->cursor > valueStart) ? YES : _ZCRJSONFail(scanner, "Expected a value");
+}
+
+// Moves past a value without materializing it. Containers are checked against a stack of their
+// openers, one bit per level, so that every bracket matches and entries are separated by commas
+// and colons. Scalars are only delimited here, and are validated if they are ever parsed.
+static BOOL _ZCRJSONSkipValue(_ZCRJSONScanner *scanner) {
+    uint64_t objectLevels[_ZCR_JSON_MAX_DEPTH / 64];
+    NSUInteger depth = 0;
+    
+    while (YES) {
+        _ZCRJSONSkipWhitespace(scanner);
+        if (scanner->cursor >= scanner->end) {
+            return _ZCRJSONFail(scanner, (depth > 0) ? "Unterminated container" : "Unexpected end of data");
+        }
+    
+        uint8_t c = *scanner->cursor;
+        if (c == '"') {
+            scanner->cursor++;
+            if (!_ZCRJSONSkipStringBody(scanner, NULL)) { return NO; }
+        } else if (c == '{' || c == '[') {
+            if (depth == _ZCR_JSON_MAX_DEPTH) {
+                return _ZCRJSONFail(scanner, "Too deeply nested");
+            }
+    
+            scanner->cursor++;
+            BOOL isObject = (c == '{');
+            if (isObject) {
+                objectLevels[depth / 64] |= (1ULL << (depth % 64));
+            } else {
+                objectLevels[depth / 64] &= ~(1ULL << (depth % 64));
+            }
+            depth++;
+    
+            // Empty containers close right away, otherwise their first entry follows.
+            if (!_ZCRJSONConsume(scanner, (isObject) ? '}' : ']')) {
+                if (isObject && !_ZCRJSONSkipKey(scanner)) { return NO; }
+                continue;
+            }
+            depth--;
+        } else if (c == '}' || c == ']' || c == ',' || c == ':') {
+            return _ZCRJSONFail(scanner, "Expected a value");
+        } else if (!_ZCRJSONSkipScalar(scanner)) {
+            return NO;
+        }
+    
+        // A value is complete, so each open container either continues with a comma or closes.
+        while (depth > 0) {
+            BOOL isObject = (objectLevels[(depth - 1) / 64] & (1ULL << ((depth - 1) % 64))) != 0;
+            if (_ZCRJSONConsume(scanner, ',')) {
+                if (isObject && !_ZCRJSONSkipKey(scanner)) { return NO; }
+                break;
+            }
+            if (!_ZCRJSONConsume(scanner, (isObject) ? '}' : ']')) {
+                return _ZCRJSONFail(scanner, (scanner->cursor < scanner->end) ?
+                                    "Mismatched bracket or missing comma" : "Unterminated container");
+            }
+            depth--;
+        }
+        if (depth == 0) { return YES; }
+    }
+}
+
+static inline BOOL _ZCRJSONMatchLiteral(_ZCRJSONScanner *scanner, const char *literal, size_t length) {
+    if ((size_t)(scanner->end - scanner->cursor) < length ||
+        memcmp(scanner->cursor, literal, length) != 0) {
+        return NO;
+    }
+    scanner->cursor += length;
+    return YES;
+}
+
+static inline const uint8_t *_ZCRJSONSkipDigits(const uint8_t *cursor, const uint8_t *end) {
+    while (cursor < end && *cursor >= '0' && *cursor <= '9') { cursor++; }
+    return cursor;
+}
+
+// Whether the bytes are exactly a JSON number, -?(0|[1-9][0-9]*)(.[0-9]+)?([eE][+-]?[0-9]+)?, which
+// strtoll and strtod are more lenient than.
+static BOOL _ZCRJSONIsValidNumber(const uint8_t *cursor, const uint8_t *end) {
+    if (cursor < end && *cursor == '-') { cursor++; }
+    
+    if (cursor < end && *cursor == '0') {
+        cursor++;
+    } else if (cursor < end && *cursor >= '1' && *cursor <= '9') {
+        cursor = _ZCRJSONSkipDigits(cursor + 1, end);
+    } else {
+        return NO;
+    }
+    
+    if (cursor < end && *cursor == '.') {
+        const uint8_t *fractionStart = cursor + 1;
+        cursor = _ZCRJSONSkipDigits(fractionStart, end);
+        if (cursor == fractionStart) { return NO; }
+    }
+    
+    if (cursor < end && (*cursor == 'e' || *cursor == 'E')) {
+        cursor++;
+        if (cursor < end && (*cursor == '+' || *cursor == '-')) { cursor++; }
+        const uint8_t *exponentStart = cursor;
+        cursor = _ZCRJSONSkipDigits(exponentStart, end);
+        if (cursor == exponentStart) { return NO; }
+    }
+    
+    return cursor == end;
+}
+
+// Materializes the value at the cursor. Plain strings, numbers and literals are decoded directly,
+// while containers and escaped strings are handed to NSJSONSerialization, which only ever sees the
+// bytes of this single value.
+static id _ZCRJSONParseValue(_ZCRJSONScanner *scanner) {
+    _ZCRJSONSkipWhitespace(scanner);
+    if (scanner->cursor >= scanner->end) {
+        _ZCRJSONFail(scanner, "Unexpected end of data");
+        return nil;
+    }
+    
+    const uint8_t *valueStart = scanner->cursor;
+    uint8_t c = *valueStart;
+    
+    if (c == '"') {
+        scanner->cursor++;
+        BOOL hasEscapes = NO;
+        if (!_ZCRJSONSkipStringBody(scanner, &hasEscapes)) { return nil; }
+        
+        if (!hasEscapes) {
+            NSString *string = [[NSString alloc] initWithBytes:valueStart + 1
+                                                        length:(NSUInteger)(scanner->cursor - valueStart - 2)
+                                                      encoding:NSUTF8StringEncoding];
+            if (!string) { _ZCRJSONFail(scanner, "Invalid UTF-8 in string"); }
+            return string;
+        }
+    } else if (c == 't' || c == 'f' || c == 'n') {
+        if (_ZCRJSONMatchLiteral(scanner, "true", 4)) { return @YES; }
+        if (_ZCRJSONMatchLiteral(scanner, "false", 5)) { return @NO; }
+        if (_ZCRJSONMatchLiteral(scanner, "null", 4)) { return [NSNull null]; }
+        _ZCRJSONFail(scanner, "Invalid literal");
+        return nil;
+    } else if (c == '-' || (c >= '0' && c <= '9')) {
+        BOOL isInteger = YES;
+        while (scanner->cursor < scanner->end) {
+            c = *scanner->cursor;
+            if (c == '.' || c == 'e' || c == 'E') {
+                isInteger = NO;
+            } else if (c != '-' && c != '+' && !(c >= '0' && c <= '9')) {
+                break;
+            }
+            scanner->cursor++;
+        }
+        
+        if (!_ZCRJSONIsValidNumber(valueStart, scanner->cursor)) {
+            _ZCRJSONFail(scanner, "Malformed number");
+            return nil;
+        }
+        
+        char buffer[64];
+        size_t length = (size_t)(scanner->cursor - valueStart);
+        if (length < sizeof(buffer)) {
+            memcpy(buffer, valueStart, length);
+            buffer[length] = '\0';
+            
+            char *parsedEnd = NULL;
+            errno = 0;
+            if (isInteger) {
+                long long integer = strtoll(buffer, &parsedEnd, 10);
+                if (errno == 0 && parsedEnd == buffer + length) { return @(integer); }
+            } else {
+                double real = strtod(buffer, &parsedEnd);
+                if (errno == 0 && parsedEnd == buffer + length) { return @(real); }
+            }
+        }
+    } else if (c != '{' && c != '[') {
+        _ZCRJSONFail(scanner, "Unexpected character");
+        return nil;
+    }
+    
+    scanner->cursor = valueStart;
+    if (!_ZCRJSONSkipValue(scanner)) { return nil; }
+    
+    NSData *valueData = [NSData dataWithBytesNoCopy:(void *)valueStart
+                                             length:(NSUInteger)(scanner->cursor - valueStart)
+                                       freeWhenDone:NO];
+    id value = [NSJSONSerialization JSONObjectWithData:valueData
+                                               options:NSJSONReadingAllowFragments error:NULL];
+    if (!value) { _ZCRJSONFail(scanner, "Malformed value"); }
+    return value;
+}
+
+// Finds the child node for a raw object key, comparing bytes unless the key needs unescaping.
+static _ZCREasyIngredientNode *_ZCRJSONChildForKey(NSArray *children, const uint8_t *keyBytes,
+                                                   NSUInteger keyLength, BOOL hasEscapes) {
+    NSString *decodedKey = nil;
+    if (hasEscapes) {
+        NSData *quotedKey = [NSData dataWithBytesNoCopy:(void *)(keyBytes - 1) length:keyLength + 2
+                                           freeWhenDone:NO];
+        decodedKey = [NSJSONSerialization JSONObjectWithData:quotedKey
+                                                     options:NSJSONReadingAllowFragments error:NULL];
+    }
+    
+    for (_ZCREasyIngredientNode *child in children) {
+        if (decodedKey) {
+            if ([child.key isEqualToString:decodedKey]) { return child; }
+        } else if (child.keyData.length == keyLength &&
+                   memcmp(child.keyData.bytes, keyBytes, keyLength) == 0) {
+            return child;
+        }
+    }
+    return nil;
+}
+
+static _ZCREasyIngredientNode *_ZCRJSONChildForIndex(NSArray *children, NSUInteger index) {
+    for (_ZCREasyIngredientNode *child in children) {
+        if (child.index == index) { return child; }
+    }
+    return nil;
+}
+
+
+#pragma mark - JSON writing
+
+static inline void _ZCRJSONAppend(NSMutableData *data, const char *bytes, size_t length) {
+    [data appendBytes:bytes length:length];
+}
+
+static void _ZCRJSONAppendString(NSMutableData *data, NSString *string) {
+    // The bytes are walked by their length rather than to a terminator, since the string may
+    // contain U+0000.
+    NSData *UTF8Data = nil;
+    const char *bytes = CFStringGetCStringPtr((__bridge CFStringRef)string, kCFStringEncodingUTF8);
+    size_t length = 0;
+    if (bytes) {
+        length = [string lengthOfBytesUsingEncoding:NSUTF8StringEncoding];
+    } else {
+        UTF8Data = [string dataUsingEncoding:NSUTF8StringEncoding];
+        bytes = (const char *)[UTF8Data bytes];
+        length = [UTF8Data length];
+    }
+    const char *end = bytes + length;
+    
+    static const char hexDigits[] = "0123456789abcdef";
+    _ZCRJSONAppend(data, "\"", 1);
+    
+    // Runs of characters which need no escaping are appended in one go.
+    const char *runStart = bytes;
+    for (const char *cursor = bytes; cursor < end; cursor++) {
+        unsigned char c = (unsigned char)*cursor;
+        if (c != '"' && c != '\\' && c >= 0x20) { continue; }
+        
+        _ZCRJSONAppend(data, runStart, (size_t)(cursor - runStart));
+        runStart = cursor + 1;
+        
+        switch (c) {
+            case '"': _ZCRJSONAppend(data, "\\\"", 2); break;
+            case '\\': _ZCRJSONAppend(data, "\\\\", 2); break;
+            case '\n': _ZCRJSONAppend(data, "\\n", 2); break;
+            case '\r': _ZCRJSONAppend(data, "\\r", 2); break;
+            case '\t': _ZCRJSONAppend(data, "\\t", 2); break;
+            default: {
+                char escape[6] = {'\\', 'u', '0', '0', hexDigits[c >> 4], hexDigits[c & 0xF]};
+                _ZCRJSONAppend(data, escape, sizeof(escape));
+                break;
+            }
+        }
+    }
+    _ZCRJSONAppend(data, runStart, (size_t)(end - runStart));
+    _ZCRJSONAppend(data, "\"", 1);
+}
+
+static BOOL _ZCRJSONAppendNumber(NSMutableData *data, NSNumber *number) {
+    if (CFGetTypeID((__bridge CFTypeRef)number) == CFBooleanGetTypeID()) {
+        if ([number boolValue]) {
+            _ZCRJSONAppend(data, "true", 4);
+        } else {
+            _ZCRJSONAppend(data, "false", 5);
+        }
+        return YES;
+    }
+    
+    char buffer[32];
+    int length;
+    switch (*[number objCType]) {
+        case 'f':
+        case 'd': {
+            double real = [number doubleValue];
+            if (isnan(real) || isinf(real)) { return NO; }
+    
+            // The fewest digits which round-trip are written, which avoids writing 0.1 as
+            // 0.10000000000000001, and 17 digits always round-trip.
+            length = snprintf(buffer, sizeof(buffer), "%.15g", real);
+            if (strtod(buffer, NULL) != real) {
+                length = snprintf(buffer, sizeof(buffer), "%.16g", real);
+            }
+            if (strtod(buffer, NULL) != real) {
+                length = snprintf(buffer, sizeof(buffer), "%.17g", real);
+            }
+            break;
+        }
+        case 'Q':
+            length = snprintf(buffer, sizeof(buffer), "%llu", [number unsignedLongLongValue]);
+            break;
+        default:
+            length = snprintf(buffer, sizeof(buffer), "%lld", [number longLongValue]);
+            break;
+    }
+    
+    _ZCRJSONAppend(data, buffer, (size_t)length);
+    return YES;
+}
+
+// Appends any JSON compatible value, returning NO for values JSON cannot represent.
+static BOOL _ZCRJSONAppendValue(NSMutableData *data, id value) {
+    if ([value isKindOfClass:[NSString class]]) {
+        _ZCRJSONAppendString(data, value);
+    } else if ([value isKindOfClass:[NSNumber class]]) {
+        return _ZCRJSONAppendNumber(data, value);
+    } else if (!value || value == [NSNull null]) {
+        _ZCRJSONAppend(data, "null", 4);
+    } else if ([value isKindOfClass:[NSDictionary class]]) {
+        __block BOOL isValid = YES;
+        __block BOOL isFirst = YES;
+        _ZCRJSONAppend(data, "{", 1);
+        [value enumerateKeysAndObjectsUsingBlock:^(id key, id object, BOOL *stop) {
+            if (![key isKindOfClass:[NSString class]]) {
+                isValid = NO;
+                *stop = YES;
+                return;
+            }
+            if (!isFirst) { _ZCRJSONAppend(data, ",", 1); }
+            isFirst = NO;
+            
+            _ZCRJSONAppendString(data, key);
+            _ZCRJSONAppend(data, ":", 1);
+            if (!_ZCRJSONAppendValue(data, object)) {
+                isValid = NO;
+                *stop = YES;
+            }
+        }];
+        _ZCRJSONAppend(data, "}", 1);
+        return isValid;
+    } else if ([value isKindOfClass:[NSArray class]]) {
+        _ZCRJSONAppend(data, "[", 1);
+        NSUInteger index = 0;
+        for (id object in value) {
+            if (index++ > 0) { _ZCRJSONAppend(data, ",", 1); }
+            if (!_ZCRJSONAppendValue(data, object)) { return NO; }
+        }
+        _ZCRJSONAppend(data, "]", 1);
+    } else {
+        return NO;
+    }
+    
+    return YES;
+}
+
 
 #pragma mark - ZCREasyRecipe
 
-@implementation ZCREasyRecipe
+@implementation ZCREasyRecipe {
+    NSUInteger _hash;
+    int _hasHash;
+}
 
 #pragma mark Public API
 
 - (instancetype)initWithName:(NSString *)name
            ingredientMapping:(NSDictionary *)ingredientMapping
       ingredientTransformers:(NSDictionary *)ingredientTransformers
+           memoizationLimits:(NSDictionary *)memoizationLimits
                        error:(NSError *__autoreleasing *)error {
+    return [self _initWithName:name ingredientMapping:ingredientMapping ingredientTransformers:ingredientTransformers
+             memoizationLimits:memoizationLimits baseRecipe:nil error:error];
+}
+
+- (instancetype)_initWithName:(NSString *)name
+            ingredientMapping:(NSDictionary *)ingredientMapping
+       ingredientTransformers:(NSDictionary *)ingredientTransformers
+            memoizationLimits:(NSDictionary *)memoizationLimits
+                   baseRecipe:(ZCREasyRecipe *)baseRecipe
+                        error:(NSError *__autoreleasing *)error {
     if (!ingredientMapping) {
         if (error) {
             *error = ZCREasyBakeParameterError(@"Missing ingredient mapping!");
@@ -32,10 +529,18 @@
         return nil;
     }
     
+    // Recipes made by modifyWith: start from the recipe they modify, whose unchanged paths are
+    // already broken down and compiled.
     NSDictionary *ingredientComponents = [[self class] _breakDownMapping:ingredientMapping
+                                                              baseRecipe:baseRecipe
                                                                    error:error];
     if (!ingredientComponents) { return nil; }
     
+    _ZCREasyIngredientNode *ingredientTrie = [[self class] _compileIngredientComponents:ingredientComponents
+                                                                             baseRecipe:baseRecipe
+                                                                                  error:error];
+    if (!ingredientTrie) { return nil; }
+    
     NSSet *propertyNames = [NSSet setWithArray:[ingredientMapping allKeys]];
     
     ingredientTransformers = [[self class] _normalizeTransformers:ingredientTransformers
@@ -43,6 +548,11 @@
                                                             error:error];
     if (!ingredientTransformers) { return nil; }
     
+    memoizationLimits = [[self class] _normalizeMemoizationLimits:memoizationLimits
+                                                     transformers:ingredientTransformers
+                                                            error:error];
+    if (!memoizationLimits) { return nil; }
+    
     if (!(self = [super init])) { return nil; }
     
     _name = [name copy];
@@ -50,10 +560,32 @@
     _ingredientMappingComponents = ingredientComponents;
     _propertyNames = propertyNames;
     _ingredientTransformers = ingredientTransformers;
+    _memoizationLimits = memoizationLimits;
+    _internedPropertyNames = [NSSet set];
+    _transformerCaches = [[self class] _transformerCachesForLimits:memoizationLimits
+                                                       transformers:ingredientTransformers];
+    _ingredientTrie = ingredientTrie;
+    
+    // Event names are built up front so that instrumented transformations don't allocate them.
+    _instrumentation = [[ZCREasyInstrumentationRecorder alloc] initWithSubject:_name];
+    NSMutableDictionary *transformingEvents = [NSMutableDictionary dictionaryWithCapacity:[ingredientTransformers count]];
+    for (NSString *propertyName in ingredientTransformers) {
+        transformingEvents[propertyName] = baseRecipe.transformingEvents[propertyName] ?:
+            [NSString stringWithFormat:@"%@.%@", ZCREasyInstrumentationTransformingEvent, propertyName];
+    }
+    _transformingEvents = [transformingEvents copy];
     
     return self;
 }
 
+- (instancetype)initWithName:(NSString *)name
+           ingredientMapping:(NSDictionary *)ingredientMapping
+      ingredientTransformers:(NSDictionary *)ingredientTransformers
+                       error:(NSError *__autoreleasing *)error {
+    return [self initWithName:name ingredientMapping:ingredientMapping
+       ingredientTransformers:ingredientTransformers memoizationLimits:nil error:error];
+}
+
 + (instancetype)makeWith:(void (^)(id<ZCREasyRecipeMaker>))constructionBlock {
     NSParameterAssert(constructionBlock);
     
@@ -67,9 +599,14 @@
     NSParameterAssert(modificationBlock);
     
     _ZCREasyRecipeMaker *maker = [[_ZCREasyRecipeMaker alloc] init];
+    maker.baseRecipe = self;
     maker.name = self.name;
     maker.ingredientMapping = self.ingredientMapping;
     maker.ingredientTransformers = self.ingredientTransformers;
+    maker.memoizationLimits = self.memoizationLimits;
+    maker.mismatchPolicy = self.mismatchPolicy;
+    maker.internedPropertyNames = self.internedPropertyNames;
+    maker.internPool = self.internPool;
     modificationBlock(maker);
     
     return [maker makeRecipe];
@@ -77,17 +614,95 @@
 
 - (NSDictionary *)processIngredients:(id)ingredients
                                error:(NSError *__autoreleasing *)error {
+    return [self processIngredients:ingredients mismatches:NULL error:error];
+}
+
+- (NSDictionary *)processIngredients:(id)ingredients
+                          mismatches:(NSDictionary *__autoreleasing *)mismatches
+                               error:(NSError *__autoreleasing *)error {
+    if (mismatches) {
+        *mismatches = [NSDictionary dictionary];
+    }
+    
     // We treat no ingredients as success
     if (!ingredients) { return [NSDictionary dictionary]; }
     
-    id ingredientValue;
-    NSMutableDictionary *processedIngredients = [NSMutableDictionary dictionary];
+    NSMutableDictionary *processedIngredients = [NSMutableDictionary dictionaryWithCapacity:[self.propertyNames count]];
+    NSMutableDictionary *foundMismatches;
+    
+    BOOL didProcess = [self _processIngredients:ingredients into:processedIngredients
+                                     mismatches:&foundMismatches error:error];
+    if (mismatches && foundMismatches) {
+        *mismatches = [foundMismatches copy];
+    }
+    
+    return (didProcess) ? [processedIngredients copy] : nil;
+}
+
+- (NSArray *)processIngredientsArray:(NSArray *)ingredientsArray
+                              errors:(NSDictionary *__autoreleasing *)errors {
+    NSParameterAssert(ingredientsArray);
+    
+    NSMutableArray *processedArray = [NSMutableArray arrayWithCapacity:[ingredientsArray count]];
+    NSMutableDictionary *mutableErrors = [NSMutableDictionary dictionary];
+    
+    // A single scratch dictionary is reused for every record and only copied out on success.
+    NSMutableDictionary *scratchIngredients = [NSMutableDictionary dictionaryWithCapacity:[self.propertyNames count]];
+    
+    NSError *error;
+    NSUInteger index = 0;
+    for (id ingredients in ingredientsArray) {
+        [scratchIngredients removeAllObjects];
+        error = nil;
+        
+        if (ingredients == [NSNull null]) {
+            [processedArray addObject:[NSDictionary dictionary]];
+        } else if ([self _processIngredients:ingredients into:scratchIngredients error:&error]) {
+            [processedArray addObject:[scratchIngredients copy]];
+        } else {
+            [processedArray addObject:[NSNull null]];
+            mutableErrors[@(index)] = error;
+        }
+        index++;
+    }
+    
+    if (errors) {
+        *errors = [mutableErrors copy];
+    }
+    
+    return [processedArray copy];
+}
+
+- (NSDictionary *)processJSONData:(NSData *)JSONData error:(NSError *__autoreleasing *)error {
+    if (!JSONData) {
+        if (error) {
+            *error = ZCREasyBakeParameterError(@"Missing JSON data!");
+        }
+        return nil;
+    }
+    
+    const uint8_t *bytes = [JSONData bytes];
+    _ZCRJSONScanner scanner = {bytes, bytes, bytes + [JSONData length], NULL};
+    
+    // A UTF-8 byte order mark is allowed before the root value.
+    if ([JSONData length] >= 3 && memcmp(bytes, "\xEF\xBB\xBF", 3) == 0) {
+        scanner.cursor += 3;
+    }
+    
+    NSMutableDictionary *processedIngredients = [NSMutableDictionary dictionaryWithCapacity:[self.propertyNames count]];
+    NSMutableDictionary *mismatches;
+    BOOL didProcess = NO;
+    
+    BOOL isInstrumented = ZCREasyInstrumentationIsEnabled();
+    uint64_t startTime = (isInstrumented) ? ZCREasyInstrumentationBegin(self.instrumentation, ZCREasyInstrumentationMappingEvent) : 0;
     
     @try {
-        for (NSString *propertyName in self.propertyNames) {
-            ingredientValue = [self _valueForProperty:propertyName ingredients:ingredients];
-            if (ingredientValue) {
-                processedIngredients[propertyName] = ingredientValue;
+        didProcess = [self _processJSONNode:self.ingredientTrie scanner:&scanner
+                       processedIngredients:processedIngredients mismatches:&mismatches];
+        if (didProcess) {
+            _ZCRJSONSkipWhitespace(&scanner);
+            if (scanner.cursor < scanner.end) {
+                didProcess = _ZCRJSONFail(&scanner, "Unexpected data after the root value");
             }
         }
     }
@@ -97,10 +712,35 @@
         }
         return nil;
     }
+    @finally {
+        if (isInstrumented) {
+            ZCREasyInstrumentationEnd(self.instrumentation, ZCREasyInstrumentationMappingEvent, startTime);
+        }
+    }
+    
+    if (!didProcess) {
+        // Stopping at a mismatch is the only failure which doesn't record a scanner failure.
+        if (error && !scanner.failureReason && mismatches) {
+            *error = ZCREasyBakeMismatchError(mismatches);
+        } else if (error) {
+            unsigned long offset = (unsigned long)(MIN(scanner.cursor, scanner.end) - scanner.start);
+            *error = ZCREasyBakeParameterError(@"Invalid JSON data at offset %lu: %s.", offset,
+                                               scanner.failureReason ?: "Unknown failure");
+        }
+        return nil;
+    }
     
     return [processedIngredients copy];
 }
 
+- (NSDictionary *)instrumentationSnapshot {
+    return [self.instrumentation snapshot];
+}
+
+- (void)resetInstrumentation {
+    [self.instrumentation reset];
+}
+
 - (void)enumerateInstructionsWith:(void (^)(NSString *, NSString *, NSValueTransformer *, BOOL *))block {
     NSParameterAssert(block);
     
@@ -153,7 +793,44 @@
 }
 
 - (NSUInteger)hash {
-    return [self.name hash] ^ [self.ingredientMapping hash] ^ [self.ingredientTransformers hash];
+    // Recipes don't change once they are made, and makers set the readwrite properties before
+    // returning them, so the hash is only computed once.
+    if (__atomic_load_n(&_hasHash, __ATOMIC_ACQUIRE)) { return _hash; }
+    
+    // Foundation collections only hash their counts, so the entries are mixed in to tell recipes of
+    // the same size apart. Entries are summed, which doesn't depend on their order. Transformers
+    // are compared with isEqual:, so only their property names are hashed.
+    NSUInteger mappingHash = 0;
+    for (NSString *propertyName in self.ingredientMapping) {
+        mappingHash += [propertyName hash] * 31 + [self.ingredientMapping[propertyName] hash];
+    }
+    
+    NSUInteger transformersHash = 0;
+    for (NSString *propertyName in self.ingredientTransformers) {
+        transformersHash += [propertyName hash];
+    }
+    
+    NSUInteger limitsHash = 0;
+    for (NSString *propertyName in self.memoizationLimits) {
+        limitsHash += [propertyName hash] * 31 + [self.memoizationLimits[propertyName] hash];
+    }
+    
+    NSUInteger internedHash = 0;
+    for (NSString *propertyName in self.internedPropertyNames) {
+        internedHash += [propertyName hash];
+    }
+    
+    NSUInteger hash = [self.name hash];
+    hash = hash * 31 + mappingHash;
+    hash = hash * 31 + transformersHash;
+    hash = hash * 31 + limitsHash;
+    hash = hash * 31 + internedHash;
+    hash = hash * 31 + (NSUInteger)self.mismatchPolicy;
+    
+    _hash = hash;
+    __atomic_store_n(&_hasHash, 1, __ATOMIC_RELEASE);
+    
+    return hash;
 }
 
 - (BOOL)isEqual:(id)object {
@@ -161,26 +838,38 @@
     if (![object isKindOfClass:[self class]]) { return NO; }
     
     ZCREasyRecipe *other = object;
+    if ([self hash] != [other hash]) { return NO; }
+    
     BOOL equalNames = (!self.name && !other.name) || [self.name isEqualToString:other.name];
     BOOL equalMapping = [self.ingredientMapping isEqualToDictionary:other.ingredientMapping];
     BOOL equalTransformers = (!self.ingredientTransformers && !other.ingredientTransformers) ||
                              [self.ingredientTransformers isEqualToDictionary:other.ingredientTransformers];
     
-    return equalNames && equalMapping && equalTransformers;
+    BOOL equalLimits = [self.memoizationLimits isEqualToDictionary:other.memoizationLimits];
+    BOOL equalInterning = [self.internedPropertyNames isEqualToSet:other.internedPropertyNames] &&
+                          self.internPool == other.internPool;
+    
+    return equalNames && equalMapping && equalTransformers && equalLimits && equalInterning &&
+           self.mismatchPolicy == other.mismatchPolicy;
 }
 
 
 #pragma mark Private utilities
 
 + (NSDictionary *)_breakDownMapping:(NSDictionary *)ingredientMapping
+                         baseRecipe:(ZCREasyRecipe *)baseRecipe
                               error:(NSError *__autoreleasing *)error {
     NSParameterAssert(ingredientMapping);
     
-    NSMutableDictionary *ingredientComponents = [NSMutableDictionary dictionary];
+    NSMutableDictionary *ingredientComponents = [NSMutableDictionary dictionaryWithCapacity:[ingredientMapping count]];
+    NSDictionary *baseMapping = baseRecipe.ingredientMapping;
+    NSDictionary *baseComponents = baseRecipe.ingredientMappingComponents;
     
     NSArray *components;
     for (NSString *key in ingredientMapping) {
-        components = [self _breakDownIngredientPath:ingredientMapping[key] error:error];
+        NSString *ingredientPath = ingredientMapping[key];
+        components = ([baseMapping[key] isEqualToString:ingredientPath]) ? baseComponents[key] :
+                     [self _breakDownIngredientPath:ingredientPath error:error];
         if (components) {
             ingredientComponents[key] = components;
         } else {
@@ -188,210 +877,894 @@
         }
     }
     
-    // We need to make sure that all mappings share the same root object, either a dictionary if
-    // all the first pieces are strings, or an array if they are all numbers.
-    NSArray *allComponents = [ingredientComponents allValues];
-    Class rootClass;
-    for (NSArray *components in allComponents) {
-        if (!rootClass) {
-            id testPiece = [components firstObject];
-            rootClass = [testPiece isKindOfClass:[NSString class]] ? [NSString class] : [NSNumber class];
-        } else if (![[components firstObject] isKindOfClass:rootClass]) {
-            if (error) {
-                *error = ZCREasyBakeParameterError(@"Invalid ingredient mapping. The mapping must share the same root object, represented as a dictionary or array.");
+    return [ingredientComponents copy];
+}
+
++ (NSArray *)_breakDownIngredientPath:(NSString *)ingredientPath
+                                error:(NSError *__autoreleasing *)error {
+    NSParameterAssert(ingredientPath);
+    
+    // Paths are tokenized in a single pass over their characters, which are copied out once rather
+    // than scanned segment by segment.
+    NSUInteger length = [ingredientPath length];
+    unichar stackCharacters[128];
+    unichar *characters = (length <= 128) ? stackCharacters : malloc(length * sizeof(unichar));
+    [ingredientPath getCharacters:characters range:NSMakeRange(0, length)];
+    
+    NSMutableArray *components = [NSMutableArray array];
+    BOOL isValid = YES;
+    NSUInteger i = 0;
+    
+    while (i < length && isValid) {
+        // Each segment is an optional key running up to the next '.' or '['. Empty keys are
+        // ignored, so a segment may also be made of indexes alone.
+        NSUInteger keyStart = i;
+        while (i < length && characters[i] != '.' && characters[i] != '[') { i++; }
+        if (i > keyStart) {
+            [components addObject:[ingredientPath substringWithRange:NSMakeRange(keyStart, i - keyStart)]];
+        }
+        
+        // The key may be followed by any number of "[<index>]" or "[*]" pieces.
+        while (i < length && characters[i] == '[') {
+            NSUInteger digitsStart = ++i;
+            if (i + 1 < length && characters[i] == '*' && characters[i + 1] == ']') {
+                i += 2;
+                [components addObject:[NSNull null]];
+                continue;
+            }
+            
+            NSUInteger index = 0;
+            while (i < length && characters[i] >= '0' && characters[i] <= '9') {
+                NSUInteger digit = characters[i] - '0';
+                if (index > (NSUIntegerMax - digit) / 10) { break; }
+                index = index * 10 + digit;
+                i++;
+            }
+            
+            if (i == digitsStart || i >= length || characters[i] != ']') {
+                isValid = NO;
+                break;
+            }
+            i++;
+            [components addObject:@(index)];
+        }
+        
+        // Anything but the start of another segment after an index is malformed.
+        if (isValid && i < length) {
+            if (characters[i] == '.') {
+                i++;
+            } else {
+                isValid = NO;
             }
-            return nil;
         }
     }
     
-    if ([self _validateIngredientComponents:ingredientComponents error:error]) {
-        return [ingredientComponents copy];
-    } else {
+    if (characters != stackCharacters) {
+        free(characters);
+    }
+    
+    if (!isValid) {
+        if (error) {
+            *error = ZCREasyBakeParameterError(@"Invalid ingredient path: %@. Arrays must be referenced in the format: [<index>] or [*]", ingredientPath);
+        }
         return nil;
     }
+    
+    return [components copy];
 }
 
-+ (NSArray *)_breakDownIngredientPath:(NSString *)ingredientPath
-                                error:(NSError *__autoreleasing *)error {
-    NSParameterAssert(ingredientPath);
++ (NSDictionary *)_normalizeTransformers:(NSDictionary *)ingredientTransformers
+                            propertyKeys:(NSSet *)propertyKeys
+                                   error:(NSError * __autoreleasing *)error {
+    // Ingredient transformers are optional, so if they are absent we treat it as a success.
+    if (!ingredientTransformers) {
+        return [NSDictionary dictionary];
+    }
     
-    NSMutableArray *components = [NSMutableArray array];
-    NSArray *splitPath = [ingredientPath componentsSeparatedByString:@"."];
-    for (NSString *piece in splitPath) {
-        NSString *keyPath;
-        NSScanner *scanner = [NSScanner scannerWithString:piece];
-        if ([scanner scanUpToString:@"[" intoString:&keyPath] && keyPath) {
-            [components addObject:keyPath];
-        }
-        
-        NSInteger arrayIndex;
-        while (!scanner.isAtEnd) {
-            if ([scanner scanString:@"[" intoString:NULL] &&
-                [scanner scanInteger:&arrayIndex] &&
-                [scanner scanString:@"]" intoString:NULL]) {
-                [components addObject:[NSNumber numberWithInteger:arrayIndex]];
+    NSSet *transformedKeys = [NSSet setWithArray:[ingredientTransformers allKeys]];
+    
+    // If the ingredient transformers have unmapped keys we treat it as a failure.
+    if (![transformedKeys isSubsetOfSet:propertyKeys]) {
+        if (error) {
+            NSMutableSet *unknownKeys = [transformedKeys mutableCopy];
+            [unknownKeys minusSet:propertyKeys];
+            *error = ZCREasyBakeParameterError(@"The ingredient transformers have unmapped keys: %@", unknownKeys);
+        }
+        return nil;
+    }
+    
+    NSMutableDictionary *mutableTransformers = [ingredientTransformers mutableCopy];
+    
+    id transformer;
+    for (NSString *key in ingredientTransformers) {
+        transformer = ingredientTransformers[key];
+        if ([transformer isKindOfClass:[NSString class]]) {
+            transformer = [NSValueTransformer valueTransformerForName:transformer];
+            if (transformer) {
+                mutableTransformers[key] = transformer;
             } else {
                 if (error) {
-                    *error = ZCREasyBakeParameterError(@"Invalid ingredient path: %@. Arrays must be referenced in the format: [<index>]", ingredientPath);
+                    *error = ZCREasyBakeParameterError(@"No registered transformer was found for the name (%@) for key (%@)", ingredientTransformers[key], key);
                 }
-                components = nil;
-                break;
+                return nil;
+            }
+        } else if (![transformer isKindOfClass:[NSValueTransformer class]]) {
+            if (error) {
+                *error = ZCREasyBakeParameterError(@"Object (%@) for key (%@) is not a valid class.", transformer, key);
+            }
+            return nil;
+        }
+    }
+    
+    return [mutableTransformers copy];
+}
+
++ (NSDictionary *)_normalizeMemoizationLimits:(NSDictionary *)memoizationLimits
+                                 transformers:(NSDictionary *)ingredientTransformers
+                                        error:(NSError *__autoreleasing *)error {
+    // Memoization is optional, so if it is absent we treat it as a success.
+    if (!memoizationLimits) {
+        return [NSDictionary dictionary];
+    }
+    
+    for (NSString *key in memoizationLimits) {
+        if (!ingredientTransformers[key]) {
+            if (error) {
+                *error = ZCREasyBakeParameterError(@"The memoization limit for key (%@) has no ingredient transformer.", key);
+            }
+            return nil;
+        }
+        
+        id limit = memoizationLimits[key];
+        if (![limit isKindOfClass:[NSNumber class]] || [limit integerValue] <= 0) {
+            if (error) {
+                *error = ZCREasyBakeParameterError(@"Memoization limit (%@) for key (%@) is not a positive number.", limit, key);
+            }
+            return nil;
+        }
+    }
+    
+    return [memoizationLimits copy];
+}
+
++ (NSDictionary *)_transformerCachesForLimits:(NSDictionary *)memoizationLimits
+                                 transformers:(NSDictionary *)ingredientTransformers {
+    NSMutableDictionary *transformerCaches = [NSMutableDictionary dictionaryWithCapacity:[memoizationLimits count]];
+    
+    [memoizationLimits enumerateKeysAndObjectsUsingBlock:^(NSString *propertyName, NSNumber *limit, BOOL *stop) {
+        // Transformers which aren't pure opt out of memoization, regardless of the recipe.
+        if (![[ingredientTransformers[propertyName] class] zcr_allowsMemoization]) { return; }
+        
+        transformerCaches[propertyName] = [[ZCREasyTransformerCache alloc] initWithCountLimit:[limit unsignedIntegerValue]];
+    }];
+    
+    return [transformerCaches copy];
+}
+
++ (_ZCREasyIngredientNode *)_compileIngredientComponents:(NSDictionary *)ingredientComponents
+                                              baseRecipe:(ZCREasyRecipe *)baseRecipe
+                                                   error:(NSError *__autoreleasing *)error {
+    _ZCREasyIngredientNode *root = [[_ZCREasyIngredientNode alloc] initWithPiece:nil];
+    
+    // A subtree of the base recipe's trie which no added, removed or changed path passes through is
+    // already valid and compiled. It is shared as it is, and only its place under the root is
+    // checked.
+    _ZCREasyIngredientNode *baseRoot = baseRecipe.ingredientTrie;
+    NSSet *affectedRootPieces = (baseRoot) ? [self _rootPiecesChangedFromComponents:baseRecipe.ingredientMappingComponents
+                                                                       toComponents:ingredientComponents] : nil;
+    
+    for (NSString *propertyName in ingredientComponents) {
+        NSArray *components = ingredientComponents[propertyName];
+        id rootPiece = [components firstObject];
+        
+        if (baseRoot && rootPiece && ![affectedRootPieces containsObject:rootPiece]) {
+            if ([root existingChildForPiece:rootPiece]) { continue; }
+            
+            if (![root acceptsPiece:rootPiece]) {
+                if (error) {
+                    *error = [self _rootMismatchError];
+                }
+                return nil;
+            }
+            [root adoptChild:[baseRoot existingChildForPiece:rootPiece] forPiece:rootPiece];
+            continue;
+        }
+        
+        if (![self _insertComponents:components forProperty:propertyName intoRoot:root error:error]) {
+            return nil;
+        }
+    }
+    
+    [root compileLayout];
+    
+    return root;
+}
+
++ (BOOL)_insertComponents:(NSArray *)components forProperty:(NSString *)propertyName
+                 intoRoot:(_ZCREasyIngredientNode *)root error:(NSError *__autoreleasing *)error {
+    // Paths are validated as they are inserted, so each piece is only looked at once. Siblings
+    // describe the same container, so they must either all be keys or all be indexes, and a
+    // wildcard takes every element of its array so it can't share it with fixed indexes.
+    _ZCREasyIngredientNode *node = root;
+    NSUInteger depth = 0;
+    for (id piece in components) {
+        if (![node acceptsPiece:piece]) {
+            if (error && depth == 0) {
+                *error = [self _rootMismatchError];
+            } else if (error && [node acceptsPiece:@0] != [node acceptsPiece:[NSNull null]]) {
+                *error = ZCREasyBakeParameterError(@"Inconsistent ingredient path components for property (%@). The array at index (%lu) can't be traversed with both a wildcard and fixed indexes.", propertyName, (unsigned long)depth);
+            } else if (error) {
+                Class componentClass = ([piece isKindOfClass:[NSString class]]) ? [NSNumber class] : [NSString class];
+                *error = ZCREasyBakeParameterError(@"Inconsistent ingredient path component types for property (%@). Expected the component at index (%lu) to be of class (%@).", propertyName, (unsigned long)depth, componentClass);
+            }
+            return NO;
+        }
+        
+        node = [node childForPiece:piece];
+        depth++;
+    }
+    [node addPropertyName:propertyName];
+    
+    return YES;
+}
+
++ (NSError *)_rootMismatchError {
+    return ZCREasyBakeParameterError(@"Invalid ingredient mapping. The mapping must share the same root object, represented as a dictionary or array.");
+}
+
++ (NSSet *)_rootPiecesChangedFromComponents:(NSDictionary *)baseComponents
+                               toComponents:(NSDictionary *)ingredientComponents {
+    NSMutableSet *rootPieces = [NSMutableSet set];
+    
+    // Unchanged paths share their components with the base recipe, so most are compared by pointer.
+    [baseComponents enumerateKeysAndObjectsUsingBlock:^(NSString *propertyName, NSArray *components, BOOL *stop) {
+        NSArray *newComponents = ingredientComponents[propertyName];
+        if (newComponents == components || [newComponents isEqualToArray:components]) { return; }
+        
+        if ([components firstObject]) { [rootPieces addObject:[components firstObject]]; }
+        if ([newComponents firstObject]) { [rootPieces addObject:[newComponents firstObject]]; }
+    }];
+    
+    [ingredientComponents enumerateKeysAndObjectsUsingBlock:^(NSString *propertyName, NSArray *components, BOOL *stop) {
+        if (!baseComponents[propertyName] && [components firstObject]) {
+            [rootPieces addObject:[components firstObject]];
+        }
+    }];
+    
+    return rootPieces;
+}
+
+- (BOOL)_processIngredients:(id)ingredients into:(NSMutableDictionary *)processedIngredients
+                      error:(NSError *__autoreleasing *)error {
+    NSMutableDictionary *mismatches;
+    return [self _processIngredients:ingredients into:processedIngredients
+                          mismatches:&mismatches error:error];
+}
+
+- (BOOL)_processIngredients:(id)ingredients into:(NSMutableDictionary *)processedIngredients
+                 mismatches:(NSMutableDictionary *__autoreleasing *)mismatches
+                      error:(NSError *__autoreleasing *)error {
+    NSParameterAssert(processedIngredients);
+    NSParameterAssert(mismatches);
+    
+    if (!ingredients) { return YES; }
+    
+    BOOL isInstrumented = ZCREasyInstrumentationIsEnabled();
+    uint64_t startTime = (isInstrumented) ? ZCREasyInstrumentationBegin(self.instrumentation, ZCREasyInstrumentationMappingEvent) : 0;
+    
+    BOOL didProcess = NO;
+    
+    // Traversal never raises, so this only guards against exceptions from ingredient transformers.
+    @try {
+        didProcess = [self _processNode:self.ingredientTrie value:ingredients
+                   processedIngredients:processedIngredients mismatches:mismatches];
+    }
+    @catch (NSException *exception) {
+        if (error) {
+            *error = ZCREasyBakeExceptionError(exception);
+        }
+        return NO;
+    }
+    @finally {
+        if (isInstrumented) {
+            ZCREasyInstrumentationEnd(self.instrumentation, ZCREasyInstrumentationMappingEvent, startTime);
+        }
+    }
+    
+    if (!didProcess && error) {
+        *error = ZCREasyBakeMismatchError(*mismatches);
+    }
+    
+    return didProcess;
+}
+
+- (BOOL)_processNode:(_ZCREasyIngredientNode *)node value:(id)value
+processedIngredients:(NSMutableDictionary *)processedIngredients
+          mismatches:(NSMutableDictionary *__autoreleasing *)mismatches {
+    // Values inside a collection are transformed a whole column at a time once it's collected.
+    BOOL isCollected = node.isCollected;
+    for (NSString *propertyName in node.propertyNames) {
+        processedIngredients[propertyName] = (isCollected) ? value : [self _transformedValue:value forProperty:propertyName];
+    }
+    
+    NSArray *children = node.children;
+    if (children.count == 0) { return YES; }
+    
+    // Sibling pieces are validated to be of the same kind, so the first child decides what the
+    // container must be. Any other value makes every child unreachable.
+    BOOL expectsArray = [children[0] isIndex];
+    if (![value isKindOfClass:(expectsArray) ? [NSArray class] : [NSDictionary class]]) {
+        BOOL shouldContinue = YES;
+        for (_ZCREasyIngredientNode *child in children) {
+            shouldContinue = [self _recordMismatchAtNode:child processedIngredients:processedIngredients
+                                              mismatches:mismatches];
+        }
+        return shouldContinue;
+    }
+    
+    // A wildcard is always the only child of its array.
+    if (expectsArray && [children[0] isWildcard]) {
+        return [self _processCollectionNode:children[0] array:value
+                       processedIngredients:processedIngredients mismatches:mismatches];
+    }
+    
+    NSUInteger count = (expectsArray) ? [value count] : 0;
+    id childValue;
+    for (_ZCREasyIngredientNode *child in children) {
+        if (expectsArray) {
+            if (child.index >= count) {
+                if (![self _recordMismatchAtNode:child processedIngredients:processedIngredients
+                                      mismatches:mismatches]) {
+                    return NO;
+                }
+                continue;
             }
+            childValue = [value objectAtIndex:child.index];
+        } else {
+            childValue = [value objectForKey:child.key];
+        }
+        
+        // Missing values can never lead to an ingredient, so the whole subtree is skipped.
+        if (childValue && ![self _processNode:child value:childValue
+                         processedIngredients:processedIngredients mismatches:mismatches]) {
+            return NO;
+        }
+    }
+    
+    return YES;
+}
+
+/**
+ *  Processes every element of an array under a wildcard node in a single pass. Each element is
+ *  processed into the same scratch dictionary and its values appended to one column per property,
+ *  so the only work per element is the traversal itself. Elements which don't lead to a property,
+ *  or whose value was nulled as a mismatch, leave an NSNull placeholder in its column, keeping the
+ *  columns aligned with the array. Placeholders are recorded so they aren't transformed.
+ */
+- (BOOL)_processCollectionNode:(_ZCREasyIngredientNode *)node array:(NSArray *)array
+          processedIngredients:(NSMutableDictionary *)processedIngredients
+                    mismatches:(NSMutableDictionary *__autoreleasing *)mismatches {
+    NSArray *propertyNames = node.collectedPropertyNames;
+    NSUInteger propertyCount = [propertyNames count];
+    NSUInteger count = [array count];
+    
+    NSMutableArray *columns = [NSMutableArray arrayWithCapacity:propertyCount];
+    NSMutableArray *placeholderIndexes = [NSMutableArray arrayWithCapacity:propertyCount];
+    for (NSUInteger i = 0; i < propertyCount; i++) {
+        [columns addObject:[NSMutableArray arrayWithCapacity:count]];
+        [placeholderIndexes addObject:[NSMutableIndexSet indexSet]];
+    }
+    
+    NSMutableDictionary *elementIngredients = [NSMutableDictionary dictionaryWithCapacity:propertyCount];
+    NSUInteger elementIndex = 0;
+    for (id element in array) {
+        // Each element's mismatches are kept apart, so a nulled mismatch can be told from an
+        // explicit null.
+        [elementIngredients removeAllObjects];
+        NSMutableDictionary *elementMismatches = nil;
+        BOOL didProcess = [self _processNode:node value:element processedIngredients:elementIngredients
+                                  mismatches:&elementMismatches];
+        if (elementMismatches) {
+            if (!*mismatches) {
+                *mismatches = [NSMutableDictionary dictionary];
+            }
+            [*mismatches addEntriesFromDictionary:elementMismatches];
+        }
+        if (!didProcess) { return NO; }
+        
+        for (NSUInteger i = 0; i < propertyCount; i++) {
+            NSString *propertyName = propertyNames[i];
+            id value = elementIngredients[propertyName];
+            if (!value || elementMismatches[propertyName]) {
+                [placeholderIndexes[i] addIndex:elementIndex];
+            }
+            [columns[i] addObject:value ?: [NSNull null]];
+        }
+        elementIndex++;
+    }
+    
+    // Columns of nested collections were already transformed by their own wildcard.
+    NSSet *transformedPropertyNames = node.transformedPropertyNames;
+    for (NSUInteger i = 0; i < propertyCount; i++) {
+        NSString *propertyName = propertyNames[i];
+        processedIngredients[propertyName] = ([transformedPropertyNames containsObject:propertyName]) ?
+            [self _transformedValues:columns[i] forProperty:propertyName placeholderIndexes:placeholderIndexes[i]] :
+            [columns[i] copy];
+    }
+    
+    return YES;
+}
+
+/**
+ *  Records every property under a node which couldn't be reached, applying the mismatch policy to
+ *  the processed ingredients.
+ *
+ *  @return YES if processing should continue past the mismatch, NO if it should fail.
+ */
+- (BOOL)_recordMismatchAtNode:(_ZCREasyIngredientNode *)node
+         processedIngredients:(NSMutableDictionary *)processedIngredients
+                   mismatches:(NSMutableDictionary *__autoreleasing *)mismatches {
+    // Well formed ingredients never get here, so the report is only allocated once it's needed.
+    if (!*mismatches) {
+        *mismatches = [NSMutableDictionary dictionary];
+    }
+    
+    [self _addPropertiesUnderNode:node toMismatches:*mismatches processedIngredients:processedIngredients];
+    
+    return (self.mismatchPolicy != ZCREasyRecipeMismatchPolicyFailFast);
+}
+
+- (void)_addPropertiesUnderNode:(_ZCREasyIngredientNode *)node toMismatches:(NSMutableDictionary *)mismatches
+           processedIngredients:(NSMutableDictionary *)processedIngredients {
+    BOOL nullsFields = (self.mismatchPolicy == ZCREasyRecipeMismatchPolicyNullField);
+    for (NSString *propertyName in node.propertyNames) {
+        mismatches[propertyName] = self.ingredientMapping[propertyName];
+        if (nullsFields) {
+            processedIngredients[propertyName] = [NSNull null];
+        }
+    }
+    
+    for (_ZCREasyIngredientNode *child in node.children) {
+        [self _addPropertiesUnderNode:child toMismatches:mismatches processedIngredients:processedIngredients];
+    }
+}
+
+- (id)_processIngredients:(id)ingredients forProperty:(NSString *)propertyName found:(BOOL *)found {
+    NSParameterAssert(found);
+    
+    *found = NO;
+    id value = nil;
+    
+    @try {
+        value = [self _followComponents:self.ingredientMappingComponents[propertyName] fromIndex:0
+                                   value:ingredients forProperty:propertyName transforms:YES];
+    }
+    @catch (NSException *exception) {
+        return nil;
+    }
+    
+    *found = (value != nil);
+    return value;
+}
+
+/**
+ *  Follows a property's path components from the given index. Unlike a full processing pass, a
+ *  single ingredient which can't be reached is simply missing, since there is nobody to report an
+ *  error to. A wildcard follows the rest of the path from each element of its array, with NSNull
+ *  standing in for elements which don't lead anywhere.
+ *
+ *  @return The value at the end of the path, transformed if requested, or nil if there is none.
+ */
+- (id)_followComponents:(NSArray *)components fromIndex:(NSUInteger)componentIndex value:(id)value
+            forProperty:(NSString *)propertyName transforms:(BOOL)transforms {
+    NSUInteger componentCount = [components count];
+    for (NSUInteger i = componentIndex; i < componentCount && value; i++) {
+        id piece = components[i];
+        if (piece == [NSNull null]) {
+            if (![value isKindOfClass:[NSArray class]]) { return nil; }
+            
+            // Only the last wildcard transforms, so the transformer sees single elements.
+            NSRange remainingRange = NSMakeRange(i + 1, componentCount - i - 1);
+            BOOL isLastWildcard = [components indexOfObject:piece inRange:remainingRange] == NSNotFound;
+            
+            NSMutableArray *column = [NSMutableArray arrayWithCapacity:[value count]];
+            NSMutableIndexSet *placeholderIndexes = [NSMutableIndexSet indexSet];
+            for (id element in value) {
+                id elementValue = [self _followComponents:components fromIndex:i + 1 value:element
+                                              forProperty:propertyName transforms:transforms && !isLastWildcard];
+                if (!elementValue) {
+                    [placeholderIndexes addIndex:[column count]];
+                }
+                [column addObject:elementValue ?: [NSNull null]];
+            }
+            
+            return (transforms && isLastWildcard) ? [self _transformedValues:column forProperty:propertyName placeholderIndexes:placeholderIndexes] : [column copy];
+        } else if ([piece isKindOfClass:[NSNumber class]]) {
+            NSUInteger index = [piece unsignedIntegerValue];
+            if (![value isKindOfClass:[NSArray class]] || index >= [value count]) { return nil; }
+            value = [value objectAtIndex:index];
+        } else {
+            if (![value isKindOfClass:[NSDictionary class]]) { return nil; }
+            value = [value objectForKey:piece];
+        }
+    }
+    
+    if (!value) { return nil; }
+    
+    return (transforms) ? [self _transformedValue:value forProperty:propertyName] : value;
+}
+
+- (BOOL)_processJSONNode:(_ZCREasyIngredientNode *)node scanner:(_ZCRJSONScanner *)scanner
+    processedIngredients:(NSMutableDictionary *)processedIngredients
+              mismatches:(NSMutableDictionary *__autoreleasing *)mismatches {
+    // Nodes mapped to properties need their whole value, as do arrays under a wildcard, so it is
+    // materialized once and the rest of the subtree is processed in memory.
+    if (node.propertyNames.count > 0 || [[node.children firstObject] isWildcard]) {
+        id value = _ZCRJSONParseValue(scanner);
+        if (!value) { return NO; }
+        
+        return [self _processNode:node value:value processedIngredients:processedIngredients
+                       mismatches:mismatches];
+    }
+    
+    NSArray *children = node.children;
+    if (children.count == 0) {
+        return _ZCRJSONSkipValue(scanner);
+    }
+    
+    // Sibling pieces are validated to be of the same kind, so the first child decides what the
+    // container must be.
+    BOOL expectsArray = [children[0] isIndex];
+    _ZCRJSONSkipWhitespace(scanner);
+    
+    if (!expectsArray && _ZCRJSONConsume(scanner, '{')) {
+        if (_ZCRJSONConsume(scanner, '}')) { return YES; }
+        
+        do {
+            if (!_ZCRJSONConsume(scanner, '"')) {
+                return _ZCRJSONFail(scanner, "Expected a string key");
+            }
+            
+            const uint8_t *keyStart = scanner->cursor;
+            BOOL hasEscapes = NO;
+            if (!_ZCRJSONSkipStringBody(scanner, &hasEscapes)) { return NO; }
+            
+            _ZCREasyIngredientNode *child = _ZCRJSONChildForKey(children, keyStart,
+                                                                (NSUInteger)(scanner->cursor - keyStart - 1),
+                                                                hasEscapes);
+            if (!_ZCRJSONConsume(scanner, ':')) {
+                return _ZCRJSONFail(scanner, "Expected ':' after key");
+            }
+            
+            if (child) {
+                if (![self _processJSONNode:child scanner:scanner
+                       processedIngredients:processedIngredients mismatches:mismatches]) {
+                    return NO;
+                }
+            } else if (!_ZCRJSONSkipValue(scanner)) {
+                return NO;
+            }
+        } while (_ZCRJSONConsume(scanner, ','));
+        
+        return (_ZCRJSONConsume(scanner, '}')) ? YES : _ZCRJSONFail(scanner, "Expected ',' or '}'");
+    } else if (expectsArray && _ZCRJSONConsume(scanner, '[')) {
+        NSUInteger count = 0;
+        if (!_ZCRJSONConsume(scanner, ']')) {
+            do {
+                _ZCREasyIngredientNode *child = _ZCRJSONChildForIndex(children, count);
+                if (child) {
+                    if (![self _processJSONNode:child scanner:scanner
+                           processedIngredients:processedIngredients mismatches:mismatches]) {
+                        return NO;
+                    }
+                } else if (!_ZCRJSONSkipValue(scanner)) {
+                    return NO;
+                }
+                count++;
+            } while (_ZCRJSONConsume(scanner, ','));
+            
+            if (!_ZCRJSONConsume(scanner, ']')) {
+                return _ZCRJSONFail(scanner, "Expected ',' or ']'");
+            }
+        }
+        
+        // Like processing in memory, indexes past the end of an array are mismatches.
+        for (_ZCREasyIngredientNode *child in children) {
+            if (child.index >= count &&
+                ![self _recordMismatchAtNode:child processedIngredients:processedIngredients
+                                  mismatches:mismatches]) {
+                return NO;
+            }
+        }
+        return YES;
+    } else {
+        BOOL shouldContinue = YES;
+        for (_ZCREasyIngredientNode *child in children) {
+            shouldContinue = [self _recordMismatchAtNode:child processedIngredients:processedIngredients
+                                              mismatches:mismatches];
+        }
+        
+        // The mismatched value still has to be scanned past to carry on with its siblings.
+        return shouldContinue && _ZCRJSONSkipValue(scanner);
+    }
+}
+
+- (id)_transformedValue:(id)value forProperty:(NSString *)propertyName {
+    NSValueTransformer *transformer = self.ingredientTransformers[propertyName];
+    if (transformer && ZCREasyInstrumentationIsEnabled()) {
+        NSString *event = self.transformingEvents[propertyName];
+        uint64_t startTime = ZCREasyInstrumentationBegin(self.instrumentation, event);
+        @try {
+            value = [self _transformedValue:value forProperty:propertyName transformer:transformer];
+        }
+        @finally {
+            ZCREasyInstrumentationEnd(self.instrumentation, event, startTime);
+        }
+    } else {
+        value = [self _transformedValue:value forProperty:propertyName transformer:transformer];
+    }
+    
+    ZCREasyInternPool *internPool = self.internPool;
+    return (internPool && [self.internedPropertyNames containsObject:propertyName]) ? [internPool internedValue:value] : value;
+}
+
+- (id)_transformedValue:(id)value forProperty:(NSString *)propertyName
+            transformer:(NSValueTransformer *)transformer {
+    ZCREasyTransformerCache *cache = transformer ? self.transformerCaches[propertyName] : nil;
+    if (cache) {
+        value = [cache transformedValue:value withTransformer:transformer];
+    } else if (transformer) {
+        if (value == [NSNull null]) {
+            value = nil;
+        }
+        value = [transformer transformedValue:value];
+        if (!value) {
+            value = [NSNull null];
+        }
+    }
+    
+    return value;
+}
+
+- (NSArray *)_transformedValues:(NSArray *)values forProperty:(NSString *)propertyName
+              placeholderIndexes:(NSIndexSet *)placeholderIndexes {
+    NSValueTransformer *transformer = self.ingredientTransformers[propertyName];
+    if (transformer && ZCREasyInstrumentationIsEnabled()) {
+        NSString *event = self.transformingEvents[propertyName];
+        uint64_t startTime = ZCREasyInstrumentationBegin(self.instrumentation, event);
+        @try {
+            values = [self _transformedValues:values forProperty:propertyName transformer:transformer
+                           placeholderIndexes:placeholderIndexes];
+        }
+        @finally {
+            ZCREasyInstrumentationEnd(self.instrumentation, event, startTime);
+        }
+    } else {
+        values = [self _transformedValues:values forProperty:propertyName transformer:transformer
+                       placeholderIndexes:placeholderIndexes];
+    }
+    
+    ZCREasyInternPool *internPool = self.internPool;
+    if (!internPool || ![self.internedPropertyNames containsObject:propertyName]) { return values; }
+    
+    NSMutableArray *internedValues = [NSMutableArray arrayWithCapacity:[values count]];
+    for (id value in values) {
+        [internedValues addObject:[internPool internedValue:value]];
+    }
+    return [internedValues copy];
+}
+
+- (NSArray *)_transformedValues:(NSArray *)values forProperty:(NSString *)propertyName
+                    transformer:(NSValueTransformer *)transformer
+             placeholderIndexes:(NSIndexSet *)placeholderIndexes {
+    if (!transformer) { return [values copy]; }
+    
+    // Placeholders for elements which didn't lead to the property, or whose value was nulled as a
+    // mismatch, stay in place rather than being handed to the transformer. Explicit nulls aren't
+    // placeholders, and are transformed as nil like they are outside of a wildcard.
+    NSUInteger placeholderCount = [placeholderIndexes count];
+    if (placeholderCount == [values count]) { return [values copy]; }
+    
+    BOOL isComplete = (placeholderCount == 0);
+    NSMutableIndexSet *presentIndexes = nil;
+    NSArray *presentValues = values;
+    if (!isComplete) {
+        presentIndexes = [NSMutableIndexSet indexSetWithIndexesInRange:NSMakeRange(0, [values count])];
+        [presentIndexes removeIndexes:placeholderIndexes];
+        presentValues = [values objectsAtIndexes:presentIndexes];
+    }
+    
+    // Memoized transformations have to go through the cache one value at a time, while everything
+    // else is handed to the transformer as a whole collection.
+    NSArray *transformedValues = nil;
+    if (!self.transformerCaches[propertyName]) {
+        transformedValues = [transformer zcr_transformedValues:presentValues];
+    } else {
+        NSMutableArray *cachedValues = [NSMutableArray arrayWithCapacity:[presentValues count]];
+        for (id value in presentValues) {
+            [cachedValues addObject:[self _transformedValue:value forProperty:propertyName transformer:transformer]];
         }
+        transformedValues = cachedValues;
     }
+    if (isComplete) { return [transformedValues copy]; }
     
-    return [components copy];
+    NSMutableArray *alignedValues = [values mutableCopy];
+    [alignedValues replaceObjectsAtIndexes:presentIndexes withObjects:transformedValues];
+    return [alignedValues copy];
 }
 
-+ (BOOL)_validateIngredientComponents:(NSDictionary *)ingredientComponents
-                                error:(NSError *__autoreleasing *)error {
-    if (!ingredientComponents) {
-        return NO;
-    }
-    
-    NSArray *allComponents = [ingredientComponents allValues];
-    NSUInteger longestPathCount = [[allComponents valueForKeyPath:@"@max.@count"] unsignedIntegerValue];
-    
-    // To prevent wasted work we have a registry keep track of which pieces have been covered at the given index.
-    NSMutableDictionary *registry = [NSMutableDictionary dictionary];
+- (id)_reverseTransformedValue:(id)value forProperty:(NSString *)propertyName {
+    NSValueTransformer *transformer = self.ingredientTransformers[propertyName];
     
-    for (NSUInteger i = 0; i < longestPathCount; i++) {
-        for (NSArray *components in allComponents) {
-            if ([components count] > i) {
-                id piece = components[i];
-                BOOL isPieceValid = [self _validateIndex:i withPiece:piece
-                                          fromComponents:allComponents
-                                                registry:registry error:error];
-                if (!isPieceValid) {
-                    return NO;
-                }
-            }
-        }
+    // Only reversible transformations are used during decomposition
+    if (transformer && [[transformer class] allowsReverseTransformation]) {
+        value = [transformer reverseTransformedValue:value];
     }
     
-    return YES;
+    return value ?: [NSNull null];
 }
 
-+ (BOOL)_validateIndex:(NSUInteger)index withPiece:(id)currentPiece
-        fromComponents:(NSArray *)allComponents
-              registry:(NSMutableDictionary *)registry error:(NSError *__autoreleasing *)error {
-    NSMutableIndexSet *registeredIndexes = registry[currentPiece];
-    if ([registeredIndexes containsIndex:index]) {
-        return YES;
+- (id)_ingredientsWithValueProvider:(id (^)(NSString *propertyName))valueProvider {
+    NSParameterAssert(valueProvider);
+    return [self _decomposeNode:self.ingredientTrie valueProvider:valueProvider];
+}
+
+- (id)_decomposeNode:(_ZCREasyIngredientNode *)node
+       valueProvider:(id (^)(NSString *propertyName))valueProvider {
+    // A path which ends at a property takes that property's value, even if longer paths pass
+    // through it.
+    NSString *propertyName = [node.propertyNames firstObject];
+    if (propertyName) {
+        return [self _reverseTransformedValue:valueProvider(propertyName) forProperty:propertyName];
     }
     
-    NSInteger nextIndex = index+1;
-    NSMutableArray *nextPieces = [NSMutableArray array];
-    for (NSArray *components in allComponents) {
-        if (([components count] > nextIndex) && [currentPiece isEqual:components[index]]) {
-            [nextPieces addObject:components[nextIndex]];
+    _ZCREasyIngredientNode *firstChild = [node.children firstObject];
+    if (firstChild.isWildcard) {
+        NSArray *elementValueProviders = [self _elementValueProvidersForCollectionNode:firstChild
+                                                                         valueProvider:valueProvider];
+        NSMutableArray *elements = [NSMutableArray arrayWithCapacity:[elementValueProviders count]];
+        for (id (^elementValueProvider)(NSString *) in elementValueProviders) {
+            [elements addObject:[self _decomposeNode:firstChild valueProvider:elementValueProvider] ?: [NSNull null]];
         }
+        return [elements copy];
     }
     
-    Class componentClass = NULL;
-    for (id piece in nextPieces) {
-        if (!componentClass) {
-            if ([piece isKindOfClass:[NSString class]]) {
-                componentClass = [NSString class];
-            } else if ([piece isKindOfClass:[NSNumber class]]) {
-                componentClass = [NSNumber class];
-            } else {
-                if (error) {
-                    *error = ZCREasyBakeParameterError(@"Invalid ingredient path component class at index (%ld).", (unsigned long)index);
-                }
-                return NO;
-            }
+    NSArray *childSlots = node.childSlots;
+    NSUInteger count = [childSlots count];
+    __strong id *values = (__strong id *)calloc(MAX(count, 1), sizeof(id));
+    __unsafe_unretained id *keys = NULL;
+    id container = nil;
+    
+    @try {
+        NSUInteger index = 0;
+        for (id child in childSlots) {
+            values[index++] = (child == [NSNull null]) ? child : [self _decomposeNode:child
+                                                                        valueProvider:valueProvider];
+        }
+        
+        if (node.childKeys) {
+            keys = (__unsafe_unretained id *)calloc(MAX(count, 1), sizeof(id));
+            [node.childKeys getObjects:keys range:NSMakeRange(0, count)];
+            container = [NSDictionary dictionaryWithObjects:values forKeys:keys count:count];
         } else {
-            if (![piece isKindOfClass:componentClass]) {
-                if (error) {
-                    *error = ZCREasyBakeParameterError(@"Inconsistent ingredient path component types. Expected all components at index (%ld) to be of class (%@).", (unsigned long)index, componentClass);
-                }
-                return NO;
-            }
+            container = [NSArray arrayWithObjects:values count:count];
         }
     }
-    
-    if (!registeredIndexes) {
-        registeredIndexes = [NSMutableIndexSet indexSet];
-        registry[currentPiece] = registeredIndexes;
+    @finally {
+        for (NSUInteger i = 0; i < count; i++) {
+            values[i] = nil;
+        }
+        free(values);
+        free(keys);
     }
-    [registeredIndexes addIndex:index];
     
-    return YES;
+    return container;
 }
 
-+ (NSDictionary *)_normalizeTransformers:(NSDictionary *)ingredientTransformers
-                            propertyKeys:(NSSet *)propertyKeys
-                                   error:(NSError * __autoreleasing *)error {
-    // Ingredient transformers are optional, so if they are absent we treat it as a success.
-    if (!ingredientTransformers) {
-        return [NSDictionary dictionary];
+/**
+ *  Splits the values of the properties collected under a wildcard node into one value provider per
+ *  element, so that each element can be decomposed like a container of its own. The collection is
+ *  as long as the longest of the properties' arrays.
+ */
+- (NSArray *)_elementValueProvidersForCollectionNode:(_ZCREasyIngredientNode *)node
+                                       valueProvider:(id (^)(NSString *propertyName))valueProvider {
+    NSMutableDictionary *columns = [NSMutableDictionary dictionaryWithCapacity:[node.collectedPropertyNames count]];
+    NSUInteger count = 0;
+    for (NSString *propertyName in node.collectedPropertyNames) {
+        id column = valueProvider(propertyName);
+        if ([column isKindOfClass:[NSArray class]]) {
+            columns[propertyName] = column;
+            count = MAX(count, [column count]);
+        }
     }
     
-    NSSet *transformedKeys = [NSSet setWithArray:[ingredientTransformers allKeys]];
+    NSMutableArray *elementValueProviders = [NSMutableArray arrayWithCapacity:count];
+    for (NSUInteger i = 0; i < count; i++) {
+        [elementValueProviders addObject:[^id(NSString *propertyName) {
+            NSArray *column = columns[propertyName];
+            id value = (i < [column count]) ? column[i] : nil;
+            return (value == [NSNull null]) ? nil : value;
+        } copy]];
+    }
     
-    // If the ingredient transformers have unmapped keys we treat it as a failure.
-    if (![transformedKeys isSubsetOfSet:propertyKeys]) {
+    return [elementValueProviders copy];
+}
+
+- (NSData *)_JSONDataWithValueProvider:(id (^)(NSString *propertyName))valueProvider
+                                 error:(NSError *__autoreleasing *)error {
+    NSParameterAssert(valueProvider);
+    
+    NSMutableData *data = [NSMutableData dataWithCapacity:256];
+    NSString *failedPropertyName = nil;
+    if (![self _writeNode:self.ingredientTrie valueProvider:valueProvider toData:data
+       failedPropertyName:&failedPropertyName]) {
         if (error) {
-            NSMutableSet *unknownKeys = [transformedKeys mutableCopy];
-            [unknownKeys minusSet:propertyKeys];
-            *error = ZCREasyBakeParameterError(@"The ingredient transformers have unmapped keys: %@", unknownKeys);
+            *error = ZCREasyBakeParameterError(@"The value for %@ cannot be represented as JSON.",
+                                               failedPropertyName);
         }
         return nil;
     }
     
-    NSMutableDictionary *mutableTransformers = [ingredientTransformers mutableCopy];
+    return [data copy];
+}
+
+- (BOOL)_writeNode:(_ZCREasyIngredientNode *)node
+     valueProvider:(id (^)(NSString *propertyName))valueProvider
+            toData:(NSMutableData *)data
+failedPropertyName:(NSString *__autoreleasing *)failedPropertyName {
+    NSString *propertyName = [node.propertyNames firstObject];
+    if (propertyName) {
+        id value = [self _reverseTransformedValue:valueProvider(propertyName) forProperty:propertyName];
+        if (!_ZCRJSONAppendValue(data, value)) {
+            *failedPropertyName = propertyName;
+            return NO;
+        }
+        return YES;
+    }
     
-    id transformer;
-    for (NSString *key in ingredientTransformers) {
-        transformer = ingredientTransformers[key];
-        if ([transformer isKindOfClass:[NSString class]]) {
-            transformer = [NSValueTransformer valueTransformerForName:transformer];
-            if (transformer) {
-                mutableTransformers[key] = transformer;
-            } else {
-                if (error) {
-                    *error = ZCREasyBakeParameterError(@"No registered transformer was found for the name (%@) for key (%@)", ingredientTransformers[key], key);
-                }
-                return nil;
-            }
-        } else if (![transformer isKindOfClass:[NSValueTransformer class]]) {
-            if (error) {
-                *error = ZCREasyBakeParameterError(@"Object (%@) for key (%@) is not a valid class.", transformer, key);
+    _ZCREasyIngredientNode *firstChild = [node.children firstObject];
+    if (firstChild.isWildcard) {
+        NSArray *elementValueProviders = [self _elementValueProvidersForCollectionNode:firstChild
+                                                                         valueProvider:valueProvider];
+        _ZCRJSONAppend(data, "[", 1);
+        
+        NSUInteger index = 0;
+        for (id (^elementValueProvider)(NSString *) in elementValueProviders) {
+            if (index++ > 0) { _ZCRJSONAppend(data, ",", 1); }
+            
+            if (![self _writeNode:firstChild valueProvider:elementValueProvider toData:data
+               failedPropertyName:failedPropertyName]) {
+                return NO;
             }
-            return nil;
         }
+        
+        _ZCRJSONAppend(data, "]", 1);
+        return YES;
     }
     
-    return [mutableTransformers copy];
-}
-
-- (id)_valueForProperty:(NSString *)propertyName ingredients:(id)ingredients {
-    id currentValue = ingredients;
+    BOOL isObject = (node.childKeys != nil);
+    _ZCRJSONAppend(data, (isObject) ? "{" : "[", 1);
     
-    NSArray *components = self.ingredientMappingComponents[propertyName];
-    for (id piece in components) {
-        if ([piece isKindOfClass:[NSString class]]) {
-            currentValue = [currentValue objectForKey:piece];
-        } else {
-            currentValue = [currentValue objectAtIndex:[piece unsignedIntegerValue]];
+    NSUInteger index = 0;
+    for (_ZCREasyIngredientNode *child in node.childSlots) {
+        if (index++ > 0) { _ZCRJSONAppend(data, ",", 1); }
+        
+        if ((id)child == [NSNull null]) {
+            _ZCRJSONAppend(data, "null", 4);
+            continue;
         }
-    }
-    
-    if (currentValue) {
-        NSValueTransformer *transformer = self.ingredientTransformers[propertyName];
-        if (transformer) {
-            if (currentValue == [NSNull null]) {
-                currentValue = nil;
-            }
-            currentValue = [transformer transformedValue:currentValue];
-            if (!currentValue) {
-                currentValue = [NSNull null];
-            }
+        
+        if (isObject) {
+            [data appendData:child.JSONKeyData];
+        }
+        if (![self _writeNode:child valueProvider:valueProvider toData:data
+           failedPropertyName:failedPropertyName]) {
+            return NO;
         }
     }
     
-    return currentValue;
+    _ZCRJSONAppend(data, (isObject) ? "}" : "]", 1);
+    return YES;
 }
 
 @end
@@ -399,11 +1772,23 @@
 
 #pragma mark - ZCREasyRecipeBox
 
-@interface ZCREasyRecipeBox ()
-@property (copy, atomic) NSDictionary *recipes;
-@end
-
-@implementation ZCREasyRecipeBox
+@implementation ZCREasyRecipeBox {
+    // Serializes changes to the box, so change notifications are only sent for changes which
+    // actually happen. It is recursive so observers may change the box while being notified.
+    pthread_mutex_t _writeLock;
+    pthread_mutex_t _lock;
+    
+    // The authoritative recipes, only touched while holding the lock.
+    NSMutableDictionary *_mutableRecipes;
+    
+    // Readers look recipes up in the latest immutable snapshot without locking. Each reader counts
+    // itself under the current reader epoch while it uses a snapshot, and a replaced snapshot is
+    // released as soon as the readers of both epochs have drained.
+    CFDictionaryRef _snapshot;
+    NSUInteger _readerEpoch;
+    NSUInteger _activeReaders[2];
+    NSUInteger _unpublishedCount;
+}
 @dynamic recipeNames;
 
 #pragma mark Public API
@@ -420,17 +1805,35 @@
 - (instancetype)init {
     if (!(self = [super init])) { return nil; }
     
-    _recipes = [NSDictionary dictionary];
+    pthread_mutexattr_t writeLockAttributes;
+    pthread_mutexattr_init(&writeLockAttributes);
+    pthread_mutexattr_settype(&writeLockAttributes, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&_writeLock, &writeLockAttributes);
+    pthread_mutexattr_destroy(&writeLockAttributes);
+    
+    pthread_mutex_init(&_lock, NULL);
+    _mutableRecipes = [NSMutableDictionary dictionary];
+    _snapshot = (CFDictionaryRef)CFBridgingRetain([_mutableRecipes copy]);
     
     return self;
 }
 
+- (void)dealloc {
+    if (_snapshot) { CFRelease(_snapshot); }
+    pthread_mutex_destroy(&_lock);
+    pthread_mutex_destroy(&_writeLock);
+}
+
 - (NSSet *)recipeNames {
-    return [NSSet setWithArray:[self.recipes allKeys]];
+    pthread_mutex_lock(&_lock);
+    NSSet *recipeNames = [NSSet setWithArray:[_mutableRecipes allKeys]];
+    pthread_mutex_unlock(&_lock);
+    
+    return recipeNames;
 }
 
-+ (NSSet *)keyPathsForValuesAffectingRecipeNames {
-    return [NSSet setWithObject:NSStringFromSelector(@selector(recipes))];
++ (BOOL)automaticallyNotifiesObserversOfRecipeNames {
+    return NO;
 }
 
 - (BOOL)addRecipe:(ZCREasyRecipe *)recipe error:(NSError *__autoreleasing *)error {
@@ -441,26 +1844,20 @@
         return NO;
     }
     
-    if (!recipe.name) {
+    return [self _addRecipes:@[recipe] publish:NO error:error];
+}
+
+- (BOOL)addRecipes:(NSArray *)recipes error:(NSError *__autoreleasing *)error {
+    if (!recipes) {
         if (error) {
-            *error = ZCREasyBakeParameterError(@"Recipe is missing a name!");
+            *error = ZCREasyBakeParameterError(@"Missing recipes to add!");
         }
         return NO;
     }
     
-    @synchronized(self) {
-        if ([self.recipeNames containsObject:recipe.name]) {
-            if (error) {
-                *error = ZCREasyBakeParameterError(@"The recipe is already added to this box!");
-            }
-            return NO;
-        }
-        
-        NSMutableDictionary *recipes = [self.recipes mutableCopy];
-        recipes[recipe.name] = recipe;
-        self.recipes = recipes;
-    }
-    return YES;
+    // A bulk registration is published right away, so its recipes are immediately readable
+    // without locking.
+    return [self _addRecipes:recipes publish:YES error:error];
 }
 
 - (ZCREasyRecipe *)addRecipeWith:(void (^)(id<ZCREasyRecipeMaker>))block {
@@ -484,31 +1881,146 @@
         return NO;
     }
     
-    ZCREasyRecipe *recipe = [self recipeWithName:recipeName];
-    if (!recipe) {
-        if (error) {
-            *error = ZCREasyBakeParameterError(@"Missing a recipe to remove!");
-        }
-        return NO;
+    pthread_mutex_lock(&_writeLock);
+    pthread_mutex_lock(&_lock);
+    BOOL canRemove = (_mutableRecipes[recipeName] != nil);
+    pthread_mutex_unlock(&_lock);
+    
+    if (canRemove) {
+        NSString *recipeNamesKey = NSStringFromSelector(@selector(recipeNames));
+        [self willChangeValueForKey:recipeNamesKey];
+        
+        // Removals are published immediately so readers never find a removed recipe.
+        pthread_mutex_lock(&_lock);
+        [_mutableRecipes removeObjectForKey:recipeName];
+        [self _publishSnapshot];
+        pthread_mutex_unlock(&_lock);
+        
+        [self didChangeValueForKey:recipeNamesKey];
+    }
+    pthread_mutex_unlock(&_writeLock);
+    
+    if (!canRemove && error) {
+        *error = ZCREasyBakeParameterError(@"Missing a recipe to remove!");
+    }
+    return canRemove;
+}
+
+- (ZCREasyRecipe *)recipeWithName:(NSString *)recipeName {
+    if (!recipeName) { return nil; }
+    
+    // The recipe is retained before the reader leaves its epoch, since the snapshot may be
+    // released as soon as it does.
+    NSUInteger epoch = __atomic_load_n(&_readerEpoch, __ATOMIC_SEQ_CST) & 1;
+    __atomic_add_fetch(&_activeReaders[epoch], 1, __ATOMIC_SEQ_CST);
+    CFDictionaryRef snapshot = __atomic_load_n(&_snapshot, __ATOMIC_SEQ_CST);
+    const void *value = CFDictionaryGetValue(snapshot, (__bridge const void *)recipeName);
+    if (value) { CFRetain(value); }
+    __atomic_sub_fetch(&_activeReaders[epoch], 1, __ATOMIC_RELEASE);
+    
+    if (value || __atomic_load_n(&_unpublishedCount, __ATOMIC_ACQUIRE) == 0) {
+        return CFBridgingRelease(value);
+    }
+    
+    // Recipes were added since the snapshot was published, so the first lookup to miss publishes
+    // them and every later lookup is lock-free again.
+    pthread_mutex_lock(&_lock);
+    ZCREasyRecipe *recipe = _mutableRecipes[recipeName];
+    if (_unpublishedCount > 0) {
+        [self _publishSnapshot];
     }
+    pthread_mutex_unlock(&_lock);
     
-    @synchronized(self) {
-        if (![self.recipeNames containsObject:recipe.name]) {
+    return recipe;
+}
+
+#pragma mark Private utilities
+
+- (BOOL)_addRecipes:(NSArray *)recipes publish:(BOOL)shouldPublish
+              error:(NSError *__autoreleasing *)error {
+    NSParameterAssert(recipes);
+    
+    NSMutableSet *recipeNames = [NSMutableSet setWithCapacity:[recipes count]];
+    for (ZCREasyRecipe *recipe in recipes) {
+        if (!recipe.name) {
+            if (error) {
+                *error = ZCREasyBakeParameterError(@"Recipe is missing a name!");
+            }
+            return NO;
+        }
+        if ([recipeNames containsObject:recipe.name]) {
             if (error) {
-                *error = ZCREasyBakeParameterError(@"Recipe to remove was not added to this box!");
+                *error = ZCREasyBakeParameterError(@"The recipe named %@ is added more than once!", recipe.name);
             }
             return NO;
         }
+        [recipeNames addObject:recipe.name];
+    }
+    
+    pthread_mutex_lock(&_writeLock);
+    pthread_mutex_lock(&_lock);
+    NSString *existingName = nil;
+    for (NSString *recipeName in recipeNames) {
+        if (_mutableRecipes[recipeName]) {
+            existingName = recipeName;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&_lock);
+    
+    // Either all of the recipes are added or none of them are.
+    if (!existingName) {
+        NSString *recipeNamesKey = NSStringFromSelector(@selector(recipeNames));
+        [self willChangeValueForKey:recipeNamesKey];
+        
+        pthread_mutex_lock(&_lock);
+        for (ZCREasyRecipe *recipe in recipes) {
+            _mutableRecipes[recipe.name] = recipe;
+        }
+        __atomic_add_fetch(&_unpublishedCount, [recipes count], __ATOMIC_RELEASE);
         
-        NSMutableDictionary *recipes = [self.recipes mutableCopy];
-        [recipes removeObjectForKey:recipe.name];
-        self.recipes = recipes;
+        if (shouldPublish) {
+            [self _publishSnapshot];
+        }
+        pthread_mutex_unlock(&_lock);
+        
+        [self didChangeValueForKey:recipeNamesKey];
+    }
+    pthread_mutex_unlock(&_writeLock);
+    
+    if (existingName) {
+        if (error) {
+            *error = ZCREasyBakeParameterError(@"The recipe named %@ is already added to this box!", existingName);
+        }
+        return NO;
     }
     return YES;
 }
 
-- (ZCREasyRecipe *)recipeWithName:(NSString *)recipeName {
-    return self.recipes[recipeName];
+// Must be called while holding the lock. The previous snapshot is released before returning.
+- (void)_publishSnapshot {
+    CFDictionaryRef previousSnapshot = _snapshot;
+    CFDictionaryRef snapshot = (CFDictionaryRef)CFBridgingRetain([_mutableRecipes copy]);
+    
+    __atomic_store_n(&_snapshot, snapshot, __ATOMIC_SEQ_CST);
+    __atomic_store_n(&_unpublishedCount, 0, __ATOMIC_RELEASE);
+    
+    [self _waitForReaders];
+    CFRelease(previousSnapshot);
+}
+
+// Must be called while holding the lock. A reader counts itself before loading the snapshot, so a
+// reader which could still hold the previous snapshot is counted in one of the two epochs. The
+// epoch is flipped before waiting on each one, so new readers count themselves in the other epoch
+// and can't keep the wait from finishing. Readers only hold a snapshot for a single lookup, so the
+// wait is short.
+- (void)_waitForReaders {
+    for (NSUInteger flip = 0; flip < 2; flip++) {
+        NSUInteger epoch = __atomic_fetch_add(&_readerEpoch, 1, __ATOMIC_SEQ_CST) & 1;
+        while (__atomic_load_n(&_activeReaders[epoch], __ATOMIC_ACQUIRE) != 0) {
+            sched_yield();
+        }
+    }
 }
 
 #pragma mark NSObject
@@ -527,12 +2039,201 @@
 @end
 
 
+#pragma mark - _ZCREasyIngredientNode
+
+@implementation _ZCREasyIngredientNode {
+    NSMutableDictionary *_childrenByPiece;
+    NSMutableArray *_mutableChildren;
+    NSMutableArray *_mutablePropertyNames;
+    BOOL _isCompiled;
+}
+
+- (instancetype)initWithPiece:(id)piece {
+    if (!(self = [super init])) { return nil; }
+    
+    if (piece == [NSNull null]) {
+        _isIndex = YES;
+        _isWildcard = YES;
+    } else if ([piece isKindOfClass:[NSNumber class]]) {
+        _isIndex = YES;
+        _index = [piece unsignedIntegerValue];
+    } else {
+        _key = [piece copy];
+        _keyData = [_key dataUsingEncoding:NSUTF8StringEncoding];
+    }
+    
+    return self;
+}
+
+- (NSArray *)children {
+    return _mutableChildren;
+}
+
+- (NSArray *)propertyNames {
+    return _mutablePropertyNames;
+}
+
+- (BOOL)acceptsPiece:(id)piece {
+    _ZCREasyIngredientNode *firstChild = [_mutableChildren firstObject];
+    if (!firstChild) { return YES; }
+    
+    BOOL isWildcard = (piece == [NSNull null]);
+    if (firstChild.isWildcard || isWildcard) { return firstChild.isWildcard && isWildcard; }
+    
+    return firstChild.isIndex == [piece isKindOfClass:[NSNumber class]];
+}
+
+- (_ZCREasyIngredientNode *)childForPiece:(id)piece {
+    NSParameterAssert(piece);
+    
+    _ZCREasyIngredientNode *child = _childrenByPiece[piece];
+    if (child) { return child; }
+    
+    child = [[_ZCREasyIngredientNode alloc] initWithPiece:piece];
+    if (!_childrenByPiece) {
+        _childrenByPiece = [NSMutableDictionary dictionary];
+        _mutableChildren = [NSMutableArray array];
+    }
+    _childrenByPiece[piece] = child;
+    [_mutableChildren addObject:child];
+    
+    return child;
+}
+
+- (_ZCREasyIngredientNode *)existingChildForPiece:(id)piece {
+    return _childrenByPiece[piece];
+}
+
+- (void)adoptChild:(_ZCREasyIngredientNode *)child forPiece:(id)piece {
+    NSParameterAssert(child);
+    NSParameterAssert(piece);
+    
+    if (!_childrenByPiece) {
+        _childrenByPiece = [NSMutableDictionary dictionary];
+        _mutableChildren = [NSMutableArray array];
+    }
+    _childrenByPiece[piece] = child;
+    [_mutableChildren addObject:child];
+}
+
+- (void)addPropertyName:(NSString *)propertyName {
+    if (!_mutablePropertyNames) {
+        _mutablePropertyNames = [NSMutableArray array];
+    }
+    [_mutablePropertyNames addObject:propertyName];
+}
+
+- (void)compileLayout {
+    // Keyed children keep their order, while indexed children are laid out densely with NSNull
+    // filling the gaps, so decomposition can emit each container in a single pass.
+    _ZCREasyIngredientNode *firstChild = [_mutableChildren firstObject];
+    if (firstChild.isWildcard) {
+        _childSlots = @[firstChild];
+    } else if (firstChild.isIndex) {
+        NSUInteger count = [[_mutableChildren valueForKeyPath:@"@max.index"] unsignedIntegerValue] + 1;
+        NSMutableArray *childSlots = [NSMutableArray arrayWithCapacity:count];
+        for (NSUInteger i = 0; i < count; i++) {
+            [childSlots addObject:[NSNull null]];
+        }
+        for (_ZCREasyIngredientNode *child in _mutableChildren) {
+            childSlots[child.index] = child;
+        }
+        _childSlots = [childSlots copy];
+    } else {
+        _childKeys = [_mutableChildren valueForKey:NSStringFromSelector(@selector(key))] ?: @[];
+        _childSlots = [_mutableChildren copy] ?: @[];
+    }
+    
+    if (_key) {
+        NSMutableData *JSONKeyData = [NSMutableData data];
+        _ZCRJSONAppendString(JSONKeyData, _key);
+        _ZCRJSONAppend(JSONKeyData, ":", 1);
+        _JSONKeyData = [JSONKeyData copy];
+    }
+    
+    // Adopted children are shared with other recipes which may be reading them, so they're never
+    // compiled again. They were compiled beneath the same kind of parent, so their layout holds.
+    for (_ZCREasyIngredientNode *child in _mutableChildren) {
+        if (child->_isCompiled) { continue; }
+        
+        child->_isCollected = _isCollected || child.isWildcard;
+        [child compileLayout];
+    }
+    
+    // A wildcard collects every property beneath it, but only transforms those which aren't also
+    // beneath a deeper wildcard.
+    if (_isWildcard) {
+        NSMutableArray *collectedPropertyNames = [NSMutableArray array];
+        NSMutableArray *transformedPropertyNames = [NSMutableArray array];
+        [self _addPropertyNamesToCollected:collectedPropertyNames transformed:transformedPropertyNames];
+        _collectedPropertyNames = [collectedPropertyNames copy];
+        _transformedPropertyNames = [NSSet setWithArray:transformedPropertyNames];
+    }
+    
+    _isCompiled = YES;
+}
+
+- (void)_addPropertyNamesToCollected:(NSMutableArray *)collectedPropertyNames
+                         transformed:(NSMutableArray *)transformedPropertyNames {
+    if (_mutablePropertyNames) {
+        [collectedPropertyNames addObjectsFromArray:_mutablePropertyNames];
+        [transformedPropertyNames addObjectsFromArray:_mutablePropertyNames];
+    }
+    
+    for (_ZCREasyIngredientNode *child in _mutableChildren) {
+        [child _addPropertyNamesToCollected:collectedPropertyNames
+                                transformed:(child.isWildcard) ? nil : transformedPropertyNames];
+    }
+}
+
+@end
+
+
 #pragma mark - _ZCREasyRecipeMaker
 
-@implementation _ZCREasyRecipeMaker
+@implementation _ZCREasyRecipeMaker {
+    // Instructions are kept mutable so that adding or removing one doesn't copy every other
+    // instruction, which would make building large recipes quadratic.
+    NSMutableDictionary *_ingredientMapping;
+    NSMutableDictionary *_ingredientTransformers;
+    NSMutableDictionary *_memoizationLimits;
+    NSMutableSet *_internedPropertyNames;
+}
 @synthesize name = _name;
-@synthesize ingredientMapping = _ingredientMapping;
-@synthesize ingredientTransformers = _ingredientTransformers;
+@synthesize mismatchPolicy = _mismatchPolicy;
+@synthesize internPool = _internPool;
+
+- (NSDictionary *)ingredientMapping {
+    return [_ingredientMapping copy];
+}
+
+- (void)setIngredientMapping:(NSDictionary *)ingredientMapping {
+    _ingredientMapping = [ingredientMapping mutableCopy];
+}
+
+- (NSDictionary *)ingredientTransformers {
+    return [_ingredientTransformers copy];
+}
+
+- (void)setIngredientTransformers:(NSDictionary *)ingredientTransformers {
+    _ingredientTransformers = [ingredientTransformers mutableCopy];
+}
+
+- (NSDictionary *)memoizationLimits {
+    return [_memoizationLimits copy];
+}
+
+- (void)setMemoizationLimits:(NSDictionary *)memoizationLimits {
+    _memoizationLimits = [memoizationLimits mutableCopy];
+}
+
+- (NSSet *)internedPropertyNames {
+    return [_internedPropertyNames copy];
+}
+
+- (void)setInternedPropertyNames:(NSSet *)internedPropertyNames {
+    _internedPropertyNames = [internedPropertyNames mutableCopy];
+}
 
 - (BOOL)addInstructionForProperty:(NSString *)propertyName ingredientPath:(NSString *)ingredientPath
                       transformer:(id)transformer error:(NSError *__autoreleasing *)error {
@@ -543,7 +2244,7 @@
         return NO;
     }
     
-    if ([[self.ingredientMapping allKeys] containsObject:propertyName]) {
+    if (_ingredientMapping[propertyName]) {
         if (error) {
             *error = ZCREasyBakeParameterError(@"Instruction for property (%@) already exists!", propertyName);
         }
@@ -575,14 +2276,16 @@
         }
     }
     
-    NSMutableDictionary *mutableMapping = [NSMutableDictionary dictionaryWithDictionary:self.ingredientMapping];
-    mutableMapping[propertyName] = ingredientPath;
-    self.ingredientMapping = mutableMapping;
+    if (!_ingredientMapping) {
+        _ingredientMapping = [NSMutableDictionary dictionary];
+    }
+    _ingredientMapping[propertyName] = [ingredientPath copy];
     
     if (transformer) {
-        NSMutableDictionary *mutableTransformers = [NSMutableDictionary dictionaryWithDictionary:self.ingredientTransformers];
-        mutableTransformers[propertyName] = transformer;
-        self.ingredientTransformers = mutableTransformers;
+        if (!_ingredientTransformers) {
+            _ingredientTransformers = [NSMutableDictionary dictionary];
+        }
+        _ingredientTransformers[propertyName] = transformer;
     }
     
     return YES;
@@ -596,38 +2299,75 @@
         return NO;
     }
     
-    if (![[self.ingredientMapping allKeys] containsObject:propertyName]) {
+    if (!_ingredientMapping[propertyName]) {
         if (error) {
             *error = ZCREasyBakeParameterError(@"No instruction for (%@) has been added!", propertyName);
         }
         return NO;
     }
     
-    NSMutableDictionary *mutableMapping = [self.ingredientMapping mutableCopy];
-    [mutableMapping removeObjectForKey:propertyName];
-    self.ingredientMapping = mutableMapping;
-    
-    if (self.ingredientTransformers &&
-        [[self.ingredientTransformers allKeys] containsObject:propertyName]) {
-        NSMutableDictionary *mutableTransformers = [self.ingredientTransformers mutableCopy];
-        [mutableTransformers removeObjectForKey:propertyName];
-        self.ingredientTransformers = mutableTransformers;
-    }
+    [_ingredientMapping removeObjectForKey:propertyName];
+    [_ingredientTransformers removeObjectForKey:propertyName];
+    [_memoizationLimits removeObjectForKey:propertyName];
+    [_internedPropertyNames removeObject:propertyName];
     
     return YES;
 }
 
 - (BOOL)validateRecipe:(NSError *__autoreleasing *)error {
-    ZCREasyRecipe *tmpRecipe = [[ZCREasyRecipe alloc] initWithName:self.name
-                                                 ingredientMapping:self.ingredientMapping
-                                            ingredientTransformers:self.ingredientTransformers
-                                                             error:error];
-    return (tmpRecipe != nil);
+    ZCREasyRecipe *tmpRecipe = [[ZCREasyRecipe alloc] _initWithName:self.name
+                                                  ingredientMapping:self.ingredientMapping
+                                             ingredientTransformers:self.ingredientTransformers
+                                                  memoizationLimits:self.memoizationLimits
+                                                         baseRecipe:self.baseRecipe
+                                                              error:error];
+    return (tmpRecipe != nil) && [self _validateInternedPropertyNames:error];
 }
 
 - (ZCREasyRecipe *)makeRecipe {
-    return [[ZCREasyRecipe alloc] initWithName:self.name ingredientMapping:self.ingredientMapping
-                        ingredientTransformers:self.ingredientTransformers error:NULL];
+    if (![self _validateInternedPropertyNames:NULL]) { return nil; }
+    
+    ZCREasyRecipe *recipe = [[ZCREasyRecipe alloc] _initWithName:self.name ingredientMapping:self.ingredientMapping
+                                          ingredientTransformers:self.ingredientTransformers
+                                               memoizationLimits:self.memoizationLimits
+                                                      baseRecipe:self.baseRecipe error:NULL];
+    recipe.mismatchPolicy = self.mismatchPolicy;
+    if ([_internedPropertyNames count] > 0) {
+        recipe.internedPropertyNames = self.internedPropertyNames;
+        recipe.internPool = self.internPool ?: [ZCREasyInternPool sharedPool];
+    }
+    
+    return recipe;
+}
+
+- (BOOL)_validateInternedPropertyNames:(NSError *__autoreleasing *)error {
+    for (NSString *propertyName in _internedPropertyNames) {
+        if (!_ingredientMapping[propertyName]) {
+            if (error) {
+                *error = ZCREasyBakeParameterError(@"Interned property (%@) is not in the ingredient mapping!", propertyName);
+            }
+            return NO;
+        }
+    }
+    
+    return YES;
+}
+
+@end
+
+
+#pragma mark - NSValueTransformer (ZCREasyCollections)
+
+@implementation NSValueTransformer (ZCREasyCollections)
+
+- (NSArray *)zcr_transformedValues:(NSArray *)values {
+    NSMutableArray *transformedValues = [NSMutableArray arrayWithCapacity:[values count]];
+    for (id value in values) {
+        id transformedValue = [self transformedValue:(value == [NSNull null]) ? nil : value];
+        [transformedValues addObject:transformedValue ?: [NSNull null]];
+    }
+    
+    return [transformedValues copy];
 }
 
 @end
@@ -0,0 +1,120 @@
+//
+//  ZCREasyTransformerCache.h
+//  ZCREasyBake
+//
+//  Created by Zachary Radke on 10/16/26.
+//  Copyright (c) 2026 Zach Radke. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+/**
+ *  ZCREasyTransformerCache memoizes the results of an NSValueTransformer, mapping raw values to
+ *  their transformed values. The cache holds at most countLimit entries, evicting the least
+ *  recently used entry to make room for a new one.
+ *
+ *  Recipes create these caches for the properties listed in their memoizationLimits, so they rarely
+ *  need to be created directly. Instead, a recipe's caches can be inspected through its
+ *  transformerCaches to tune the limits by their hit rates.
+ *
+ *  Caches are thread-safe.
+ */
+@interface ZCREasyTransformerCache : NSObject
+
+/**
+ *  Designated initializer for this class.
+ *
+ *  @param countLimit The maximum number of entries to keep. This must be greater than 0.
+ *
+ *  @return A new, empty cache.
+ */
+- (instancetype)initWithCountLimit:(NSUInteger)countLimit;
+
+/**
+ *  The maximum number of entries kept by the cache.
+ */
+@property (assign, nonatomic, readonly) NSUInteger countLimit;
+
+/**
+ *  Returns the cached transformed value for a raw value, or transforms the value and caches the
+ *  result. A nil result is cached as NSNull. Values which don't conform to NSCopying are transformed
+ *  without being cached. Numbers only share a result with numbers of the same type, so @YES, @1 and
+ *  @1.0 are each transformed on their own, and only the first of them to be cached is kept.
+ *
+ *  @param value       The raw value to transform. NSNull is passed to the transformer as nil.
+ *  @param transformer The transformer to apply on a miss. This must not be nil.
+ *
+ *  @return The transformed value, or NSNull if the transformer returned nil.
+ */
+- (id)transformedValue:(id)value withTransformer:(NSValueTransformer *)transformer __attribute__((nonnull (2)));
+
+/**
+ *  @return The cached transformed value for the raw value, or nil if none is cached. This counts
+ *          as a hit or a miss.
+ */
+- (id)objectForKey:(id)key;
+
+/**
+ *  Caches a transformed value for a raw value, evicting the least recently used entry if the cache
+ *  is full.
+ *
+ *  @param object The transformed value. This must not be nil.
+ *  @param key    The raw value. This must not be nil and must conform to NSCopying.
+ */
+- (void)setObject:(id)object forKey:(id<NSCopying>)key __attribute__((nonnull));
+
+/**
+ *  Removes every entry from the cache. The statistics are unaffected.
+ */
+- (void)removeAllObjects;
+
+/**
+ *  The number of entries currently cached.
+ */
+@property (assign, nonatomic, readonly) NSUInteger count;
+
+/**
+ *  The number of lookups which found a cached value.
+ */
+@property (assign, nonatomic, readonly) NSUInteger hitCount;
+
+/**
+ *  The number of lookups which found no cached value.
+ */
+@property (assign, nonatomic, readonly) NSUInteger missCount;
+
+/**
+ *  The number of entries evicted to make room for newer ones.
+ */
+@property (assign, nonatomic, readonly) NSUInteger evictionCount;
+
+/**
+ *  The fraction of lookups which found a cached value, from 0.0 to 1.0. This is 0.0 if no lookups
+ *  have been made.
+ */
+@property (assign, nonatomic, readonly) double hitRate;
+
+/**
+ *  Resets the hit, miss, and eviction counts. Cached entries are unaffected.
+ */
+- (void)resetStatistics;
+
+@end
+
+
+/**
+ *  Memoization support for NSValueTransformer.
+ */
+@interface NSValueTransformer (ZCREasyMemoization)
+
+/**
+ *  Whether the results of this transformer class may be memoized by a ZCREasyTransformerCache. This
+ *  defaults to YES. Subclasses whose results aren't determined solely by the value being
+ *  transformed, or which have side effects, must override this to return NO. Recipes ignore the
+ *  memoization limits of properties whose transformers don't allow memoization.
+ *
+ *  @return YES if results may be memoized, NO if they may not.
+ */
++ (BOOL)zcr_allowsMemoization;
+
+@end
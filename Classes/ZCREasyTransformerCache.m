@@ -0,0 +1,295 @@
+//
+//  ZCREasyTransformerCache.m
+//  ZCREasyBake
+//
+//  Created by Zachary Radke on 10/16/26.
+//  Copyright (c) 2026 Zach Radke. All rights reserved.
+//
+
+#import "ZCREasyTransformerCache.h"
+
+#import <pthread.h>
+
+/**
+ *  An entry in the cache's recency list. The list owns entries through their next pointers, so
+ *  previous pointers are unretained.
+ */
+@interface _ZCREasyCacheEntry : NSObject {
+    @package
+    id _key;
+    id _object;
+    _ZCREasyCacheEntry *_next;
+    __unsafe_unretained _ZCREasyCacheEntry *_previous;
+}
+@end
+
+@implementation _ZCREasyCacheEntry
+@end
+
+// NSNumber considers @YES, @1 and @1.0 equal, but a transformer may treat them differently, so a
+// cached number only answers for a key of the same class and type.
+static inline BOOL _ZCRCacheKeyMatches(id cachedKey, id key) {
+    if (![key isKindOfClass:[NSNumber class]]) { return YES; }
+    
+    return [cachedKey class] == [key class] && strcmp([cachedKey objCType], [key objCType]) == 0;
+}
+
+
+#pragma mark - ZCREasyTransformerCache
+
+@implementation ZCREasyTransformerCache {
+    pthread_mutex_t _lock;
+    NSMutableDictionary *_entries;
+    
+    // The most recently used entry is the head, and the least recently used is the tail.
+    _ZCREasyCacheEntry *_head;
+    __unsafe_unretained _ZCREasyCacheEntry *_tail;
+    
+    NSUInteger _hitCount;
+    NSUInteger _missCount;
+    NSUInteger _evictionCount;
+}
+
+- (instancetype)initWithCountLimit:(NSUInteger)countLimit {
+    NSParameterAssert(countLimit > 0);
+    
+    if (!(self = [super init])) { return nil; }
+    
+    _countLimit = MAX(countLimit, (NSUInteger)1);
+    pthread_mutex_init(&_lock, NULL);
+    _entries = [NSMutableDictionary dictionary];
+    
+    return self;
+}
+
+- (instancetype)init {
+    return [self initWithCountLimit:256];
+}
+
+- (void)dealloc {
+    [self _unlinkAllEntries];
+    pthread_mutex_destroy(&_lock);
+}
+
+- (id)transformedValue:(id)value withTransformer:(NSValueTransformer *)transformer {
+    NSParameterAssert(transformer);
+    
+    id key = value ?: [NSNull null];
+    BOOL isCacheable = [key conformsToProtocol:@protocol(NSCopying)];
+    
+    if (isCacheable) {
+        id cachedValue = [self _objectForKey:key matchingType:YES];
+        if (cachedValue) { return cachedValue; }
+    }
+    
+    // The transformation happens outside the lock, so concurrent misses for the same value may both
+    // transform it. Transformers are pure, so either result is fine to keep.
+    id transformedValue = [transformer transformedValue:(key == [NSNull null]) ? nil : key];
+    if (!transformedValue) {
+        transformedValue = [NSNull null];
+    }
+    
+    if (isCacheable) {
+        [self _setObject:transformedValue forKey:key matchingType:YES];
+    }
+    
+    return transformedValue;
+}
+
+- (id)objectForKey:(id)key {
+    return [self _objectForKey:key matchingType:NO];
+}
+
+- (void)setObject:(id)object forKey:(id<NSCopying>)key {
+    [self _setObject:object forKey:key matchingType:NO];
+}
+
+- (id)_objectForKey:(id)key matchingType:(BOOL)matchesType {
+    if (!key) { return nil; }
+    
+    pthread_mutex_lock(&_lock);
+    _ZCREasyCacheEntry *entry = _entries[key];
+    id object = nil;
+    if (entry && (!matchesType || _ZCRCacheKeyMatches(entry->_key, key))) {
+        [self _moveEntryToHead:entry];
+        object = entry->_object;
+        _hitCount++;
+    } else {
+        _missCount++;
+    }
+    pthread_mutex_unlock(&_lock);
+    
+    return object;
+}
+
+// An equal key of another type keeps its entry, and the object is simply not cached.
+- (void)_setObject:(id)object forKey:(id<NSCopying>)key matchingType:(BOOL)matchesType {
+    NSParameterAssert(object);
+    NSParameterAssert(key);
+    
+    pthread_mutex_lock(&_lock);
+    _ZCREasyCacheEntry *entry = _entries[key];
+    if (entry) {
+        if (!matchesType || _ZCRCacheKeyMatches(entry->_key, key)) {
+            entry->_object = object;
+            [self _moveEntryToHead:entry];
+        }
+    } else {
+        entry = [[_ZCREasyCacheEntry alloc] init];
+        entry->_key = [(id)key copy];
+        entry->_object = object;
+        _entries[entry->_key] = entry;
+        [self _insertEntryAtHead:entry];
+    
+        if ([_entries count] > _countLimit) {
+            _ZCREasyCacheEntry *leastRecentEntry = _tail;
+            [self _removeEntry:leastRecentEntry];
+            _evictionCount++;
+        }
+    }
+    pthread_mutex_unlock(&_lock);
+}
+
+- (void)removeAllObjects {
+    pthread_mutex_lock(&_lock);
+    [self _unlinkAllEntries];
+    [_entries removeAllObjects];
+    pthread_mutex_unlock(&_lock);
+}
+
+- (NSUInteger)count {
+    pthread_mutex_lock(&_lock);
+    NSUInteger count = [_entries count];
+    pthread_mutex_unlock(&_lock);
+    return count;
+}
+
+- (NSUInteger)hitCount {
+    pthread_mutex_lock(&_lock);
+    NSUInteger hitCount = _hitCount;
+    pthread_mutex_unlock(&_lock);
+    return hitCount;
+}
+
+- (NSUInteger)missCount {
+    pthread_mutex_lock(&_lock);
+    NSUInteger missCount = _missCount;
+    pthread_mutex_unlock(&_lock);
+    return missCount;
+}
+
+- (NSUInteger)evictionCount {
+    pthread_mutex_lock(&_lock);
+    NSUInteger evictionCount = _evictionCount;
+    pthread_mutex_unlock(&_lock);
+    return evictionCount;
+}
+
+- (double)hitRate {
+    pthread_mutex_lock(&_lock);
+    NSUInteger lookupCount = _hitCount + _missCount;
+    double hitRate = (lookupCount > 0) ? (double)_hitCount / (double)lookupCount : 0.0;
+    pthread_mutex_unlock(&_lock);
+    return hitRate;
+}
+
+- (void)resetStatistics {
+    pthread_mutex_lock(&_lock);
+    _hitCount = 0;
+    _missCount = 0;
+    _evictionCount = 0;
+    pthread_mutex_unlock(&_lock);
+}
+
+
+#pragma mark NSObject
+
+- (NSString *)description {
+    pthread_mutex_lock(&_lock);
+    NSUInteger lookupCount = _hitCount + _missCount;
+    NSString *description = [NSString stringWithFormat:@"<%@:%p> count:%lu/%lu hits:%lu misses:%lu evictions:%lu hitRate:%.3f",
+                             NSStringFromClass([self class]), self,
+                             (unsigned long)[_entries count], (unsigned long)_countLimit,
+                             (unsigned long)_hitCount, (unsigned long)_missCount,
+                             (unsigned long)_evictionCount,
+                             (lookupCount > 0) ? (double)_hitCount / (double)lookupCount : 0.0];
+    pthread_mutex_unlock(&_lock);
+    return description;
+}
+
+
+#pragma mark Private utilities
+
+// The following utilities must be called while holding the lock.
+
+- (void)_insertEntryAtHead:(_ZCREasyCacheEntry *)entry {
+    entry->_previous = nil;
+    entry->_next = _head;
+    if (_head) {
+        _head->_previous = entry;
+    } else {
+        _tail = entry;
+    }
+    _head = entry;
+}
+
+- (void)_moveEntryToHead:(_ZCREasyCacheEntry *)entry {
+    if (entry == _head) { return; }
+    
+    // Keep the entry alive while it is unlinked, since only its neighbours retain it.
+    _ZCREasyCacheEntry *retainedEntry = entry;
+    [self _unlinkEntry:retainedEntry];
+    [self _insertEntryAtHead:retainedEntry];
+}
+
+- (void)_unlinkEntry:(_ZCREasyCacheEntry *)entry {
+    _ZCREasyCacheEntry *previous = entry->_previous;
+    _ZCREasyCacheEntry *next = entry->_next;
+    
+    if (previous) {
+        previous->_next = next;
+    } else {
+        _head = next;
+    }
+    
+    if (next) {
+        next->_previous = previous;
+    } else {
+        _tail = previous;
+    }
+    
+    entry->_next = nil;
+    entry->_previous = nil;
+}
+
+- (void)_removeEntry:(_ZCREasyCacheEntry *)entry {
+    _ZCREasyCacheEntry *retainedEntry = entry;
+    [self _unlinkEntry:retainedEntry];
+    [_entries removeObjectForKey:retainedEntry->_key];
+}
+
+- (void)_unlinkAllEntries {
+    // Entries are released front to back so that releasing a long list never recurses deeply.
+    _ZCREasyCacheEntry *entry = _head;
+    _head = nil;
+    _tail = nil;
+    while (entry) {
+        _ZCREasyCacheEntry *next = entry->_next;
+        entry->_next = nil;
+        entry->_previous = nil;
+        entry = next;
+    }
+}
+
+@end
+
+
+#pragma mark - NSValueTransformer (ZCREasyMemoization)
+
+@implementation NSValueTransformer (ZCREasyMemoization)
+
++ (BOOL)zcr_allowsMemoization {
+    return YES;
+}
+
+@end
@@ -0,0 +1,216 @@
+//
+//  ZCREasyCoercionTests.m
+//  ZCREasyBake
+//
+//  Created by Zachary Radke on 10/16/26.
+//  Copyright (c) 2026 Zach Radke. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#import "ZCREasyBake.h"
+
+@interface ZCRCoercionPrefixTransformer : NSValueTransformer
+@end
+
+@implementation ZCRCoercionPrefixTransformer
+
++ (BOOL)allowsReverseTransformation {
+    return NO;
+}
+
+- (id)transformedValue:(id)value {
+    return [NSString stringWithFormat:@"#%@", value];
+}
+
+@end
+
+@interface ZCRCoercedModel : ZCREasyDough
+@property (strong, nonatomic, readonly) NSString *name;
+@property (strong, nonatomic, readonly) NSNumber *score;
+@property (strong, nonatomic, readonly) NSDate *updatedAt;
+@property (strong, nonatomic, readonly) NSURL *website;
+@property (assign, nonatomic, readonly) NSInteger count;
+@property (assign, nonatomic, readonly) unsigned long long total;
+@property (assign, nonatomic, readonly) double ratio;
+@property (assign, nonatomic, readonly) BOOL isActive;
+@end
+
+@implementation ZCRCoercedModel
+
++ (BOOL)coercesIngredients {
+    return YES;
+}
+
+@end
+
+@interface ZCRLazyCoercedModel : ZCREasyDough
+@property (strong, nonatomic, readonly) NSDate *updatedAt;
+@property (assign, nonatomic, readonly) NSInteger count;
+@end
+
+@implementation ZCRLazyCoercedModel
+@dynamic updatedAt, count;
+
++ (BOOL)usesSlotStorage {
+    return YES;
+}
+
++ (BOOL)usesLazyBaking {
+    return YES;
+}
+
++ (BOOL)coercesIngredients {
+    return YES;
+}
+
+@end
+
+@interface ZCREasyCoercionTests : XCTestCase {
+    ZCREasyRecipe *recipe;
+}
+@end
+
+@implementation ZCREasyCoercionTests
+
+- (void)setUp {
+    [super setUp];
+    
+    recipe = [ZCREasyRecipe makeWith:^(id<ZCREasyRecipeMaker> recipeMaker) {
+        recipeMaker.ingredientMapping = @{@"name": @"name",
+                                          @"score": @"score",
+                                          @"updatedAt": @"updated_at",
+                                          @"website": @"website",
+                                          @"count": @"count",
+                                          @"total": @"total",
+                                          @"ratio": @"ratio",
+                                          @"isActive": @"is_active"};
+    }];
+}
+
+- (void)tearDown {
+    recipe = nil;
+    
+    [super tearDown];
+}
+
+- (void)testParsingDates {
+    NSTimeInterval timeInterval = 0;
+    
+    XCTAssertTrue(ZCREasyParseISO8601Date(@"2014-04-21", &timeInterval), @"Dates should be parsed");
+    XCTAssertEqual(timeInterval, 1398038400.0, @"Dates should be midnight UTC");
+    
+    XCTAssertTrue(ZCREasyParseISO8601Date(@"2014-04-21T10:20:30Z", &timeInterval), @"UTC times should be parsed");
+    XCTAssertEqual(timeInterval, 1398075630.0, @"The time should be added to the date");
+    
+    XCTAssertTrue(ZCREasyParseISO8601Date(@"2014-04-21T10:20:30.25+05:30", &timeInterval), @"Offsets should be parsed");
+    XCTAssertEqualWithAccuracy(timeInterval, 1398055830.25, 0.0001, @"The offset and fraction should be applied");
+    
+    XCTAssertTrue(ZCREasyParseISO8601Date(@"20140421T102030-0800", &timeInterval), @"The basic format should be parsed");
+    XCTAssertEqual(timeInterval, 1398104430.0, @"The negative offset should be applied");
+    
+    XCTAssertTrue(ZCREasyParseISO8601Date(@"2016-02-29", NULL), @"Leap days should be parsed");
+    XCTAssertFalse(ZCREasyParseISO8601Date(@"2014-02-29", NULL), @"Leap days should only exist in leap years");
+    XCTAssertFalse(ZCREasyParseISO8601Date(@"2014-4-21", NULL), @"Components must be zero padded");
+    XCTAssertFalse(ZCREasyParseISO8601Date(@"2014-04-21T10:20:30+", NULL), @"Offsets must be complete");
+    XCTAssertFalse(ZCREasyParseISO8601Date(@"2014-04-21T25:00", NULL), @"Hours must be in range");
+    XCTAssertFalse(ZCREasyParseISO8601Date(@"yesterday", NULL), @"Other strings should not be parsed");
+}
+
+- (void)testCoercingValues {
+    XCTAssertEqualObjects(ZCREasyCoerceValue(@"42", Nil, 'q'), @42, @"Integer strings should become numbers");
+    XCTAssertEqualObjects(ZCREasyCoerceValue(@"18446744073709551615", Nil, 'Q'), @(ULLONG_MAX), @"Unsigned strings should not overflow");
+    XCTAssertEqualObjects(ZCREasyCoerceValue(@"0.5", Nil, 'd'), @0.5, @"Decimal strings should become numbers");
+    XCTAssertEqualObjects(ZCREasyCoerceValue(@"TRUE", Nil, 'B'), @YES, @"Boolean literals should become numbers");
+    XCTAssertEqualObjects(ZCREasyCoerceValue(@"1.5", [NSNumber class], 0), @1.5, @"Strings should become NSNumbers");
+    XCTAssertEqualObjects(ZCREasyCoerceValue(@12, [NSString class], 0), @"12", @"Numbers should become strings");
+    XCTAssertEqualObjects(ZCREasyCoerceValue(@60, [NSDate class], 0), [NSDate dateWithTimeIntervalSince1970:60], @"Timestamps should become dates");
+    XCTAssertEqualObjects(ZCREasyCoerceValue(@"1.25", [NSDecimalNumber class], 0), [NSDecimalNumber decimalNumberWithString:@"1.25"], @"Strings should become decimal numbers");
+    
+    XCTAssertNil(ZCREasyCoerceValue(@"42 apples", Nil, 'q'), @"Partially numeric strings should not be coerced");
+    XCTAssertNil(ZCREasyCoerceValue(@" 42", Nil, 'q'), @"Padded strings should not be coerced");
+    XCTAssertNil(ZCREasyCoerceValue(@"99999999999999999999", Nil, 'q'), @"Overflowing strings should not be coerced");
+    XCTAssertNil(ZCREasyCoerceValue(@{}, [NSDate class], 0), @"Dictionaries should not become dates");
+    
+    NSArray *array = @[];
+    XCTAssertEqual(ZCREasyCoerceValue(array, [NSArray class], 0), array, @"Values of the right type should be returned as they are");
+    XCTAssertEqual(ZCREasyCoerceValue(array, [NSSet class], 0), array, @"Values for other types should be returned as they are");
+    XCTAssertEqual(ZCREasyCoerceValue([NSNull null], [NSString class], 0), [NSNull null], @"Null should be returned as it is");
+}
+
+- (void)testBakingCoercedIngredients {
+    NSDictionary *ingredients = @{@"name": @7,
+                                  @"score": @"9.5",
+                                  @"updated_at": @"2014-04-21T10:20:30Z",
+                                  @"website": @"https://example.com",
+                                  @"count": @"12",
+                                  @"total": @"18446744073709551615",
+                                  @"ratio": @"0.25",
+                                  @"is_active": @"true"};
+    
+    NSError *error;
+    ZCRCoercedModel *model = [[ZCRCoercedModel alloc] initWithIdentifier:@"coerced" ingredients:ingredients recipe:recipe error:&error];
+    
+    XCTAssertNotNil(model, @"The model should be baked: %@", error);
+    XCTAssertEqualObjects(model.name, @"7", @"The number should become a string");
+    XCTAssertEqualObjects(model.score, @9.5, @"The string should become a number");
+    XCTAssertEqualObjects(model.updatedAt, [NSDate dateWithTimeIntervalSince1970:1398075630], @"The string should become a date");
+    XCTAssertEqualObjects(model.website, [NSURL URLWithString:@"https://example.com"], @"The string should become a URL");
+    XCTAssertEqual(model.count, (NSInteger)12, @"The string should become an integer");
+    XCTAssertEqual(model.total, ULLONG_MAX, @"The string should become an unsigned integer");
+    XCTAssertEqual(model.ratio, 0.25, @"The string should become a double");
+    XCTAssertTrue(model.isActive, @"The string should become a BOOL");
+    
+    XCTAssertTrue([model isEqualToIngredients:ingredients withRecipe:recipe error:NULL], @"Coerced ingredients should match the model");
+    XCTAssertEqual([model updateWithIngredients:ingredients recipe:recipe error:NULL], model, @"Coerced ingredients should not be an update");
+}
+
+- (void)testTransformersTakePrecedence {
+    ZCREasyRecipe *transformingRecipe = [recipe modifyWith:^(id<ZCREasyRecipeMaker> recipeMaker) {
+        recipeMaker.ingredientTransformers = @{@"name": [[ZCRCoercionPrefixTransformer alloc] init]};
+    }];
+    
+    ZCRCoercedModel *model = [[ZCRCoercedModel alloc] initWithIdentifier:@"coerced" ingredients:@{@"name": @7, @"count": @"3"}
+                                                                  recipe:transformingRecipe error:NULL];
+    
+    XCTAssertEqualObjects(model.name, @"#7", @"The transformer should be used instead of coercion");
+    XCTAssertEqual(model.count, (NSInteger)3, @"Other properties should still be coerced");
+}
+
+- (void)testUncoercibleIngredients {
+    NSDictionary *ingredients = @{@"count": @"many", @"updated_at": @"yesterday", @"name": @"Name"};
+    
+    NSError *error;
+    ZCRCoercedModel *model = [[ZCRCoercedModel alloc] initWithIdentifier:@"coerced" ingredients:ingredients recipe:recipe error:&error];
+    
+    XCTAssertNil(model, @"The model should fail to bake");
+    XCTAssertEqual(error.code, ZCREasyBakeErrorMismatchedIngredients, @"The error should report the mismatch");
+    NSDictionary *expectedMismatches = @{@"count": @"count", @"updatedAt": @"updated_at"};
+    XCTAssertEqualObjects(error.userInfo[ZCREasyBakeMismatchedPropertiesKey], expectedMismatches, @"Both properties should be reported");
+    
+    ZCREasyRecipe *nullingRecipe = [recipe modifyWith:^(id<ZCREasyRecipeMaker> recipeMaker) {
+        recipeMaker.mismatchPolicy = ZCREasyRecipeMismatchPolicyNullField;
+    }];
+    model = [[ZCRCoercedModel alloc] initWithIdentifier:@"coerced" ingredients:ingredients recipe:nullingRecipe error:&error];
+    
+    XCTAssertNotNil(model, @"The model should be baked: %@", error);
+    XCTAssertEqualObjects(model.name, @"Name", @"Coercible properties should be set");
+    XCTAssertNil(model.updatedAt, @"The date should be nulled");
+    XCTAssertEqual(model.count, (NSInteger)0, @"The scalar should be left unset");
+}
+
+- (void)testLazyCoercion {
+    ZCREasyRecipe *lazyRecipe = [ZCREasyRecipe makeWith:^(id<ZCREasyRecipeMaker> recipeMaker) {
+        recipeMaker.ingredientMapping = @{@"updatedAt": @"updated_at", @"count": @"count"};
+    }];
+    ZCRLazyCoercedModel *model = [[ZCRLazyCoercedModel alloc] initWithIdentifier:@"lazy"
+                                                                      ingredients:@{@"updated_at": @"2014-04-21", @"count": @"nope"}
+                                                                           recipe:lazyRecipe error:NULL];
+    
+    XCTAssertNotNil(model, @"The model should be baked");
+    
+    XCTAssertEqualObjects(model.updatedAt, [NSDate dateWithTimeIntervalSince1970:1398038400], @"The date should be coerced when read");
+    XCTAssertEqual(model.count, (NSInteger)0, @"Uncoercible values should be left unset");
+}
+
+@end
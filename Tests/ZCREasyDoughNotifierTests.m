@@ -0,0 +1,142 @@
+//
+//  ZCREasyDoughNotifierTests.m
+//  ZCREasyBake
+//
+//  Created by Zachary Radke on 10/16/26.
+//  Copyright (c) 2026 Zach Radke. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "ZCREasyDough.h"
+#import "ZCREasyDoughNotifier.h"
+
+@interface ZCREasyDoughNotifierTestsModel : ZCREasyDough
+@property (strong, nonatomic, readonly) NSString *name;
+@end
+
+@implementation ZCREasyDoughNotifierTestsModel
+@end
+
+@interface ZCREasyDoughNotifierTests : XCTestCase
+{
+    NSNotificationCenter *center;
+    ZCREasyDoughNotifier *notifier;
+    NSMutableArray *notifications;
+    id observer;
+    id batchObserver;
+    ZCREasyDoughNotifierTestsModel *model;
+}
+@end
+
+@implementation ZCREasyDoughNotifierTests
+
+- (void)setUp {
+    [super setUp];
+    
+    center = [[NSNotificationCenter alloc] init];
+    notifier = [[ZCREasyDoughNotifier alloc] initWithNotificationCenter:center
+                                                          deliveryQueue:dispatch_queue_create("com.zachradke.easyBake.tests.notifier", DISPATCH_QUEUE_SERIAL)
+                                                     coalescingInterval:60.0];
+    
+    notifications = [NSMutableArray array];
+    NSMutableArray *receivedNotifications = notifications;
+    void (^receiveBlock)(NSNotification *) = ^(NSNotification *note) {
+        @synchronized(receivedNotifications) {
+            [receivedNotifications addObject:note];
+        }
+    };
+    observer = [center addObserverForName:ZCREasyDoughUpdateNotification object:nil queue:nil
+                               usingBlock:receiveBlock];
+    batchObserver = [center addObserverForName:ZCREasyDoughBatchUpdateNotification object:nil
+                                         queue:nil usingBlock:receiveBlock];
+    
+    model = [[ZCREasyDoughNotifierTestsModel alloc] initWithIdentifier:@1
+                                                           ingredients:@{@"name": @"Zach"}
+                                                                recipe:[ZCREasyDoughNotifierTestsModel genericRecipe]
+                                                                 error:NULL];
+}
+
+- (void)tearDown {
+    [center removeObserver:observer];
+    [center removeObserver:batchObserver];
+    model = nil;
+    notifications = nil;
+    notifier = nil;
+    center = nil;
+    
+    [super tearDown];
+}
+
+- (ZCREasyDoughNotifierTestsModel *)updatedModelNamed:(NSString *)name from:(ZCREasyDoughNotifierTestsModel *)original {
+    return [[ZCREasyDoughNotifierTestsModel alloc] initWithIdentifier:original.uniqueIdentifier
+                                                          ingredients:@{@"name": name}
+                                                               recipe:[ZCREasyDoughNotifierTestsModel genericRecipe]
+                                                                error:NULL];
+}
+
+- (void)testSynchronousDelivery {
+    notifier = [[ZCREasyDoughNotifier alloc] initWithNotificationCenter:center deliveryQueue:nil
+                                                     coalescingInterval:0.0];
+    
+    ZCREasyDoughNotifierTestsModel *updatedModel = [self updatedModelNamed:@"Radke" from:model];
+    [notifier postUpdateOfDough:model updatedDough:updatedModel
+           changedPropertyNames:[NSSet setWithObject:@"name"]];
+    
+    XCTAssertEqual(notifications.count, (NSUInteger)1, @"The update should be delivered immediately");
+    XCTAssertTrue([notifications[0] object] == model, @"The notification object should be the original model");
+    XCTAssertTrue([notifications[0] userInfo][ZCREasyDoughUpdatedDoughKey] == updatedModel, @"The updated model should be passed");
+}
+
+- (void)testCoalescesUpdates {
+    ZCREasyDoughNotifierTestsModel *firstModel = [self updatedModelNamed:@"First" from:model];
+    ZCREasyDoughNotifierTestsModel *secondModel = [self updatedModelNamed:@"Second" from:model];
+    [notifier postUpdateOfDough:model updatedDough:firstModel
+           changedPropertyNames:[NSSet setWithObject:@"name"]];
+    [notifier postUpdateOfDough:firstModel updatedDough:secondModel
+           changedPropertyNames:[NSSet setWithObject:@"other"]];
+    
+    XCTAssertEqual(notifications.count, (NSUInteger)0, @"The updates should wait for the coalescing interval");
+    XCTAssertEqualObjects([notifier statistics][ZCREasyDoughNotifierQueueDepthKey], @1, @"The updates should be coalesced");
+    
+    [notifier flush];
+    
+    XCTAssertEqual(notifications.count, (NSUInteger)1, @"One notification should be delivered");
+    NSNotification *note = notifications[0];
+    XCTAssertTrue(note.object == model, @"The original model should be the notification object");
+    XCTAssertTrue(note.userInfo[ZCREasyDoughUpdatedDoughKey] == secondModel, @"The latest model should be passed");
+    NSSet *expectedNames = [NSSet setWithObjects:@"name", @"other", nil];
+    XCTAssertEqualObjects(note.userInfo[ZCREasyDoughChangedPropertyNamesKey], expectedNames, @"The changed names should be merged");
+    
+    NSDictionary *statistics = [notifier statistics];
+    XCTAssertEqualObjects(statistics[ZCREasyDoughNotifierPostedCountKey], @2, @"Both updates should be counted");
+    XCTAssertEqualObjects(statistics[ZCREasyDoughNotifierCoalescedCountKey], @1, @"One update should be coalesced");
+    XCTAssertEqualObjects(statistics[ZCREasyDoughNotifierDeliveredCountKey], @1, @"One update should be delivered");
+    XCTAssertEqualObjects(statistics[ZCREasyDoughNotifierQueueDepthKey], @0, @"Nothing should be pending");
+    XCTAssertTrue([statistics[ZCREasyDoughNotifierMaxLatencyKey] doubleValue] >= 0.0, @"The latency should be measured");
+}
+
+- (void)testBatchUpdates {
+    ZCREasyDoughNotifierTestsModel *otherModel = [[ZCREasyDoughNotifierTestsModel alloc] initWithIdentifier:@2
+                                                                                                 ingredients:@{@"name": @"Other"}
+                                                                                                      recipe:[ZCREasyDoughNotifierTestsModel genericRecipe]
+                                                                                                       error:NULL];
+    
+    [notifier performBatchUpdates:^{
+        [notifier postUpdateOfDough:model updatedDough:[self updatedModelNamed:@"First" from:model]
+               changedPropertyNames:[NSSet setWithObject:@"name"]];
+        [notifier postUpdateOfDough:otherModel updatedDough:[self updatedModelNamed:@"Second" from:otherModel]
+               changedPropertyNames:[NSSet setWithObject:@"name"]];
+    }];
+    [notifier flush];
+    
+    XCTAssertEqual(notifications.count, (NSUInteger)1, @"One batched notification should be delivered");
+    NSNotification *note = notifications[0];
+    XCTAssertEqualObjects(note.name, ZCREasyDoughBatchUpdateNotification, @"The batch notification should be posted");
+    
+    NSArray *updates = note.userInfo[ZCREasyDoughUpdatesKey];
+    XCTAssertEqual(updates.count, (NSUInteger)2, @"Both updates should be listed");
+    XCTAssertTrue(updates[0][ZCREasyDoughOriginalDoughKey] == model, @"The updates should be in order");
+    XCTAssertTrue(updates[1][ZCREasyDoughOriginalDoughKey] == otherModel, @"The updates should be in order");
+}
+
+@end
@@ -0,0 +1,214 @@
+//
+//  ZCREasyDoughSnapshotTests.m
+//  ZCREasyBake
+//
+//  Created by Zachary Radke on 10/16/26.
+//  Copyright (c) 2026 Zach Radke. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "ZCREasyDough.h"
+#import "ZCREasyDoughSnapshot.h"
+
+@interface ZCREasyDoughSnapshotTestsModel : ZCREasyDough
+@property (strong, nonatomic, readonly) NSString *name;
+@property (strong, nonatomic, readonly) NSDate *createdAt;
+@property (strong, nonatomic, readonly) NSNumber *rating;
+@property (strong, nonatomic, readonly) NSArray *tags;
+@property (assign, nonatomic, readonly) NSInteger visitCount;
+@property (assign, nonatomic, readonly) double score;
+@property (assign, nonatomic, readonly) BOOL isActive;
+@end
+
+@implementation ZCREasyDoughSnapshotTestsModel
+@end
+
+@interface ZCREasyDoughSnapshotTestsOtherModel : ZCREasyDough
+@property (assign, nonatomic, readonly) NSInteger name;
+@end
+
+@implementation ZCREasyDoughSnapshotTestsOtherModel
+@end
+
+@interface ZCREasyDoughSnapshotTestsInsecureValue : NSObject <NSCoding>
+@end
+
+@implementation ZCREasyDoughSnapshotTestsInsecureValue
+
+- (instancetype)initWithCoder:(NSCoder *)aDecoder {
+    return [self init];
+}
+
+- (void)encodeWithCoder:(NSCoder *)aCoder {
+}
+
+@end
+
+@interface ZCREasyDoughSnapshotTestsInsecureModel : ZCREasyDough
+@property (strong, nonatomic, readonly) ZCREasyDoughSnapshotTestsInsecureValue *value;
+@end
+
+@implementation ZCREasyDoughSnapshotTestsInsecureModel
+@end
+
+@interface ZCREasyDoughSnapshotTests : XCTestCase
+{
+    NSArray *doughs;
+}
+@end
+
+@implementation ZCREasyDoughSnapshotTests
+
+- (void)setUp {
+    [super setUp];
+    
+    NSMutableArray *mutableDoughs = [NSMutableArray array];
+    for (NSInteger i = 0; i < 100; i++) {
+        NSMutableDictionary *ingredients = [@{@"name": (i % 2 == 0) ? @"Even" : @"Odd",
+                                              @"createdAt": [NSDate dateWithTimeIntervalSinceReferenceDate:i * 60.0],
+                                              @"tags": @[@"tag", @(i)],
+                                              @"visitCount": @(i),
+                                              @"score": @(i / 4.0),
+                                              @"isActive": @(i % 3 == 0)} mutableCopy];
+        if (i % 5 != 0) {
+            ingredients[@"rating"] = @(i % 5);
+        }
+        
+        [mutableDoughs addObject:[[ZCREasyDoughSnapshotTestsModel alloc] initWithIdentifier:@(i)
+                                                                                ingredients:ingredients
+                                                                                     recipe:[ZCREasyDoughSnapshotTestsModel genericRecipe]
+                                                                                      error:NULL]];
+    }
+    doughs = [mutableDoughs copy];
+}
+
+- (void)tearDown {
+    doughs = nil;
+    
+    [super tearDown];
+}
+
+- (void)testRoundTrip {
+    NSError *error;
+    NSData *data = [ZCREasyDoughSnapshot dataWithDoughs:doughs doughClass:[ZCREasyDoughSnapshotTestsModel class]
+                                                 recipe:nil error:&error];
+    XCTAssertNotNil(data, @"The doughs should be encoded: %@", error);
+    
+    ZCREasyDoughSnapshot *snapshot = [[ZCREasyDoughSnapshot alloc] initWithData:data
+                                                                     doughClass:[ZCREasyDoughSnapshotTestsModel class]
+                                                                          error:&error];
+    XCTAssertNotNil(snapshot, @"The snapshot should be opened: %@", error);
+    XCTAssertEqual(snapshot.count, (NSUInteger)100, @"Every dough should be stored.");
+    XCTAssertEqual(snapshot.materializedCount, (NSUInteger)0, @"Opening should not materialize doughs.");
+    XCTAssertEqualObjects([snapshot identifierAtIndex:42], @42, @"Identifiers should be readable directly.");
+    XCTAssertEqual(snapshot.materializedCount, (NSUInteger)0, @"Reading identifiers should not materialize doughs.");
+    
+    for (NSUInteger i = 0; i < [doughs count]; i++) {
+        ZCREasyDoughSnapshotTestsModel *original = doughs[i];
+        ZCREasyDoughSnapshotTestsModel *restored = snapshot[i];
+        
+        XCTAssertEqualObjects(restored.uniqueIdentifier, original.uniqueIdentifier, @"The identifier should be restored.");
+        XCTAssertEqualObjects(restored.name, original.name, @"Strings should be restored.");
+        XCTAssertEqualObjects(restored.createdAt, original.createdAt, @"Dates should be restored.");
+        XCTAssertEqualObjects(restored.rating, original.rating, @"Numbers and nils should be restored.");
+        XCTAssertEqualObjects(restored.tags, original.tags, @"Archived objects should be restored.");
+        XCTAssertEqual(restored.visitCount, original.visitCount, @"Integers should be restored.");
+        XCTAssertEqual(restored.score, original.score, @"Doubles should be restored.");
+        XCTAssertEqual(restored.isActive, original.isActive, @"Booleans should be restored.");
+    }
+    
+    XCTAssertEqual(snapshot.materializedCount, (NSUInteger)100, @"Every accessed dough should be materialized.");
+    XCTAssertTrue(snapshot[3] == snapshot[3], @"Materialized doughs should be reused.");
+    XCTAssertTrue([snapshot[1] name] == [snapshot[3] name], @"Interned strings should be shared.");
+}
+
+- (void)testLazyMaterialization {
+    NSData *data = [ZCREasyDoughSnapshot dataWithDoughs:doughs doughClass:[ZCREasyDoughSnapshotTestsModel class]
+                                                 recipe:nil error:NULL];
+    ZCREasyDoughSnapshot *snapshot = [[ZCREasyDoughSnapshot alloc] initWithData:data
+                                                                     doughClass:[ZCREasyDoughSnapshotTestsModel class]
+                                                                          error:NULL];
+    
+    ZCREasyDoughSnapshotTestsModel *dough = snapshot[57];
+    XCTAssertEqualObjects(dough.uniqueIdentifier, @57, @"The requested dough should be materialized.");
+    XCTAssertEqual(snapshot.materializedCount, (NSUInteger)1, @"Only the requested dough should be materialized.");
+    
+    NSError *error;
+    XCTAssertNil([snapshot doughAtIndex:100 error:&error], @"Out of bounds doughs should not be returned.");
+    XCTAssertNotNil(error, @"The error should be populated.");
+}
+
+- (void)testMappedFile {
+    NSURL *URL = [NSURL fileURLWithPath:[NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID] UUIDString]]];
+    ZCREasyRecipe *recipe = [ZCREasyRecipe makeWith:^(id<ZCREasyRecipeMaker> recipeMaker) {
+        recipeMaker.ingredientMapping = @{@"name": @"name", @"visitCount": @"visitCount"};
+    }];
+    
+    NSError *error;
+    XCTAssertTrue([ZCREasyDoughSnapshot writeDoughs:doughs doughClass:[ZCREasyDoughSnapshotTestsModel class]
+                                             recipe:recipe toURL:URL error:&error], @"The snapshot should be written: %@", error);
+    
+    ZCREasyDoughSnapshot *snapshot = [[ZCREasyDoughSnapshot alloc] initWithContentsOfURL:URL
+                                                                              doughClass:[ZCREasyDoughSnapshotTestsModel class]
+                                                                                   error:&error];
+    NSArray *expectedNames = @[@"name", @"visitCount"];
+    XCTAssertEqualObjects(snapshot.propertyNames, expectedNames, @"Only the recipe's properties should be stored.");
+    
+    ZCREasyDoughSnapshotTestsModel *dough = snapshot[9];
+    XCTAssertEqualObjects(dough.name, @"Odd", @"Stored properties should be restored.");
+    XCTAssertEqual(dough.visitCount, (NSInteger)9, @"Stored properties should be restored.");
+    XCTAssertNil(dough.createdAt, @"Properties outside the recipe should not be restored.");
+    
+    snapshot = nil;
+    [[NSFileManager defaultManager] removeItemAtURL:URL error:NULL];
+}
+
+#pragma mark - Errors
+
+- (void)testInvalidData {
+    NSError *error;
+    ZCREasyDoughSnapshot *snapshot = [[ZCREasyDoughSnapshot alloc] initWithData:[@"not a snapshot" dataUsingEncoding:NSUTF8StringEncoding]
+                                                                     doughClass:[ZCREasyDoughSnapshotTestsModel class]
+                                                                          error:&error];
+    XCTAssertNil(snapshot, @"Invalid data should not be opened.");
+    XCTAssertNotNil(error, @"The error should be populated.");
+}
+
+- (void)testTruncatedData {
+    NSData *data = [ZCREasyDoughSnapshot dataWithDoughs:doughs doughClass:[ZCREasyDoughSnapshotTestsModel class]
+                                                 recipe:nil error:NULL];
+    
+    NSError *error;
+    ZCREasyDoughSnapshot *snapshot = [[ZCREasyDoughSnapshot alloc] initWithData:[data subdataWithRange:NSMakeRange(0, [data length] / 2)]
+                                                                     doughClass:[ZCREasyDoughSnapshotTestsModel class]
+                                                                          error:&error];
+    XCTAssertNil(snapshot, @"Truncated data should not be opened.");
+    XCTAssertNotNil(error, @"The error should be populated.");
+}
+
+- (void)testIncompatibleClass {
+    NSData *data = [ZCREasyDoughSnapshot dataWithDoughs:doughs doughClass:[ZCREasyDoughSnapshotTestsModel class]
+                                                 recipe:nil error:NULL];
+    
+    NSError *error;
+    ZCREasyDoughSnapshot *snapshot = [[ZCREasyDoughSnapshot alloc] initWithData:data
+                                                                     doughClass:[ZCREasyDoughSnapshotTestsOtherModel class]
+                                                                          error:&error];
+    XCTAssertNil(snapshot, @"A class without compatible properties should not open the snapshot.");
+    XCTAssertNotNil(error, @"The error should be populated.");
+}
+
+- (void)testInsecureArchive {
+    ZCREasyDoughSnapshotTestsInsecureModel *dough = [[ZCREasyDoughSnapshotTestsInsecureModel alloc] initWithIdentifier:@1
+                                                                                                             ingredients:@{@"value": [[ZCREasyDoughSnapshotTestsInsecureValue alloc] init]}
+                                                                                                                  recipe:[ZCREasyDoughSnapshotTestsInsecureModel genericRecipe]
+                                                                                                                   error:NULL];
+    
+    NSError *error;
+    NSData *data = [ZCREasyDoughSnapshot dataWithDoughs:@[dough] doughClass:[ZCREasyDoughSnapshotTestsInsecureModel class]
+                                                 recipe:nil error:&error];
+    XCTAssertNil(data, @"Objects without secure coding should not be archived.");
+    XCTAssertNotNil(error, @"The error should be populated.");
+}
+
+@end
@@ -10,6 +10,7 @@
 
 #import "ZCREasyDough.h"
 #import "ZCREasyRecipe.h"
+#import "ZCREasyError.h"
 
 @interface ZCRDateTransformer : NSValueTransformer
 @end
@@ -64,7 +65,7 @@
 + (ZCREasyRecipe *)simpleRecipe {
     ZCREasyRecipe *recipe = [[ZCREasyRecipeBox defaultBox] recipeWithName:@"simpleRecipe"];
     if (recipe) { return recipe; }
-
+    
     return [[ZCREasyRecipeBox defaultBox] addRecipeWith:^(id<ZCREasyRecipeMaker> recipeMaker) {
         [recipeMaker setName:@"simpleRecipe"];
         [recipeMaker setIngredientMapping:@{@"name": @"user_name",
@@ -102,6 +103,114 @@
 
 @end
 
+@interface ZCREasyDoughTestsSlotModel : ZCREasyDough
+
+@property (copy, nonatomic, readonly) NSString *title;
+@property (weak, nonatomic, readonly) id delegate;
+@property (assign, nonatomic, readonly) BOOL isActive;
+@property (assign, nonatomic, readonly) double rating;
+@property (assign, nonatomic, readonly) long long views;
+@property (assign, nonatomic) NSInteger adjustedCount;
+
+@end
+
+@implementation ZCREasyDoughTestsSlotModel
+
+- (void)setAdjustedCount:(NSInteger)adjustedCount {
+    _adjustedCount = adjustedCount * 2;
+}
+
+@end
+
+@interface ZCREasyDoughTestsCanonicalModel : ZCREasyDough
+@property (strong, nonatomic, readonly) NSString *name;
+@end
+
+@implementation ZCREasyDoughTestsCanonicalModel
+
++ (BOOL)usesIdentityMap {
+    return YES;
+}
+
+@end
+
+@interface ZCREasyDoughTestsCompactModel : ZCREasyDough
+@property (copy, nonatomic, readonly) NSString *title;
+@property (assign, nonatomic, readonly) double rating;
+@property (assign, nonatomic, readonly) NSUInteger views;
+@end
+
+@implementation ZCREasyDoughTestsCompactModel
+@dynamic title, rating, views;
+
++ (BOOL)usesSlotStorage {
+    return YES;
+}
+
+@end
+
+@interface ZCRLazyCountingTransformer : NSValueTransformer
+@end
+
+@implementation ZCRLazyCountingTransformer
+
+static volatile int32_t ZCRLazyTransformCount = 0;
+
++ (BOOL)allowsReverseTransformation {
+    return NO;
+}
+
+- (id)transformedValue:(id)value {
+    __sync_fetch_and_add(&ZCRLazyTransformCount, 1);
+    return ([value isKindOfClass:[NSString class]]) ? [value uppercaseString] : nil;
+}
+
+@end
+
+@interface ZCREasyDoughTestsLazyModel : ZCREasyDough
+@property (copy, nonatomic, readonly) NSString *title;
+@property (assign, nonatomic, readonly) double rating;
+@property (strong, nonatomic, readonly) NSString *author;
+@end
+
+@implementation ZCREasyDoughTestsLazyModel
+@dynamic title, rating;
+
++ (BOOL)usesSlotStorage {
+    return YES;
+}
+
++ (BOOL)usesLazyBaking {
+    return YES;
+}
+
++ (ZCREasyRecipe *)lazyRecipe {
+    return [ZCREasyRecipe makeWith:^(id<ZCREasyRecipeMaker> recipeMaker) {
+        recipeMaker.ingredientMapping = @{@"title": @"info.title",
+                                          @"rating": @"info.rating",
+                                          @"author": @"author"};
+        recipeMaker.ingredientTransformers = @{@"title": [[ZCRLazyCountingTransformer alloc] init]};
+    }];
+}
+
+@end
+
+@interface ZCREasyDoughTestsPrewarmModel : ZCREasyDough
+@property (strong, nonatomic, readonly) NSString *name;
+@property (assign, nonatomic) NSInteger count;
+@end
+
+@implementation ZCREasyDoughTestsPrewarmModel
+@end
+
+@interface ZCREasyDoughTestsImplicitStrongModel : ZCREasyDough
+@property (nonatomic, readonly) NSString *note;
+@property (nonatomic, readonly) NSDate *seenAt;
+@end
+
+@implementation ZCREasyDoughTestsImplicitStrongModel
+@end
+
 @interface ZCREasyDoughTests : XCTestCase {
     ZCREasyDoughTestsModel *model;
     NSDictionary *JSON;
@@ -163,6 +272,318 @@
     XCTAssertTrue(model.badgeCount == [JSON[@"badge_count"] unsignedIntegerValue], @"The badge count should be set");
 }
 
+- (void)testSetsPropertySlots {
+    NSMutableString *title = [NSMutableString stringWithString:@"Title"];
+    id delegate = [[NSObject alloc] init];
+    NSDictionary *ingredients = @{@"title": title,
+                                  @"delegate": delegate,
+                                  @"isActive": @YES,
+                                  @"rating": @4.5,
+                                  @"views": @(1LL << 40),
+                                  @"adjustedCount": @3};
+    
+    NSError *error;
+    ZCREasyDoughTestsSlotModel *slotModel = [[ZCREasyDoughTestsSlotModel alloc] initWithIdentifier:@"slots"
+                                                                                       ingredients:ingredients
+                                                                                            recipe:[ZCREasyDoughTestsSlotModel genericRecipe]
+                                                                                             error:&error];
+    [title appendString:@" Changed"];
+    
+    XCTAssertNotNil(slotModel, @"The model should be baked");
+    XCTAssertNil(error, @"There should be no error");
+    XCTAssertEqualObjects(slotModel.title, @"Title", @"Copy properties should copy their value");
+    XCTAssertTrue(slotModel.delegate == delegate, @"Weak properties should reference their value");
+    XCTAssertTrue(slotModel.isActive, @"BOOL properties should be unboxed");
+    XCTAssertEqual(slotModel.rating, 4.5, @"Double properties should be unboxed");
+    XCTAssertEqual(slotModel.views, (1LL << 40), @"Long long properties should be unboxed");
+    XCTAssertEqual(slotModel.adjustedCount, (NSInteger)6, @"Custom setters should be invoked");
+    
+    XCTAssertThrowsSpecificNamed([slotModel setValue:@"Other" forKey:@"title"],
+                                 NSException, ZCREasyDoughExceptionAlreadyBaked,
+                                 @"The baked model should remain immutable");
+}
+
+- (void)testRetainsImplicitlyStrongIVars {
+    ZCREasyRecipe *recipe = [ZCREasyRecipe makeWith:^(id<ZCREasyRecipeMaker> recipeMaker) {
+        recipeMaker.ingredientMapping = @{@"note": @"note", @"seenAt": @"seen_at"};
+        recipeMaker.ingredientTransformers = @{@"seenAt": [[ZCRDateTransformer alloc] init]};
+    }];
+    
+    __weak id weakNote;
+    ZCREasyDoughTestsImplicitStrongModel *strongModel;
+    @autoreleasepool {
+        NSDictionary *ingredients = @{@"note": [NSString stringWithFormat:@"A note baked at %@", [NSDate date]],
+                                      @"seen_at": @"2014-04-07 13:45:29"};
+        strongModel = [[ZCREasyDoughTestsImplicitStrongModel alloc] initWithIdentifier:@"strong"
+                                                                           ingredients:ingredients
+                                                                                recipe:recipe
+                                                                                 error:NULL];
+        weakNote = strongModel.note;
+    }
+    
+    @autoreleasepool {
+        XCTAssertNotNil(weakNote, @"The baked value should outlive its ingredients");
+        XCTAssertTrue([strongModel.note hasPrefix:@"A note baked at"], @"The baked value should stay valid");
+        XCTAssertEqualObjects(strongModel.seenAt, [dateTransformer transformedValue:@"2014-04-07 13:45:29"],
+                              @"Transformed values should be retained");
+        strongModel = nil;
+    }
+    XCTAssertNil(weakNote, @"The baked value should be released with the dough");
+}
+
+- (void)testSettingNilScalarFails {
+    NSError *error;
+    ZCREasyDoughTestsSlotModel *slotModel = [[ZCREasyDoughTestsSlotModel alloc] initWithIdentifier:@"slots"
+                                                                                       ingredients:@{@"rating": [NSNull null]}
+                                                                                            recipe:[ZCREasyDoughTestsSlotModel genericRecipe]
+                                                                                             error:&error];
+    XCTAssertNil(slotModel, @"Nil scalars should not be settable");
+    XCTAssertEqual(error.code, ZCREasyBakeErrorMismatchedIngredients, @"The error should report the mismatch");
+    XCTAssertEqualObjects(error.userInfo[ZCREasyBakeMismatchedPropertiesKey], @{@"rating": @"rating"}, @"The error should list the property and path");
+}
+
+- (void)testSkippingNilScalars {
+    ZCREasyRecipe *recipe = [[ZCREasyDoughTestsSlotModel genericRecipe] modifyWith:^(id<ZCREasyRecipeMaker> recipeMaker) {
+        recipeMaker.mismatchPolicy = ZCREasyRecipeMismatchPolicySkipField;
+    }];
+    
+    NSError *error;
+    ZCREasyDoughTestsSlotModel *slotModel = [[ZCREasyDoughTestsSlotModel alloc] initWithIdentifier:@"slots"
+                                                                                       ingredients:@{@"title": @"Title", @"rating": [NSNull null]}
+                                                                                            recipe:recipe error:&error];
+    XCTAssertNotNil(slotModel, @"The model should be baked");
+    XCTAssertNil(error, @"There should be no error");
+    XCTAssertEqualObjects(slotModel.title, @"Title", @"Other properties should be set");
+    XCTAssertEqual(slotModel.rating, 0.0, @"Skipped scalars should be left unset");
+}
+
+- (void)testSlotStorage {
+    NSMutableString *title = [NSMutableString stringWithString:@"Title"];
+    NSDictionary *ingredients = @{@"title": title,
+                                  @"rating": @4.5,
+                                  @"views": @12};
+    ZCREasyRecipe *recipe = [ZCREasyDoughTestsCompactModel genericRecipe];
+    
+    NSError *error;
+    ZCREasyDoughTestsCompactModel *compactModel = [[ZCREasyDoughTestsCompactModel alloc] initWithIdentifier:@"compact"
+                                                                                                 ingredients:ingredients
+                                                                                                      recipe:recipe
+                                                                                                       error:&error];
+    [title appendString:@" Changed"];
+    
+    XCTAssertNotNil(compactModel, @"The model should be baked");
+    XCTAssertNil(error, @"There should be no error");
+    XCTAssertEqualObjects(compactModel.title, @"Title", @"Copy properties should copy their value");
+    XCTAssertEqual(compactModel.rating, 4.5, @"Scalar properties should be read from their slots");
+    XCTAssertEqual(compactModel.views, (NSUInteger)12, @"Scalar properties should be read from their slots");
+    
+    ZCREasyDoughTestsCompactModel *copiedModel = [compactModel copy];
+    XCTAssertEqualObjects(copiedModel, compactModel, @"The copy should be equal");
+    XCTAssertEqualObjects(copiedModel.title, @"Title", @"The copy should share the slot values");
+    
+    ZCREasyDoughTestsCompactModel *updatedModel = [compactModel updateWithIngredients:@{@"views": @13}
+                                                                               recipe:recipe
+                                                                                error:&error];
+    XCTAssertNil(error, @"There should be no error");
+    XCTAssertEqual(updatedModel.views, (NSUInteger)13, @"The updated model should have the new value");
+    XCTAssertEqual(updatedModel.rating, 4.5, @"The updated model should keep the unchanged values");
+    XCTAssertEqual(compactModel.views, (NSUInteger)12, @"The original model should be unchanged");
+    XCTAssertEqual(copiedModel.views, (NSUInteger)12, @"The copied model should be unchanged");
+}
+
+- (void)testLazyBaking {
+    NSDictionary *ingredients = @{@"info": @{@"title": @"Title", @"rating": @4.5},
+                                  @"author": @"Author"};
+    ZCREasyRecipe *recipe = [ZCREasyDoughTestsLazyModel lazyRecipe];
+    ZCRLazyTransformCount = 0;
+    
+    NSError *error;
+    ZCREasyDoughTestsLazyModel *lazyModel = [[ZCREasyDoughTestsLazyModel alloc] initWithIdentifier:@"lazy"
+                                                                                        ingredients:ingredients
+                                                                                             recipe:recipe
+                                                                                              error:&error];
+    XCTAssertNotNil(lazyModel, @"The model should be baked");
+    XCTAssertNil(error, @"There should be no error");
+    XCTAssertEqual(ZCRLazyTransformCount, 0, @"Slot properties should not be transformed while baking");
+    XCTAssertEqualObjects(lazyModel.author, @"Author", @"Properties outside slot storage should be baked eagerly");
+    
+    XCTAssertEqualObjects(lazyModel.title, @"TITLE", @"The property should be resolved on first access");
+    XCTAssertEqual(ZCRLazyTransformCount, 1, @"The property should be transformed once");
+    XCTAssertEqualObjects(lazyModel.title, @"TITLE", @"The resolved value should be kept");
+    XCTAssertEqual(ZCRLazyTransformCount, 1, @"The property should not be transformed again");
+    XCTAssertEqual(lazyModel.rating, 4.5, @"Scalar properties should be resolved on first access");
+    
+    XCTAssertTrue([lazyModel isEqualToIngredients:ingredients withRecipe:recipe error:NULL], @"The model should match its ingredients");
+    XCTAssertThrowsSpecificNamed([lazyModel setValue:@"Other" forKey:@"title"],
+                                 NSException, ZCREasyDoughExceptionAlreadyBaked,
+                                 @"The lazy model should remain immutable");
+    
+    ZCREasyDoughTestsLazyModel *updatedModel = [lazyModel updateWithIngredients:@{@"info": @{@"rating": @5}}
+                                                                         recipe:recipe
+                                                                          error:&error];
+    XCTAssertNil(error, @"There should be no error");
+    XCTAssertEqual(updatedModel.rating, 5.0, @"The updated model should have the new value");
+    XCTAssertEqualObjects(updatedModel.title, @"TITLE", @"The updated model should keep the unchanged values");
+}
+
+- (void)testLazyBakingCopy {
+    ZCREasyDoughTestsLazyModel *lazyModel = [[ZCREasyDoughTestsLazyModel alloc] initWithIdentifier:@"lazy"
+                                                                                        ingredients:@{@"info": @{@"title": @"Title", @"rating": @2}}
+                                                                                             recipe:[ZCREasyDoughTestsLazyModel lazyRecipe]
+                                                                                              error:NULL];
+    ZCREasyDoughTestsLazyModel *copiedModel = [lazyModel copy];
+    XCTAssertEqualObjects(copiedModel, lazyModel, @"The copy should be equal");
+    XCTAssertEqualObjects(copiedModel.title, @"TITLE", @"The copy should have the resolved values");
+    XCTAssertEqual(copiedModel.rating, 2.0, @"The copy should have the resolved values");
+}
+
+- (void)testLazyBakingUnresolvableProperty {
+    NSError *error;
+    ZCREasyDoughTestsLazyModel *lazyModel = [[ZCREasyDoughTestsLazyModel alloc] initWithIdentifier:@"lazy"
+                                                                                        ingredients:@{@"info": @"Not a dictionary"}
+                                                                                             recipe:[ZCREasyDoughTestsLazyModel lazyRecipe]
+                                                                                              error:&error];
+    XCTAssertNotNil(lazyModel, @"Lazy properties should not be validated while baking");
+    XCTAssertNil(lazyModel.title, @"Unresolvable object properties should be nil");
+    XCTAssertEqual(lazyModel.rating, 0.0, @"Unresolvable scalar properties should be zero");
+}
+
+- (void)testLazyBakingConcurrentAccess {
+    ZCRLazyTransformCount = 0;
+    ZCREasyDoughTestsLazyModel *lazyModel = [[ZCREasyDoughTestsLazyModel alloc] initWithIdentifier:@"lazy"
+                                                                                        ingredients:@{@"info": @{@"title": @"Title"}}
+                                                                                             recipe:[ZCREasyDoughTestsLazyModel lazyRecipe]
+                                                                                              error:NULL];
+    __block int32_t mismatches = 0;
+    dispatch_apply(64, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t iteration) {
+        if (![lazyModel.title isEqualToString:@"TITLE"]) {
+            __sync_fetch_and_add(&mismatches, 1);
+        }
+    });
+    
+    XCTAssertEqual(mismatches, 0, @"Every reader should see the resolved value");
+    XCTAssertTrue(ZCRLazyTransformCount >= 1, @"The property should be transformed at least once");
+}
+
+- (void)testCanonicalDough {
+    [ZCREasyDoughTestsCanonicalModel resetIdentityMap];
+    ZCREasyRecipe *recipe = [ZCREasyDoughTestsCanonicalModel genericRecipe];
+    
+    NSError *error;
+    ZCREasyDoughTestsCanonicalModel *first = [ZCREasyDoughTestsCanonicalModel canonicalDoughWithIdentifier:@"canonical" ingredients:@{@"name": @"Name"} recipe:recipe error:&error];
+    ZCREasyDoughTestsCanonicalModel *second = [ZCREasyDoughTestsCanonicalModel canonicalDoughWithIdentifier:@"canonical" ingredients:@{@"name": @"Name"} recipe:recipe error:&error];
+    
+    XCTAssertNotNil(first, @"The canonical model should be baked");
+    XCTAssertNil(error, @"There should be no error");
+    XCTAssertTrue(first == second, @"Unchanged ingredients should resolve to the same instance");
+    XCTAssertTrue([ZCREasyDoughTestsCanonicalModel canonicalDoughWithIdentifier:@"canonical"] == first, @"The instance should be canonical");
+    
+    ZCREasyDoughTestsCanonicalModel *updated = [ZCREasyDoughTestsCanonicalModel canonicalDoughWithIdentifier:@"canonical" ingredients:@{@"name": @"Updated"} recipe:recipe error:&error];
+    
+    XCTAssertFalse(updated == first, @"Changed ingredients should produce an updated instance");
+    XCTAssertEqualObjects(updated.name, @"Updated", @"The updated instance should have the new values");
+    XCTAssertTrue([ZCREasyDoughTestsCanonicalModel canonicalDoughWithIdentifier:@"canonical"] == updated, @"The updated instance should become canonical");
+    
+    NSDictionary *statistics = [ZCREasyDoughTestsCanonicalModel identityMapStatistics];
+    XCTAssertEqualObjects(statistics[ZCREasyDoughIdentityMapMissesKey], @1, @"The first bake should miss");
+    XCTAssertEqualObjects(statistics[ZCREasyDoughIdentityMapHitsKey], @4, @"The later lookups should hit");
+    XCTAssertEqualObjects(statistics[ZCREasyDoughIdentityMapUpdatesKey], @1, @"The update should be counted");
+    XCTAssertEqualObjects(statistics[ZCREasyDoughIdentityMapCountKey], @1, @"There should be one live instance");
+}
+
+- (void)testCanonicalDoughPrunesReleasedInstances {
+    [ZCREasyDoughTestsCanonicalModel resetIdentityMap];
+    ZCREasyRecipe *recipe = [ZCREasyDoughTestsCanonicalModel genericRecipe];
+    
+    for (NSInteger i = 0; i < 2000; i++) {
+        @autoreleasepool {
+            [ZCREasyDoughTestsCanonicalModel canonicalDoughWithIdentifier:@(i) ingredients:@{@"name": @"Name"} recipe:recipe error:NULL];
+        }
+    }
+    
+    NSNumber *count = [ZCREasyDoughTestsCanonicalModel identityMapStatistics][ZCREasyDoughIdentityMapCountKey];
+    XCTAssertTrue([count unsignedIntegerValue] < 2000, @"Released instances should be pruned as the map grows");
+    
+    for (NSInteger i = 0; i < 2000; i++) {
+        XCTAssertNil([ZCREasyDoughTestsCanonicalModel canonicalDoughWithIdentifier:@(i)], @"Released instances should not be canonical");
+    }
+    count = [ZCREasyDoughTestsCanonicalModel identityMapStatistics][ZCREasyDoughIdentityMapCountKey];
+    XCTAssertEqualObjects(count, @0, @"Missed lookups should prune released instances");
+}
+
+- (void)testCanonicalDoughWithoutIdentityMap {
+    NSError *error;
+    ZCREasyDoughTestsModel *first = [ZCREasyDoughTestsModel canonicalDoughWithIdentifier:JSON[@"server_id"] ingredients:JSON recipe:[ZCREasyDoughTestsModel simpleRecipe] error:&error];
+    
+    XCTAssertNotNil(first, @"The model should be baked");
+    XCTAssertFalse(first == model, @"Classes without an identity map should always bake new instances");
+    XCTAssertNil([ZCREasyDoughTestsModel canonicalDoughWithIdentifier:JSON[@"server_id"]], @"There should be no canonical instance");
+    XCTAssertNil([ZCREasyDoughTestsModel identityMapStatistics], @"There should be no statistics");
+}
+
+- (void)testBakeAll {
+    NSArray *ingredientsArray = @[JSON,
+                                  @{@"server_id": @"1", @"user_name": @"Second User"},
+                                  @{@"user_name": @"Missing Identifier"},
+                                  @"Invalid ingredients"];
+    
+    NSDictionary *errors;
+    NSArray *models = [ZCREasyDoughTestsModel bakeAll:ingredientsArray identifierPath:@"server_id"
+                                               recipe:[ZCREasyDoughTestsModel simpleRecipe]
+                                               errors:&errors];
+    
+    XCTAssertEqual(models.count, ingredientsArray.count, @"There should be a result for every record");
+    XCTAssertEqualObjects(models[0], model, @"The first model should share the identifier");
+    XCTAssertEqualObjects([models[0] name], JSON[@"user_name"], @"The name should be set");
+    XCTAssertEqualObjects([models[1] uniqueIdentifier], @"1", @"The identifier should be read from the path");
+    XCTAssertEqualObjects([models[1] name], @"Second User", @"The name should be set");
+    XCTAssertEqualObjects(models[2], [NSNull null], @"Records without identifiers should fail");
+    XCTAssertEqualObjects(models[3], [NSNull null], @"Invalid records should fail");
+    
+    NSSet *expectedIndexes = [NSSet setWithArray:@[@2, @3]];
+    XCTAssertEqualObjects([NSSet setWithArray:[errors allKeys]], expectedIndexes, @"Errors should be reported per index");
+}
+
+- (void)testBakeAllConcurrently {
+    NSMutableArray *ingredientsArray = [NSMutableArray array];
+    for (NSUInteger i = 0; i < 500; i++) {
+        if (i % 7 == 0) {
+            [ingredientsArray addObject:@{@"user_name": @"Missing Identifier"}];
+        } else {
+            [ingredientsArray addObject:@{@"server_id": [NSString stringWithFormat:@"%lu", (unsigned long)i],
+                                          @"user_name": [NSString stringWithFormat:@"User %lu", (unsigned long)i]}];
+        }
+    }
+    
+    NSDictionary *errors;
+    NSArray *models = [ZCREasyDoughTestsModel bakeAllConcurrently:ingredientsArray identifierPath:@"server_id"
+                                                           recipe:[ZCREasyDoughTestsModel simpleRecipe]
+                                                           errors:&errors];
+    NSDictionary *serialErrors;
+    NSArray *serialModels = [ZCREasyDoughTestsModel bakeAll:ingredientsArray identifierPath:@"server_id"
+                                                     recipe:[ZCREasyDoughTestsModel simpleRecipe]
+                                                     errors:&serialErrors];
+    
+    XCTAssertEqualObjects(models, serialModels, @"Baking concurrently should bake the same models in the same order");
+    XCTAssertEqualObjects([models[1] name], @"User 1", @"The name should be set");
+    XCTAssertEqualObjects([models[499] name], @"User 499", @"The name should be set");
+    XCTAssertEqualObjects([NSSet setWithArray:[errors allKeys]], [NSSet setWithArray:[serialErrors allKeys]], @"Errors should be reported per index");
+    XCTAssertEqual([errors count], (NSUInteger)72, @"Every record without an identifier should fail");
+}
+
+- (void)testBakeAllWithInvalidRecipe {
+    ZCREasyRecipe *recipe = [ZCREasyRecipe makeWith:^(id<ZCREasyRecipeMaker> recipeMaker) {
+        [recipeMaker setIngredientMapping:@{@"unknownKey": @"unknownKey"}];
+    }];
+    
+    NSDictionary *errors;
+    NSArray *models = [ZCREasyDoughTestsModel bakeAll:@[JSON] identifierPath:nil recipe:recipe
+                                               errors:&errors];
+    
+    XCTAssertNil(models, @"Nothing should be baked with an invalid recipe");
+    XCTAssertNotNil(errors[@0], @"The error should be reported for every index");
+}
+
 - (void)testUpdate {
     NSDictionary *updatedJSON = @{@"user_name": @"Updated User"};
     
@@ -186,6 +607,7 @@
     __block BOOL didNotifyClass = NO;
     __block BOOL didNotifyGeneric = NO;
     __block id notificationIdentifier;
+    __block NSSet *changedPropertyNames;
     
     __block id classNotifier = [[NSNotificationCenter defaultCenter] addObserverForName:[ZCREasyDoughTestsModel updateNotificationName] object:nil queue:[NSOperationQueue mainQueue] usingBlock:^(NSNotification *note) {
         didNotifyClass = YES;
@@ -196,6 +618,7 @@
     __block id genericNotifier = [[NSNotificationCenter defaultCenter] addObserverForName:ZCREasyDoughUpdateNotification object:nil queue:[NSOperationQueue mainQueue] usingBlock:^(NSNotification *note) {
         didNotifyGeneric = YES;
         notificationIdentifier = note.userInfo[ZCREasyDoughIdentifierKey];
+        changedPropertyNames = note.userInfo[ZCREasyDoughChangedPropertyNamesKey];
         [[NSNotificationCenter defaultCenter] removeObserver:genericNotifier];
     }];
     
@@ -216,8 +639,54 @@
     XCTAssertTrue(didNotifyClass, @"The class should be notified");
     XCTAssertTrue(didNotifyGeneric, @"The generic notification should be posted");
     XCTAssertEqualObjects(notificationIdentifier, model.uniqueIdentifier, @"The identifiers should match");
+    XCTAssertEqualObjects(changedPropertyNames, [NSSet setWithObject:@"name"], @"Only the changed property should be reported");
+    XCTAssertNotNil(updatedModel, @"The updated model should not be nil");
+    XCTAssertNil(error, @"There should be no error");
+}
+
+- (void)testUpdateOnlyChangesDifferingProperties {
+    NSDictionary *updatedJSON = @{@"user_name": JSON[@"user_name"],
+                                  @"badge_count": @91};
+    
+    NSError *error;
+    ZCREasyDoughTestsModel *updatedModel = [model updateWithIngredients:updatedJSON
+                                                                 recipe:[ZCREasyDoughTestsModel simpleRecipe]
+                                                                  error:&error];
+    
+    XCTAssertNotNil(updatedModel, @"The updated model should not be nil");
+    XCTAssertNil(error, @"There should be no error");
+    XCTAssertFalse(model == updatedModel, @"The two pointers should be different");
+    XCTAssertEqualObjects(updatedModel.name, model.name, @"The unchanged name should be carried over");
+    XCTAssertEqualObjects(updatedModel.updatedAt, model.updatedAt, @"The unmapped date should be carried over");
+    XCTAssertTrue(updatedModel.badgeCount == 91, @"The changed badge count should be updated");
+}
+
+- (void)testUpdateCarriesOverIVarProperties {
+    id delegate = [[NSObject alloc] init];
+    NSDictionary *ingredients = @{@"title": @"Title",
+                                  @"delegate": delegate,
+                                  @"isActive": @YES,
+                                  @"rating": @4.5,
+                                  @"views": @(1LL << 40),
+                                  @"adjustedCount": @3};
+    ZCREasyDoughTestsSlotModel *slotModel = [[ZCREasyDoughTestsSlotModel alloc] initWithIdentifier:@"slots"
+                                                                                       ingredients:ingredients
+                                                                                            recipe:[ZCREasyDoughTestsSlotModel genericRecipe]
+                                                                                             error:NULL];
+    
+    NSError *error;
+    ZCREasyDoughTestsSlotModel *updatedModel = [slotModel updateWithIngredients:@{@"adjustedCount": @5}
+                                                                         recipe:[ZCREasyDoughTestsSlotModel genericRecipe]
+                                                                          error:&error];
+    
     XCTAssertNotNil(updatedModel, @"The updated model should not be nil");
     XCTAssertNil(error, @"There should be no error");
+    XCTAssertEqualObjects(updatedModel.title, @"Title", @"Copied object iVars should be carried over");
+    XCTAssertTrue(updatedModel.delegate == delegate, @"Weak iVars should be carried over");
+    XCTAssertTrue(updatedModel.isActive, @"BOOL iVars should be carried over");
+    XCTAssertEqual(updatedModel.rating, 4.5, @"Double iVars should be carried over");
+    XCTAssertEqual(updatedModel.views, (1LL << 40), @"Long long iVars should be carried over");
+    XCTAssertEqual(updatedModel.adjustedCount, (NSInteger)10, @"The changed property should be set through its setter once");
 }
 
 - (void)testUpdateUnchanged {
@@ -329,6 +798,75 @@
     XCTAssertEqual([ingredients[1][@"badge_count"] unsignedIntegerValue], model.badgeCount, @"The badge counts should match.");
 }
 
+- (void)testDecomposeToJSONData {
+    for (ZCREasyRecipe *recipe in @[[ZCREasyDoughTestsModel complicatedRecipe], [ZCREasyDoughTestsModel arrayBasedRecipe]]) {
+        NSError *error;
+        NSData *JSONData = [model decomposeToJSONDataWithRecipe:recipe error:&error];
+        
+        XCTAssertNotNil(JSONData, @"There should be JSON data");
+        XCTAssertNil(error, @"There should be no error");
+        
+        id ingredients = [NSJSONSerialization JSONObjectWithData:JSONData options:0 error:NULL];
+        XCTAssertEqualObjects(ingredients, [model decomposeWithRecipe:recipe error:NULL], @"The JSON should represent the decomposed ingredients");
+    }
+}
+
+- (void)testDecomposeToJSONDataEscapesAndNumbers {
+    NSString *title = [NSString stringWithFormat:@"Nul%Cl \u00e9", (unichar)0];
+    ZCREasyDoughTestsCompactModel *compactModel = [[ZCREasyDoughTestsCompactModel alloc] initWithIdentifier:@"json"
+                                                                                                ingredients:@{@"title": title, @"rating": @0.1, @"views": @3}
+                                                                                                     recipe:[ZCREasyDoughTestsCompactModel genericRecipe]
+                                                                                                      error:NULL];
+    
+    NSData *JSONData = [compactModel decomposeToJSONDataWithRecipe:[ZCREasyDoughTestsCompactModel genericRecipe] error:NULL];
+    NSString *JSONString = [[NSString alloc] initWithData:JSONData encoding:NSUTF8StringEncoding];
+    
+    XCTAssertTrue([JSONString rangeOfString:@"Nul\\u0000l"].location != NSNotFound, @"U+0000 should be escaped rather than truncating the string");
+    XCTAssertTrue([JSONString rangeOfString:@"0.1"].location != NSNotFound, @"Doubles should be written in their shortest form");
+    XCTAssertTrue([JSONString rangeOfString:@"0.10000000000000001"].location == NSNotFound, @"Doubles should not be padded");
+    
+    NSDictionary *ingredients = [NSJSONSerialization JSONObjectWithData:JSONData options:0 error:NULL];
+    XCTAssertEqualObjects(ingredients[@"title"], title, @"The string should round-trip");
+    XCTAssertEqual([ingredients[@"rating"] doubleValue], 0.1, @"The double should round-trip");
+}
+
+- (void)testDecomposeToJSONDataWritesSixteenDigitDoubles {
+    // 2/3 needs 16 digits to round-trip, so it shouldn't be written with 17.
+    double rating = 2.0 / 3.0;
+    ZCREasyDoughTestsCompactModel *compactModel = [[ZCREasyDoughTestsCompactModel alloc] initWithIdentifier:@"json"
+                                                                                                ingredients:@{@"title": @"Title", @"rating": @(rating), @"views": @3}
+                                                                                                     recipe:[ZCREasyDoughTestsCompactModel genericRecipe]
+                                                                                                      error:NULL];
+    
+    NSData *JSONData = [compactModel decomposeToJSONDataWithRecipe:[ZCREasyDoughTestsCompactModel genericRecipe] error:NULL];
+    NSString *JSONString = [[NSString alloc] initWithData:JSONData encoding:NSUTF8StringEncoding];
+    
+    XCTAssertTrue([JSONString rangeOfString:@"0.6666666666666666"].location != NSNotFound, @"Doubles should be written with 16 digits when 15 don't round-trip");
+    XCTAssertTrue([JSONString rangeOfString:@"0.66666666666666663"].location == NSNotFound, @"Doubles should not be written with 17 digits when 16 round-trip");
+    
+    NSDictionary *ingredients = [NSJSONSerialization JSONObjectWithData:JSONData options:0 error:NULL];
+    XCTAssertEqual([ingredients[@"rating"] doubleValue], rating, @"The double should round-trip");
+}
+
+- (void)testConcurrentMetadata {
+    NSMutableArray *propertyNameSets = [NSMutableArray array];
+    dispatch_apply(16, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t iteration) {
+        NSSet *propertyNames = [ZCREasyDoughTestsPrewarmModel allPropertyNames];
+        @synchronized(propertyNameSets) {
+            [propertyNameSets addObject:propertyNames];
+        }
+    });
+    
+    NSSet *expectedNames = [NSSet setWithObjects:@"name", @"count", nil];
+    XCTAssertEqualObjects([propertyNameSets firstObject], expectedNames, @"The property names should be introspected");
+    for (NSSet *propertyNames in propertyNameSets) {
+        XCTAssertTrue(propertyNames == [propertyNameSets firstObject], @"The metadata should only be built once");
+    }
+    
+    [ZCREasyDough prewarmClasses:@[[ZCREasyDoughTestsModel class], [NSObject class]]];
+    XCTAssertNotNil([ZCREasyDoughTestsModel allPropertyNames], @"Prewarmed classes should still be usable");
+}
+
 - (void)testIsEqualToIngredients {
     NSDictionary *ingredients = @{@"user_name": JSON[@"user_name"]};
     
@@ -18,6 +18,13 @@
 @implementation _ZCREasyDoughTransformerModel
 @end
 
+@interface _ZCREasyDoughTransformerOrder : ZCREasyDough
+@property (strong, nonatomic, readonly) NSArray *items;
+@end
+
+@implementation _ZCREasyDoughTransformerOrder
+@end
+
 @interface _ZCRURLTransformer : NSValueTransformer
 @end
 
@@ -118,4 +125,76 @@
     XCTAssertNotNil(transformer.error, @"There should be an error without an identifier.");
 }
 
+- (void)testErrorsArePerThread {
+    transformer = [[ZCREasyDoughTransformer alloc] initWithDoughClass:[_ZCREasyDoughTransformerModel class] recipe:recipe identifierBlock:^id<NSObject,NSCopying>(id rawIngredients) {
+        return rawIngredients[@"id"];
+    }];
+    
+    __block NSError *backgroundError;
+    dispatch_semaphore_t semaphore = dispatch_semaphore_create(0);
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        [transformer transformedValue:@{@"name": @"Missing Identifier"}];
+        backgroundError = transformer.error;
+        dispatch_semaphore_signal(semaphore);
+    });
+    dispatch_semaphore_wait(semaphore, DISPATCH_TIME_FOREVER);
+    
+    XCTAssertNotNil(backgroundError, @"The failing thread should see its error.");
+    XCTAssertNil(transformer.error, @"Other threads should not see the error.");
+    
+    NSError *error;
+    XCTAssertNil([transformer transformedValue:@{@"name": @"Missing Identifier"} error:&error], @"There should be no model serialized.");
+    XCTAssertNotNil(error, @"The error should be reported directly.");
+}
+
+- (void)testErrorsAreCleared {
+    transformer = [[ZCREasyDoughTransformer alloc] initWithDoughClass:[_ZCREasyDoughTransformerModel class] recipe:recipe identifierBlock:^id<NSObject,NSCopying>(id rawIngredients) {
+        return rawIngredients[@"id"];
+    }];
+    NSUInteger threadDictionaryCount = [[[NSThread currentThread] threadDictionary] count];
+    
+    [transformer transformedValue:@{@"name": @"Missing Identifier"}];
+    XCTAssertNotNil(transformer.error, @"The failure should be recorded.");
+    
+    XCTAssertNotNil([transformer transformedValue:ingredients], @"The model should be serialized.");
+    XCTAssertNil(transformer.error, @"A successful transformation should clear the error.");
+    
+    @autoreleasepool {
+        [transformer transformedValue:@{@"name": @"Missing Identifier"}];
+        transformer = nil;
+    }
+    XCTAssertEqual([[[NSThread currentThread] threadDictionary] count], threadDictionaryCount,
+                   @"Deallocating the transformer should remove its error from the thread.");
+}
+
+- (void)testTransformedValuesAreBakedInBatches {
+    transformer = [[ZCREasyDoughTransformer alloc] initWithDoughClass:[_ZCREasyDoughTransformerModel class] recipe:recipe identifierBlock:nil];
+    
+    NSArray *models = [transformer zcr_transformedValues:@[ingredients, [NSNull null], @[@"Not a dictionary"]]];
+    XCTAssertEqual([models count], (NSUInteger)3, @"Every value should have a result.");
+    XCTAssertEqualObjects([models[0] name], ingredients[@"name"], @"The model should be baked.");
+    XCTAssertEqualObjects(models[1], [NSNull null], @"Missing values should stay missing.");
+    XCTAssertEqualObjects(models[2], [NSNull null], @"Invalid values should fail to bake.");
+    XCTAssertNotNil(transformer.error, @"The failure should be recorded.");
+}
+
+- (void)testWildcardRoundTrip {
+    ZCREasyRecipe *orderRecipe = [ZCREasyRecipe makeWith:^(id<ZCREasyRecipeMaker> recipeMaker) {
+        [recipeMaker addInstructionForProperty:@"items" ingredientPath:@"line_items[*]"
+                                   transformer:[_ZCREasyDoughTransformerModel transformerWithRecipe:recipe identifierBlock:nil]
+                                         error:nil];
+    }];
+    NSDictionary *orderIngredients = @{@"line_items": @[@{@"name": @"First", @"link": @"http://www.google.com"},
+                                                        @{@"name": @"Second", @"link": @"http://www.apple.com"}]};
+    
+    NSError *error;
+    _ZCREasyDoughTransformerOrder *order = [[_ZCREasyDoughTransformerOrder alloc] initWithIdentifier:@"order" ingredients:orderIngredients
+                                                                                              recipe:orderRecipe error:&error];
+    XCTAssertNotNil(order, @"The order should be baked: %@", error);
+    XCTAssertEqualObjects([order.items valueForKey:@"name"], (@[@"First", @"Second"]), @"Every item should be baked in order.");
+    XCTAssertEqualObjects([order.items[1] link], [NSURL URLWithString:@"http://www.apple.com"], @"Items should be transformed by their own recipe.");
+    
+    XCTAssertEqualObjects([order decomposeWithRecipe:orderRecipe error:NULL], orderIngredients, @"The items should decompose back into an array.");
+}
+
 @end
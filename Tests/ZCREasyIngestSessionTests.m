@@ -0,0 +1,128 @@
+//
+//  ZCREasyIngestSessionTests.m
+//  ZCREasyBake
+//
+//  Created by Zachary Radke on 10/16/26.
+//  Copyright (c) 2026 Zach Radke. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#import "ZCREasyBake.h"
+
+@interface ZCRIngestedModel : ZCREasyDough
+@property (strong, nonatomic, readonly) NSString *name;
+@property (assign, nonatomic, readonly) NSInteger count;
+@end
+
+@implementation ZCRIngestedModel
+@end
+
+@interface ZCREasyIngestSessionTests : XCTestCase {
+    ZCREasyRecipe *recipe;
+    NSArray *records;
+}
+@end
+
+@implementation ZCREasyIngestSessionTests
+
+- (void)setUp {
+    [super setUp];
+    
+    recipe = [ZCREasyRecipe makeWith:^(id<ZCREasyRecipeMaker> recipeMaker) {
+        recipeMaker.ingredientMapping = @{@"name": @"name", @"count": @"count"};
+    }];
+    
+    NSMutableArray *mutableRecords = [NSMutableArray array];
+    for (NSInteger i = 0; i < 10; i++) {
+        [mutableRecords addObject:@{@"id": @(i), @"name": [NSString stringWithFormat:@"Name %ld", (long)i], @"count": @(i)}];
+    }
+    records = [mutableRecords copy];
+}
+
+- (void)tearDown {
+    recipe = nil;
+    records = nil;
+    
+    [super tearDown];
+}
+
+- (void)testBakingThroughSession {
+    ZCREasyIngestSession *session = [[ZCREasyIngestSession alloc] initWithDrainInterval:2];
+    
+    NSError *error;
+    ZCRIngestedModel *first = [[ZCRIngestedModel alloc] initWithIdentifier:@1 ingredients:records[1] recipe:recipe
+                                                                   session:session error:&error];
+    ZCRIngestedModel *second = [[ZCRIngestedModel alloc] initWithIdentifier:@2 ingredients:records[2] recipe:recipe
+                                                                    session:session error:&error];
+    
+    XCTAssertEqualObjects(first.name, @"Name 1", @"The first model should be baked: %@", error);
+    XCTAssertEqual(second.count, (NSInteger)2, @"The second model should be baked: %@", error);
+    XCTAssertEqual(session.recordCount, (NSUInteger)2, @"Both records should be counted");
+    XCTAssertEqual(session.reusedContainerCount, (NSUInteger)1, @"The second record should reuse the first's container");
+    XCTAssertTrue(session.peakResidentBytes > 0, @"Memory should be sampled every drain interval");
+    
+    XCTAssertNil([[ZCRIngestedModel alloc] initWithIdentifier:@3 ingredients:@{@"count": @[]} recipe:recipe
+                                                      session:session error:&error], @"Invalid records should fail");
+    XCTAssertEqual(error.code, ZCREasyBakeErrorMismatchedIngredients, @"The error should be reported as without a session");
+    
+    [session resetStatistics];
+    XCTAssertEqual(session.recordCount + session.reusedContainerCount, (NSUInteger)0, @"The statistics should be reset");
+    XCTAssertEqual(session.peakResidentBytes, 0ULL, @"The peak should be reset");
+}
+
+- (void)testUpdatingThroughSession {
+    ZCREasyIngestSession *session = [[ZCREasyIngestSession alloc] init];
+    ZCRIngestedModel *model = [[ZCRIngestedModel alloc] initWithIdentifier:@1 ingredients:records[1] recipe:recipe error:NULL];
+    
+    ZCRIngestedModel *updatedModel = [model updateWithIngredients:@{@"count": @5} recipe:recipe session:session error:NULL];
+    XCTAssertEqual(updatedModel.count, (NSInteger)5, @"The changed property should be updated");
+    XCTAssertEqualObjects(updatedModel.name, @"Name 1", @"Unchanged properties should be kept");
+    
+    XCTAssertEqual([updatedModel updateWithIngredients:@{@"count": @5} recipe:recipe session:session error:NULL], updatedModel,
+                   @"Unchanged ingredients should not be an update");
+    XCTAssertEqual(session.recordCount, (NSUInteger)2, @"Both updates should be counted");
+    XCTAssertEqual(session.reusedContainerCount, (NSUInteger)2, @"The second update should reuse both containers");
+}
+
+- (void)testBakingAllThroughSession {
+    ZCREasyIngestSession *session = [[ZCREasyIngestSession alloc] initWithDrainInterval:4];
+    
+    NSDictionary *errors;
+    NSArray *models = [ZCRIngestedModel bakeAll:records identifierPath:@"id" recipe:recipe session:session errors:&errors];
+    NSArray *expectedModels = [ZCRIngestedModel bakeAll:records identifierPath:@"id" recipe:recipe errors:NULL];
+    
+    XCTAssertEqual([errors count], (NSUInteger)0, @"Every record should be baked");
+    XCTAssertEqualObjects(models, expectedModels, @"The models should be the same as without a session");
+    XCTAssertEqualObjects([models valueForKey:@"name"], [expectedModels valueForKey:@"name"], @"The values should be the same as without a session");
+    XCTAssertEqual(session.recordCount, [records count], @"Every record should be counted");
+    XCTAssertEqual(session.drainCount, (NSUInteger)3, @"The pool should be drained every four records");
+    
+    [ZCRIngestedModel bakeAllConcurrently:records identifierPath:@"id" recipe:recipe session:session errors:&errors];
+    XCTAssertEqual([errors count], (NSUInteger)0, @"Every record should be baked concurrently");
+    XCTAssertEqual(session.recordCount, [records count] * 2, @"Concurrent records should be counted");
+    XCTAssertTrue(session.reusedContainerCount >= 2, @"Later batches should reuse the containers");
+}
+
+- (void)testIngestingRecords {
+    ZCREasyIngestSession *session = [[ZCREasyIngestSession alloc] initWithDrainInterval:3];
+    NSMutableArray *models = [NSMutableArray array];
+    
+    [session ingestRecords:[records objectEnumerator] usingBlock:^(id record, BOOL *stop) {
+        ZCRIngestedModel *model = [[ZCRIngestedModel alloc] initWithIdentifier:record[@"id"] ingredients:record
+                                                                        recipe:recipe session:session error:NULL];
+        [models addObject:model];
+    }];
+    
+    XCTAssertEqual([models count], [records count], @"Every record should be ingested");
+    XCTAssertEqual(session.drainCount, (NSUInteger)4, @"The pool should be drained every three records");
+    
+    [models removeAllObjects];
+    [session ingestRecords:[records objectEnumerator] usingBlock:^(id record, BOOL *stop) {
+        [models addObject:record];
+        *stop = ([models count] == 5);
+    }];
+    XCTAssertEqual([models count], (NSUInteger)5, @"Stopping should end the enumeration");
+}
+
+@end
@@ -0,0 +1,158 @@
+//
+//  ZCREasyInstrumentationTests.m
+//  ZCREasyBake
+//
+//  Created by Zachary Radke on 10/16/26.
+//  Copyright (c) 2026 Zach Radke. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#import "ZCREasyBake.h"
+
+@interface ZCRInstrumentationUppercaseTransformer : NSValueTransformer
+@end
+
+@implementation ZCRInstrumentationUppercaseTransformer
+
++ (BOOL)allowsReverseTransformation {
+    return NO;
+}
+
+- (id)transformedValue:(id)value {
+    return ([value isKindOfClass:[NSString class]]) ? [value uppercaseString] : nil;
+}
+
+@end
+
+@interface ZCRInstrumentedModel : ZCREasyDough
+@property (strong, nonatomic, readonly) NSString *name;
+@property (assign, nonatomic, readonly) NSUInteger count;
+@end
+
+@implementation ZCRInstrumentedModel
+@end
+
+@interface ZCREasyInstrumentationTests : XCTestCase {
+    ZCREasyRecipe *recipe;
+}
+@end
+
+@implementation ZCREasyInstrumentationTests
+
+- (void)setUp {
+    [super setUp];
+    
+    recipe = [ZCREasyRecipe makeWith:^(id<ZCREasyRecipeMaker> recipeMaker) {
+        recipeMaker.name = @"InstrumentedRecipe";
+        recipeMaker.ingredientMapping = @{@"name": @"user.name", @"count": @"count"};
+        recipeMaker.ingredientTransformers = @{@"name": [[ZCRInstrumentationUppercaseTransformer alloc] init]};
+    }];
+    
+    [ZCRInstrumentedModel resetInstrumentation];
+}
+
+- (void)tearDown {
+    [ZCREasyInstrumentation setEnabled:NO];
+    [ZCREasyInstrumentation setTraceBeginHandler:nil endHandler:nil];
+    recipe = nil;
+    
+    [super tearDown];
+}
+
+- (ZCRInstrumentedModel *)bakeModel {
+    return [[ZCRInstrumentedModel alloc] initWithIdentifier:@"instrumented"
+                                                ingredients:@{@"user": @{@"name": @"Name"}, @"count": @1}
+                                                     recipe:recipe error:NULL];
+}
+
+- (void)testDisabledByDefault {
+    XCTAssertFalse([ZCREasyInstrumentation isEnabled], @"Instrumentation should be disabled by default");
+    
+    XCTAssertNotNil([self bakeModel], @"The model should be baked");
+    XCTAssertEqual([[recipe instrumentationSnapshot] count], (NSUInteger)0, @"Nothing should be recorded by the recipe");
+    XCTAssertEqual([[ZCRInstrumentedModel instrumentationSnapshot] count], (NSUInteger)0, @"Nothing should be recorded by the class");
+}
+
+- (void)testRecipeEvents {
+    [ZCREasyInstrumentation setEnabled:YES];
+    
+    XCTAssertNotNil([self bakeModel], @"The model should be baked");
+    XCTAssertNotNil([self bakeModel], @"The model should be baked");
+    
+    NSDictionary *snapshot = [recipe instrumentationSnapshot];
+    ZCREasyInstrumentationStatistics *mapping = snapshot[ZCREasyInstrumentationMappingEvent];
+    ZCREasyInstrumentationStatistics *transforming = snapshot[@"transforming.name"];
+    
+    XCTAssertEqual(mapping.count, (uint64_t)2, @"Each bake should record a mapping");
+    XCTAssertEqual(transforming.count, (uint64_t)2, @"Each transformation should be recorded");
+    XCTAssertNil(snapshot[@"transforming.count"], @"Properties without transformers should not be recorded");
+    XCTAssertTrue(mapping.totalNanoseconds >= transforming.totalNanoseconds, @"Mapping should include transforming");
+    
+    [recipe resetInstrumentation];
+    XCTAssertEqual([[recipe instrumentationSnapshot] count], (NSUInteger)0, @"Resetting should discard the measurements");
+}
+
+- (void)testClassEvents {
+    [ZCREasyInstrumentation setEnabled:YES];
+    
+    ZCRInstrumentedModel *model = [self bakeModel];
+    ZCRInstrumentedModel *copiedModel = [model copy];
+    ZCRInstrumentedModel *updatedModel = [model updateWithIngredients:@{@"count": @2} recipe:recipe error:NULL];
+    
+    XCTAssertNotNil(copiedModel, @"The model should be copied");
+    XCTAssertEqual(updatedModel.count, (NSUInteger)2, @"The model should be updated");
+    
+    NSDictionary *snapshot = [ZCRInstrumentedModel instrumentationSnapshot];
+    ZCREasyInstrumentationStatistics *mapping = snapshot[ZCREasyInstrumentationMappingEvent];
+    ZCREasyInstrumentationStatistics *copying = snapshot[ZCREasyInstrumentationCopyingEvent];
+    ZCREasyInstrumentationStatistics *notifying = snapshot[ZCREasyInstrumentationNotifyingEvent];
+    ZCREasyInstrumentationStatistics *setting = snapshot[ZCREasyInstrumentationSettingEvent];
+    
+    XCTAssertEqual(mapping.count, (uint64_t)2, @"Baking and updating should record mappings");
+    XCTAssertEqual(copying.count, (uint64_t)2, @"Copying and updating should record copies");
+    XCTAssertEqual(notifying.count, (uint64_t)1, @"Updating should record a notification");
+    XCTAssertTrue(setting.count >= 2, @"Baking and updating should record setting values");
+}
+
+- (void)testTraceHandlers {
+    [ZCREasyInstrumentation setEnabled:YES];
+    
+    NSMutableArray *trace = [NSMutableArray array];
+    [ZCREasyInstrumentation setTraceBeginHandler:^(NSString *event, NSString *subject) {
+        [trace addObject:[NSString stringWithFormat:@"begin %@ %@", subject, event]];
+    } endHandler:^(NSString *event, NSString *subject) {
+        [trace addObject:[NSString stringWithFormat:@"end %@ %@", subject, event]];
+    }];
+    
+    [recipe processIngredients:@{@"user": @{@"name": @"Name"}} error:NULL];
+    
+    NSArray *expectedTrace = @[@"begin InstrumentedRecipe mapping",
+                               @"begin InstrumentedRecipe transforming.name",
+                               @"end InstrumentedRecipe transforming.name",
+                               @"end InstrumentedRecipe mapping"];
+    XCTAssertEqualObjects(trace, expectedTrace, @"Events should be traced as they begin and end");
+}
+
+- (void)testStatistics {
+    ZCREasyInstrumentationRecorder *recorder = [[ZCREasyInstrumentationRecorder alloc] initWithSubject:@"Recorder"];
+    [recorder recordEvent:@"event" nanoseconds:0];
+    [recorder recordEvent:@"event" nanoseconds:100];
+    [recorder recordEvent:@"event" nanoseconds:1000];
+    [recorder recordEvent:@"event" nanoseconds:1000000];
+    
+    ZCREasyInstrumentationStatistics *statistics = [recorder snapshot][@"event"];
+    XCTAssertEqual(statistics.count, (uint64_t)4, @"Every measurement should be counted");
+    XCTAssertEqual(statistics.totalNanoseconds, (uint64_t)1001100, @"Every duration should be totaled");
+    XCTAssertEqual(statistics.minimumNanoseconds, (uint64_t)0, @"The minimum should be tracked");
+    XCTAssertEqual(statistics.maximumNanoseconds, (uint64_t)1000000, @"The maximum should be tracked");
+    XCTAssertEqualWithAccuracy(statistics.meanNanoseconds, 250275.0, 0.001, @"The mean should be computed");
+    
+    XCTAssertEqual([[statistics.histogram valueForKeyPath:@"@sum.self"] integerValue], (NSInteger)4, @"Every measurement should be bucketed");
+    XCTAssertEqualObjects(statistics.histogram[6], @1, @"100ns should fall in the 64-127ns bucket");
+    XCTAssertEqualObjects(statistics.histogram[9], @1, @"1000ns should fall in the 512-1023ns bucket");
+    XCTAssertEqual([statistics nanosecondsAtPercentile:0.5], (uint64_t)127, @"The median should be the upper bound of its bucket");
+    XCTAssertEqual([statistics nanosecondsAtPercentile:1.0], (uint64_t)1000000, @"The maximum percentile should be clamped to the maximum");
+}
+
+@end
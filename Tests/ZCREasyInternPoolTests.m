@@ -0,0 +1,165 @@
+//
+//  ZCREasyInternPoolTests.m
+//  ZCREasyBake
+//
+//  Created by Zachary Radke on 10/16/26.
+//  Copyright (c) 2026 Zach Radke. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#import "ZCREasyBake.h"
+
+@interface ZCRInternedModel : ZCREasyDough
+@property (strong, nonatomic, readonly) NSString *status;
+@property (strong, nonatomic, readonly) NSString *name;
+@property (strong, nonatomic, readonly) NSArray *tags;
+@end
+
+@implementation ZCRInternedModel
+@end
+
+@interface ZCREasyInternPoolTests : XCTestCase {
+    ZCREasyInternPool *pool;
+    ZCREasyRecipe *recipe;
+}
+@end
+
+@implementation ZCREasyInternPoolTests
+
+- (void)setUp {
+    [super setUp];
+    
+    pool = [[ZCREasyInternPool alloc] init];
+    recipe = [ZCREasyRecipe makeWith:^(id<ZCREasyRecipeMaker> recipeMaker) {
+        recipeMaker.ingredientMapping = @{@"status": @"status", @"name": @"name", @"tags": @"tags[*].name"};
+        recipeMaker.internedPropertyNames = [NSSet setWithObjects:@"status", @"tags", nil];
+        recipeMaker.internPool = pool;
+    }];
+}
+
+- (void)tearDown {
+    pool = nil;
+    recipe = nil;
+    
+    [super tearDown];
+}
+
+// Long enough to never be a tagged pointer, and a fresh instance every time.
+- (NSString *)distinctStringWithSuffix:(NSString *)suffix {
+    return [[NSMutableString stringWithFormat:@"a string long enough to be heap allocated %@", suffix] copy];
+}
+
+- (void)testInterningStrings {
+    NSString *first = [self distinctStringWithSuffix:@"1"];
+    NSString *second = [self distinctStringWithSuffix:@"1"];
+    XCTAssertNotEqual(first, second, @"The strings should start out as separate instances");
+    
+    XCTAssertEqual([pool internedValue:first], first, @"The first string should be pooled");
+    XCTAssertEqual([pool internedValue:second], first, @"Equal strings should share the pooled instance");
+    XCTAssertNotEqual([pool internedValue:[self distinctStringWithSuffix:@"2"]], first, @"Other strings should not be shared");
+    
+    XCTAssertEqual(pool.hitCount, (NSUInteger)1, @"The equal string should be a hit");
+    XCTAssertEqual(pool.missCount, (NSUInteger)2, @"The new strings should be misses");
+    XCTAssertTrue(pool.savedByteCount > 0, @"Sharing the string should save its bytes");
+    
+    [pool resetStatistics];
+    XCTAssertEqual(pool.hitCount + pool.missCount, (NSUInteger)0, @"The statistics should be reset");
+    XCTAssertEqual(pool.savedByteCount, 0ULL, @"The saved bytes should be reset");
+}
+
+- (void)testInterningMutableStrings {
+    NSMutableString *mutableString = [NSMutableString stringWithString:[self distinctStringWithSuffix:@"mutable"]];
+    NSString *interned = [pool internedValue:mutableString];
+    
+    XCTAssertNotEqual(interned, (NSString *)mutableString, @"Mutable strings should be copied");
+    [mutableString appendString:@" changed"];
+    XCTAssertEqualObjects(interned, [self distinctStringWithSuffix:@"mutable"], @"Mutating the original should not change the pooled string");
+}
+
+- (void)testInterningNumbers {
+    NSNumber *integer = [pool internedValue:@1];
+    
+    XCTAssertEqual([pool internedValue:[NSNumber numberWithInt:1]], integer, @"Equal integers should be shared");
+    XCTAssertEqual([[pool internedValue:@YES] boolValue], YES, @"Booleans should stay booleans");
+    XCTAssertEqual(strcmp([[pool internedValue:@1.0] objCType], @encode(double)), 0, @"Doubles should not become integers");
+}
+
+- (void)testOtherValues {
+    NSArray *array = @[@"value"];
+    NSDate *date = [NSDate date];
+    
+    XCTAssertEqual([pool internedValue:array], array, @"Arrays should be returned as they are");
+    XCTAssertEqual([pool internedValue:date], date, @"Dates should be returned as they are");
+    XCTAssertNil([pool internedValue:nil], @"Nil should be returned as it is");
+    XCTAssertEqual(pool.hitCount + pool.missCount, (NSUInteger)0, @"Other values should not be looked up");
+}
+
+- (void)testValuesAreHeldWeakly {
+    @autoreleasepool {
+        [pool internedValue:[self distinctStringWithSuffix:@"weak"]];
+    }
+    
+    XCTAssertEqual(pool.count, (NSUInteger)0, @"Released values should leave the pool");
+    
+    NSString *retained = [self distinctStringWithSuffix:@"strong"];
+    [pool internedValue:retained];
+    XCTAssertEqual(pool.count, (NSUInteger)1, @"Retained values should stay in the pool");
+    
+    [pool removeAllValues];
+    XCTAssertEqual(pool.count, (NSUInteger)0, @"Removing all values should empty the pool");
+}
+
+- (void)testBakingInternedProperties {
+    NSDictionary *firstIngredients = @{@"status": [self distinctStringWithSuffix:@"active"],
+                                       @"name": [self distinctStringWithSuffix:@"name"],
+                                       @"tags": @[@{@"name": [self distinctStringWithSuffix:@"tag"]}]};
+    NSDictionary *secondIngredients = @{@"status": [self distinctStringWithSuffix:@"active"],
+                                        @"name": [self distinctStringWithSuffix:@"name"],
+                                        @"tags": @[@{@"name": [self distinctStringWithSuffix:@"tag"]}, @{}]};
+    
+    ZCRInternedModel *first = [[ZCRInternedModel alloc] initWithIdentifier:@1 ingredients:firstIngredients recipe:recipe error:NULL];
+    ZCRInternedModel *second = [[ZCRInternedModel alloc] initWithIdentifier:@2 ingredients:secondIngredients recipe:recipe error:NULL];
+    
+    XCTAssertEqual(first.status, second.status, @"Interned properties should share their values");
+    XCTAssertNotEqual(first.name, second.name, @"Other properties should not be interned");
+    XCTAssertEqual(first.tags[0], second.tags[0], @"Wildcard elements should be interned");
+    XCTAssertEqualObjects(second.tags[1], [NSNull null], @"Missing wildcard elements should be left as NSNull");
+    XCTAssertEqual(pool.hitCount, (NSUInteger)2, @"The repeated values should be hits");
+}
+
+- (void)testConfiguringInterning {
+    XCTAssertEqualObjects(recipe.internedPropertyNames, ([NSSet setWithObjects:@"status", @"tags", nil]), @"The interned properties should be kept");
+    XCTAssertEqual(recipe.internPool, pool, @"The configured pool should be used");
+    
+    ZCREasyRecipe *plainRecipe = [recipe modifyWith:^(id<ZCREasyRecipeMaker> recipeMaker) {
+        recipeMaker.internedPropertyNames = nil;
+    }];
+    XCTAssertEqual([plainRecipe.internedPropertyNames count], (NSUInteger)0, @"Interning should be removable");
+    XCTAssertNil(plainRecipe.internPool, @"Recipes which don't intern should have no pool");
+    XCTAssertNotEqualObjects(plainRecipe, recipe, @"Interning should affect equality");
+    
+    ZCREasyRecipe *sharedRecipe = [plainRecipe modifyWith:^(id<ZCREasyRecipeMaker> recipeMaker) {
+        recipeMaker.internedPropertyNames = [NSSet setWithObject:@"name"];
+    }];
+    XCTAssertEqual(sharedRecipe.internPool, [ZCREasyInternPool sharedPool], @"The shared pool should be the default");
+    
+    ZCREasyRecipe *removedRecipe = [recipe modifyWith:^(id<ZCREasyRecipeMaker> recipeMaker) {
+        [recipeMaker removeInstructionForProperty:@"status" error:NULL];
+    }];
+    XCTAssertEqualObjects(removedRecipe.internedPropertyNames, [NSSet setWithObject:@"tags"], @"Removed properties should no longer be interned");
+}
+
+- (void)testInterningUnmappedProperties {
+    __block NSError *error;
+    ZCREasyRecipe *invalidRecipe = [ZCREasyRecipe makeWith:^(id<ZCREasyRecipeMaker> recipeMaker) {
+        recipeMaker.ingredientMapping = @{@"status": @"status"};
+        recipeMaker.internedPropertyNames = [NSSet setWithObject:@"missing"];
+        [recipeMaker validateRecipe:&error];
+    }];
+    
+    XCTAssertNil(invalidRecipe, @"Interned properties must be mapped");
+    XCTAssertEqual(error.code, ZCREasyBakeErrorInvalidParameters, @"The error should report the invalid parameter");
+}
+
+@end
@@ -0,0 +1,225 @@
+//
+//  ZCREasyPipelineTests.m
+//  ZCREasyBake
+//
+//  Created by Zachary Radke on 10/16/26.
+//  Copyright (c) 2026 Zach Radke. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#import "ZCREasyBake.h"
+
+@interface ZCRPipelinedModel : ZCREasyDough
+@property (strong, nonatomic, readonly) NSString *name;
+@property (assign, nonatomic, readonly) NSInteger count;
+@end
+
+@implementation ZCRPipelinedModel
+@end
+
+@interface ZCREasyPipelineTests : XCTestCase {
+    ZCREasyRecipe *recipe;
+    ZCREasyPipeline *pipeline;
+    NSMutableArray *publishedModels;
+}
+@end
+
+@implementation ZCREasyPipelineTests
+
+- (void)setUp {
+    [super setUp];
+    
+    recipe = [ZCREasyRecipe makeWith:^(id<ZCREasyRecipeMaker> recipeMaker) {
+        recipeMaker.ingredientMapping = @{@"name": @"name", @"count": @"count"};
+    }];
+    
+    publishedModels = [NSMutableArray array];
+    NSMutableArray *models = publishedModels;
+    
+    pipeline = [[ZCREasyPipeline alloc] initWithDoughClass:[ZCRPipelinedModel class] recipe:recipe];
+    pipeline.identifierPath = @"id";
+    pipeline.publishBlock = ^(id dough) {
+        [models addObject:dough];
+    };
+}
+
+- (void)tearDown {
+    [pipeline cancel];
+    [pipeline waitUntilFinished];
+    
+    recipe = nil;
+    pipeline = nil;
+    publishedModels = nil;
+    
+    [super tearDown];
+}
+
+- (NSDictionary *)recordAtIndex:(NSInteger)index {
+    return @{@"id": @(index), @"name": [NSString stringWithFormat:@"Name %ld", (long)index], @"count": @(index)};
+}
+
+- (void)testBakingSubmittedRecords {
+    pipeline.bakeConcurrency = 4;
+    pipeline.queueCapacity = 8;
+    XCTAssertTrue([pipeline startWithError:NULL], @"The pipeline should start");
+    
+    for (NSInteger i = 0; i < 100; i++) {
+        XCTAssertTrue([pipeline submitInput:[self recordAtIndex:i]], @"Every input should be accepted");
+    }
+    
+    [pipeline finishWithCompletion:nil];
+    [pipeline waitUntilFinished];
+    
+    XCTAssertTrue(pipeline.isFinished, @"The pipeline should finish");
+    XCTAssertFalse([pipeline submitInput:[self recordAtIndex:100]], @"Finished pipelines should not accept inputs");
+    XCTAssertEqual([publishedModels count], (NSUInteger)100, @"Every record should be published");
+    
+    NSArray *counts = [[publishedModels valueForKey:@"count"] sortedArrayUsingSelector:@selector(compare:)];
+    XCTAssertEqualObjects(counts[99], @99, @"The records should be baked with the recipe");
+    XCTAssertEqual([[NSSet setWithArray:[publishedModels valueForKey:@"identifier"]] count], (NSUInteger)100,
+                   @"The identifiers should be read from the identifier path");
+    
+    for (NSString *stage in @[ZCREasyPipelineParseStage, ZCREasyPipelineBakeStage, ZCREasyPipelinePublishStage]) {
+        XCTAssertEqual([pipeline processedCountForStage:stage], (NSUInteger)100, @"Every stage should count its items");
+        XCTAssertTrue([pipeline throughputForStage:stage] > 0.0, @"Every stage should report its throughput");
+        XCTAssertNotNil([pipeline latencyForStage:stage], @"Every stage should report its latency");
+    }
+}
+
+- (void)testParsingData {
+    NSMutableArray *failedStages = [NSMutableArray array];
+    pipeline.errorBlock = ^(NSString *stage, id value, NSError *error) {
+        @synchronized(failedStages) {
+            [failedStages addObject:stage];
+        }
+    };
+    [pipeline startWithError:NULL];
+    
+    NSArray *page = @[[self recordAtIndex:1], [self recordAtIndex:2], @{@"id": @3, @"count": @[]}];
+    [pipeline submitInput:[NSJSONSerialization dataWithJSONObject:page options:0 error:NULL]];
+    [pipeline submitInput:[@"not JSON" dataUsingEncoding:NSUTF8StringEncoding]];
+    [pipeline finishWithCompletion:nil];
+    [pipeline waitUntilFinished];
+    
+    XCTAssertEqual([publishedModels count], (NSUInteger)2, @"Each record in the page should be baked");
+    XCTAssertEqual([pipeline processedCountForStage:ZCREasyPipelineParseStage], (NSUInteger)2, @"Each input should be parsed once");
+    XCTAssertEqual(pipeline.errorCount, (NSUInteger)2, @"The invalid input and record should fail");
+    XCTAssertEqualObjects([failedStages sortedArrayUsingSelector:@selector(compare:)],
+                          (@[ZCREasyPipelineBakeStage, ZCREasyPipelineParseStage]), @"Errors should report their stage");
+}
+
+- (void)testBackpressure {
+    dispatch_semaphore_t publishGate = dispatch_semaphore_create(0);
+    pipeline.queueCapacity = 2;
+    pipeline.bakeConcurrency = 1;
+    pipeline.publishBlock = ^(id dough) {
+        dispatch_semaphore_wait(publishGate, DISPATCH_TIME_FOREVER);
+    };
+    [pipeline startWithError:NULL];
+    
+    __block NSUInteger submittedCount = 0;
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        for (NSInteger i = 0; i < 50; i++) {
+            if ([pipeline submitInput:[self recordAtIndex:i]]) {
+                __atomic_add_fetch(&submittedCount, 1, __ATOMIC_RELAXED);
+            }
+        }
+    });
+    
+    [NSThread sleepForTimeInterval:0.2];
+    XCTAssertTrue(__atomic_load_n(&submittedCount, __ATOMIC_RELAXED) < 50, @"A blocked publisher should throttle submission");
+    XCTAssertTrue([pipeline stallCountForStage:ZCREasyPipelineParseStage] > 0, @"The parse queue should have filled up");
+    
+    for (NSInteger i = 0; i < 50; i++) {
+        dispatch_semaphore_signal(publishGate);
+    }
+    
+    while (__atomic_load_n(&submittedCount, __ATOMIC_RELAXED) < 50) {
+        [NSThread sleepForTimeInterval:0.01];
+    }
+    [pipeline finishWithCompletion:nil];
+    [pipeline waitUntilFinished];
+    
+    XCTAssertEqual([pipeline processedCountForStage:ZCREasyPipelinePublishStage], (NSUInteger)50, @"Every record should be published once unblocked");
+}
+
+- (void)testCancelling {
+    dispatch_semaphore_t publishGate = dispatch_semaphore_create(0);
+    pipeline.queueCapacity = 1;
+    pipeline.publishBlock = ^(id dough) {
+        dispatch_semaphore_wait(publishGate, DISPATCH_TIME_FOREVER);
+    };
+    [pipeline startWithError:NULL];
+    
+    __block BOOL lastSubmission = YES;
+    dispatch_semaphore_t submitted = dispatch_semaphore_create(0);
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        for (NSInteger i = 0; i < 20 && lastSubmission; i++) {
+            lastSubmission = [pipeline submitInput:[self recordAtIndex:i]];
+        }
+        dispatch_semaphore_signal(submitted);
+    });
+    
+    [NSThread sleepForTimeInterval:0.1];
+    [pipeline cancel];
+    dispatch_semaphore_signal(publishGate);
+    
+    dispatch_semaphore_wait(submitted, DISPATCH_TIME_FOREVER);
+    [pipeline waitUntilFinished];
+    
+    XCTAssertTrue(pipeline.isCancelled, @"The pipeline should be cancelled");
+    XCTAssertFalse(lastSubmission, @"Blocked submissions should fail once cancelled");
+    XCTAssertTrue([pipeline processedCountForStage:ZCREasyPipelinePublishStage] < 20, @"Queued records should be discarded");
+    
+    __block BOOL completionCancelled = NO;
+    dispatch_semaphore_t completed = dispatch_semaphore_create(0);
+    [pipeline finishWithCompletion:^(BOOL cancelled) {
+        completionCancelled = cancelled;
+        dispatch_semaphore_signal(completed);
+    }];
+    dispatch_semaphore_wait(completed, DISPATCH_TIME_FOREVER);
+    XCTAssertTrue(completionCancelled, @"Completions should report the cancellation");
+}
+
+- (void)testFinishingWhileSubmitting {
+    pipeline.queueCapacity = 4;
+    [pipeline startWithError:NULL];
+    
+    __block NSUInteger acceptedCount = 0;
+    dispatch_group_t submitters = dispatch_group_create();
+    for (NSInteger submitter = 0; submitter < 4; submitter++) {
+        dispatch_group_async(submitters, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+            for (NSInteger i = 0; i < 200; i++) {
+                if ([pipeline submitInput:[self recordAtIndex:submitter * 200 + i]]) {
+                    __atomic_add_fetch(&acceptedCount, 1, __ATOMIC_RELAXED);
+                }
+            }
+        });
+    }
+    
+    [NSThread sleepForTimeInterval:0.01];
+    [pipeline finishWithCompletion:nil];
+    dispatch_group_wait(submitters, DISPATCH_TIME_FOREVER);
+    [pipeline waitUntilFinished];
+    
+    XCTAssertEqual([publishedModels count], __atomic_load_n(&acceptedCount, __ATOMIC_RELAXED),
+                   @"Every accepted input should be published, even when submitted while finishing");
+}
+
+- (void)testStartingWithInvalidConfiguration {
+    ZCREasyRecipe *unknownRecipe = [ZCREasyRecipe makeWith:^(id<ZCREasyRecipeMaker> recipeMaker) {
+        recipeMaker.ingredientMapping = @{@"missing": @"missing"};
+    }];
+    ZCREasyPipeline *invalidPipeline = [[ZCREasyPipeline alloc] initWithDoughClass:[ZCRPipelinedModel class] recipe:unknownRecipe];
+    
+    NSError *error;
+    XCTAssertFalse([invalidPipeline startWithError:&error], @"Unknown properties should fail to start");
+    XCTAssertEqual(error.code, ZCREasyBakeErrorInvalidParameters, @"The error should report the invalid parameter");
+    XCTAssertFalse([invalidPipeline submitInput:@{}], @"Pipelines which didn't start should not accept inputs");
+    
+    XCTAssertTrue([pipeline startWithError:NULL], @"The pipeline should start");
+    XCTAssertFalse([pipeline startWithError:&error], @"Pipelines should only start once");
+}
+
+@end
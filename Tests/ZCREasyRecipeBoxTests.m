@@ -13,6 +13,7 @@
 {
     ZCREasyRecipeBox *box;
     ZCREasyRecipe *recipe;
+    NSUInteger changeCount;
 }
 @end
 
@@ -91,6 +92,114 @@
     XCTAssert([box.recipeNames containsObject:recipe.name], @"The recipe should be in the box.");
 }
 
+- (void)testAddRecipes {
+    ZCREasyRecipe *otherRecipe = [recipe modifyWith:^(id<ZCREasyRecipeMaker> recipeMaker) {
+        recipeMaker.name = @"TestRecipe2";
+    }];
+    
+    NSError *error;
+    XCTAssertTrue([box addRecipes:@[recipe, otherRecipe] error:&error], @"The recipes should be added.");
+    XCTAssertNil(error, @"There should be no error adding the recipes.");
+    XCTAssertEqual([box recipeWithName:@"TestRecipe1"], recipe, @"The first recipe should be added.");
+    XCTAssertEqual([box recipeWithName:@"TestRecipe2"], otherRecipe, @"The second recipe should be added.");
+}
+
+- (void)testRecipesAddedAfterSnapshot {
+    NSMutableArray *recipes = [NSMutableArray array];
+    for (NSUInteger i = 0; i < 100; i++) {
+        ZCREasyRecipe *numberedRecipe = [recipe modifyWith:^(id<ZCREasyRecipeMaker> recipeMaker) {
+            recipeMaker.name = [NSString stringWithFormat:@"NumberedRecipe%lu", (unsigned long)i];
+        }];
+        [box addRecipe:numberedRecipe error:NULL];
+        [recipes addObject:numberedRecipe];
+        
+        XCTAssertEqual([box recipeWithName:numberedRecipe.name], numberedRecipe, @"Each recipe should be readable once added.");
+    }
+    
+    for (ZCREasyRecipe *numberedRecipe in recipes) {
+        XCTAssertEqual([box recipeWithName:numberedRecipe.name], numberedRecipe, @"Every recipe should remain readable.");
+    }
+    XCTAssertEqual(box.recipeNames.count, (NSUInteger)100, @"Every recipe should be registered.");
+}
+
+- (void)testReplacedSnapshotsAreReleased {
+    NSHashTable *removedRecipes = [NSHashTable weakObjectsHashTable];
+    for (NSUInteger i = 0; i < 200; i++) {
+        @autoreleasepool {
+            ZCREasyRecipe *cycledRecipe = [recipe modifyWith:^(id<ZCREasyRecipeMaker> recipeMaker) {
+                recipeMaker.name = [NSString stringWithFormat:@"CycledRecipe%lu", (unsigned long)i];
+            }];
+            [box addRecipes:@[cycledRecipe] error:NULL];
+            XCTAssertEqual([box recipeWithName:cycledRecipe.name], cycledRecipe, @"The recipe should be readable once added.");
+            [box removeRecipeNamed:cycledRecipe.name error:NULL];
+            [removedRecipes addObject:cycledRecipe];
+        }
+    }
+    
+    XCTAssertEqual([[removedRecipes allObjects] count], (NSUInteger)0, @"Removed recipes should not be kept alive by old snapshots");
+    XCTAssertNil([box recipeWithName:@"CycledRecipe199"], @"Removed recipes should not be readable");
+}
+
+- (void)testReplacedSnapshotsAreReleasedWithConcurrentReaders {
+    [box addRecipe:recipe error:NULL];
+    
+    __block BOOL isReading = YES;
+    __block NSUInteger missCount = 0;
+    dispatch_group_t readers = dispatch_group_create();
+    for (NSUInteger thread = 0; thread < 4; thread++) {
+        dispatch_group_async(readers, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+            NSUInteger misses = 0;
+            while (__atomic_load_n(&isReading, __ATOMIC_ACQUIRE)) {
+                @autoreleasepool {
+                    if (![box recipeWithName:@"TestRecipe1"]) { misses++; }
+                    (void)[box recipeWithName:[NSString stringWithFormat:@"CycledRecipe%lu", (unsigned long)(thread * 50)]];
+                }
+            }
+            __atomic_add_fetch(&missCount, misses, __ATOMIC_RELAXED);
+        });
+    }
+    
+    NSHashTable *removedRecipes = [NSHashTable weakObjectsHashTable];
+    for (NSUInteger i = 0; i < 200; i++) {
+        @autoreleasepool {
+            ZCREasyRecipe *cycledRecipe = [recipe modifyWith:^(id<ZCREasyRecipeMaker> recipeMaker) {
+                recipeMaker.name = [NSString stringWithFormat:@"CycledRecipe%lu", (unsigned long)i];
+            }];
+            [box addRecipe:cycledRecipe error:NULL];
+            XCTAssertEqual([box recipeWithName:cycledRecipe.name], cycledRecipe, @"The recipe should be readable once added.");
+            [box removeRecipeNamed:cycledRecipe.name error:NULL];
+            [removedRecipes addObject:cycledRecipe];
+        }
+    }
+    
+    // Only the readers' own lookups could still hold a removed recipe, and they are released with
+    // the readers' autorelease pools.
+    __atomic_store_n(&isReading, NO, __ATOMIC_RELEASE);
+    dispatch_group_wait(readers, DISPATCH_TIME_FOREVER);
+    
+    XCTAssertEqual([[removedRecipes allObjects] count], (NSUInteger)0, @"Removed recipes should not be kept alive by old snapshots");
+    XCTAssertEqual(missCount, (NSUInteger)0, @"Recipes which were never removed should always be readable.");
+}
+
+- (void)testFailedChangesDoNotNotify {
+    [box addRecipe:recipe error:NULL];
+    [box addObserver:self forKeyPath:@"recipeNames" options:0 context:NULL];
+    
+    changeCount = 0;
+    XCTAssertFalse([box addRecipe:recipe error:NULL], @"The recipe should not be added twice.");
+    XCTAssertFalse([box removeRecipeNamed:@"UnknownRecipe" error:NULL], @"The unknown recipe should not be removed.");
+    XCTAssertEqual(changeCount, (NSUInteger)0, @"Failed changes should not be observed.");
+    
+    XCTAssertTrue([box removeRecipeNamed:@"TestRecipe1" error:NULL], @"The recipe should be removed.");
+    XCTAssertEqual(changeCount, (NSUInteger)1, @"Successful changes should be observed.");
+    
+    [box removeObserver:self forKeyPath:@"recipeNames"];
+}
+
+- (void)observeValueForKeyPath:(NSString *)keyPath ofObject:(id)object change:(NSDictionary *)change context:(void *)context {
+    changeCount++;
+}
+
 #pragma mark - Errors
 
 - (void)testErrorAddNilRecipe {
@@ -129,6 +238,18 @@
     XCTAssertNotNil(error, @"The error should be populated.");
 }
 
+- (void)testErrorAddRecipesWithRegisteredName {
+    [box addRecipe:recipe error:NULL];
+    ZCREasyRecipe *otherRecipe = [recipe modifyWith:^(id<ZCREasyRecipeMaker> recipeMaker) {
+        recipeMaker.name = @"TestRecipe2";
+    }];
+    
+    NSError *error;
+    XCTAssertFalse([box addRecipes:@[otherRecipe, recipe] error:&error], @"The recipes should not be added.");
+    XCTAssertNotNil(error, @"The error should be populated.");
+    XCTAssertNil([box recipeWithName:@"TestRecipe2"], @"No recipe should be added when one fails.");
+}
+
 - (void)testErrorRemoveRecipeWithUnknownName {
     [box addRecipe:recipe error:NULL];
     NSError *error;
@@ -8,6 +8,8 @@
 
 #import <XCTest/XCTest.h>
 #import "ZCREasyRecipe.h"
+#import "ZCREasyError.h"
+#import "ZCREasyTransformerCache.h"
 
 @interface ZCROneWayTransformer : NSValueTransformer
 @end
@@ -28,6 +30,64 @@
 
 @end
 
+@interface ZCRCountingTransformer : NSValueTransformer
+@property (assign, nonatomic) NSUInteger transformationCount;
+@end
+
+@implementation ZCRCountingTransformer
+
++ (Class)transformedValueClass {
+    return [NSString class];
+}
+
+- (id)transformedValue:(id)value {
+    @synchronized(self) {
+        self.transformationCount++;
+    }
+    return [value lowercaseString];
+}
+
+@end
+
+@interface ZCRImpureTransformer : ZCRCountingTransformer
+@end
+
+@implementation ZCRImpureTransformer
+
++ (BOOL)zcr_allowsMemoization {
+    return NO;
+}
+
+@end
+
+@interface ZCRCollectionTransformer : ZCROneWayTransformer
+@property (assign, nonatomic) NSUInteger collectionCount;
+@end
+
+@implementation ZCRCollectionTransformer
+
+- (NSArray *)zcr_transformedValues:(NSArray *)values {
+    self.collectionCount++;
+    return [super zcr_transformedValues:values];
+}
+
+@end
+
+@interface ZCRNullCountingTransformer : ZCROneWayTransformer
+@property (assign, nonatomic) NSUInteger nullCount;
+@end
+
+@implementation ZCRNullCountingTransformer
+
+- (id)transformedValue:(id)value {
+    if (!value || value == [NSNull null]) {
+        self.nullCount++;
+    }
+    return [super transformedValue:value];
+}
+
+@end
+
 @interface ZCREasyRecipeTests : XCTestCase {
     NSString *name;
     NSDictionary *mapping;
@@ -105,6 +165,47 @@
     XCTAssertEqualObjects(components, expectedComponents, @"The components should be properly broken down.");
 }
 
+- (void)testIngredientMappingComponentsWithNestedIndexes {
+    recipe = [[ZCREasyRecipe alloc] initWithName:nil ingredientMapping:@{@"key1": @"data.rows[1][12].value",
+                                                                         @"key2": @"[0].first name"}
+                          ingredientTransformers:nil error:NULL];
+    XCTAssertNil(recipe, @"Paths with different roots should be invalid.");
+    
+    recipe = [[ZCREasyRecipe alloc] initWithName:nil ingredientMapping:@{@"key1": @"data.rows[1][12].value",
+                                                                         @"key2": @"first name"}
+                          ingredientTransformers:nil error:NULL];
+    NSArray *expectedComponents = @[@"data", @"rows", @1, @12, @"value"];
+    XCTAssertEqualObjects(recipe.ingredientMappingComponents[@"key1"], expectedComponents, @"Consecutive indexes should be broken down.");
+    XCTAssertEqualObjects(recipe.ingredientMappingComponents[@"key2"], @[@"first name"], @"Keys should be kept verbatim.");
+}
+
+- (void)testPathsWithDifferentPrefixes {
+    NSDictionary *validMapping = @{@"key1": @"first.shared[0]",
+                                   @"key2": @"second.shared.value"};
+    NSError *error;
+    recipe = [[ZCREasyRecipe alloc] initWithName:nil ingredientMapping:validMapping ingredientTransformers:nil error:&error];
+    XCTAssertNotNil(recipe, @"Pieces only need to agree with the paths sharing their prefix.");
+    XCTAssertNil(error, @"There should be no error.");
+}
+
+- (void)testLargeRecipe {
+    ZCREasyRecipe *largeRecipe = [ZCREasyRecipe makeWith:^(id<ZCREasyRecipeMaker> recipeMaker) {
+        for (NSUInteger i = 0; i < 1000; i++) {
+            NSString *ingredientPath = [NSString stringWithFormat:@"group%lu.items[%lu].field%lu",
+                                        (unsigned long)(i % 10), (unsigned long)(i % 4), (unsigned long)i];
+            [recipeMaker addInstructionForProperty:[NSString stringWithFormat:@"property%lu", (unsigned long)i]
+                                    ingredientPath:ingredientPath transformer:nil error:NULL];
+        }
+        [recipeMaker removeInstructionForProperty:@"property0" error:NULL];
+    }];
+    
+    XCTAssertEqual([largeRecipe.propertyNames count], (NSUInteger)999, @"Every instruction should be kept.");
+    
+    NSDictionary *processedIngredients = [largeRecipe processIngredients:@{@"group7": @{@"items": @[@{}, @{}, @{}, @{@"field7": @"seven"}]}}
+                                                                   error:NULL];
+    XCTAssertEqualObjects(processedIngredients, @{@"property7": @"seven"}, @"The large recipe should process ingredients.");
+}
+
 - (void)testPropertyNames {
     NSSet *expectedNames = [NSSet setWithArray:[mapping allKeys]];
     XCTAssertEqualObjects(recipe.propertyNames, expectedNames, @"The property names should be made from the mapping.");
@@ -128,6 +229,62 @@
     XCTAssertEqualObjects(modifiedRecipe.ingredientTransformers, expectedTransformers, @"The ingredient transformers should be modified");
 }
 
+- (void)testModifyWithSharedPaths {
+    ZCREasyRecipe *baseRecipe = [ZCREasyRecipe makeWith:^(id<ZCREasyRecipeMaker> recipeMaker) {
+        recipeMaker.ingredientMapping = @{@"userName": @"user.name",
+                                          @"titles": @"items[*].title",
+                                          @"count": @"meta.count"};
+    }];
+    ZCREasyRecipe *modifiedRecipe = [baseRecipe modifyWith:^(id<ZCREasyRecipeMaker> recipeMaker) {
+        [recipeMaker removeInstructionForProperty:@"count" error:NULL];
+        [recipeMaker addInstructionForProperty:@"count" ingredientPath:@"meta.total" transformer:nil error:NULL];
+        [recipeMaker addInstructionForProperty:@"userID" ingredientPath:@"user.id" transformer:nil error:NULL];
+    }];
+    
+    XCTAssertEqual(modifiedRecipe.ingredientMappingComponents[@"titles"], baseRecipe.ingredientMappingComponents[@"titles"],
+                   @"Unchanged paths should not be broken down again");
+    
+    NSDictionary *ingredients = @{@"user": @{@"name": @"Zach", @"id": @7},
+                                  @"items": @[@{@"title": @"First"}, @{@"title": @"Second"}],
+                                  @"meta": @{@"count": @1, @"total": @2}};
+    NSDictionary *expectedIngredients = @{@"userName": @"Zach", @"userID": @7, @"titles": @[@"First", @"Second"], @"count": @2};
+    XCTAssertEqualObjects([modifiedRecipe processIngredients:ingredients error:NULL], expectedIngredients,
+                          @"The modified recipe should process both shared and changed paths");
+    
+    expectedIngredients = @{@"userName": @"Zach", @"titles": @[@"First", @"Second"], @"count": @1};
+    XCTAssertEqualObjects([baseRecipe processIngredients:ingredients error:NULL], expectedIngredients,
+                          @"The original recipe should be unaffected by the modification");
+}
+
+- (void)testModifyWithInconsistentRoot {
+    __block NSError *error;
+    ZCREasyRecipe *modifiedRecipe = [recipe modifyWith:^(id<ZCREasyRecipeMaker> recipeMaker) {
+        [recipeMaker addInstructionForProperty:@"key4" ingredientPath:@"[0]" transformer:nil error:NULL];
+        [recipeMaker validateRecipe:&error];
+    }];
+    
+    XCTAssertNil(modifiedRecipe, @"Modifications should still be validated against the shared paths");
+    XCTAssertEqual(error.code, ZCREasyBakeErrorInvalidParameters, @"The error should report the invalid mapping");
+}
+
+- (void)testHash {
+    ZCREasyRecipe *sameRecipe = [ZCREasyRecipe makeWith:^(id<ZCREasyRecipeMaker> recipeMaker) {
+        recipeMaker.name = name;
+        recipeMaker.ingredientMapping = mapping;
+        recipeMaker.ingredientTransformers = transformers;
+    }];
+    ZCREasyRecipe *otherRecipe = [recipe modifyWith:^(id<ZCREasyRecipeMaker> recipeMaker) {
+        [recipeMaker removeInstructionForProperty:@"key3" error:NULL];
+        [recipeMaker addInstructionForProperty:@"key3" ingredientPath:@"key_4" transformer:nil error:NULL];
+    }];
+    
+    XCTAssertEqualObjects(sameRecipe, recipe, @"Recipes with the same instructions should be equal");
+    XCTAssertEqual([sameRecipe hash], [recipe hash], @"Equal recipes should have equal hashes");
+    XCTAssertEqual([recipe hash], [recipe hash], @"The hash should not change");
+    XCTAssertNotEqual([otherRecipe hash], [recipe hash], @"Recipes of the same size should hash their paths");
+    XCTAssertNotEqualObjects(otherRecipe, recipe, @"Recipes with different paths should not be equal");
+}
+
 - (void)testProcessIngredients {
     NSDictionary *ingredients = @{@"key_1": @"test1",
                                   @"key_3": @[@"test2", @"test3"]};
@@ -140,6 +297,339 @@
     XCTAssertNil(error, @"There should be no error.");
 }
 
+- (void)testProcessIngredientsWithSharedPrefixes {
+    recipe = [[ZCREasyRecipe alloc] initWithName:nil
+                               ingredientMapping:@{@"key1": @"data.attributes.first",
+                                                   @"key2": @"data.attributes.second[1]",
+                                                   @"key3": @"data.attributes.second[0]",
+                                                   @"key4": @"data.missing.fourth",
+                                                   @"key5": @"data.id"}
+                          ingredientTransformers:@{@"key2": [ZCROneWayTransformer new]}
+                                           error:NULL];
+    
+    NSDictionary *ingredients = @{@"data": @{@"id": @42,
+                                             @"attributes": @{@"first": @"test1",
+                                                              @"second": @[@"test2", @"test3"]}}};
+    NSError *error;
+    NSDictionary *processedIngredients = [recipe processIngredients:ingredients error:&error];
+    
+    NSDictionary *expectedIngredients = @{@"key1": @"test1",
+                                          @"key2": @"TEST3",
+                                          @"key3": @"test2",
+                                          @"key5": @42};
+    XCTAssertEqualObjects(expectedIngredients, processedIngredients, @"Paths sharing a prefix should all be processed");
+    XCTAssertNil(error, @"There should be no error.");
+}
+
+- (void)testProcessIngredientsWithWildcards {
+    ZCRCollectionTransformer *transformer = [ZCRCollectionTransformer new];
+    recipe = [[ZCREasyRecipe alloc] initWithName:nil
+                               ingredientMapping:@{@"skus": @"order.items[*].sku",
+                                                   @"quantities": @"order.items[*].quantity",
+                                                   @"items": @"order.items[*]",
+                                                   @"tags": @"order.items[*].tags[*]",
+                                                   @"orderID": @"order.id"}
+                          ingredientTransformers:@{@"skus": transformer}
+                                           error:NULL];
+    XCTAssertEqualObjects(recipe.ingredientMappingComponents[@"tags"], (@[@"order", @"items", [NSNull null], @"tags", [NSNull null]]), @"Wildcards should be broken down into NSNull");
+    
+    NSArray *items = @[@{@"sku": @"a1", @"quantity": @2, @"tags": @[@"x", @"y"]},
+                       @{@"quantity": @1, @"tags": @[]},
+                       @{@"sku": @"b2", @"quantity": @5}];
+    NSError *error;
+    NSDictionary *processedIngredients = [recipe processIngredients:@{@"order": @{@"id": @7, @"items": items}}
+                                                              error:&error];
+    
+    NSDictionary *expectedIngredients = @{@"skus": @[@"A1", [NSNull null], @"B2"],
+                                          @"quantities": @[@2, @1, @5],
+                                          @"items": items,
+                                          @"tags": @[@[@"x", @"y"], @[], [NSNull null]],
+                                          @"orderID": @7};
+    XCTAssertEqualObjects(processedIngredients, expectedIngredients, @"Every element should be mapped in order");
+    XCTAssertNil(error, @"There should be no error.");
+    XCTAssertEqual(transformer.collectionCount, (NSUInteger)1, @"The transformer should be given the whole collection at once");
+    
+    processedIngredients = [recipe processIngredients:@{@"order": @{@"items": @[]}} error:&error];
+    XCTAssertEqualObjects(processedIngredients[@"skus"], @[], @"An empty array should map to an empty array");
+}
+
+- (void)testProcessIngredientsWithMismatchedWildcards {
+    recipe = [ZCREasyRecipe makeWith:^(id<ZCREasyRecipeMaker> recipeMaker) {
+        recipeMaker.ingredientMapping = @{@"skus": @"items[*].sku"};
+        recipeMaker.mismatchPolicy = ZCREasyRecipeMismatchPolicySkipField;
+    }];
+    
+    NSDictionary *mismatches;
+    NSDictionary *processedIngredients = [recipe processIngredients:@{@"items": @[@{@"sku": @"a1"}, @"b2"]}
+                                                         mismatches:&mismatches error:NULL];
+    XCTAssertEqualObjects(processedIngredients[@"skus"], (@[@"a1", [NSNull null]]), @"Mismatched elements should be null");
+    XCTAssertEqualObjects(mismatches, @{@"skus": @"items[*].sku"}, @"The mismatch should be reported");
+    
+    processedIngredients = [recipe processIngredients:@{@"items": @{@"sku": @"a1"}} mismatches:&mismatches error:NULL];
+    XCTAssertNil(processedIngredients[@"skus"], @"A wildcard over something other than an array should be skipped");
+}
+
+- (void)testProcessIngredientsWithNullFieldWildcards {
+    ZCRNullCountingTransformer *transformer = [ZCRNullCountingTransformer new];
+    recipe = [ZCREasyRecipe makeWith:^(id<ZCREasyRecipeMaker> recipeMaker) {
+        recipeMaker.ingredientMapping = @{@"skus": @"items[*].sku"};
+        recipeMaker.ingredientTransformers = @{@"skus": transformer};
+        recipeMaker.mismatchPolicy = ZCREasyRecipeMismatchPolicyNullField;
+    }];
+    
+    NSDictionary *ingredients = @{@"items": @[@{@"sku": @"a1"}, @"b2", @{@"sku": [NSNull null]}, @{}, @{@"sku": @"c3"}]};
+    NSDictionary *processedIngredients = [recipe processIngredients:ingredients mismatches:NULL error:NULL];
+    
+    XCTAssertEqualObjects(processedIngredients[@"skus"], (@[@"A1", [NSNull null], [NSNull null], [NSNull null], @"C3"]), @"Placeholders should stay in place");
+    XCTAssertEqual(transformer.nullCount, (NSUInteger)1, @"Only the explicit null should be transformed, as nil");
+    
+    // Outside of a wildcard, an explicit null is transformed as nil too.
+    transformer.nullCount = 0;
+    ZCREasyRecipe *singleRecipe = [recipe modifyWith:^(id<ZCREasyRecipeMaker> recipeMaker) {
+        recipeMaker.ingredientMapping = @{@"skus": @"items[0].sku"};
+    }];
+    [singleRecipe processIngredients:@{@"items": @[@{@"sku": [NSNull null]}]} mismatches:NULL error:NULL];
+    XCTAssertEqual(transformer.nullCount, (NSUInteger)1, @"The explicit null should be transformed, as nil");
+}
+
+- (void)testProcessIngredientsWithOutOfBoundsIndex {
+    NSDictionary *ingredients = @{@"key_1": @"test1",
+                                  @"key_3": @[]};
+    NSError *error;
+    NSDictionary *processedIngredients = [recipe processIngredients:ingredients error:&error];
+    
+    XCTAssertNil(processedIngredients, @"The ingredients should not be processed.");
+    XCTAssertNotNil(error, @"There should be an error.");
+}
+
+- (void)testProcessIngredientsArray {
+    NSArray *ingredientsArray = @[@{@"key_1": @"test1"},
+                                  @{@"key_3": @[]},
+                                  @{@"key_1": @"test2", @"key_3": @[@"test3"]}];
+    NSDictionary *errors;
+    NSArray *processedArray = [recipe processIngredientsArray:ingredientsArray errors:&errors];
+    
+    NSArray *expectedArray = @[@{@"key1": @"TEST1"},
+                               [NSNull null],
+                               @{@"key1": @"TEST2", @"key3": @"test3"}];
+    XCTAssertEqualObjects(processedArray, expectedArray, @"Each record should be processed in order");
+    XCTAssertEqualObjects([errors allKeys], @[@1], @"Only the failed record should have an error");
+}
+
+- (void)testProcessJSONData {
+    recipe = [[ZCREasyRecipe alloc] initWithName:nil
+                               ingredientMapping:@{@"key1": @"data.attributes.first",
+                                                   @"key2": @"data.attributes.second[1]",
+                                                   @"key3": @"data.tags",
+                                                   @"key4": @"data.missing.fourth",
+                                                   @"key5": @"data.id",
+                                                   @"key6": @"data.escaped\\key"}
+                          ingredientTransformers:@{@"key2": [ZCROneWayTransformer new]}
+                                           error:NULL];
+    
+    NSString *JSONString = @"{\"skipped\": {\"nested\": [1, \"]}\", {\"a\": null}]},"
+                           @" \"data\": {\"id\": -42, \"tags\": [\"a\", {\"b\": 1.5}],"
+                           @" \"attributes\": {\"first\": \"t\\u00e9st\", \"second\": [\"test2\", \"test3\"]},"
+                           @" \"escaped\\\\key\": true}}";
+    NSData *JSONData = [JSONString dataUsingEncoding:NSUTF8StringEncoding];
+    
+    NSError *error;
+    NSDictionary *processedIngredients = [recipe processJSONData:JSONData error:&error];
+    
+    NSDictionary *expectedIngredients = [recipe processIngredients:[NSJSONSerialization JSONObjectWithData:JSONData options:0 error:NULL]
+                                                             error:NULL];
+    XCTAssertNotNil(processedIngredients, @"The JSON data should be processed.");
+    XCTAssertNil(error, @"There should be no error.");
+    XCTAssertEqualObjects(processedIngredients, expectedIngredients, @"Streaming should match processing deserialized ingredients");
+    XCTAssertEqualObjects(processedIngredients[@"key1"], @"t\u00e9st", @"Escaped strings should be decoded");
+    XCTAssertEqualObjects(processedIngredients[@"key6"], @YES, @"Escaped keys should be matched");
+}
+
+- (void)testProcessJSONDataWithWildcards {
+    recipe = [[ZCREasyRecipe alloc] initWithName:nil
+                               ingredientMapping:@{@"skus": @"items[*].sku",
+                                                   @"tags": @"items[*].tags[*]",
+                                                   @"total": @"total"}
+                          ingredientTransformers:@{@"skus": [ZCROneWayTransformer new]}
+                                           error:NULL];
+    
+    NSData *JSONData = [@"{\"items\": [{\"sku\": \"a1\", \"tags\": [\"x\"]}, {\"sku\": \"b2\"}], \"total\": 3}"
+                        dataUsingEncoding:NSUTF8StringEncoding];
+    NSError *error;
+    NSDictionary *processedIngredients = [recipe processJSONData:JSONData error:&error];
+    
+    NSDictionary *expectedIngredients = [recipe processIngredients:[NSJSONSerialization JSONObjectWithData:JSONData options:0 error:NULL]
+                                                             error:NULL];
+    XCTAssertNil(error, @"There should be no error.");
+    XCTAssertEqualObjects(processedIngredients, expectedIngredients, @"Streaming should match processing deserialized ingredients");
+    XCTAssertEqualObjects(processedIngredients[@"skus"], (@[@"A1", @"B2"]), @"Every element should be transformed");
+}
+
+- (void)testProcessJSONDataWithOutOfBoundsIndex {
+    NSData *JSONData = [@"{\"key_1\": \"test1\", \"key_3\": []}" dataUsingEncoding:NSUTF8StringEncoding];
+    NSError *error;
+    NSDictionary *processedIngredients = [recipe processJSONData:JSONData error:&error];
+    
+    XCTAssertNil(processedIngredients, @"The ingredients should not be processed.");
+    XCTAssertNotNil(error, @"There should be an error.");
+}
+
+- (void)testProcessMalformedJSONData {
+    NSData *JSONData = [@"{\"other\": [1, 2, \"key_1\": \"test1\"}" dataUsingEncoding:NSUTF8StringEncoding];
+    NSError *error;
+    NSDictionary *processedIngredients = [recipe processJSONData:JSONData error:&error];
+    
+    XCTAssertNil(processedIngredients, @"Malformed data should not be processed.");
+    XCTAssertNotNil(error, @"There should be an error.");
+}
+
+- (void)testProcessMalformedSkippedJSONData {
+    for (NSString *skippedValue in @[@"{\"a\": [1}", @"[1 2]", @"{]", @"{\"a\" 1}", @"[1,]", @"[[]"]) {
+        NSString *JSONString = [NSString stringWithFormat:@"{\"other\": %@, \"key_1\": \"test1\"}", skippedValue];
+        NSError *error;
+        NSDictionary *processedIngredients = [recipe processJSONData:[JSONString dataUsingEncoding:NSUTF8StringEncoding] error:&error];
+    
+        XCTAssertNil(processedIngredients, @"Malformed skipped value %@ should not be processed.", skippedValue);
+        XCTAssertNotNil(error, @"There should be an error for %@.", skippedValue);
+    }
+    
+    NSData *JSONData = [@"{\"other\": {\"a\": [1, {}, [], \"]\"], \"b\": {\"c\": null}}, \"key_1\": \"test1\"}" dataUsingEncoding:NSUTF8StringEncoding];
+    XCTAssertNotNil([recipe processJSONData:JSONData error:NULL], @"Well formed skipped values should be processed.");
+}
+
+- (void)testProcessMalformedJSONNumbers {
+    recipe = [[ZCREasyRecipe alloc] initWithName:nil ingredientMapping:@{@"number": @"value"}
+                          ingredientTransformers:nil error:NULL];
+    
+    for (NSString *number in @[@"01", @"-01", @"1.", @"+1", @".5", @"-", @"1e", @"1e+", @"1.e5", @"1-2", @"--1"]) {
+        NSString *JSONString = [NSString stringWithFormat:@"{\"value\": %@}", number];
+        NSError *error;
+        NSDictionary *processedIngredients = [recipe processJSONData:[JSONString dataUsingEncoding:NSUTF8StringEncoding] error:&error];
+    
+        XCTAssertNil(processedIngredients, @"The malformed number %@ should not be processed.", number);
+        XCTAssertNotNil(error, @"There should be an error for %@.", number);
+    }
+    
+    for (NSString *number in @[@"0", @"-0", @"10", @"-1.5", @"0.25", @"1e5", @"1E-5", @"-2.5e+3"]) {
+        NSData *JSONData = [[NSString stringWithFormat:@"{\"value\": %@}", number] dataUsingEncoding:NSUTF8StringEncoding];
+        NSDictionary *processedIngredients = [recipe processJSONData:JSONData error:NULL];
+        NSDictionary *ingredients = [NSJSONSerialization JSONObjectWithData:JSONData options:0 error:NULL];
+        XCTAssertEqualObjects(processedIngredients[@"number"], ingredients[@"value"], @"The number %@ should be processed.", number);
+    }
+}
+
+- (ZCREasyRecipe *)mismatchRecipeWithPolicy:(ZCREasyRecipeMismatchPolicy)policy {
+    return [ZCREasyRecipe makeWith:^(id<ZCREasyRecipeMaker> recipeMaker) {
+        recipeMaker.ingredientMapping = @{@"name": @"user.name",
+                                          @"email": @"user.email",
+                                          @"tag": @"tags[2]",
+                                          @"identifier": @"id"};
+        recipeMaker.mismatchPolicy = policy;
+    }];
+}
+
+- (void)testFailFastMismatchPolicy {
+    recipe = [self mismatchRecipeWithPolicy:ZCREasyRecipeMismatchPolicyFailFast];
+    XCTAssertEqual(recipe.mismatchPolicy, ZCREasyRecipeMismatchPolicyFailFast, @"Failing fast should be the default");
+    
+    NSError *error;
+    NSDictionary *processedIngredients = [recipe processIngredients:@{@"user": @"Name", @"id": @1} error:&error];
+    
+    XCTAssertNil(processedIngredients, @"The ingredients should not be processed.");
+    XCTAssertEqual(error.code, ZCREasyBakeErrorMismatchedIngredients, @"The error should report the mismatch");
+    
+    NSDictionary *expectedMismatches = @{@"name": @"user.name", @"email": @"user.email"};
+    XCTAssertEqualObjects(error.userInfo[ZCREasyBakeMismatchedPropertiesKey], expectedMismatches, @"Every property under the mismatched container should be listed");
+    XCTAssertTrue([error.localizedFailureReason rangeOfString:@"email (user.email), name (user.name)"].location != NSNotFound, @"The reason should list every property and path");
+}
+
+- (void)testSkipFieldMismatchPolicy {
+    recipe = [self mismatchRecipeWithPolicy:ZCREasyRecipeMismatchPolicySkipField];
+    
+    NSDictionary *mismatches;
+    NSError *error;
+    NSDictionary *processedIngredients = [recipe processIngredients:@{@"user": [NSNull null], @"tags": @[@"a"], @"id": @1}
+                                                         mismatches:&mismatches error:&error];
+    
+    XCTAssertEqualObjects(processedIngredients, @{@"identifier": @1}, @"Unreachable properties should be skipped");
+    XCTAssertNil(error, @"There should be no error.");
+    
+    NSDictionary *expectedMismatches = @{@"name": @"user.name", @"email": @"user.email", @"tag": @"tags[2]"};
+    XCTAssertEqualObjects(mismatches, expectedMismatches, @"Every skipped property should be reported");
+    
+    ZCREasyRecipe *modifiedRecipe = [recipe modifyWith:^(id<ZCREasyRecipeMaker> recipeMaker) {}];
+    XCTAssertEqual(modifiedRecipe.mismatchPolicy, ZCREasyRecipeMismatchPolicySkipField, @"Modified recipes should keep the policy");
+    XCTAssertEqualObjects(modifiedRecipe, recipe, @"Recipes with the same policy should be equal");
+    XCTAssertNotEqualObjects([self mismatchRecipeWithPolicy:ZCREasyRecipeMismatchPolicyNullField], recipe, @"Recipes with different policies should not be equal");
+}
+
+- (void)testNullFieldMismatchPolicy {
+    recipe = [self mismatchRecipeWithPolicy:ZCREasyRecipeMismatchPolicyNullField];
+    
+    NSDictionary *mismatches;
+    NSDictionary *processedIngredients = [recipe processIngredients:@{@"user": @{@"name": @"Name"}, @"tags": @{}}
+                                                         mismatches:&mismatches error:NULL];
+    
+    NSDictionary *expectedIngredients = @{@"name": @"Name", @"tag": [NSNull null]};
+    XCTAssertEqualObjects(processedIngredients, expectedIngredients, @"Unreachable properties should be nulled, and missing ones left out");
+    XCTAssertEqualObjects(mismatches, @{@"tag": @"tags[2]"}, @"Only mismatched properties should be reported");
+}
+
+- (void)testProcessJSONDataWithMismatchPolicy {
+    NSData *JSONData = [@"{\"user\": [1, 2], \"tags\": [\"a\", \"b\", \"c\"], \"id\": 1}" dataUsingEncoding:NSUTF8StringEncoding];
+    
+    NSError *error;
+    recipe = [self mismatchRecipeWithPolicy:ZCREasyRecipeMismatchPolicyFailFast];
+    XCTAssertNil([recipe processJSONData:JSONData error:&error], @"The ingredients should not be processed.");
+    XCTAssertEqual(error.code, ZCREasyBakeErrorMismatchedIngredients, @"The error should report the mismatch");
+    
+    error = nil;
+    recipe = [self mismatchRecipeWithPolicy:ZCREasyRecipeMismatchPolicyNullField];
+    NSDictionary *processedIngredients = [recipe processJSONData:JSONData error:&error];
+    
+    NSDictionary *expectedIngredients = @{@"name": [NSNull null], @"email": [NSNull null],
+                                          @"tag": @"c", @"identifier": @1};
+    XCTAssertEqualObjects(processedIngredients, expectedIngredients, @"Mismatched values should be skipped over");
+    XCTAssertNil(error, @"There should be no error.");
+}
+
+- (void)testMemoizedTransformations {
+    ZCRCountingTransformer *transformer = [ZCRCountingTransformer new];
+    recipe = [[ZCREasyRecipe alloc] initWithName:nil ingredientMapping:mapping
+                          ingredientTransformers:@{@"key1": transformer}
+                               memoizationLimits:@{@"key1": @2} error:NULL];
+    
+    NSArray *rawValues = @[@"A", @"B", @"A", @"A", @"B", @"C", @"A"];
+    for (NSString *rawValue in rawValues) {
+        NSDictionary *processedIngredients = [recipe processIngredients:@{@"key_1": rawValue} error:NULL];
+        XCTAssertEqualObjects(processedIngredients[@"key1"], [rawValue lowercaseString], @"Memoized values should be transformed.");
+    }
+    
+    ZCREasyTransformerCache *cache = recipe.transformerCaches[@"key1"];
+    XCTAssertNotNil(cache, @"A cache should be created for the memoized property.");
+    XCTAssertEqual(transformer.transformationCount, (NSUInteger)4, @"Only misses should be transformed.");
+    XCTAssertEqual(cache.hitCount, (NSUInteger)3, @"Repeated values should hit the cache.");
+    XCTAssertEqual(cache.evictionCount, (NSUInteger)2, @"The least recently used values should be evicted.");
+    XCTAssertEqualWithAccuracy(cache.hitRate, 3.0 / 7.0, 0.0001, @"The hit rate should be reported.");
+    
+    ZCREasyRecipe *modifiedRecipe = [recipe modifyWith:^(id<ZCREasyRecipeMaker> recipeMaker) {
+        [recipeMaker removeInstructionForProperty:@"key1" error:NULL];
+    }];
+    XCTAssertEqual(modifiedRecipe.memoizationLimits.count, (NSUInteger)0, @"Removed properties should not be memoized.");
+}
+
+- (void)testImpureTransformersAreNotMemoized {
+    ZCRImpureTransformer *transformer = [ZCRImpureTransformer new];
+    recipe = [[ZCREasyRecipe alloc] initWithName:nil ingredientMapping:mapping
+                          ingredientTransformers:@{@"key1": transformer}
+                               memoizationLimits:@{@"key1": @10} error:NULL];
+    
+    [recipe processIngredients:@{@"key_1": @"A"} error:NULL];
+    [recipe processIngredients:@{@"key_1": @"A"} error:NULL];
+    
+    XCTAssertNil(recipe.transformerCaches[@"key1"], @"Impure transformers should not be cached.");
+    XCTAssertEqual(transformer.transformationCount, (NSUInteger)2, @"Each value should be transformed.");
+}
 
 #pragma mark - Error tests
 
@@ -158,6 +648,16 @@
     XCTAssertNotNil(error, @"The error should be returned.");
 }
 
+- (void)testMalformedIndexes {
+    for (NSString *ingredientPath in @[@"key[1]suffix", @"key[-1]", @"key[1", @"key[one]", @"key[99999999999999999999999]", @"key[*", @"key[**]"]) {
+        NSError *error;
+        recipe = [[ZCREasyRecipe alloc] initWithName:nil ingredientMapping:@{@"key1": ingredientPath}
+                              ingredientTransformers:nil error:&error];
+        XCTAssertNil(recipe, @"The recipe should be nil for %@.", ingredientPath);
+        XCTAssertNotNil(error, @"The error should be returned for %@.", ingredientPath);
+    }
+}
+
 - (void)testInconsistentRootMapping {
     NSDictionary *invalidMapping = @{@"key1": @"key_1",
                                      @"key2": @"[2]"};
@@ -176,6 +676,15 @@
     XCTAssertNotNil(error, @"The error should be returned.");
 }
 
+- (void)testInconsistentWildcardMapping {
+    NSDictionary *invalidMapping = @{@"key1": @"key[*].first",
+                                     @"key2": @"key[0].second"};
+    NSError *error;
+    recipe = [[ZCREasyRecipe alloc] initWithName:nil ingredientMapping:invalidMapping ingredientTransformers:nil error:&error];
+    XCTAssertNil(recipe, @"The recipe should be nil.");
+    XCTAssertNotNil(error, @"The error should be returned.");
+}
+
 - (void)testUnknownTransformerKey {
     NSDictionary *invalidTransformer = @{@"unknownKey": [ZCROneWayTransformer new]};
     NSError *error;
@@ -192,6 +701,22 @@
     XCTAssertNotNil(error, @"The error should be returned.");
 }
 
+- (void)testMemoizationLimitWithoutTransformer {
+    NSError *error;
+    recipe = [[ZCREasyRecipe alloc] initWithName:nil ingredientMapping:mapping ingredientTransformers:nil
+                               memoizationLimits:@{@"key1": @10} error:&error];
+    XCTAssertNil(recipe, @"The recipe should be nil.");
+    XCTAssertNotNil(error, @"The error should be returned.");
+}
+
+- (void)testInvalidMemoizationLimit {
+    NSError *error;
+    recipe = [[ZCREasyRecipe alloc] initWithName:nil ingredientMapping:mapping ingredientTransformers:transformers
+                               memoizationLimits:@{@"key1": @0} error:&error];
+    XCTAssertNil(recipe, @"The recipe should be nil.");
+    XCTAssertNotNil(error, @"The error should be returned.");
+}
+
 - (void)testInvalidTransformer {
     NSDictionary *invalidTransformer = @{@"key1": [NSNull null]};
     NSError *error;
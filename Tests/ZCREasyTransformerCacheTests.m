@@ -0,0 +1,133 @@
+//
+//  ZCREasyTransformerCacheTests.m
+//  ZCREasyBake
+//
+//  Created by Zachary Radke on 10/16/26.
+//  Copyright (c) 2026 Zach Radke. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "ZCREasyTransformerCache.h"
+
+@interface ZCREasyTransformerCacheTestsTransformer : NSValueTransformer
+@end
+
+@implementation ZCREasyTransformerCacheTestsTransformer
+
+- (id)transformedValue:(id)value {
+    return value ? [NSString stringWithFormat:@"transformed-%@", value] : nil;
+}
+
+@end
+
+@interface ZCREasyTransformerCacheTestsTypeTransformer : NSValueTransformer
+@end
+
+@implementation ZCREasyTransformerCacheTestsTypeTransformer
+
+- (id)transformedValue:(id)value {
+    return [NSString stringWithFormat:@"%@-%s", NSStringFromClass([value class]), [value objCType]];
+}
+
+@end
+
+@interface ZCREasyTransformerCacheTests : XCTestCase
+{
+    ZCREasyTransformerCache *cache;
+}
+@end
+
+@implementation ZCREasyTransformerCacheTests
+
+- (void)setUp {
+    [super setUp];
+    
+    cache = [[ZCREasyTransformerCache alloc] initWithCountLimit:3];
+}
+
+- (void)tearDown {
+    cache = nil;
+    
+    [super tearDown];
+}
+
+- (void)testEvictsLeastRecentlyUsed {
+    [cache setObject:@"a" forKey:@1];
+    [cache setObject:@"b" forKey:@2];
+    [cache setObject:@"c" forKey:@3];
+    
+    XCTAssertEqualObjects([cache objectForKey:@1], @"a", @"The first entry should be cached.");
+    
+    [cache setObject:@"d" forKey:@4];
+    
+    XCTAssertEqual(cache.count, (NSUInteger)3, @"The cache should respect its limit.");
+    XCTAssertNil([cache objectForKey:@2], @"The least recently used entry should be evicted.");
+    XCTAssertEqualObjects([cache objectForKey:@1], @"a", @"Recently used entries should be kept.");
+    XCTAssertEqualObjects([cache objectForKey:@4], @"d", @"The newest entry should be kept.");
+    XCTAssertEqual(cache.evictionCount, (NSUInteger)1, @"The eviction should be counted.");
+}
+
+- (void)testStatistics {
+    [cache setObject:@"a" forKey:@1];
+    [cache objectForKey:@1];
+    [cache objectForKey:@1];
+    [cache objectForKey:@2];
+    
+    XCTAssertEqual(cache.hitCount, (NSUInteger)2, @"The hits should be counted.");
+    XCTAssertEqual(cache.missCount, (NSUInteger)1, @"The misses should be counted.");
+    XCTAssertEqualWithAccuracy(cache.hitRate, 2.0 / 3.0, 0.0001, @"The hit rate should be reported.");
+    
+    [cache resetStatistics];
+    XCTAssertEqual(cache.hitCount, (NSUInteger)0, @"The statistics should be reset.");
+    XCTAssertEqual(cache.count, (NSUInteger)1, @"Resetting statistics should keep entries.");
+    
+    [cache removeAllObjects];
+    XCTAssertEqual(cache.count, (NSUInteger)0, @"All entries should be removed.");
+}
+
+- (void)testTransformedValue {
+    ZCREasyTransformerCacheTestsTransformer *transformer = [ZCREasyTransformerCacheTestsTransformer new];
+    
+    XCTAssertEqualObjects([cache transformedValue:@"x" withTransformer:transformer], @"transformed-x", @"The value should be transformed.");
+    XCTAssertEqualObjects([cache transformedValue:@"x" withTransformer:transformer], @"transformed-x", @"The cached value should be returned.");
+    XCTAssertEqualObjects([cache transformedValue:[NSNull null] withTransformer:transformer], [NSNull null], @"Nil results should become NSNull.");
+    XCTAssertEqual(cache.hitCount, (NSUInteger)1, @"The repeated value should hit the cache.");
+}
+
+- (void)testTransformedNumbersOfDifferentTypes {
+    ZCREasyTransformerCacheTestsTypeTransformer *transformer = [ZCREasyTransformerCacheTestsTypeTransformer new];
+    
+    NSString *boolResult = [cache transformedValue:@YES withTransformer:transformer];
+    NSString *integerResult = [cache transformedValue:@1 withTransformer:transformer];
+    NSString *doubleResult = [cache transformedValue:@1.0 withTransformer:transformer];
+    
+    XCTAssertEqualObjects(integerResult, [transformer transformedValue:@1], @"Integers should not reuse the result for a boolean.");
+    XCTAssertEqualObjects(doubleResult, [transformer transformedValue:@1.0], @"Doubles should not reuse the result for an integer.");
+    XCTAssertEqualObjects([cache transformedValue:@YES withTransformer:transformer], boolResult, @"The first type should stay cached.");
+    XCTAssertEqual(cache.hitCount, (NSUInteger)1, @"Only the value of the same type should hit the cache.");
+}
+
+- (void)testConcurrentAccess {
+    ZCREasyTransformerCacheTestsTransformer *transformer = [ZCREasyTransformerCacheTestsTransformer new];
+    __block NSUInteger mismatchCount = 0;
+    
+    dispatch_apply(8, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t thread) {
+        NSUInteger mismatches = 0;
+        for (NSUInteger i = 0; i < 10000; i++) {
+            NSNumber *value = @((i * (thread + 1)) % 7);
+            NSString *expected = [NSString stringWithFormat:@"transformed-%@", value];
+            if (![[cache transformedValue:value withTransformer:transformer] isEqual:expected]) {
+                mismatches++;
+            }
+        }
+        @synchronized(transformer) {
+            mismatchCount += mismatches;
+        }
+    });
+    
+    XCTAssertEqual(mismatchCount, (NSUInteger)0, @"Every lookup should return the right value.");
+    XCTAssertTrue(cache.count <= cache.countLimit, @"The cache should respect its limit.");
+    XCTAssertEqual(cache.hitCount + cache.missCount, (NSUInteger)80000, @"Every lookup should be counted.");
+}
+
+@end